@@ -75,8 +75,8 @@ declare module "@microsoft/windows-ai-electron" {
   // Progress Promise Interface
   // =============================
   
-  interface ProgressPromise<T> extends Promise<T> {
-    progress(callback: (error: Error | null, progress: string) => void): this;
+  interface ProgressPromise<T, P = string> extends Promise<T> {
+    progress(callback: (error: Error | null, progress: P) => void): this;
   }
   
   // =============================
@@ -89,6 +89,8 @@ declare module "@microsoft/windows-ai-electron" {
     static EnsureReadyAsync(): ProgressPromise<AIFeatureReadyResult>;
     
     GenerateResponseAsync(prompt: string, options?: LanguageModelOptions): ProgressPromise<LanguageModelResponseResult>;
+    GenerateResponseAsync(prompt: string, options: StopOptions & { languageModelOptions?: LanguageModelOptions }): ProgressPromise<StoppedResponse>;
+    GenerateResponseBatchAsync(prompts: string[], options?: BatchOptions & { languageModelOptions?: LanguageModelOptions; pack?: boolean | PackOptions }): ProgressPromise<BatchStats, BatchItem>;
     Close(): void;
   }
   
@@ -106,6 +108,17 @@ declare module "@microsoft/windows-ai-electron" {
     readonly ExtendedError?: string;
   }
   
+  export type StopReason = 'stopSequence' | 'maxChars' | 'maxSentences';
+  
+  export interface StopOptions {
+    stopSequences?: string[];
+    /** UTF-16 code units */
+    maxChars?: number;
+    maxSentences?: number;
+  }
+  
+  export type StoppedResponse = LanguageModelResponseResult & { readonly stopReason: StopReason | null };
+  
   export class AIFeatureReadyResult {
     readonly Error: number;
     readonly ErrorDisplayText: string;
@@ -122,20 +135,175 @@ declare module "@microsoft/windows-ai-electron" {
   export interface ConversationSummaryOptions {
     includeMessageCitations?: boolean;
     includeParticipantAttribution?: boolean;
+    fitToContext?: 'dropOldest' | 'summarizeOldest';
+  }
+
+  export type ConversationInput =
+    | Array<ConversationItem | { participant?: string; message: string }>
+    | { participants?: string[]; messages: string[] };
+
+  export interface ConversationFitReport {
+    readonly mode: 'dropOldest' | 'summarizeOldest';
+    readonly itemCount: number;
+    readonly droppedItems: number;
+    readonly condensedItems: number;
+    readonly summarizeCalls: number;
+    readonly checks: number;
   }
 
   // =============================
   // Text Intelligence Classes
   // =============================
 
+  export interface BatchOptions {
+    concurrency?: number;
+    ordered?: boolean;
+  }
+
+  export interface BatchItem {
+    readonly index: number;
+    readonly status?: number;
+    readonly text?: string;
+    readonly error?: string;
+  }
+
+  export interface TableBatchItem {
+    readonly index: number;
+    readonly status?: number;
+    readonly rows?: string[][];
+    readonly error?: string;
+  }
+
+  export interface BatchStats<TItem = BatchItem> {
+    readonly results: TItem[];
+    readonly count: number;
+    readonly completed: number;
+    readonly failed: number;
+    readonly totalMs: number;
+    readonly itemsPerSecond: number;
+    readonly meanLatencyMs: number;
+    readonly maxLatencyMs: number;
+    readonly inputLength: number;
+    readonly outputLength: number;
+    readonly modelCalls: number;
+    readonly packing?: PackingStats;
+  }
+
+  export interface PackOptions {
+    maxItems?: number;
+    maxLength?: number;
+  }
+
+  export interface PackingStats {
+    readonly packedCalls: number;
+    readonly packedItems: number;
+    readonly fallbackItems: number;
+    readonly itemsPerCall: number;
+    readonly estimatedGain: number | null;
+  }
+
   export class TextSummarizer {
     constructor(languageModel: LanguageModel);
     
     SummarizeAsync(text: string): ProgressPromise<LanguageModelResponseResult>;
-    SummarizeConversationAsync(conversationItems: ConversationItem[], options: ConversationSummaryOptions): ProgressPromise<LanguageModelResponseResult>;
+    SummarizeAsync(text: string, options: StopOptions): ProgressPromise<StoppedResponse>;
+    SummarizeConversationAsync(conversationItems: ConversationInput, options: ConversationSummaryOptions): ProgressPromise<LanguageModelResponseResult & { readonly fitToContext?: ConversationFitReport }>;
     SummarizeParagraphAsync(text: string): ProgressPromise<LanguageModelResponseResult>;
+    SummarizeParagraphAsync(text: string, options: StopOptions): ProgressPromise<StoppedResponse>;
     IsPromptLargerThanContext(text: string): boolean;
-    IsPromptLargerThanContext(conversationItems: ConversationItem[], options: ConversationSummaryOptions): { isLarger: boolean; cutoffPosition: number };
+    IsPromptLargerThanContext(conversationItems: ConversationInput, options: ConversationSummaryOptions): { isLarger: boolean; cutoffPosition: number };
+    SummarizeImageTextAsync(recognizer: TextRecognizer, image: string | RawFrame, options?: TextRecognitionOptions): ProgressPromise<ImageTextSummary>;
+    SummarizeLongTextAsync(text: string, options?: { maxParallel?: number }): ProgressPromise<LongTextSummary, LongTextSummaryProgress>;
+    FitToContextAsync(text: string): Promise<ContextFit>;
+    FitToContextAsync(texts: string[]): Promise<ContextFit[]>;
+    SummarizeDocumentAsync(text: string, options?: { maxParallel?: number; minParagraphLength?: number }): ProgressPromise<DocumentSummary, DocumentSummaryProgress>;
+    SummarizeBatchAsync(texts: string[], options?: BatchOptions & { paragraph?: boolean }): ProgressPromise<BatchStats, BatchItem>;
+  }
+
+  export interface DocumentSummaryProgress {
+    readonly paragraph: number;
+    readonly paragraphCount: number;
+    readonly text: string;
+  }
+
+  export interface DocumentSummary {
+    readonly text: string;
+    readonly status: number;
+    readonly paragraphCount: number;
+    readonly recomputedParagraphs: number;
+    readonly cachedParagraphs: number;
+    readonly verbatimParagraphs: number;
+    readonly skippedParagraphs: number;
+    readonly truncatedParagraphs: number;
+    readonly truncated: boolean;
+    readonly combinedFromCache: boolean;
+    readonly summarizeCalls: number;
+  }
+
+  export interface ConversationSummaryCheckpoint {
+    summary: string;
+    itemCount: number;
+  }
+
+  export interface ConversationSummaryUpdate {
+    readonly text: string;
+    readonly status: number;
+    readonly itemCount: number;
+    readonly appendedItems: number;
+    readonly condensedItems: number;
+    readonly droppedItems: number;
+    readonly summarizeCalls: number;
+  }
+
+  export class ConversationSummarySession {
+    constructor(summarizer: TextSummarizer, options?: ConversationSummaryOptions & { state?: ConversationSummaryCheckpoint });
+
+    AppendAsync(conversationItems: ConversationInput): ProgressPromise<ConversationSummaryUpdate>;
+    GetSummary(): string;
+    Checkpoint(): ConversationSummaryCheckpoint;
+    Restore(state: ConversationSummaryCheckpoint): void;
+    Reset(): void;
+  }
+
+  export interface ContextFit {
+    readonly fits: boolean;
+    readonly length: number;
+    readonly prefixLength: number;
+    readonly checks: number;
+    readonly cached: boolean;
+  }
+
+  export interface LongTextSummaryProgress {
+    readonly level: number;
+    readonly chunk: number;
+    readonly chunkCount: number;
+    readonly text: string;
+  }
+
+  export interface LongTextSummary {
+    readonly text: string;
+    readonly status: number;
+    readonly chunkCount: number;
+    readonly levels: number;
+    readonly summarizeCalls: number;
+    readonly skippedChunks: number;
+  }
+
+  export interface ImageTextSummary {
+    readonly text: string;
+    readonly status: number;
+    readonly lineCount: number;
+    readonly sourceLength: number;
+    readonly promptLength: number;
+    readonly truncated: boolean;
+    readonly timings: {
+      readonly decodeMs: number;
+      readonly recognizeMs: number;
+      readonly layoutMs: number;
+      readonly fitMs: number;
+      readonly summarizeMs: number;
+      readonly totalMs: number;
+    };
   }
 
   export class TextRewriter {
@@ -143,12 +311,113 @@ declare module "@microsoft/windows-ai-electron" {
     
     RewriteAsync(text: string): ProgressPromise<LanguageModelResponseResult>;
     RewriteAsync(text: string, tone: TextRewriteTone): ProgressPromise<LanguageModelResponseResult>;
+    RewriteAsync(text: string, options: StopOptions): ProgressPromise<StoppedResponse>;
+    RewriteAsync(text: string, tone: TextRewriteTone | undefined, options: StopOptions): ProgressPromise<StoppedResponse>;
+    RewriteDocumentAsync(text: string, options?: { tone?: TextRewriteTone; maxParallel?: number }): ProgressPromise<DocumentRewrite, DocumentRewriteProgress>;
+    RewriteBatchAsync(texts: string[], options?: BatchOptions & { tone?: TextRewriteTone; pack?: boolean | PackOptions }): ProgressPromise<BatchStats, BatchItem>;
+  }
+
+  export interface TextEdit {
+    readonly range: [number, number];
+    readonly replacement: string;
+  }
+
+  export interface DocumentRewriteProgress {
+    readonly paragraph: number;
+    readonly paragraphCount: number;
+    readonly text: string;
+  }
+
+  export interface DocumentRewrite {
+    readonly edits: TextEdit[];
+    readonly paragraphCount: number;
+    readonly rewrittenParagraphs: number;
+    readonly cachedParagraphs: number;
+    readonly skippedParagraphs: number;
   }
 
   export class TextToTableConverter {
     constructor(languageModel: LanguageModel);
     
     ConvertAsync(text: string): ProgressPromise<TextToTableResponseResult>;
+    ConvertAsync(text: string, options: { shape: TableShape; stream: true }): ProgressPromise<TableData, StreamedTableRow> & AsyncIterable<StreamedTableRow>;
+    ConvertAsync(text: string, options: { stream: true }): ProgressPromise<TextToTableResponseResult, StreamedTableRow> & AsyncIterable<StreamedTableRow>;
+    ConvertAsync(text: string, options: { shape: TableShape; stream?: false }): ProgressPromise<TableData>;
+    ConvertImageAsync(recognizer: TextRecognizer, image: string | RawFrame, options?: TextRecognitionOptions): ProgressPromise<ImageTable>;
+    ConvertLongAsync(text: string, options?: { maxChunkLength?: number; concurrency?: number; shape?: TableShape }): ProgressPromise<LongTable, TableChunkProgress>;
+    ConvertBatchAsync(texts: string[], options?: BatchOptions): ProgressPromise<BatchStats<TableBatchItem>, TableBatchItem>;
+  }
+
+  export interface ImageTable {
+    readonly columns: string[][];
+    readonly rowCount: number;
+    readonly columnCount: number;
+    readonly status: number;
+    readonly extendedError: number;
+    readonly detectedColumns: number;
+    readonly sourceLength: number;
+    readonly timings: {
+      readonly decodeMs: number;
+      readonly recognizeMs: number;
+      readonly serializeMs: number;
+      readonly convertMs: number;
+      readonly marshalMs: number;
+      readonly totalMs: number;
+    };
+  }
+
+  export type TableShape = 'columns' | 'blob' | 'csv' | 'tsv';
+
+  export interface TableData {
+    readonly columns?: string[][];
+    readonly data?: Buffer;
+    readonly offsets?: Uint32Array;
+    readonly rowCount: number;
+    readonly columnCount: number;
+    readonly status: number;
+    readonly extendedError: number;
+  }
+
+  export interface StreamedTableRow {
+    readonly index: number;
+    readonly cells: string[];
+    readonly revised: boolean;
+    readonly elapsedMs: number;
+  }
+
+  export interface TableChunkProgress {
+    readonly index: number;
+    readonly chunkCount: number;
+    readonly status?: number;
+    readonly rowCount?: number;
+    readonly error?: string;
+    readonly convertMs: number;
+  }
+
+  export interface LongTable {
+    readonly columns?: string[][];
+    readonly data?: Buffer;
+    readonly offsets?: Uint32Array;
+    readonly rowCount: number;
+    readonly columnCount: number;
+    readonly status: number;
+    readonly droppedHeaderRows: number;
+    readonly addedColumns: number;
+    readonly chunks: ReadonlyArray<{
+      readonly offset: number;
+      readonly length: number;
+      readonly status?: number;
+      readonly rowCount?: number;
+      readonly error?: string;
+      readonly convertMs: number;
+    }>;
+    readonly timings: {
+      readonly splitMs: number;
+      readonly convertMs: number;
+      readonly mergeMs: number;
+      readonly marshalMs: number;
+      readonly totalMs: number;
+    };
   }
 
   export class TextToTableResponseResult {
@@ -203,6 +472,24 @@ declare module "@microsoft/windows-ai-electron" {
       contentFilterOptions: ContentFilterOptions
     ): ProgressPromise<ImageDescriptionResult>;
     Close(): void;
+    ConfigureCache(options: DescriptionCacheOptions): void;
+    GetCacheStats(): DescriptionCacheStats;
+    ClearCache(): void;
+  }
+
+  export interface DescriptionCacheOptions {
+    enabled?: boolean;
+    maxHammingDistance?: number;
+    capacity?: number;
+  }
+
+  export interface DescriptionCacheStats {
+    readonly enabled: boolean;
+    readonly hits: number;
+    readonly misses: number;
+    readonly size: number;
+    readonly capacity: number;
+    readonly maxHammingDistance: number;
   }
   
   export class ImageDescriptionResult {
@@ -215,15 +502,38 @@ declare module "@microsoft/windows-ai-electron" {
     static GetReadyState(): AIFeatureReadyState;
     static EnsureReadyAsync(): ProgressPromise<AIFeatureReadyResult>;
     
-    RecognizeTextFromImageAsync(filePath: string): Promise<RecognizedText>;
+    RecognizeTextFromImageAsync(filePath: string, options: TextRecognitionOptions & { textOnly: true }): Promise<string>;
+    RecognizeTextFromImageAsync(filePath: string, options: TextRecognitionOptions & { layout: true }): Promise<TextLayout>;
+    RecognizeTextFromImageAsync(filePath: string, options?: TextRecognitionOptions): Promise<RecognizedText>;
     RecognizeTextFromImage(filePath: string): RecognizedText;
+    GetAdaptiveStats(): AdaptiveRecognitionStats;
     Close(): void;
     Dispose(): void;
   }
+
+  export interface AdaptiveRecognitionOptions {
+    scale?: number;
+    minConfidence?: number;
+    fullFrameRatio?: number;
+  }
+
+  export interface AdaptiveRecognitionStats {
+    readonly pages: number;
+    readonly refinedPages: number;
+    readonly fullFramePages: number;
+    readonly refinedRegions: number;
+    readonly refinedLines: number;
+    readonly coarseMs: number;
+    readonly refineMs: number;
+  }
   
   export class RecognizedText {
     readonly Lines: RecognizedLine[];
     readonly TextAngle: number;
+
+    HitTest(x: number, y: number): number;
+    QueryRect(rect: PixelRegion): number[];
+    Nearest(x: number, y: number, k?: number): number[];
   }
   
   export class RecognizedLine {
@@ -252,21 +562,144 @@ declare module "@microsoft/windows-ai-electron" {
     readonly BottomRight: Point;
   }
   
+  export interface RawFrame {
+    width: number;
+    height: number;
+    buffer: Buffer;
+    stride?: number;
+  }
+
+  export interface PixelRegion {
+    readonly x: number;
+    readonly y: number;
+    readonly width: number;
+    readonly height: number;
+  }
+
+  export interface TextRecognitionOptions {
+    regions?: PixelRegion[];
+    adaptive?: boolean | AdaptiveRecognitionOptions;
+    textOnly?: boolean;
+    layout?: boolean;
+    lineSeparator?: string;
+    paragraphSeparator?: string;
+    minWordConfidence?: number;
+  }
+
+  export interface TextLayoutLine {
+    text: string;
+    box: number[];
+  }
+
+  export interface TextLayoutParagraph {
+    block: number;
+    firstLine: number;
+    lineCount: number;
+  }
+
+  export interface TextLayoutBlock {
+    box: number[];
+    column: number;
+    firstParagraph: number;
+    paragraphCount: number;
+  }
+
+  export interface TextLayout {
+    textAngle: number;
+    lines: TextLayoutLine[];
+    paragraphs: TextLayoutParagraph[];
+    blocks: TextLayoutBlock[];
+  }
+
+  export interface IncrementalTextRecognizerOptions {
+    blockSize?: number;
+    tolerance?: number;
+    padding?: number;
+    fullFrameRatio?: number;
+  }
+
+  export interface IncrementalRecognitionResult {
+    readonly text: RecognizedText;
+    readonly dirtyRegions: PixelRegion[];
+    readonly fullFrame: boolean;
+  }
+
+  export class IncrementalTextRecognizer {
+    constructor(recognizer: TextRecognizer, options?: IncrementalTextRecognizerOptions);
+    RecognizeFrameAsync(frame: string | RawFrame): Promise<IncrementalRecognitionResult>;
+    Reset(): void;
+  }
+
+  export interface TextSearchIndexOptions {
+    flushDocuments?: number;
+    maxSegments?: number;
+  }
+
+  export interface TextSearchHit {
+    readonly imageId: string;
+    readonly boxes: number[][];
+  }
+
+  export interface TextSearchIndexStats {
+    readonly segments: number;
+    readonly documents: number;
+    readonly pendingDocuments: number;
+    readonly bytes: number;
+    readonly flushes: number;
+    readonly merges: number;
+    readonly lastError: string | null;
+  }
+
+  export class TextSearchIndex {
+    constructor(directory: string, options?: TextSearchIndexOptions);
+    Add(imageId: string, text: RecognizedText): void;
+    FlushAsync(): Promise<void>;
+    SearchAsync(query: string, options?: { limit?: number }): Promise<TextSearchHit[]>;
+    GetStats(): TextSearchIndexStats;
+    Close(): void;
+  }
+  
+  export interface ImageOutputOptions {
+    format: 'png' | 'jpeg';
+    quality?: number;
+    filePath?: string;
+  }
+
+  export interface EncodedImage {
+    readonly format: 'png' | 'jpeg';
+    readonly width: number;
+    readonly height: number;
+    readonly byteLength: number;
+    readonly encodeMs: number;
+    readonly buffer?: Buffer;
+    readonly filePath?: string;
+  }
+
+  export interface RawImage {
+    readonly format: 'bgra8';
+    readonly width: number;
+    readonly height: number;
+    readonly byteLength: number;
+    readonly buffer: Buffer;
+  }
+  
   export class ImageObjectRemover {
     static CreateAsync(): Promise<ImageObjectRemover>;
     static GetReadyState(): AIFeatureReadyState;
-    static EnsureReadyAsync(): Promise<AIFeatureReadyResult>;
+    static EnsureReadyAsync(): ProgressPromise<AIFeatureReadyResult>;
     
-    RemoveAsync(...args: any[]): Promise<any>; // Implementation pending
+    RemoveAsync(filePath: string, maskFilePath: string): Promise<RawImage>;
+    RemoveAsync(filePath: string, maskFilePath: string, output: ImageOutputOptions): Promise<EncodedImage>;
     Close(): void;
   }
   
   export class ImageScaler {
     static CreateAsync(): Promise<ImageScaler>;
     static GetReadyState(): AIFeatureReadyState;
-    static EnsureReadyAsync(): Promise<AIFeatureReadyResult>;
+    static EnsureReadyAsync(): ProgressPromise<AIFeatureReadyResult>;
     
-    ScaleAsync(...args: any[]): Promise<any>; // Implementation pending
+    ScaleAsync(filePath: string, width: number, height: number): Promise<RawImage>;
+    ScaleAsync(filePath: string, width: number, height: number, output: ImageOutputOptions): Promise<EncodedImage>;
     Close(): void;
   }
   
@@ -301,6 +734,34 @@ declare module "@microsoft/windows-ai-electron" {
     readonly EstimatedRemovalDate: Date | null;
   }
   
+  // =============================
+  // Result Store
+  // =============================
+  
+  export interface ResultStoreOptions {
+    maxBytes?: number;
+  }
+  
+  export interface ResultStoreStats {
+    readonly path: string;
+    readonly maxBytes: number;
+    readonly fileBytes: number;
+    readonly liveBytes: number;
+    readonly entries: number;
+    readonly hits: number;
+    readonly misses: number;
+    readonly compactions: number;
+    readonly lastError: string | null;
+  }
+  
+  export class ResultStore {
+    static Open(filePath: string, options?: ResultStoreOptions): void;
+    static Close(): void;
+    static GetStats(): ResultStoreStats | null;
+    static Compact(): void;
+    static Clear(): void;
+  }
+  
   // =============================
   // Module Properties
   // =============================
@@ -350,6 +811,8 @@ declare module "@microsoft/windows-ai-electron" {
     RecognizedLine: typeof RecognizedLine;
     RecognizedWord: typeof RecognizedWord;
     RecognizedTextBoundingBox: typeof RecognizedTextBoundingBox;
+    IncrementalTextRecognizer: typeof IncrementalTextRecognizer;
+    TextSearchIndex: typeof TextSearchIndex;
     ImageObjectRemover: typeof ImageObjectRemover;
     ImageScaler: typeof ImageScaler;
     ImageObjectExtractor: typeof ImageObjectExtractor;
@@ -359,6 +822,9 @@ declare module "@microsoft/windows-ai-electron" {
     LimitedAccessFeatures: typeof LimitedAccessFeatures;
     LimitedAccessFeatureRequestResult: typeof LimitedAccessFeatureRequestResult;
     
+    // Result Store
+    ResultStore: typeof ResultStore;
+    
     // Module Properties
     version: string;
   };
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <iostream>
+
+// Assertions for the native unit tests. A failed check prints its location and the test carries on;
+// main returns CheckResult() so ctest reports the executable as failed.
+
+inline int& CheckFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+template <typename Actual, typename Expected>
+void CheckEqual(const Actual& actual, const Expected& expected, const char* expression, const char* file, int line) {
+    if (!(actual == expected)) {
+        std::cerr << file << ":" << line << ": CHECK_EQ(" << expression << ") failed: got " << actual << ", expected " << expected << "\n";
+        CheckFailures()++;
+    }
+}
+
+inline int CheckResult() {
+    if (CheckFailures() > 0) {
+        std::cerr << CheckFailures() << " check(s) failed\n";
+        return 1;
+    }
+    return 0;
+}
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed\n"; \
+            CheckFailures()++;                                                             \
+        }                                                                                  \
+    } while (0)
+
+#define CHECK_EQ(actual, expected) CheckEqual((actual), (expected), #actual ", " #expected, __FILE__, __LINE__)
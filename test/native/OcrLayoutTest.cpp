@@ -0,0 +1,167 @@
+#include "Check.h"
+#include "OcrLayout.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+
+OcrLine MakeLine(const std::string& text, float x, float y, float width, float height = 16) {
+    OcrLine line;
+    line.text = text;
+    line.box = { { x, y }, { x + width, y }, { x, y + height }, { x + width, y + height } };
+    line.words.push_back({ text, line.box, 1.0f });
+    return line;
+}
+
+// Line texts in layout order, space separated
+std::string ReadingOrder(const OcrPage& page, const OcrLayout& layout) {
+    std::string order;
+    for (uint32_t index : layout.lineOrder) {
+        if (!order.empty()) {
+            order += ' ';
+        }
+        order += page.lines[index].text;
+    }
+    return order;
+}
+
+// Two columns of four lines, stored row by row as a recognizer returns them
+OcrPage TwoColumnPage() {
+    OcrPage page;
+    for (int row = 0; row < 4; row++) {
+        page.lines.push_back(MakeLine("L" + std::to_string(row), 0, row * 20.0f, 400));
+        page.lines.push_back(MakeLine("R" + std::to_string(row), 500, row * 20.0f, 400));
+    }
+    return page;
+}
+
+void Rotate(OcrPage& page, float degrees) {
+    float radians = degrees * 3.14159265f / 180.0f;
+    float cosine = std::cos(radians);
+    float sine = std::sin(radians);
+    auto rotate = [cosine, sine](OcrPoint& point) {
+        point = { point.x * cosine - point.y * sine, point.x * sine + point.y * cosine };
+    };
+    for (auto& line : page.lines) {
+        for (OcrPoint* point : { &line.box.topLeft, &line.box.topRight, &line.box.bottomLeft, &line.box.bottomRight }) {
+            rotate(*point);
+        }
+    }
+    page.textAngle = degrees;
+}
+
+void TestEmptyPage() {
+    OcrLayout layout = AnalyzeOcrLayout(OcrPage());
+    CHECK(layout.lineOrder.empty());
+    CHECK(layout.blocks.empty());
+}
+
+void TestColumnsReadBeforeRows() {
+    OcrPage page = TwoColumnPage();
+    OcrLayout layout = AnalyzeOcrLayout(page);
+    CHECK_EQ(ReadingOrder(page, layout), std::string("L0 L1 L2 L3 R0 R1 R2 R3"));
+    CHECK_EQ(layout.blocks.size(), size_t(2));
+    CHECK_EQ(layout.blocks[0].column, 0u);
+    CHECK_EQ(layout.blocks[1].column, 1u);
+}
+
+void TestHeadingAndFooterSpanColumns() {
+    OcrPage page = TwoColumnPage();
+    page.lines.insert(page.lines.begin(), MakeLine("H", 0, -40, 900));
+    page.lines.push_back(MakeLine("F", 0, 200, 900));
+    OcrLayout layout = AnalyzeOcrLayout(page);
+    CHECK_EQ(ReadingOrder(page, layout), std::string("H L0 L1 L2 L3 R0 R1 R2 R3 F"));
+    CHECK_EQ(layout.blocks.size(), size_t(4));
+}
+
+void TestTableColumnsAreBlocks() {
+    OcrPage page;
+    for (int row = 1; row <= 3; row++) {
+        for (char column : { 'a', 'b', 'c' }) {
+            page.lines.push_back(MakeLine(std::string(1, column) + std::to_string(row), (column - 'a') * 150.0f, row * 22.0f, 60));
+        }
+    }
+    OcrLayout layout = AnalyzeOcrLayout(page);
+    CHECK_EQ(ReadingOrder(page, layout), std::string("a1 a2 a3 b1 b2 b3 c1 c2 c3"));
+    CHECK_EQ(layout.blocks.size(), size_t(3));
+    for (uint32_t i = 0; i < layout.blocks.size(); i++) {
+        CHECK_EQ(layout.blocks[i].column, i);
+    }
+}
+
+void TestRotatedPageKeepsOrder() {
+    OcrPage page = TwoColumnPage();
+    page.lines.insert(page.lines.begin(), MakeLine("H", 0, -40, 900));
+    for (float angle : { -12.0f, 5.0f, 12.0f }) {
+        OcrPage rotated = page;
+        Rotate(rotated, angle);
+        OcrLayout layout = AnalyzeOcrLayout(rotated);
+        CHECK_EQ(ReadingOrder(rotated, layout), std::string("H L0 L1 L2 L3 R0 R1 R2 R3"));
+        CHECK_EQ(layout.textAngle, angle);
+    }
+}
+
+void TestOverlappingLinesKeptOnce() {
+    OcrPage page;
+    page.lines.push_back(MakeLine("A", 0, 0, 400));
+    page.lines.push_back(MakeLine("B", 10, 4, 400));
+    page.lines.push_back(MakeLine("C", 0, 20, 400));
+    page.lines.push_back(MakeLine("D", 300, 22, 400));
+    OcrLayout layout = AnalyzeOcrLayout(page);
+
+    std::vector<uint32_t> order = layout.lineOrder;
+    std::sort(order.begin(), order.end());
+    CHECK_EQ(order.size(), page.lines.size());
+    for (uint32_t i = 0; i < order.size(); i++) {
+        CHECK_EQ(order[i], i);
+    }
+    CHECK_EQ(page.lines[layout.lineOrder[0]].text, std::string("A"));
+
+    uint32_t covered = 0;
+    for (const auto& paragraph : layout.paragraphs) {
+        covered += paragraph.lineCount;
+    }
+    CHECK_EQ(covered, static_cast<uint32_t>(page.lines.size()));
+}
+
+void TestParagraphsSplitAtShortLine() {
+    OcrPage page;
+    page.lines.push_back(MakeLine("one", 0, 0, 400));
+    page.lines.push_back(MakeLine("two", 0, 20, 200));
+    page.lines.push_back(MakeLine("three", 0, 40, 400));
+    page.lines.push_back(MakeLine("four", 0, 60, 400));
+    OcrLayout layout = AnalyzeOcrLayout(page);
+    CHECK_EQ(layout.blocks.size(), size_t(1));
+    CHECK_EQ(layout.paragraphs.size(), size_t(2));
+    CHECK_EQ(JoinOcrLayoutText(page, layout, OcrTextOptions()), std::string("one\ntwo\n\nthree\nfour"));
+}
+
+void TestWideGridStaysLinear() {
+    // One block per cell; every row is a band with many open blocks. Guards against per-band work
+    // proportional to all blocks created so far.
+    OcrPage page;
+    for (int row = 0; row < 400; row++) {
+        for (int column = 0; column < 50; column++) {
+            page.lines.push_back(MakeLine("x", column * 100.0f, row * 60.0f, 60));
+        }
+    }
+    OcrLayout layout = AnalyzeOcrLayout(page);
+    CHECK_EQ(layout.lineOrder.size(), page.lines.size());
+    CHECK_EQ(layout.blocks.size(), page.lines.size());
+}
+
+} // namespace
+
+int main() {
+    TestEmptyPage();
+    TestColumnsReadBeforeRows();
+    TestHeadingAndFooterSpanColumns();
+    TestTableColumnsAreBlocks();
+    TestRotatedPageKeepsOrder();
+    TestOverlappingLinesKeptOnce();
+    TestParagraphsSplitAtShortLine();
+    TestWideGridStaysLinear();
+    return CheckResult();
+}
@@ -0,0 +1,65 @@
+#include "Check.h"
+#include "OcrModel.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+OcrLine MakeLine(const std::string& text, float x, float y, float width, float height = 16) {
+    OcrLine line;
+    line.text = text;
+    line.box = { { x, y }, { x + width, y }, { x, y + height }, { x + width, y + height } };
+    line.words.push_back({ text, line.box, 1.0f });
+    return line;
+}
+
+std::string Texts(const OcrPage& page) {
+    std::string texts;
+    for (const auto& line : page.lines) {
+        texts += (texts.empty() ? "" : " ") + line.text;
+    }
+    return texts;
+}
+
+void TestSpliceReplacesLinesInRegions() {
+    OcrPage page;
+    page.lines.push_back(MakeLine("A", 0, 0, 400));
+    page.lines.push_back(MakeLine("B", 0, 20, 200));
+    page.lines.push_back(MakeLine("side", 300, 22, 100));
+    page.lines.push_back(MakeLine("C", 0, 40, 400));
+
+    // Covers the band of B and the side note only; A ends at 16 and C starts at 40
+    std::vector<OcrRect> regions = { { 0, 18, 500, 20 } };
+    std::vector<OcrLine> replacement;
+    replacement.push_back(MakeLine("B2", 250, 21, 150));
+    replacement.push_back(MakeLine("B1", 0, 20, 200));
+    SpliceLines(page, regions, std::move(replacement));
+    CHECK_EQ(Texts(page), std::string("A B1 B2 C"));
+}
+
+void TestSpliceWithoutRegionsOnlyInserts() {
+    OcrPage page;
+    page.lines.push_back(MakeLine("C", 0, 40, 400));
+    page.lines.push_back(MakeLine("A", 0, 0, 400));
+    std::vector<OcrLine> replacement;
+    replacement.push_back(MakeLine("B", 0, 20, 400));
+    SpliceLines(page, {}, std::move(replacement));
+    CHECK_EQ(Texts(page), std::string("A B C"));
+}
+
+void TestSpliceEmptyReplacementDrops() {
+    OcrPage page;
+    page.lines.push_back(MakeLine("A", 0, 0, 100));
+    page.lines.push_back(MakeLine("B", 200, 0, 100));
+    SpliceLines(page, { { 150, 0, 200, 16 } }, {});
+    CHECK_EQ(Texts(page), std::string("A"));
+}
+
+} // namespace
+
+int main() {
+    TestSpliceReplacesLinesInRegions();
+    TestSpliceWithoutRegionsOnlyInserts();
+    TestSpliceEmptyReplacementDrops();
+    return CheckResult();
+}
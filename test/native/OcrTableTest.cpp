@@ -0,0 +1,99 @@
+#include "Check.h"
+#include "OcrTable.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+struct WordSpec {
+    std::string text;
+    float x;
+    float width;
+    float confidence;
+};
+
+// One recognized line across a table row, as the recognizer returns a row with wide gaps
+OcrLine MakeRow(float y, const std::vector<WordSpec>& words, float height = 16) {
+    OcrLine line;
+    for (const auto& spec : words) {
+        OcrQuad box = { { spec.x, y }, { spec.x + spec.width, y }, { spec.x, y + height }, { spec.x + spec.width, y + height } };
+        line.words.push_back({ spec.text, box, spec.confidence });
+        line.text += (line.text.empty() ? "" : " ") + spec.text;
+    }
+    float left = words.front().x;
+    float right = words.back().x + words.back().width;
+    line.box = { { left, y }, { right, y }, { left, y + height }, { right, y + height } };
+    return line;
+}
+
+// Three columns at x = 0, 200 and 400, one row every 30 pixels
+OcrPage GridPage() {
+    OcrPage page;
+    for (int row = 1; row <= 3; row++) {
+        std::string n = std::to_string(row);
+        page.lines.push_back(MakeRow(row * 30.0f, { { "a" + n, 0, 60, 1 }, { "b" + n, 200, 60, 1 }, { "c" + n, 400, 60, 1 } }));
+    }
+    return page;
+}
+
+void TestRegularGrid() {
+    OcrTableGrid grid = BuildOcrTableGrid(GridPage(), 0);
+    CHECK_EQ(grid.columnCount, 3u);
+    CHECK_EQ(grid.rows.size(), size_t(3));
+    CHECK(grid.rows[1] == std::vector<std::string>({ "a2", "b2", "c2" }));
+    CHECK_EQ(FormatOcrTableText(grid), std::string("a1 | b1 | c1\na2 | b2 | c2\na3 | b3 | c3"));
+}
+
+void TestRaggedRow() {
+    OcrPage page = GridPage();
+    page.lines.push_back(MakeRow(120, { { "a4", 0, 60, 1 }, { "c4", 410, 40, 1 } }));
+    OcrTableGrid grid = BuildOcrTableGrid(page, 0);
+    CHECK_EQ(grid.columnCount, 3u);
+    CHECK(grid.rows.back() == std::vector<std::string>({ "a4", "", "c4" }));
+    CHECK_EQ(FormatOcrTableText(grid).substr(FormatOcrTableText(grid).rfind('\n') + 1), std::string("a4 |  | c4"));
+}
+
+void TestWideCellKeepsColumns() {
+    // "Total due" reaches from column b into column c; it must not fuse the two columns
+    OcrPage page = GridPage();
+    page.lines.push_back(MakeRow(120, { { "Sum", 0, 60, 1 }, { "Total", 190, 100, 1 }, { "due", 300, 140, 1 } }));
+    OcrTableGrid grid = BuildOcrTableGrid(page, 0);
+    CHECK_EQ(grid.columnCount, 3u);
+    CHECK(grid.rows.back() == std::vector<std::string>({ "Sum", "Total due", "" }));
+    CHECK(grid.rows[0] == std::vector<std::string>({ "a1", "b1", "c1" }));
+}
+
+void TestTitleRowDoesNotBridge() {
+    OcrPage page = GridPage();
+    page.lines.insert(page.lines.begin(), MakeRow(0, { { "Quarterly", 0, 200, 1 }, { "report", 205, 250, 1 } }));
+    OcrTableGrid grid = BuildOcrTableGrid(page, 0);
+    CHECK_EQ(grid.columnCount, 3u);
+    CHECK_EQ(grid.rows.size(), size_t(4));
+    CHECK(grid.rows[0] == std::vector<std::string>({ "Quarterly report", "", "" }));
+}
+
+void TestLowConfidenceWordsFiltered() {
+    OcrPage page = GridPage();
+    page.lines[1] = MakeRow(60, { { "a2", 0, 60, 0.9f }, { "b2", 200, 60, 0.2f }, { "c2", 400, 60, 0.9f } });
+    CHECK(BuildOcrTableGrid(page, 0.5f).rows[1] == std::vector<std::string>({ "a2", "", "c2" }));
+    CHECK(BuildOcrTableGrid(page, 0).rows[1] == std::vector<std::string>({ "a2", "b2", "c2" }));
+}
+
+void TestEmptyPage() {
+    OcrTableGrid grid = BuildOcrTableGrid(OcrPage(), 0);
+    CHECK_EQ(grid.columnCount, 0u);
+    CHECK(grid.rows.empty());
+    CHECK(FormatOcrTableText(grid).empty());
+}
+
+} // namespace
+
+int main() {
+    TestRegularGrid();
+    TestRaggedRow();
+    TestWideCellKeepsColumns();
+    TestTitleRowDoesNotBridge();
+    TestLowConfidenceWordsFiltered();
+    TestEmptyPage();
+    return CheckResult();
+}
@@ -0,0 +1,93 @@
+// Build time and query latency of OcrWordIndex on a synthetic dense page. Not run by ctest:
+//   OcrWordIndexBenchmark [words]
+#include "OcrWordIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MicrosecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+// Lines of words of random width across an A4 page at 300 dpi, wrapping like body text
+OcrPage MakePage(size_t words, std::mt19937& rng) {
+    OcrPage page;
+    OcrLine line;
+    float x = 100;
+    float y = 100;
+    for (size_t i = 0; i < words; i++) {
+        float width = static_cast<float>(20 + rng() % 120);
+        if (x + width > 2380) {
+            page.lines.push_back(std::move(line));
+            line = OcrLine();
+            x = 100;
+            y += 40;
+        }
+        line.words.push_back({ "w", { { x, y }, { x + width, y }, { x, y + 30 }, { x + width, y + 30 } }, 1.0f });
+        x += width + 15;
+    }
+    page.lines.push_back(std::move(line));
+    return page;
+}
+
+void ReportLatency(const char* label, size_t queries, const std::function<size_t(std::mt19937&)>& query) {
+    std::mt19937 rng(7);
+    std::vector<double> samples;
+    size_t results = 0;
+    for (size_t i = 0; i < queries; i++) {
+        auto start = Clock::now();
+        results += query(rng);
+        samples.push_back(MicrosecondsSince(start));
+    }
+    std::sort(samples.begin(), samples.end());
+    std::printf("%-10s p50 %7.2f us  p99 %7.2f us  avg results %.1f\n", label, samples[samples.size() / 2], samples[samples.size() * 99 / 100],
+                static_cast<double>(results) / queries);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t words = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000;
+    std::mt19937 rng(1);
+    OcrPage page = MakePage(words, rng);
+
+    auto start = Clock::now();
+    OcrWordIndex index(page);
+    std::printf("build      %zu words in %.0f us\n", index.WordCount(), MicrosecondsSince(start));
+
+    OcrRect extent = QuadBounds(page.lines.front().words.front().box);
+    for (const auto& line : page.lines) {
+        for (const auto& word : line.words) {
+            extent = RectUnion(extent, QuadBounds(word.box));
+        }
+    }
+    auto point = [&extent](std::mt19937& generator, float& x, float& y) {
+        x = extent.x + std::uniform_real_distribution<float>(0, extent.width)(generator);
+        y = extent.y + std::uniform_real_distribution<float>(0, extent.height)(generator);
+    };
+
+    ReportLatency("hitTest", 10000, [&](std::mt19937& generator) {
+        float x, y;
+        point(generator, x, y);
+        return index.HitTest(x, y) >= 0 ? size_t(1) : size_t(0);
+    });
+    ReportLatency("queryRect", 10000, [&](std::mt19937& generator) {
+        float x, y;
+        point(generator, x, y);
+        return index.QueryRect({ x, y, 300, 120 }).size(); // a drag selection of a few lines
+    });
+    ReportLatency("nearest", 10000, [&](std::mt19937& generator) {
+        float x, y;
+        point(generator, x, y);
+        return index.Nearest(x, y, 5).size();
+    });
+    return 0;
+}
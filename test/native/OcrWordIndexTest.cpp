@@ -0,0 +1,137 @@
+#include "Check.h"
+#include "OcrWordIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+OcrQuad Box(float x, float y, float width, float height) {
+    return { { x, y }, { x + width, y }, { x, y + height }, { x + width, y + height } };
+}
+
+// One line per word keeps the flat index equal to the order of the boxes
+OcrPage MakePage(const std::vector<OcrQuad>& boxes) {
+    OcrPage page;
+    for (const auto& box : boxes) {
+        OcrLine line;
+        line.box = box;
+        line.words.push_back({ "w", box, 1.0f });
+        page.lines.push_back(std::move(line));
+    }
+    return page;
+}
+
+// Distance from the point to an axis-aligned box, 0 inside
+float DistanceToBox(const OcrQuad& box, float x, float y) {
+    OcrRect bounds = QuadBounds(box);
+    float dx = std::max({ bounds.x - x, 0.0f, x - bounds.Right() });
+    float dy = std::max({ bounds.y - y, 0.0f, y - bounds.Bottom() });
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+void TestEmptyPage() {
+    OcrWordIndex index{ OcrPage() };
+    CHECK_EQ(index.WordCount(), size_t(0));
+    CHECK_EQ(index.HitTest(0, 0), int64_t(-1));
+    CHECK(index.QueryRect({ -10, -10, 100, 100 }).empty());
+    CHECK(index.Nearest(0, 0, 3).empty());
+}
+
+void TestHitTestPicksSmallestWord() {
+    OcrWordIndex index(MakePage({ Box(0, 0, 100, 20), Box(40, 5, 20, 10), Box(200, 0, 50, 20) }));
+    CHECK_EQ(index.HitTest(50, 10), int64_t(1));
+    CHECK_EQ(index.HitTest(10, 10), int64_t(0));
+    CHECK_EQ(index.HitTest(220, 10), int64_t(2));
+    CHECK_EQ(index.HitTest(150, 10), int64_t(-1));
+    CHECK_EQ(index.HitTest(-5, 10), int64_t(-1));
+}
+
+void TestHitTestMissesOutsideRotatedQuad() {
+    // A word rotated by 45 degrees: the corners of its bounds are in its cell but outside the quad
+    OcrQuad diamond = { { 50, 0 }, { 100, 50 }, { 0, 50 }, { 50, 100 } };
+    OcrWordIndex index(MakePage({ diamond }));
+    CHECK_EQ(index.HitTest(50, 50), int64_t(0));
+    CHECK_EQ(index.HitTest(70, 45), int64_t(0));
+    CHECK_EQ(index.HitTest(5, 5), int64_t(-1));
+    CHECK_EQ(index.HitTest(95, 95), int64_t(-1));
+}
+
+void TestQueryRectSortedWithoutDuplicates() {
+    // Long words cross many cells of a grid sized for the many small ones
+    std::vector<OcrQuad> boxes;
+    for (int i = 0; i < 200; i++) {
+        boxes.push_back(Box((i % 20) * 50.0f, (i / 20) * 30.0f, 40, 20));
+    }
+    boxes.push_back(Box(0, 25, 1000, 4));
+    boxes.push_back(Box(475, 0, 4, 300));
+    OcrWordIndex index(MakePage(boxes));
+
+    std::mt19937 rng(5);
+    for (int round = 0; round < 200; round++) {
+        OcrRect rect = { static_cast<float>(rng() % 1100) - 50, static_cast<float>(rng() % 350) - 25, static_cast<float>(rng() % 400), static_cast<float>(rng() % 150) };
+        std::vector<uint32_t> expected;
+        for (uint32_t word = 0; word < boxes.size(); word++) {
+            OcrRect bounds = QuadBounds(boxes[word]);
+            if (bounds.x <= rect.Right() && rect.x <= bounds.Right() && bounds.y <= rect.Bottom() && rect.y <= bounds.Bottom()) {
+                expected.push_back(word);
+            }
+        }
+        CHECK(index.QueryRect(rect) == expected);
+    }
+    auto all = index.QueryRect({ 400, 0, 100, 300 });
+    CHECK(std::is_sorted(all.begin(), all.end()));
+    CHECK(std::adjacent_find(all.begin(), all.end()) == all.end());
+    CHECK(std::count(all.begin(), all.end(), 200u) == 1 && std::count(all.begin(), all.end(), 201u) == 1);
+}
+
+void TestNearestFarRings() {
+    // A dense block in one corner and three words far away: from the empty middle the k-th word is
+    // many rings out
+    std::vector<OcrQuad> boxes;
+    for (int i = 0; i < 100; i++) {
+        boxes.push_back(Box((i % 10) * 12.0f, (i / 10) * 12.0f, 10, 10));
+    }
+    boxes.push_back(Box(900, 900, 10, 10));
+    boxes.push_back(Box(1000, 500, 10, 10));
+    boxes.push_back(Box(500, 1000, 10, 10));
+    OcrWordIndex index(MakePage(boxes));
+
+    auto nearest = index.Nearest(950, 800, 3);
+    CHECK_EQ(nearest.size(), size_t(3));
+    CHECK_EQ(nearest[0], 100u);
+    CHECK_EQ(nearest[1], 101u);
+    CHECK_EQ(nearest[2], 102u);
+
+    // Distances match a brute-force ranking wherever the point is
+    std::mt19937 rng(9);
+    for (int round = 0; round < 300; round++) {
+        float x = static_cast<float>(rng() % 1200) - 100;
+        float y = static_cast<float>(rng() % 1200) - 100;
+        size_t k = 1 + rng() % 12;
+        std::vector<float> expected;
+        for (const auto& box : boxes) {
+            expected.push_back(DistanceToBox(box, x, y));
+        }
+        std::sort(expected.begin(), expected.end());
+        auto words = index.Nearest(x, y, k);
+        CHECK_EQ(words.size(), k);
+        for (size_t i = 0; i < words.size(); i++) {
+            CHECK(std::fabs(DistanceToBox(boxes[words[i]], x, y) - expected[i]) < 1e-3f);
+        }
+    }
+    CHECK_EQ(index.Nearest(0, 0, 1000).size(), boxes.size());
+}
+
+} // namespace
+
+int main() {
+    TestEmptyPage();
+    TestHitTestPicksSmallestWord();
+    TestHitTestMissesOutsideRotatedQuad();
+    TestQueryRectSortedWithoutDuplicates();
+    TestNearestFarRings();
+    return CheckResult();
+}
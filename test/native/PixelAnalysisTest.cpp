@@ -0,0 +1,165 @@
+#include "Check.h"
+#include "PixelAnalysis.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+// BGRA8 frame with an optional row padding
+struct Frame {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t stride = 0;
+    std::vector<uint8_t> pixels;
+
+    Frame(uint32_t frameWidth, uint32_t frameHeight, uint32_t padding = 0)
+        : width(frameWidth), height(frameHeight), stride(frameWidth * 4 + padding), pixels(static_cast<size_t>(stride) * frameHeight, 0) {}
+
+    uint8_t* At(uint32_t x, uint32_t y) { return pixels.data() + static_cast<size_t>(y) * stride + static_cast<size_t>(x) * 4; }
+
+    void Fill(uint32_t x, uint32_t y, uint8_t gray) {
+        uint8_t* pixel = At(x, y);
+        pixel[0] = pixel[1] = pixel[2] = gray;
+        pixel[3] = 255;
+    }
+};
+
+// 90x80 frame of 10x10 gray blocks with random levels, one block per hash cell
+Frame BlockFrame(uint32_t seed, uint32_t padding = 0) {
+    std::mt19937 rng(seed);
+    uint8_t levels[8][9];
+    for (auto& row : levels) {
+        for (auto& level : row) {
+            level = static_cast<uint8_t>(30 + rng() % 190);
+        }
+    }
+    Frame frame(90, 80, padding);
+    for (uint32_t y = 0; y < frame.height; y++) {
+        for (uint32_t x = 0; x < frame.width; x++) {
+            frame.Fill(x, y, levels[y / 10][x / 10]);
+        }
+    }
+    return frame;
+}
+
+uint64_t Hash(const Frame& frame) {
+    return ComputeDifferenceHash(frame.pixels.data(), frame.width, frame.height, frame.stride);
+}
+
+void TestIdenticalFramesHashTheSame() {
+    CHECK_EQ(Hash(BlockFrame(1)), Hash(BlockFrame(1)));
+    CHECK_EQ(HammingDistance(Hash(BlockFrame(1)), Hash(BlockFrame(1))), 0u);
+    CHECK_EQ(ComputeDifferenceHash(nullptr, 0, 0, 0), uint64_t(0));
+}
+
+void TestBrightnessChangeStaysNear() {
+    // Brighter by 8 with a little per-pixel noise, as a recompressed screenshot would be
+    Frame original = BlockFrame(2);
+    Frame brighter = original;
+    std::mt19937 rng(3);
+    for (uint32_t y = 0; y < brighter.height; y++) {
+        for (uint32_t x = 0; x < brighter.width; x++) {
+            brighter.Fill(x, y, static_cast<uint8_t>(original.At(x, y)[0] + 8 + rng() % 3));
+        }
+    }
+    // A distance a caller would configure for near duplicates
+    CHECK(HammingDistance(Hash(original), Hash(brighter)) <= 4u);
+}
+
+void TestDifferentImageIsFar() {
+    CHECK(HammingDistance(Hash(BlockFrame(4)), Hash(BlockFrame(5))) > 16u);
+}
+
+void TestStridePaddingIgnored() {
+    Frame packed = BlockFrame(6);
+    Frame padded = BlockFrame(6, 24);
+    // Bright garbage in the padding would shift the right-hand cells if it were read
+    for (uint32_t y = 0; y < padded.height; y++) {
+        for (uint32_t i = padded.width * 4; i < padded.stride; i++) {
+            padded.pixels[static_cast<size_t>(y) * padded.stride + i] = 255;
+        }
+    }
+    CHECK_EQ(Hash(packed), Hash(padded));
+}
+
+// Uniform gray frame
+Frame GrayFrame(uint32_t width, uint32_t height, uint8_t gray) {
+    Frame frame(width, height);
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            frame.Fill(x, y, gray);
+        }
+    }
+    return frame;
+}
+
+// Adds delta to the color channels of the block at (bx, by)
+void ChangeBlock(Frame& frame, uint32_t bx, uint32_t by, uint32_t blockSize, uint8_t delta) {
+    for (uint32_t y = by * blockSize; y < (by + 1) * blockSize && y < frame.height; y++) {
+        for (uint32_t x = bx * blockSize; x < (bx + 1) * blockSize && x < frame.width; x++) {
+            frame.Fill(x, y, static_cast<uint8_t>(frame.At(x, y)[0] + delta));
+        }
+    }
+}
+
+std::vector<PixelRect> Changes(const Frame& previous, const Frame& current, uint32_t tolerance) {
+    return FindChangedRegions(previous.pixels.data(), current.pixels.data(), previous.width, previous.height, previous.stride, 16, tolerance);
+}
+
+bool SameRect(const PixelRect& rect, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    return rect.x == x && rect.y == y && rect.width == width && rect.height == height;
+}
+
+void TestIdenticalFramesHaveNoRegions() {
+    Frame frame = BlockFrame(7);
+    CHECK(Changes(frame, frame, 0).empty());
+}
+
+void TestToleranceAgainstOneBlock() {
+    // +8 on three of four channels is a mean difference of 6 per byte
+    Frame previous = GrayFrame(64, 64, 100);
+    Frame current = previous;
+    ChangeBlock(current, 1, 2, 16, 8);
+    CHECK(Changes(previous, current, 6).empty());
+    auto regions = Changes(previous, current, 5);
+    CHECK_EQ(regions.size(), size_t(1));
+    CHECK(SameRect(regions[0], 16, 32, 16, 16));
+    CHECK_EQ(Changes(previous, current, 0).size(), size_t(1));
+}
+
+void TestAdjacentBlocksMerge() {
+    Frame previous = GrayFrame(128, 64, 100);
+    Frame current = previous;
+    ChangeBlock(current, 1, 1, 16, 50);
+    ChangeBlock(current, 2, 1, 16, 50);
+    ChangeBlock(current, 3, 2, 16, 50); // diagonal neighbour
+    ChangeBlock(current, 7, 0, 16, 50); // apart
+    auto regions = Changes(previous, current, 0);
+    CHECK_EQ(regions.size(), size_t(2));
+    CHECK(SameRect(regions[0], 112, 0, 16, 16));
+    CHECK(SameRect(regions[1], 16, 16, 48, 32));
+}
+
+void TestPartialEdgeBlockIsClipped() {
+    Frame previous = GrayFrame(70, 50, 100);
+    Frame current = previous;
+    current.Fill(69, 49, 200);
+    auto regions = Changes(previous, current, 0);
+    CHECK_EQ(regions.size(), size_t(1));
+    CHECK(SameRect(regions[0], 64, 48, 6, 2));
+}
+
+} // namespace
+
+int main() {
+    TestIdenticalFramesHashTheSame();
+    TestBrightnessChangeStaysNear();
+    TestDifferentImageIsFar();
+    TestStridePaddingIgnored();
+    TestIdenticalFramesHaveNoRegions();
+    TestToleranceAgainstOneBlock();
+    TestAdjacentBlocksMerge();
+    TestPartialEdgeBlockIsClipped();
+    return CheckResult();
+}
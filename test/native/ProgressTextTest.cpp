@@ -0,0 +1,68 @@
+#include "Check.h"
+#include "ProgressText.h"
+#include <initializer_list>
+#include <string>
+
+namespace {
+
+// Text after feeding the fragments in order, and what the calls returned together
+std::string Feed(ProgressText& text, std::initializer_list<const char*> fragments) {
+    std::string added;
+    for (const char* fragment : fragments) {
+        added += text.Append(fragment);
+    }
+    return added;
+}
+
+void TestNewTextFragments() {
+    ProgressText text;
+    CHECK_EQ(Feed(text, { "Hello", " world", "!" }), std::string("Hello world!"));
+    CHECK_EQ(text.Text(), std::string("Hello world!"));
+}
+
+void TestNewTextThatExtendsThePreviousFragment() {
+    // "\n|" starts with "\n" but is new text, settled by " Name"
+    ProgressText text;
+    CHECK_EQ(Feed(text, { "\n", "\n|", " Name", " |\n" }), std::string("\n\n| Name |\n"));
+    CHECK_EQ(text.Text(), std::string("\n\n| Name |\n"));
+}
+
+void TestTextSoFarWithRepeat() {
+    // The repeated "Hi" adds nothing; two extensions in a row settle it as text so far
+    ProgressText text;
+    CHECK_EQ(Feed(text, { "Hi", "Hi", "Hi there", "Hi there." }), std::string("Hi there."));
+    CHECK_EQ(Feed(text, { "Hi there.", "Hi there. Bye" }), std::string(" Bye"));
+    CHECK_EQ(text.Text(), std::string("Hi there. Bye"));
+}
+
+void TestTextSoFarSettledByLongPrefix() {
+    ProgressText text;
+    CHECK_EQ(Feed(text, { "A long first fragment", "A long first fragment, then more" }), std::string("A long first fragment, then more"));
+}
+
+void TestRepeatAfterSettlingAsNewText() {
+    // Once settled as new text, a repeated fragment is text like any other
+    ProgressText text;
+    Feed(text, { "ha", " ", "ha", "ha" });
+    CHECK_EQ(text.Text(), std::string("ha haha"));
+}
+
+void TestHeldBackUntilSettled() {
+    ProgressText text;
+    CHECK(text.Append("Hi").empty());
+    CHECK(text.Append("Hi").empty());
+    CHECK(text.Text().empty());
+    CHECK_EQ(std::string(text.Append(" you")), std::string("Hi you"));
+}
+
+} // namespace
+
+int main() {
+    TestNewTextFragments();
+    TestNewTextThatExtendsThePreviousFragment();
+    TestTextSoFarWithRepeat();
+    TestTextSoFarSettledByLongPrefix();
+    TestRepeatAfterSettlingAsNewText();
+    TestHeldBackUntilSettled();
+    return CheckResult();
+}
@@ -0,0 +1,99 @@
+#include "Check.h"
+#include "PromptPacking.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::wstring_view> Views(const std::vector<std::wstring>& inputs) {
+    return std::vector<std::wstring_view>(inputs.begin(), inputs.end());
+}
+
+size_t GroupSize(const PackGroup& group) {
+    return group.end - group.begin;
+}
+
+// Groups cover every input once, in order
+void CheckCoverage(const std::vector<PackGroup>& groups, size_t count) {
+    size_t next = 0;
+    for (const auto& group : groups) {
+        CHECK_EQ(group.begin, next);
+        CHECK(group.end > group.begin);
+        next = group.end;
+    }
+    CHECK_EQ(next, count);
+}
+
+void TestAllShortInputsKeepOneAlone() {
+    std::vector<std::wstring> inputs(10, L"short text");
+    auto groups = PlanPackGroups(Views(inputs), 4, 2000);
+    CheckCoverage(groups, inputs.size());
+    // Groups of 4, 4 and 2, with the first item of a full group split off as the baseline call
+    size_t alone = 0;
+    for (const auto& group : groups) {
+        CHECK(GroupSize(group) <= 4);
+        alone += GroupSize(group) == 1;
+    }
+    CHECK_EQ(alone, size_t(1));
+    CHECK_EQ(groups.size(), size_t(4));
+    CHECK_EQ(GroupSize(groups[0]), size_t(1));
+    CHECK_EQ(GroupSize(groups[1]), size_t(3));
+}
+
+void TestExistingBaselineIsKept() {
+    // The last short input is alone anyway, nothing is split off
+    std::vector<std::wstring> inputs = { L"a", L"b", L"c", L"d", L"e" };
+    auto groups = PlanPackGroups(Views(inputs), 4, 2000);
+    CheckCoverage(groups, inputs.size());
+    CHECK_EQ(groups.size(), size_t(2));
+    CHECK_EQ(GroupSize(groups[0]), size_t(4));
+    CHECK_EQ(GroupSize(groups[1]), size_t(1));
+}
+
+void TestUnpackableInputsGoAlone() {
+    std::vector<std::wstring> inputs = { L"one", L"two", std::wstring(600, L'x'), L"has [[marker]]", L"   ", L"three", L"four" };
+    auto groups = PlanPackGroups(Views(inputs), 8, 2000);
+    CheckCoverage(groups, inputs.size());
+    for (size_t i : { 2, 3, 4 }) {
+        bool alone = false;
+        for (const auto& group : groups) {
+            alone |= group.begin == i && group.end == i + 1;
+        }
+        CHECK(alone);
+    }
+    CHECK(!IsPackable(inputs[2], 2000));
+    CHECK(!IsPackable(inputs[3], 2000));
+    CHECK(!IsPackable(inputs[4], 2000));
+    CHECK(IsPackable(inputs[0], 2000));
+
+    // Only unpackable inputs: nothing to calibrate
+    std::vector<std::wstring> large(3, std::wstring(600, L'y'));
+    CHECK_EQ(PlanPackGroups(Views(large), 8, 2000).size(), size_t(3));
+}
+
+void TestPromptRoundTrip() {
+    std::vector<std::wstring> inputs = { L" first ", L"second" };
+    std::wstring prompt = PackPrompt(Views(inputs), L"Answer each item.");
+    CHECK(prompt == L"Answer each item.\n[[1]]\nfirst\n\n[[2]]\nsecond\n");
+
+    std::vector<std::wstring> items;
+    CHECK(SplitPackedOutput(L"Sure!\n[[1]]\n Premier \n[[2]]\nDeuxi\xE8me\n", 2, items));
+    CHECK_EQ(items.size(), size_t(2));
+    CHECK(items[0] == L"Premier");
+    CHECK(items[1] == L"Deuxi\xE8me");
+
+    CHECK(!SplitPackedOutput(L"[[2]] b [[1]] a", 2, items));
+    CHECK(!SplitPackedOutput(L"[[1]]\n\n[[2]] b", 2, items));
+    CHECK(!SplitPackedOutput(L"[[1]] a", 2, items));
+    CHECK(SplitPackedOutput(L"", 0, items));
+}
+
+} // namespace
+
+int main() {
+    TestAllShortInputsKeepOneAlone();
+    TestExistingBaselineIsKept();
+    TestUnpackableInputsGoAlone();
+    TestPromptRoundTrip();
+    return CheckResult();
+}
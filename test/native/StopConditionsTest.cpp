@@ -0,0 +1,96 @@
+#include "Check.h"
+#include "StopConditions.h"
+#include <initializer_list>
+#include <string>
+
+namespace {
+
+StopConditions Sequences(std::initializer_list<const char*> sequences) {
+    StopConditions conditions;
+    for (const char* sequence : sequences) {
+        conditions.stopSequences.push_back(sequence);
+    }
+    return conditions;
+}
+
+void TestStopSequenceAcrossFragments() {
+    GenerationStopper stopper(Sequences({ "END", "STOP here" }));
+    CHECK(!stopper.Append("one two "));
+    CHECK(!stopper.Append("three EN"));
+    CHECK(stopper.Append("D four"));
+    CHECK(stopper.Reason() == StopReason::StopSequence);
+    CHECK_EQ(stopper.Sequence(), std::string("END"));
+    CHECK_EQ(std::string(stopper.Text()), std::string("one two three "));
+    // Later fragments are ignored
+    CHECK(stopper.Append("more"));
+    CHECK_EQ(std::string(stopper.Text()), std::string("one two three "));
+}
+
+void TestOverlappingSequences() {
+    // "abcd" is found through the failure link of the longer "xabce" prefix
+    GenerationStopper stopper(Sequences({ "xabce", "abcd" }));
+    CHECK(!stopper.Append("-- "));
+    CHECK(stopper.Append("xabcd tail"));
+    CHECK_EQ(stopper.Sequence(), std::string("abcd"));
+    CHECK_EQ(std::string(stopper.Text()), std::string("-- x"));
+}
+
+void TestMaxCharsCountsUtf16() {
+    StopConditions conditions;
+    conditions.maxChars = 4;
+    GenerationStopper stopper(conditions);
+    CHECK(!stopper.Append("a\xC3\xA9"));
+    CHECK(stopper.Append("\xF0\x9F\x98\x80z")); // U+1F600 takes two units
+    CHECK(stopper.Reason() == StopReason::MaxChars);
+    CHECK_EQ(std::string(stopper.Text()), std::string("a\xC3\xA9\xF0\x9F\x98\x80"));
+}
+
+void TestMaxSentences() {
+    StopConditions conditions;
+    conditions.maxSentences = 2;
+    GenerationStopper stopper(conditions);
+    CHECK(!stopper.Append("Version 1.5 works. "));
+    CHECK(stopper.Append("Second one! Third."));
+    CHECK(stopper.Reason() == StopReason::MaxSentences);
+    CHECK_EQ(std::string(stopper.Text()), std::string("Version 1.5 works. Second one!"));
+    CHECK(StopReasonName(StopReason::MaxSentences) == std::string("maxSentences"));
+    CHECK(StopReasonName(StopReason::None) == nullptr);
+}
+
+void TestRepeatedProgressDoesNotTrip() {
+    // Text-so-far progress with a repeated fragment: the repeat must not count twice
+    StopConditions conditions;
+    conditions.maxChars = 10;
+    GenerationStopper stopper(conditions);
+    CHECK(!stopper.Append("Hello"));
+    CHECK(!stopper.Append("Hello"));
+    CHECK(!stopper.Append("Hello you"));
+    CHECK(!stopper.Append("Hello you!"));
+    CHECK(!stopper.Stopped());
+    CHECK(stopper.Append("Hello you! Bye"));
+    CHECK_EQ(std::string(stopper.Text()), std::string("Hello you!"));
+    // The whole cut text, the form the fragments came in
+    CHECK_EQ(std::string(stopper.StopFragment()), std::string("Hello you!"));
+}
+
+void TestStopFragmentOfNewTextProgress() {
+    GenerationStopper stopper(Sequences({ "###" }));
+    CHECK(stopper.StopFragment().empty());
+    CHECK(!stopper.Append("Intro "));
+    CHECK(!stopper.Append("text"));
+    CHECK(stopper.Append(" end### footer"));
+    CHECK_EQ(std::string(stopper.Text()), std::string("Intro text end"));
+    CHECK_EQ(std::string(stopper.StopFragment()), std::string(" end"));
+}
+
+} // namespace
+
+int main() {
+    TestStopSequenceAcrossFragments();
+    TestOverlappingSequences();
+    TestMaxCharsCountsUtf16();
+    TestMaxSentences();
+    TestRepeatedProgressDoesNotTrip();
+    TestStopFragmentOfNewTextProgress();
+    return CheckResult();
+}
@@ -0,0 +1,76 @@
+#include "Check.h"
+#include "TableFormat.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+void TestCsvPlainCells() {
+    CHECK_EQ(FormatTableCsv({ { "id", "name" }, { "1", "Ada Lovelace" } }, 2), std::string("id,name\r\n1,Ada Lovelace\r\n"));
+}
+
+void TestCsvQuoting() {
+    TableRows rows = { { "a,b", "say \"hi\"", "line\nbreak", "cr\rhere", "plain" } };
+    CHECK_EQ(FormatTableCsv(rows, 5), std::string("\"a,b\",\"say \"\"hi\"\"\",\"line\nbreak\",\"cr\rhere\",plain\r\n"));
+    CHECK_EQ(FormatTableCsv({ { "\"" } }, 1), std::string("\"\"\"\"\r\n"));
+}
+
+void TestTsvEscapes() {
+    TableRows rows = { { "a\tb", "c\nd", "e\rf", "g\\h", "i,\"j\"" } };
+    CHECK_EQ(FormatTableTsv(rows, 5), std::string("a\\tb\tc\\nd\te\\rf\tg\\\\h\ti,\"j\"\n"));
+}
+
+void TestShortRowsPadded() {
+    TableRows rows = { { "a", "b", "c" }, { "d" }, {} };
+    CHECK_EQ(FormatTableCsv(rows, 3), std::string("a,b,c\r\nd,,\r\n,,\r\n"));
+    CHECK_EQ(FormatTableTsv(rows, 3), std::string("a\tb\tc\nd\t\t\n\t\t\n"));
+}
+
+void TestPackedOffsetsSliceCells() {
+    TableRows rows = { { "id", "name", "note" }, { "1", "" }, { "2", "Bob", "x,y" } };
+    std::string data;
+    std::vector<uint32_t> offsets;
+    PackTableCells(rows, 3, data, offsets);
+    CHECK_EQ(offsets.size(), size_t(3 * 3 + 1));
+    CHECK_EQ(offsets.front(), 0u);
+    CHECK_EQ(offsets.back(), static_cast<uint32_t>(data.size()));
+    for (size_t r = 0; r < rows.size(); r++) {
+        for (size_t c = 0; c < 3; c++) {
+            size_t i = r * 3 + c;
+            std::string cell = data.substr(offsets[i], offsets[i + 1] - offsets[i]);
+            CHECK_EQ(cell, c < rows[r].size() ? rows[r][c] : std::string());
+        }
+    }
+}
+
+void TestPackReplacesPreviousContents() {
+    std::string data = "stale";
+    std::vector<uint32_t> offsets = { 7, 8 };
+    PackTableCells({ { "a" } }, 1, data, offsets);
+    CHECK_EQ(data, std::string("a"));
+    CHECK(offsets == std::vector<uint32_t>({ 0, 1 }));
+}
+
+void TestEmptyTable() {
+    CHECK(FormatTableCsv({}, 0).empty());
+    CHECK(FormatTableTsv({}, 0).empty());
+    std::string data;
+    std::vector<uint32_t> offsets;
+    PackTableCells({}, 0, data, offsets);
+    CHECK(data.empty());
+    CHECK(offsets == std::vector<uint32_t>({ 0 }));
+}
+
+} // namespace
+
+int main() {
+    TestCsvPlainCells();
+    TestCsvQuoting();
+    TestTsvEscapes();
+    TestShortRowsPadded();
+    TestPackedOffsetsSliceCells();
+    TestPackReplacesPreviousContents();
+    TestEmptyTable();
+    return CheckResult();
+}
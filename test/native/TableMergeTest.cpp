@@ -0,0 +1,82 @@
+#include "Check.h"
+#include "TableMerge.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+// Rows joined with '|' and ';', for one comparison per table
+std::string Flatten(const TableRows& rows) {
+    std::string text;
+    for (const auto& row : rows) {
+        for (size_t c = 0; c < row.size(); c++) {
+            text += (c > 0 ? "|" : "") + row[c];
+        }
+        text += ";";
+    }
+    return text;
+}
+
+void TestEmptyChunks() {
+    MergedTable table = MergeTableChunks({ {}, {} });
+    CHECK(table.rows.empty());
+    CHECK_EQ(table.columnCount, size_t(0));
+}
+
+void TestRepeatedHeaderDropped() {
+    MergedTable table = MergeTableChunks({ { { "id", "name" }, { "1", "Ada" } }, { { "ID", " Name " }, { "2", "Bob" } } }, "id,name");
+    CHECK_EQ(Flatten(table.rows), std::string("id|name;1|Ada;2|Bob;"));
+    CHECK_EQ(table.droppedHeaderRows, size_t(1));
+    CHECK_EQ(table.droppedLeadingRows, size_t(0));
+}
+
+void TestReorderedHeaderMappedByName() {
+    MergedTable table = MergeTableChunks({ { { "id", "name", "role" }, { "1", "Ada", "eng" } }, { { "role", "id", "name", "team" }, { "chef", "2", "Bob", "k" } } });
+    CHECK_EQ(Flatten(table.rows), std::string("id|name|role|team;1|Ada|eng|;2|Bob|chef|k;"));
+    CHECK_EQ(table.addedColumns, size_t(1));
+}
+
+void TestCellsPastHeaderBecomeColumns() {
+    // The reordered header claims column 0 for "name"; the extra cell must not land on it
+    MergedTable table = MergeTableChunks({ { { "id", "name" }, { "1", "Ada" } }, { { "name", "id" }, { "Bob", "2", "extra" } } });
+    CHECK_EQ(Flatten(table.rows), std::string("id|name|;1|Ada|;2|Bob|extra;"));
+    CHECK_EQ(table.addedColumns, size_t(1));
+}
+
+void TestLeadingDataRecordNotRepeated() {
+    // A log without a header: the first line is data, sent in front of every later chunk
+    std::string leading = "2024-01-01 ERROR disk full";
+    MergedTable table = MergeTableChunks({ { { "date", "level", "message" }, { "2024-01-01", "ERROR", "disk full" }, { "2024-01-02", "INFO", "ok" } },
+                                           { { "date", "level", "message" }, { "2024-01-01", "error", "disk full" }, { "2024-01-03", "WARN", "slow" } } },
+                                         leading);
+    CHECK_EQ(Flatten(table.rows), std::string("date|level|message;2024-01-01|ERROR|disk full;2024-01-02|INFO|ok;2024-01-03|WARN|slow;"));
+    CHECK_EQ(table.droppedHeaderRows, size_t(1));
+    CHECK_EQ(table.droppedLeadingRows, size_t(1));
+}
+
+void TestHeaderOnlyRecordKeepsDuplicates() {
+    // The first record is the header, so an equal first data row in a later chunk is real data
+    MergedTable table = MergeTableChunks({ { { "id", "name" }, { "1", "Ada" } }, { { "id", "name" }, { "1", "Ada" } } }, "id,name");
+    CHECK_EQ(Flatten(table.rows), std::string("id|name;1|Ada;1|Ada;"));
+    CHECK_EQ(table.droppedLeadingRows, size_t(0));
+}
+
+void TestUnmatchedChunkByPosition() {
+    MergedTable table = MergeTableChunks({ { { "id", "name" }, { "1", "Ada" } }, { { "2", "Bob", "x" } } });
+    CHECK_EQ(Flatten(table.rows), std::string("id|name|;1|Ada|;2|Bob|x;"));
+    CHECK_EQ(table.droppedHeaderRows, size_t(0));
+    CHECK_EQ(table.columnCount, size_t(3));
+}
+
+} // namespace
+
+int main() {
+    TestEmptyChunks();
+    TestRepeatedHeaderDropped();
+    TestReorderedHeaderMappedByName();
+    TestCellsPastHeaderBecomeColumns();
+    TestLeadingDataRecordNotRepeated();
+    TestHeaderOnlyRecordKeepsDuplicates();
+    TestUnmatchedChunkByPosition();
+    return CheckResult();
+}
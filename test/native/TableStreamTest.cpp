@@ -0,0 +1,97 @@
+#include "Check.h"
+#include "TableStream.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+using Rows = std::vector<std::vector<std::string>>;
+
+// Feeds the text one byte per fragment, as new-text progress
+Rows ParseByByte(const std::string& text) {
+    TableStreamParser parser;
+    Rows rows;
+    for (char c : text) {
+        parser.Append(std::string(1, c));
+        for (auto& row : parser.TakeRows()) {
+            rows.push_back(std::move(row));
+        }
+    }
+    return rows;
+}
+
+void TestMarkdown() {
+    Rows rows = ParseByByte("| Name | Role |\n|---|:---:|\n| Ada | a \\| b |\n| Bob | chef |\n");
+    CHECK_EQ(rows.size(), size_t(3));
+    CHECK(rows[0] == std::vector<std::string>({ "Name", "Role" }));
+    CHECK(rows[1] == std::vector<std::string>({ "Ada", "a | b" }));
+    CHECK(rows[2] == std::vector<std::string>({ "Bob", "chef" }));
+}
+
+void TestTsvAndCsv() {
+    Rows tsv = ParseByByte("id\tname\n1\tAda\n");
+    CHECK_EQ(tsv.size(), size_t(2));
+    CHECK(tsv[1] == std::vector<std::string>({ "1", "Ada" }));
+
+    Rows csv = ParseByByte("id,note\n1,\"two\nlines, \"\"quoted\"\"\"\n");
+    CHECK_EQ(csv.size(), size_t(2));
+    CHECK(csv[1] == std::vector<std::string>({ "1", "two\nlines, \"quoted\"" }));
+}
+
+void TestCsvHeaderWithLineBreak() {
+    // The layout is not known yet while the header's quoted field is open
+    Rows rows = ParseByByte("\"Full\nname\",age\nAda,36\n");
+    CHECK_EQ(rows.size(), size_t(2));
+    CHECK(rows[0] == std::vector<std::string>({ "Full\nname", "age" }));
+    CHECK(rows[1] == std::vector<std::string>({ "Ada", "36" }));
+
+    // An inch mark in a Markdown header is not a CSV quote
+    Rows markdown = ParseByByte("| 5\" disc | 7\" disc |\n| 4 | 2 |\n");
+    CHECK_EQ(markdown.size(), size_t(2));
+    CHECK(markdown[0] == std::vector<std::string>({ "5\" disc", "7\" disc" }));
+}
+
+void TestOpenRowNotEmitted() {
+    TableStreamParser parser;
+    parser.Append("a,b\n");
+    CHECK(parser.TakeRows().empty()); // held back until the progress form is settled
+    parser.Append("c,");
+    CHECK_EQ(parser.TakeRows().size(), size_t(1));
+    parser.Append("d");
+    CHECK(parser.TakeRows().empty());
+    parser.Append("\n");
+    auto rows = parser.TakeRows();
+    CHECK_EQ(rows.size(), size_t(1));
+    CHECK(rows[0] == std::vector<std::string>({ "c", "d" }));
+}
+
+void TestStructuredOutputIgnored() {
+    CHECK(ParseByByte("[{\"a\": 1},\n{\"a\": 2}]\n").empty());
+}
+
+void TestTextSoFarProgress() {
+    // Progress repeating everything generated so far gives the same rows as new-text progress
+    std::string text = "| Name | Role |\n| Ada | engineer |\n";
+    TableStreamParser parser;
+    Rows rows;
+    for (size_t length = 1; length <= text.size(); length++) {
+        parser.Append(text.substr(0, length));
+        for (auto& row : parser.TakeRows()) {
+            rows.push_back(std::move(row));
+        }
+    }
+    CHECK(rows == ParseByByte(text));
+    CHECK_EQ(rows.size(), size_t(2));
+}
+
+} // namespace
+
+int main() {
+    TestMarkdown();
+    TestTsvAndCsv();
+    TestCsvHeaderWithLineBreak();
+    TestOpenRowNotEmitted();
+    TestStructuredOutputIgnored();
+    TestTextSoFarProgress();
+    return CheckResult();
+}
@@ -0,0 +1,166 @@
+#include "Check.h"
+#include "TextChunking.h"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string_view Slice(std::string_view text, const TextChunk& chunk) {
+    return text.substr(chunk.offset, chunk.length);
+}
+
+bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Chunks are in order, within the limit, trimmed, start on a code point and together keep every
+// non-space byte of the text
+void CheckChunking(std::string_view text, const std::vector<TextChunk>& chunks, size_t maxBytes) {
+    size_t covered = 0;
+    for (const auto& chunk : chunks) {
+        CHECK(chunk.length > 0);
+        CHECK(chunk.length <= maxBytes);
+        CHECK(chunk.offset >= covered);
+        CHECK((static_cast<unsigned char>(text[chunk.offset]) & 0xC0) != 0x80);
+        size_t end = chunk.offset + chunk.length;
+        CHECK(end == text.size() || (static_cast<unsigned char>(text[end]) & 0xC0) != 0x80);
+        CHECK(!IsSpace(text[chunk.offset]) && !IsSpace(text[end - 1]));
+        for (size_t i = covered; i < chunk.offset; i++) {
+            CHECK(IsSpace(text[i]));
+        }
+        covered = end;
+    }
+    for (size_t i = covered; i < text.size(); i++) {
+        CHECK(IsSpace(text[i]));
+    }
+}
+
+void TestShortTextIsOneChunk() {
+    std::string text = "  Hello world.\n";
+    auto chunks = ChunkText(text, 100);
+    CHECK_EQ(chunks.size(), size_t(1));
+    CHECK_EQ(std::string(Slice(text, chunks[0])), std::string("Hello world."));
+    CHECK(ChunkText("", 100).empty());
+    CHECK(ChunkText(" \n\n ", 100).empty());
+}
+
+void TestPrefersParagraphBreak() {
+    std::string text = "First paragraph here.\n\nSecond one. It goes on.";
+    auto chunks = ChunkText(text, 36);
+    CHECK_EQ(chunks.size(), size_t(2));
+    CHECK_EQ(std::string(Slice(text, chunks[0])), std::string("First paragraph here."));
+    CHECK_EQ(std::string(Slice(text, chunks[1])), std::string("Second one. It goes on."));
+}
+
+void TestPrefersSentenceOverSpace() {
+    std::string text = "One two three four. Five six seven eight nine ten";
+    auto chunks = ChunkText(text, 30);
+    CHECK_EQ(std::string(Slice(text, chunks[0])), std::string("One two three four."));
+    CheckChunking(text, chunks, 30);
+}
+
+void TestNeverSplitsCodePoints() {
+    std::string text;
+    for (int i = 0; i < 50; i++) {
+        text += "\xE4\xB8\xAD\xF0\x9F\x98\x80"; // U+4E2D, U+1F600
+    }
+    for (size_t maxBytes : { 4, 5, 7, 10, 33 }) {
+        CheckChunking(text, ChunkText(text, maxBytes), maxBytes);
+    }
+}
+
+void TestRandomTextCovered() {
+    std::mt19937 rng(11);
+    const char* pieces[] = { "word", " ", "\n", "\n\n", ". ", "\xC3\xA9", "\xE3\x80\x82", "\xF0\x9F\x98\x80", "longerword" };
+    for (int round = 0; round < 300; round++) {
+        std::string text;
+        for (int count = rng() % 200; count > 0; count--) {
+            text += pieces[rng() % 9];
+        }
+        size_t maxBytes = 4 + rng() % 60;
+        CheckChunking(text, ChunkText(text, maxBytes), maxBytes);
+        CheckChunking(text, ChunkRecords(text, maxBytes), maxBytes);
+    }
+}
+
+void TestRecordsKeepQuotedFieldsTogether() {
+    std::string text = "id,note\n1,\"first line\nsecond line\"\n2,plain\n";
+    auto chunks = ChunkRecords(text, 30);
+    CHECK_EQ(chunks.size(), size_t(3));
+    CHECK_EQ(std::string(Slice(text, chunks[0])), std::string("id,note"));
+    CHECK_EQ(std::string(Slice(text, chunks[1])), std::string("1,\"first line\nsecond line\""));
+    CHECK_EQ(std::string(Slice(text, chunks[2])), std::string("2,plain"));
+}
+
+void TestRecordsTakeContinuationLines() {
+    std::string text = "Name: Ada\n  Role: engineer\n\nName: Bob\n  Role: chef\n";
+    auto chunks = ChunkRecords(text, 30);
+    CHECK_EQ(chunks.size(), size_t(2));
+    CHECK_EQ(std::string(Slice(text, chunks[0])), std::string("Name: Ada\n  Role: engineer"));
+    CHECK_EQ(std::string(Slice(text, chunks[1])), std::string("Name: Bob\n  Role: chef"));
+
+    // Records are packed together while they fit
+    auto packed = ChunkRecords(text, 200);
+    CHECK_EQ(packed.size(), size_t(1));
+}
+
+void TestFirstRecord() {
+    std::string text = "\n  id,note\n1,\"a\nb\"\n";
+    CHECK_EQ(std::string(Slice(text, FirstRecord(text))), std::string("id,note"));
+    std::string trace = "Error: boom\n  at f()\n  at g()\nNext";
+    CHECK_EQ(std::string(Slice(trace, FirstRecord(trace))), std::string("Error: boom\n  at f()\n  at g()"));
+    CHECK_EQ(FirstRecord(" \n\n").length, size_t(0));
+}
+
+void TestSplitParagraphs() {
+    std::string text = "\n  one\ntwo  \n \n\nthree\n";
+    auto paragraphs = SplitParagraphs(text);
+    CHECK_EQ(paragraphs.size(), size_t(2));
+    CHECK_EQ(std::string(Slice(text, paragraphs[0])), std::string("one\ntwo"));
+    CHECK_EQ(std::string(Slice(text, paragraphs[1])), std::string("three"));
+}
+
+void TestUtf16Length() {
+    CHECK_EQ(Utf16Length(""), size_t(0));
+    CHECK_EQ(Utf16Length("abc"), size_t(3));
+    CHECK_EQ(Utf16Length("caf\xC3\xA9"), size_t(4));
+    CHECK_EQ(Utf16Length("\xE4\xB8\xAD"), size_t(1));
+    CHECK_EQ(Utf16Length("\xF0\x9F\x98\x80"), size_t(2));
+}
+
+void TestSentenceBoundaries() {
+    auto boundaries = FindSentenceBoundaries(L"Hi there. Version 1.5 works! Ok?");
+    CHECK_EQ(boundaries.size(), size_t(3));
+    CHECK_EQ(boundaries[0], size_t(9));
+    CHECK_EQ(boundaries[1], size_t(28));
+    CHECK_EQ(boundaries[2], size_t(32));
+
+    auto ideographic = FindSentenceBoundaries(L"\x4F60\x597D\x3002\x8C22\x8C22\xFF01");
+    CHECK_EQ(ideographic.size(), size_t(2));
+    CHECK_EQ(ideographic[0], size_t(3));
+    CHECK_EQ(ideographic[1], size_t(6));
+
+    // Line breaks end a sentence before the break, CRLF counts once
+    auto lines = FindSentenceBoundaries(L"one\r\ntwo\nthree");
+    CHECK_EQ(lines.size(), size_t(2));
+    CHECK_EQ(lines[0], size_t(3));
+    CHECK_EQ(lines[1], size_t(8));
+}
+
+} // namespace
+
+int main() {
+    TestShortTextIsOneChunk();
+    TestPrefersParagraphBreak();
+    TestPrefersSentenceOverSpace();
+    TestNeverSplitsCodePoints();
+    TestRandomTextCovered();
+    TestRecordsKeepQuotedFieldsTogether();
+    TestRecordsTakeContinuationLines();
+    TestFirstRecord();
+    TestSplitParagraphs();
+    TestUtf16Length();
+    TestSentenceBoundaries();
+    return CheckResult();
+}
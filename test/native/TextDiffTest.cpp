@@ -0,0 +1,118 @@
+#include "Check.h"
+#include "TextDiff.h"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::wstring Apply(std::wstring_view before, std::wstring_view after, const std::vector<TextEdit>& edits) {
+    std::wstring text(before);
+    for (auto it = edits.rbegin(); it != edits.rend(); ++it) {
+        text.replace(it->start, it->end - it->start, after.substr(it->replacementStart, it->replacementEnd - it->replacementStart));
+    }
+    return text;
+}
+
+bool Ordered(const std::vector<TextEdit>& edits) {
+    for (size_t i = 0; i < edits.size(); i++) {
+        if (edits[i].start > edits[i].end || edits[i].replacementStart > edits[i].replacementEnd) {
+            return false;
+        }
+        if (i > 0 && (edits[i].start < edits[i - 1].end || edits[i].replacementStart < edits[i - 1].replacementEnd)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TestIdenticalTexts() {
+    CHECK(DiffWords(L"", L"").empty());
+    CHECK(DiffWords(L"same text.", L"same text.").empty());
+}
+
+void TestSingleWordReplaced() {
+    std::wstring before = L"The quick brown fox";
+    std::wstring after = L"The slow brown fox";
+    auto edits = DiffWords(before, after);
+    CHECK_EQ(edits.size(), size_t(1));
+    CHECK_EQ(edits[0].start, size_t(4));
+    CHECK_EQ(edits[0].end, size_t(9));
+    CHECK(after.substr(edits[0].replacementStart, edits[0].replacementEnd - edits[0].replacementStart) == L"slow");
+}
+
+void TestInsertAndDelete() {
+    std::wstring before = L"one two three";
+    std::wstring after = L"one three four";
+    auto edits = DiffWords(before, after);
+    CHECK(Ordered(edits));
+    CHECK(Apply(before, after, edits) == after);
+}
+
+void TestPhraseMergedIntoOneEdit() {
+    // Edits separated by a single unchanged token (the space) come back as one
+    std::wstring before = L"I think it is good.";
+    std::wstring after = L"I believe this is good.";
+    auto edits = DiffWords(before, after);
+    CHECK_EQ(edits.size(), size_t(1));
+    CHECK(Apply(before, after, edits) == after);
+}
+
+void TestPunctuationAndIdeographsAreTokens() {
+    std::wstring before = L"Hello, world! \x4F60\x597D\x4E16\x754C";
+    std::wstring after = L"Hello; world! \x4F60\x597D\x5730\x7403";
+    auto edits = DiffWords(before, after);
+    CHECK(Ordered(edits));
+    CHECK(Apply(before, after, edits) == after);
+    // The comma and the two changed ideographs, nothing else
+    size_t changed = 0;
+    for (const auto& edit : edits) {
+        changed += edit.end - edit.start;
+    }
+    CHECK_EQ(changed, size_t(3));
+}
+
+void TestCostLimitReturnsMiddle() {
+    std::wstring before = L"a b c d e f g h";
+    std::wstring after = L"a z y x w v u h";
+    auto edits = DiffWords(before, after, 2);
+    CHECK_EQ(edits.size(), size_t(1));
+    CHECK(Apply(before, after, edits) == after);
+}
+
+void TestRandomEditsRoundTrip() {
+    std::mt19937 rng(7);
+    const wchar_t* words[] = { L"alpha", L"beta", L"gamma", L"delta", L".", L",", L"\x4E2D", L"caf\xE9" };
+    auto randomText = [&rng, &words](size_t count) {
+        std::wstring text;
+        for (size_t i = 0; i < count; i++) {
+            text += words[rng() % 8];
+            text += (rng() % 5 == 0) ? L"\n" : L" ";
+        }
+        return text;
+    };
+    for (int round = 0; round < 500; round++) {
+        std::wstring before = randomText(rng() % 40);
+        std::wstring after = before;
+        for (int change = rng() % 6; change > 0 && !after.empty(); change--) {
+            size_t at = rng() % after.size();
+            after.replace(at, rng() % 8, randomText(rng() % 3));
+        }
+        auto edits = DiffWords(before, after, (round % 3 == 0) ? 4 : 2000);
+        CHECK(Ordered(edits));
+        CHECK(Apply(before, after, edits) == after);
+    }
+}
+
+} // namespace
+
+int main() {
+    TestIdenticalTexts();
+    TestSingleWordReplaced();
+    TestInsertAndDelete();
+    TestPhraseMergedIntoOneEdit();
+    TestPunctuationAndIdeographsAreTokens();
+    TestCostLimitReturnsMiddle();
+    TestRandomEditsRoundTrip();
+    return CheckResult();
+}
@@ -0,0 +1,124 @@
+// Ingest throughput and query latency of TextIndex on a synthetic corpus. Not run by ctest:
+//   TextIndexBenchmark [images] [wordsPerImage] [directory]
+#include "TextIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MillisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Zipf-distributed vocabulary, so a few terms are in nearly every image and most are rare
+class Vocabulary {
+public:
+    explicit Vocabulary(size_t size) {
+        double total = 0;
+        for (size_t rank = 1; rank <= size; rank++) {
+            total += 1.0 / rank;
+            m_cumulative.push_back(total);
+        }
+        for (auto& value : m_cumulative) {
+            value /= total;
+        }
+    }
+
+    static std::string Word(size_t rank) {
+        return "w" + std::to_string(rank);
+    }
+
+    size_t Sample(std::mt19937& rng) const {
+        double value = std::uniform_real_distribution<double>(0, 1)(rng);
+        return std::lower_bound(m_cumulative.begin(), m_cumulative.end(), value) - m_cumulative.begin();
+    }
+
+private:
+    std::vector<double> m_cumulative;
+};
+
+OcrPage MakePage(const Vocabulary& vocabulary, size_t words, std::mt19937& rng) {
+    OcrPage page;
+    for (size_t i = 0; i < words; i += 10) {
+        OcrLine line;
+        float y = static_cast<float>(i / 10) * 20;
+        for (size_t j = i; j < std::min(words, i + 10); j++) {
+            float x = static_cast<float>(j - i) * 60;
+            line.words.push_back({ Vocabulary::Word(vocabulary.Sample(rng)), { { x, y }, { x + 50, y }, { x, y + 16 }, { x + 50, y + 16 } }, 1.0f });
+        }
+        page.lines.push_back(std::move(line));
+    }
+    return page;
+}
+
+void ReportLatency(TextIndex& index, const char* label, const std::vector<std::string>& queries) {
+    std::vector<double> samples;
+    size_t hits = 0;
+    for (const auto& query : queries) {
+        auto start = Clock::now();
+        hits += index.Search(ParseTextIndexQuery(query), 100).size();
+        samples.push_back(MillisecondsSince(start) * 1000);
+    }
+    std::sort(samples.begin(), samples.end());
+    std::printf("%-8s p50 %8.1f us  p99 %8.1f us  avg hits %.1f\n", label, samples[samples.size() / 2], samples[samples.size() * 99 / 100], static_cast<double>(hits) / queries.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t images = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    size_t wordsPerImage = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+    std::filesystem::path directory = argc > 3 ? std::filesystem::path(argv[3]) : std::filesystem::temp_directory_path() / "waie-text-index-benchmark";
+    std::filesystem::remove_all(directory);
+
+    Vocabulary vocabulary(50000);
+    std::mt19937 rng(1);
+    std::vector<OcrPage> pages;
+    pages.reserve(images);
+    for (size_t i = 0; i < images; i++) {
+        pages.push_back(MakePage(vocabulary, wordsPerImage, rng));
+    }
+
+    {
+        TextIndex index(directory, TextIndexOptions());
+        auto start = Clock::now();
+        for (size_t i = 0; i < images; i++) {
+            index.Add("image-" + std::to_string(i), pages[i]);
+        }
+        index.Close();
+        double ms = MillisecondsSince(start);
+        auto stats = index.GetStats();
+        std::printf("ingest   %zu images x %zu words in %.0f ms, %.0f images/s, %llu segments, %.1f MB, %llu merges\n", images, wordsPerImage, ms, images / ms * 1000,
+            static_cast<unsigned long long>(stats.segments), stats.bytes / 1e6, static_cast<unsigned long long>(stats.merges));
+    }
+
+    auto start = Clock::now();
+    TextIndex index(directory, TextIndexOptions());
+    std::printf("reopen   %.1f ms\n", MillisecondsSince(start));
+
+    // Queries drawn from the whole frequency range
+    std::vector<std::string> common, rare, phrases, prefixes;
+    for (size_t i = 0; i < 200; i++) {
+        common.push_back(Vocabulary::Word(1 + i % 20));
+        rare.push_back(Vocabulary::Word(1000 + i * 200));
+        phrases.push_back("\"" + Vocabulary::Word(vocabulary.Sample(rng)) + " " + Vocabulary::Word(vocabulary.Sample(rng)) + "\"");
+        prefixes.push_back(Vocabulary::Word(1 + i % 90) + "*");
+    }
+    ReportLatency(index, "common", common);
+    ReportLatency(index, "rare", rare);
+    ReportLatency(index, "phrase", phrases);
+    ReportLatency(index, "prefix", prefixes);
+
+    index.Close();
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,197 @@
+#include "Check.h"
+#include "TextIndex.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Scratch index directory, removed when the test ends
+struct TemporaryDirectory {
+    std::filesystem::path path;
+
+    explicit TemporaryDirectory(const std::string& name) : path(std::filesystem::temp_directory_path() / ("waie-" + name)) {
+        std::filesystem::remove_all(path);
+    }
+    ~TemporaryDirectory() {
+        std::error_code error;
+        std::filesystem::remove_all(path, error);
+    }
+};
+
+// One line, one word per whitespace-separated token, boxes laid out left to right
+OcrPage MakePage(const std::string& text) {
+    OcrPage page;
+    OcrLine line;
+    line.text = text;
+    std::istringstream words(text);
+    std::string word;
+    float x = 0;
+    while (words >> word) {
+        OcrQuad box = { { x, 0 }, { x + 10, 0 }, { x, 10 }, { x + 10, 10 } };
+        line.words.push_back({ word, box, 1.0f });
+        x += 12;
+    }
+    page.lines.push_back(std::move(line));
+    return page;
+}
+
+std::set<std::string> SearchIds(TextIndex& index, const std::string& query) {
+    std::set<std::string> ids;
+    for (const auto& hit : index.Search(ParseTextIndexQuery(query), 100)) {
+        ids.insert(hit.imageId);
+    }
+    return ids;
+}
+
+// Segment files in the directory, every one of them must be listed in the manifest
+std::set<std::string> SegmentFiles(const std::filesystem::path& directory) {
+    std::set<std::string> files;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("seg-", 0) == 0) {
+            files.insert(name);
+        }
+    }
+    return files;
+}
+
+std::set<std::string> ManifestFiles(const std::filesystem::path& directory) {
+    std::set<std::string> files;
+    std::ifstream manifest(directory / "manifest");
+    uint64_t generation = 0;
+    while (manifest >> generation) {
+        files.insert("seg-" + std::to_string(generation) + ".tix");
+    }
+    return files;
+}
+
+void TestQuerySyntax() {
+    TemporaryDirectory directory("query");
+    TextIndex index(directory.path, TextIndexOptions());
+    index.Add("a", MakePage("Invoice total due: 42"));
+    index.Add("b", MakePage("total invoices due"));
+
+    CHECK(SearchIds(index, "invoice") == std::set<std::string>({ "a" }));
+    CHECK(SearchIds(index, "INVOICE*") == std::set<std::string>({ "a", "b" }));
+    CHECK(SearchIds(index, "\"total due\"") == std::set<std::string>({ "a" }));
+    CHECK(SearchIds(index, "total due") == std::set<std::string>({ "a", "b" }));
+    CHECK(SearchIds(index, "missing").empty());
+
+    auto hits = index.Search(ParseTextIndexQuery("\"total due\""), 10);
+    CHECK_EQ(hits.size(), size_t(1));
+    CHECK_EQ(hits[0].boxes.size(), size_t(2));
+    CHECK_EQ(hits[0].boxes[0].topLeft.x, 12.0f);
+}
+
+void TestReAddReplacesDocument() {
+    TemporaryDirectory directory("readd");
+    TextIndexOptions options;
+    options.flushDocuments = 1000;
+    {
+        TextIndex index(directory.path, options);
+        // Replaced while buffered
+        index.Add("a", MakePage("apple"));
+        index.Add("a", MakePage("banana"));
+        CHECK(SearchIds(index, "apple").empty());
+        CHECK(SearchIds(index, "banana") == std::set<std::string>({ "a" }));
+
+        // Replaced after it was flushed to a segment
+        index.Add("b", MakePage("cherry"));
+        index.Flush();
+        index.Add("b", MakePage("date"));
+        CHECK(SearchIds(index, "cherry").empty());
+        CHECK(SearchIds(index, "date") == std::set<std::string>({ "b" }));
+
+        auto stats = index.GetStats();
+        CHECK_EQ(stats.documents, uint64_t(2));
+        index.Close();
+    }
+
+    // Tombstones are rebuilt from the segment order on open
+    TextIndex reopened(directory.path, options);
+    CHECK(SearchIds(reopened, "apple").empty());
+    CHECK(SearchIds(reopened, "cherry").empty());
+    CHECK(SearchIds(reopened, "banana") == std::set<std::string>({ "a" }));
+    CHECK(SearchIds(reopened, "date") == std::set<std::string>({ "b" }));
+    CHECK_EQ(reopened.GetStats().documents, uint64_t(2));
+}
+
+void TestMergeDropsTombstonesAndFiles() {
+    TemporaryDirectory directory("merge");
+    TextIndexOptions options;
+    options.flushDocuments = 1000;
+    options.maxSegments = 2;
+    {
+        TextIndex index(directory.path, options);
+        for (int round = 0; round < 12; round++) {
+            // Every round rewrites the same ten ids, so one round's worth of documents stays live
+            for (int id = 0; id < 10; id++) {
+                index.Add("img" + std::to_string(id), MakePage("round" + std::to_string(round) + " common"));
+            }
+            index.Flush();
+        }
+        index.Close();
+
+        CHECK_EQ(index.GetStats().documents, uint64_t(10));
+        CHECK(index.GetStats().merges > 0);
+        CHECK_EQ(index.Search(ParseTextIndexQuery("common"), 100).size(), size_t(10));
+        CHECK(SearchIds(index, "round3").empty());
+        CHECK_EQ(SearchIds(index, "round11").size(), size_t(10));
+        CHECK(SegmentFiles(directory.path) == ManifestFiles(directory.path));
+    }
+
+    TextIndex reopened(directory.path, options);
+    CHECK_EQ(reopened.GetStats().documents, uint64_t(10));
+    CHECK_EQ(SearchIds(reopened, "round11").size(), size_t(10));
+}
+
+void TestSearchDuringMerges() {
+    TemporaryDirectory directory("concurrent");
+    TextIndexOptions options;
+    options.flushDocuments = 8;
+    options.maxSegments = 2;
+    TextIndex index(directory.path, options);
+
+    std::atomic<bool> done{ false };
+    std::atomic<int> wrongCounts{ 0 };
+    std::thread reader([&]() {
+        while (!done) {
+            // Each id is live exactly once whatever flush or merge is in flight
+            auto hits = index.Search(ParseTextIndexQuery("shared"), 1000);
+            std::set<std::string> ids;
+            for (const auto& hit : hits) {
+                ids.insert(hit.imageId);
+            }
+            if (ids.size() != hits.size()) {
+                wrongCounts++;
+            }
+        }
+    });
+    for (int i = 0; i < 2000; i++) {
+        index.Add("img" + std::to_string(i % 50), MakePage("shared word" + std::to_string(i)));
+    }
+    index.Flush();
+    done = true;
+    reader.join();
+    index.Close();
+
+    CHECK_EQ(wrongCounts.load(), 0);
+    CHECK_EQ(index.Search(ParseTextIndexQuery("shared"), 1000).size(), size_t(50));
+    CHECK(SegmentFiles(directory.path) == ManifestFiles(directory.path));
+}
+
+} // namespace
+
+int main() {
+    TestQuerySyntax();
+    TestReAddReplacesDocument();
+    TestMergeDropsTombstonesAndFiles();
+    TestSearchDuringMerges();
+    return CheckResult();
+}
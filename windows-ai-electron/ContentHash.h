@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 64-bit XXH64 hash of a byte range. Used to content-address stored results, so it only has to be
+// fast and well distributed, not cryptographic.
+uint64_t ComputeContentHash(const void* data, size_t length, uint64_t seed = 0);
+
+// Mixes a value into an existing hash, used to fold options into a key
+uint64_t CombineHash(uint64_t hash, uint64_t value);
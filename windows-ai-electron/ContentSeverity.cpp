@@ -38,6 +38,42 @@ ContentFilterOptions MyContentFilterOptions::GetOptions() const {
     return m_options;
 }
 
+uint64_t ContentFilterOptionsFingerprint(const ContentFilterOptions& options) {
+    // 5 bits per level (SeverityLevel values are 10-13), 0 marks a category that is not set
+    uint64_t fingerprint = 0;
+    auto pack = [&fingerprint](uint32_t level) {
+        fingerprint = (fingerprint << 5) | (level & 0x1F);
+    };
+    auto packImage = [&pack](const ImageContentFilterSeverity& severity) {
+        if (!severity) {
+            for (int i = 0; i < 4; i++) pack(0);
+            return;
+        }
+        pack(static_cast<uint32_t>(severity.AdultContentLevel()));
+        pack(static_cast<uint32_t>(severity.GoryContentLevel()));
+        pack(static_cast<uint32_t>(severity.RacyContentLevel()));
+        pack(static_cast<uint32_t>(severity.ViolentContentLevel()));
+    };
+    auto packText = [&pack](const TextContentFilterSeverity& severity) {
+        if (!severity) {
+            for (int i = 0; i < 4; i++) pack(0);
+            return;
+        }
+        pack(static_cast<uint32_t>(severity.Hate()));
+        pack(static_cast<uint32_t>(severity.SelfHarm()));
+        pack(static_cast<uint32_t>(severity.Sexual()));
+        pack(static_cast<uint32_t>(severity.Violent()));
+    };
+
+    if (!options) {
+        return 0;
+    }
+    packImage(options.ImageMaxAllowedSeverityLevel());
+    packText(options.PromptMaxAllowedSeverityLevel());
+    packText(options.ResponseMaxAllowedSeverityLevel());
+    return fingerprint;
+}
+
 Napi::Value MyContentFilterOptions::GetImageMaxAllowedSeverityLevel(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     try {
@@ -15,6 +15,9 @@ class MyContentFilterOptions;
 class MyImageContentFilterSeverity;
 class MyTextContentFilterSeverity;
 
+// Packs every severity level of the options into one value, so cached results can be keyed by the filter they were produced under
+uint64_t ContentFilterOptionsFingerprint(const ContentFilterOptions& options);
+
 // Wrapper for ContentFilterOptions
 class MyContentFilterOptions : public Napi::ObjectWrap<MyContentFilterOptions> {
 public:
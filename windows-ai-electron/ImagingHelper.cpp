@@ -0,0 +1,600 @@
+#include "ImagingHelper.h"
+#include "ContentHash.h"
+#include "PixelAnalysis.h"
+#include "ProjectionHelper.h"
+#include <winrt/Microsoft.Graphics.Imaging.h>
+#include <winrt/Windows.Storage.h>
+#include <winrt/Windows.Storage.Streams.h>
+#include <MemoryBuffer.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+using namespace winrt::Windows::Foundation;
+using namespace winrt::Windows::Graphics::Imaging;
+using namespace winrt::Windows::Storage;
+using namespace winrt::Windows::Storage::Streams;
+using namespace winrt::Microsoft::Windows::AI::Imaging;
+
+namespace {
+
+OcrQuad ToOcrQuad(const RecognizedTextBoundingBox& box, float offsetX, float offsetY) {
+    OcrQuad quad;
+    quad.topLeft = { box.TopLeft.X + offsetX, box.TopLeft.Y + offsetY };
+    quad.topRight = { box.TopRight.X + offsetX, box.TopRight.Y + offsetY };
+    quad.bottomLeft = { box.BottomLeft.X + offsetX, box.BottomLeft.Y + offsetY };
+    quad.bottomRight = { box.BottomRight.X + offsetX, box.BottomRight.Y + offsetY };
+    return quad;
+}
+
+} // namespace
+
+SoftwareBitmapPixelView::SoftwareBitmapPixelView(const SoftwareBitmap& bitmap) {
+    m_bitmap = bitmap;
+    if (m_bitmap.BitmapPixelFormat() != BitmapPixelFormat::Bgra8) {
+        m_bitmap = SoftwareBitmap::Convert(m_bitmap, BitmapPixelFormat::Bgra8, BitmapAlphaMode::Premultiplied);
+    }
+
+    m_buffer = m_bitmap.LockBuffer(BitmapBufferAccessMode::Read);
+    auto plane = m_buffer.GetPlaneDescription(0);
+    m_reference = m_buffer.CreateReference();
+
+    uint8_t* data = nullptr;
+    uint32_t capacity = 0;
+    winrt::check_hresult(m_reference.as<::Windows::Foundation::IMemoryBufferByteAccess>()->GetBuffer(&data, &capacity));
+
+    m_data = data + plane.StartIndex;
+    m_width = static_cast<uint32_t>(plane.Width);
+    m_height = static_cast<uint32_t>(plane.Height);
+    m_stride = static_cast<uint32_t>(plane.Stride);
+}
+
+SoftwareBitmapPixelView::~SoftwareBitmapPixelView() {
+    if (m_reference) {
+        m_reference.Close();
+    }
+    if (m_buffer) {
+        m_buffer.Close();
+    }
+}
+
+SoftwareBitmap LoadSoftwareBitmapFromFile(const winrt::hstring& filePath) {
+    auto storageFile = StorageFile::GetFileFromPathAsync(filePath).get();
+    auto stream = storageFile.OpenAsync(FileAccessMode::Read).get();
+    auto decoder = BitmapDecoder::CreateAsync(stream).get();
+    return decoder.GetSoftwareBitmapAsync().get();
+}
+
+SoftwareBitmap CreateSoftwareBitmapFromBgra(const uint8_t* data, uint32_t width, uint32_t height, uint32_t stride) {
+    uint32_t rowBytes = width * 4;
+    Buffer buffer(rowBytes * height);
+    buffer.Length(rowBytes * height);
+    for (uint32_t y = 0; y < height; y++) {
+        std::copy_n(data + static_cast<size_t>(y) * stride, rowBytes, buffer.data() + static_cast<size_t>(y) * rowBytes);
+    }
+
+    SoftwareBitmap bitmap(BitmapPixelFormat::Bgra8, static_cast<int32_t>(width), static_cast<int32_t>(height), BitmapAlphaMode::Premultiplied);
+    bitmap.CopyFromBuffer(buffer);
+    return bitmap;
+}
+
+OcrPage OcrPageFromRecognizedText(const RecognizedText& text, float offsetX, float offsetY) {
+    OcrPage page;
+    page.textAngle = text.TextAngle();
+
+    auto lines = text.Lines();
+    page.lines.reserve(lines.size());
+    for (const auto& line : lines) {
+        OcrLine ocrLine;
+        ocrLine.text = winrt::to_string(line.Text());
+        ocrLine.box = ToOcrQuad(line.BoundingBox(), offsetX, offsetY);
+        ocrLine.style = static_cast<int32_t>(line.Style());
+        ocrLine.styleConfidence = line.LineStyleConfidence();
+
+        auto words = line.Words();
+        ocrLine.words.reserve(words.size());
+        for (const auto& word : words) {
+            OcrWord ocrWord;
+            ocrWord.text = winrt::to_string(word.Text());
+            ocrWord.box = ToOcrQuad(word.BoundingBox(), offsetX, offsetY);
+            ocrWord.confidence = word.MatchConfidence();
+            ocrLine.words.push_back(std::move(ocrWord));
+        }
+        page.lines.push_back(std::move(ocrLine));
+    }
+    return page;
+}
+
+Napi::Object OcrPointToJs(Napi::Env env, const OcrPoint& point) {
+    auto pointObj = Napi::Object::New(env);
+    pointObj.Set("X", Napi::Number::New(env, point.x));
+    pointObj.Set("Y", Napi::Number::New(env, point.y));
+    return pointObj;
+}
+
+Napi::Array OcrQuadToFlatJs(Napi::Env env, const OcrQuad& quad) {
+    auto boxArray = Napi::Array::New(env, 8);
+    uint32_t index = 0;
+    for (const OcrPoint* point : { &quad.topLeft, &quad.topRight, &quad.bottomLeft, &quad.bottomRight }) {
+        boxArray.Set(index++, Napi::Number::New(env, point->x));
+        boxArray.Set(index++, Napi::Number::New(env, point->y));
+    }
+    return boxArray;
+}
+
+Napi::Object OcrLayoutToJs(Napi::Env env, const OcrPage& page, const OcrLayout& layout) {
+    auto layoutObj = Napi::Object::New(env);
+    layoutObj.Set("textAngle", Napi::Number::New(env, layout.textAngle));
+
+    auto linesArray = Napi::Array::New(env, layout.lineOrder.size());
+    for (uint32_t i = 0; i < layout.lineOrder.size(); i++) {
+        const auto& line = page.lines[layout.lineOrder[i]];
+        auto lineObj = Napi::Object::New(env);
+        lineObj.Set("text", Napi::String::New(env, line.text));
+        lineObj.Set("box", OcrQuadToFlatJs(env, line.box));
+        linesArray.Set(i, lineObj);
+    }
+    layoutObj.Set("lines", linesArray);
+
+    auto paragraphsArray = Napi::Array::New(env, layout.paragraphs.size());
+    for (uint32_t i = 0; i < layout.paragraphs.size(); i++) {
+        const auto& paragraph = layout.paragraphs[i];
+        auto paragraphObj = Napi::Object::New(env);
+        paragraphObj.Set("block", Napi::Number::New(env, paragraph.block));
+        paragraphObj.Set("firstLine", Napi::Number::New(env, paragraph.firstLine));
+        paragraphObj.Set("lineCount", Napi::Number::New(env, paragraph.lineCount));
+        paragraphsArray.Set(i, paragraphObj);
+    }
+    layoutObj.Set("paragraphs", paragraphsArray);
+
+    auto blocksArray = Napi::Array::New(env, layout.blocks.size());
+    for (uint32_t i = 0; i < layout.blocks.size(); i++) {
+        const auto& block = layout.blocks[i];
+        auto blockObj = Napi::Object::New(env);
+        blockObj.Set("box", OcrQuadToFlatJs(env, block.box));
+        blockObj.Set("column", Napi::Number::New(env, block.column));
+        blockObj.Set("firstParagraph", Napi::Number::New(env, block.firstParagraph));
+        blockObj.Set("paragraphCount", Napi::Number::New(env, block.paragraphCount));
+        blocksArray.Set(i, blockObj);
+    }
+    layoutObj.Set("blocks", blocksArray);
+    return layoutObj;
+}
+
+std::vector<uint8_t> ParseRawFrame(const Napi::Value& value, uint32_t& width, uint32_t& height) {
+    if (!value.IsObject()) {
+        throw std::runtime_error("Frame must be a file path or an object { width, height, buffer, stride? } of BGRA8 pixels");
+    }
+    auto frameObj = value.As<Napi::Object>();
+    if (!frameObj.Get("width").IsNumber() || !frameObj.Get("height").IsNumber() || !frameObj.Get("buffer").IsBuffer()) {
+        throw std::runtime_error("Frame must be a file path or an object { width, height, buffer, stride? } of BGRA8 pixels");
+    }
+
+    int64_t frameWidth = frameObj.Get("width").As<Napi::Number>().Int64Value();
+    int64_t frameHeight = frameObj.Get("height").As<Napi::Number>().Int64Value();
+    if (frameWidth <= 0 || frameHeight <= 0) {
+        throw std::runtime_error("Frame width and height must be positive");
+    }
+    width = static_cast<uint32_t>(frameWidth);
+    height = static_cast<uint32_t>(frameHeight);
+
+    size_t rowBytes = static_cast<size_t>(width) * 4;
+    size_t stride = rowBytes;
+    if (frameObj.Has("stride") && frameObj.Get("stride").IsNumber()) {
+        stride = static_cast<size_t>(frameObj.Get("stride").As<Napi::Number>().Int64Value());
+        if (stride < rowBytes) {
+            throw std::runtime_error("Frame stride must be at least width * 4");
+        }
+    }
+
+    auto buffer = frameObj.Get("buffer").As<Napi::Buffer<uint8_t>>();
+    if (buffer.Length() < stride * (height - 1) + rowBytes) {
+        throw std::runtime_error("Frame buffer is smaller than width * height * 4");
+    }
+
+    std::vector<uint8_t> pixels(rowBytes * height);
+    for (uint32_t y = 0; y < height; y++) {
+        std::copy_n(buffer.Data() + y * stride, rowBytes, pixels.data() + y * rowBytes);
+    }
+    return pixels;
+}
+
+std::vector<uint8_t> ReadFileBytes(const winrt::hstring& filePath) {
+    std::ifstream file(std::filesystem::path(std::wstring(filePath)), std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Failed to open " + winrt::to_string(filePath));
+    }
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    std::vector<uint8_t> bytes(static_cast<size_t>(size));
+    if (size > 0 && !file.read(reinterpret_cast<char*>(bytes.data()), size)) {
+        throw std::runtime_error("Failed to read " + winrt::to_string(filePath));
+    }
+    return bytes;
+}
+
+SoftwareBitmap LoadSoftwareBitmapFromBytes(const std::vector<uint8_t>& bytes) {
+    InMemoryRandomAccessStream stream;
+    DataWriter writer(stream);
+    writer.WriteBytes(winrt::array_view<const uint8_t>(bytes.data(), bytes.data() + bytes.size()));
+    writer.StoreAsync().get();
+    writer.DetachStream();
+    stream.Seek(0);
+
+    auto decoder = BitmapDecoder::CreateAsync(stream).get();
+    return decoder.GetSoftwareBitmapAsync().get();
+}
+
+TextRecognitionOptions ParseTextRecognitionOptions(const Napi::Value& value) {
+    TextRecognitionOptions options;
+    if (value.IsUndefined() || value.IsNull()) {
+        return options;
+    }
+    if (!value.IsObject()) {
+        throw std::runtime_error("Recognition options must be an object");
+    }
+
+    auto optionsObj = value.As<Napi::Object>();
+    if (optionsObj.Has("regions") && !optionsObj.Get("regions").IsUndefined()) {
+        if (!optionsObj.Get("regions").IsArray()) {
+            throw std::runtime_error("regions must be an array of { x, y, width, height } rectangles");
+        }
+        auto regionsArray = optionsObj.Get("regions").As<Napi::Array>();
+        for (uint32_t i = 0; i < regionsArray.Length(); i++) {
+            Napi::Value regionValue = regionsArray.Get(i);
+            if (!regionValue.IsObject()) {
+                throw std::runtime_error("regions must be an array of { x, y, width, height } rectangles");
+            }
+            auto regionObj = regionValue.As<Napi::Object>();
+            if (!regionObj.Get("x").IsNumber() || !regionObj.Get("y").IsNumber() || !regionObj.Get("width").IsNumber() || !regionObj.Get("height").IsNumber()) {
+                throw std::runtime_error("Region " + std::to_string(i) + " must have numeric x, y, width and height");
+            }
+            OcrRect region;
+            region.x = regionObj.Get("x").As<Napi::Number>().FloatValue();
+            region.y = regionObj.Get("y").As<Napi::Number>().FloatValue();
+            region.width = regionObj.Get("width").As<Napi::Number>().FloatValue();
+            region.height = regionObj.Get("height").As<Napi::Number>().FloatValue();
+            if (!(region.width > 0) || !(region.height > 0)) {
+                throw std::runtime_error("Region " + std::to_string(i) + " must have a positive width and height");
+            }
+            options.regions.push_back(region);
+        }
+    }
+    if (optionsObj.Has("adaptive") && !optionsObj.Get("adaptive").IsUndefined() && !optionsObj.Get("adaptive").IsNull()) {
+        Napi::Value adaptiveValue = optionsObj.Get("adaptive");
+        if (adaptiveValue.IsBoolean()) {
+            if (adaptiveValue.As<Napi::Boolean>().Value()) {
+                options.adaptive = AdaptiveRecognitionOptions();
+            }
+        } else if (adaptiveValue.IsObject()) {
+            auto adaptiveObj = adaptiveValue.As<Napi::Object>();
+            AdaptiveRecognitionOptions adaptive;
+            auto readFraction = [&adaptiveObj](const char* name, float& target, bool allowZero) {
+                if (!adaptiveObj.Has(name) || adaptiveObj.Get(name).IsUndefined()) {
+                    return;
+                }
+                double value = adaptiveObj.Get(name).IsNumber() ? adaptiveObj.Get(name).As<Napi::Number>().DoubleValue() : -1.0;
+                if (!((allowZero ? value >= 0.0 : value > 0.0) && value <= 1.0)) {
+                    throw std::runtime_error(std::string("adaptive.") + name + " must be a number between 0 and 1");
+                }
+                target = static_cast<float>(value);
+            };
+            readFraction("scale", adaptive.scale, false);
+            readFraction("minConfidence", adaptive.minConfidence, true);
+            readFraction("fullFrameRatio", adaptive.fullFrameRatio, true);
+            options.adaptive = adaptive;
+        } else {
+            throw std::runtime_error("adaptive must be a boolean or an object { scale, minConfidence, fullFrameRatio }");
+        }
+        if (options.adaptive && !options.regions.empty()) {
+            throw std::runtime_error("adaptive cannot be combined with regions");
+        }
+    }
+    if (optionsObj.Has("textOnly") && !optionsObj.Get("textOnly").IsUndefined()) {
+        if (!optionsObj.Get("textOnly").IsBoolean()) {
+            throw std::runtime_error("textOnly must be a boolean");
+        }
+        options.textOnly = optionsObj.Get("textOnly").As<Napi::Boolean>().Value();
+    }
+    if (optionsObj.Has("layout") && !optionsObj.Get("layout").IsUndefined()) {
+        if (!optionsObj.Get("layout").IsBoolean()) {
+            throw std::runtime_error("layout must be a boolean");
+        }
+        options.layout = optionsObj.Get("layout").As<Napi::Boolean>().Value();
+    }
+    if (optionsObj.Has("lineSeparator") && !optionsObj.Get("lineSeparator").IsUndefined()) {
+        if (!optionsObj.Get("lineSeparator").IsString()) {
+            throw std::runtime_error("lineSeparator must be a string");
+        }
+        options.text.lineSeparator = optionsObj.Get("lineSeparator").As<Napi::String>().Utf8Value();
+    }
+    if (optionsObj.Has("paragraphSeparator") && !optionsObj.Get("paragraphSeparator").IsUndefined()) {
+        if (!optionsObj.Get("paragraphSeparator").IsString()) {
+            throw std::runtime_error("paragraphSeparator must be a string");
+        }
+        options.text.paragraphSeparator = optionsObj.Get("paragraphSeparator").As<Napi::String>().Utf8Value();
+    }
+    if (optionsObj.Has("minWordConfidence") && !optionsObj.Get("minWordConfidence").IsUndefined()) {
+        if (!optionsObj.Get("minWordConfidence").IsNumber()) {
+            throw std::runtime_error("minWordConfidence must be a number between 0 and 1");
+        }
+        double minWordConfidence = optionsObj.Get("minWordConfidence").As<Napi::Number>().DoubleValue();
+        if (!(minWordConfidence >= 0.0 && minWordConfidence <= 1.0)) {
+            throw std::runtime_error("minWordConfidence must be a number between 0 and 1");
+        }
+        options.text.minWordConfidence = static_cast<float>(minWordConfidence);
+    }
+    return options;
+}
+
+uint64_t TextRecognitionOptionsKey(const TextRecognitionOptions& options) {
+    uint64_t key = 0;
+    for (const auto& region : options.regions) {
+        key = CombineHash(key, ComputeContentHash(&region, sizeof(region)));
+    }
+    if (options.adaptive) {
+        const AdaptiveRecognitionOptions& adaptive = *options.adaptive;
+        const float values[] = { adaptive.scale, adaptive.minConfidence, adaptive.fullFrameRatio };
+        key = CombineHash(key, ComputeContentHash(values, sizeof(values)));
+    }
+    return key;
+}
+
+OcrPage RecognizeTextInRegions(const TextRecognizer& recognizer, const SoftwareBitmap& bitmap, const std::vector<OcrRect>& regions) {
+    SoftwareBitmapPixelView pixels(bitmap);
+
+    struct Crop {
+        uint32_t x, y, width, height;
+    };
+    std::vector<Crop> crops;
+    for (const auto& region : regions) {
+        double left = std::floor((std::max)(0.0, static_cast<double>(region.x)));
+        double top = std::floor((std::max)(0.0, static_cast<double>(region.y)));
+        double right = std::ceil((std::min)(static_cast<double>(pixels.Width()), static_cast<double>(region.Right())));
+        double bottom = std::ceil((std::min)(static_cast<double>(pixels.Height()), static_cast<double>(region.Bottom())));
+        if (right > left && bottom > top) {
+            crops.push_back({ static_cast<uint32_t>(left), static_cast<uint32_t>(top), static_cast<uint32_t>(right - left), static_cast<uint32_t>(bottom - top) });
+        }
+    }
+
+    std::vector<std::vector<OcrLine>> regionLines(crops.size());
+    std::vector<float> textAngles(crops.size(), 0.0f);
+    RunConcurrently(crops.size(), 4, [&](size_t i) {
+        const Crop& crop = crops[i];
+        auto cropBitmap = CreateSoftwareBitmapFromBgra(pixels.Data() + static_cast<size_t>(crop.y) * pixels.Stride() + static_cast<size_t>(crop.x) * 4, crop.width, crop.height, pixels.Stride());
+        auto imageBuffer = winrt::Microsoft::Graphics::Imaging::ImageBuffer::CreateForSoftwareBitmap(cropBitmap);
+        auto result = recognizer.RecognizeTextFromImageAsync(imageBuffer).get();
+        auto regionPage = OcrPageFromRecognizedText(result, static_cast<float>(crop.x), static_cast<float>(crop.y));
+        regionLines[i] = std::move(regionPage.lines);
+        textAngles[i] = regionPage.textAngle;
+    });
+
+    OcrPage page;
+    // Report the angle of the region that produced the most lines
+    size_t dominant = 0;
+    for (size_t i = 0; i < regionLines.size(); i++) {
+        if (regionLines[i].size() > regionLines[dominant].size()) {
+            dominant = i;
+        }
+    }
+    page.textAngle = textAngles.empty() ? 0.0f : textAngles[dominant];
+    page.lines = MergeRegionLines(std::move(regionLines));
+    return page;
+}
+
+OcrPage RecognizeTextAdaptive(const TextRecognizer& recognizer, const SoftwareBitmap& bitmap, const AdaptiveRecognitionOptions& options, AdaptiveRecognitionReport& report) {
+    auto recognizeWhole = [&recognizer](const SoftwareBitmap& source) {
+        auto imageBuffer = winrt::Microsoft::Graphics::Imaging::ImageBuffer::CreateForSoftwareBitmap(source);
+        return OcrPageFromRecognizedText(recognizer.RecognizeTextFromImageAsync(imageBuffer).get());
+    };
+    auto elapsedMs = [](std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t coarseWidth = 0;
+    uint32_t coarseHeight = 0;
+    std::vector<uint8_t> coarsePixels;
+    {
+        // Released before the bitmap is recognized again at full resolution
+        SoftwareBitmapPixelView pixels(bitmap);
+        width = pixels.Width();
+        height = pixels.Height();
+        coarseWidth = (std::max)(1u, static_cast<uint32_t>(std::lround(width * options.scale)));
+        coarseHeight = (std::max)(1u, static_cast<uint32_t>(std::lround(height * options.scale)));
+        if (coarseWidth < width || coarseHeight < height) {
+            coarsePixels = DownscaleBgra(pixels.Data(), width, height, pixels.Stride(), coarseWidth, coarseHeight);
+        }
+    }
+    if (coarsePixels.empty()) {
+        OcrPage page = recognizeWhole(bitmap);
+        report.coarseMs = elapsedMs(start);
+        return page;
+    }
+
+    OcrPage page = recognizeWhole(CreateSoftwareBitmapFromBgra(coarsePixels.data(), coarseWidth, coarseHeight, coarseWidth * 4));
+    ScaleOcrPage(page, static_cast<float>(width) / coarseWidth, static_cast<float>(height) / coarseHeight);
+    report.coarseMs = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    // Crops get half a line height of margin, the recognizer does poorly on text touching the edge
+    auto regions = ExpandToIntersectingLines(FindLowConfidenceLines(page, options.minConfidence, 0.5f), page.lines);
+    double regionArea = 0;
+    for (const auto& region : regions) {
+        regionArea += static_cast<double>(region.Area());
+    }
+    double imageArea = static_cast<double>(width) * height;
+
+    if (page.lines.empty() || regionArea > imageArea * options.fullFrameRatio) {
+        report.refinedLines = static_cast<uint32_t>(page.lines.size());
+        report.refinedRegions = 1;
+        report.fullFrame = true;
+        page = recognizeWhole(bitmap);
+    } else if (!regions.empty()) {
+        for (const auto& line : page.lines) {
+            OcrRect bounds = QuadBounds(line.box);
+            if (std::any_of(regions.begin(), regions.end(), [&bounds](const OcrRect& region) { return RectsIntersect(region, bounds); })) {
+                report.refinedLines++;
+            }
+        }
+        report.refinedRegions = static_cast<uint32_t>(regions.size());
+        OcrPage refined = RecognizeTextInRegions(recognizer, bitmap, regions);
+        SpliceLines(page, regions, std::move(refined.lines));
+    }
+    report.refineMs = report.refinedRegions > 0 ? elapsedMs(start) : 0;
+    return page;
+}
+
+OcrPage RecognizeTextWithOptions(const TextRecognizer& recognizer, const SoftwareBitmap& bitmap, const TextRecognitionOptions& options, AdaptiveRecognitionReport& report) {
+    if (!options.regions.empty()) {
+        return RecognizeTextInRegions(recognizer, bitmap, options.regions);
+    }
+    if (options.adaptive) {
+        return RecognizeTextAdaptive(recognizer, bitmap, *options.adaptive, report);
+    }
+    auto imageBuffer = winrt::Microsoft::Graphics::Imaging::ImageBuffer::CreateForSoftwareBitmap(bitmap);
+    return OcrPageFromRecognizedText(recognizer.RecognizeTextFromImageAsync(imageBuffer).get());
+}
+
+std::optional<ImageOutputOptions> ParseImageOutputOptions(const Napi::Value& value) {
+    if (value.IsUndefined() || value.IsNull()) {
+        return std::nullopt;
+    }
+    if (!value.IsObject()) {
+        throw std::runtime_error("Output options must be an object with a format property");
+    }
+
+    auto optionsObj = value.As<Napi::Object>();
+    if (!optionsObj.Has("format") || !optionsObj.Get("format").IsString()) {
+        throw std::runtime_error("Output options require a format of 'png' or 'jpeg'");
+    }
+
+    ImageOutputOptions options;
+    options.format = optionsObj.Get("format").As<Napi::String>().Utf8Value();
+    std::transform(options.format.begin(), options.format.end(), options.format.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (options.format == "png") {
+        options.encoderId = BitmapEncoder::PngEncoderId();
+    } else if (options.format == "jpeg" || options.format == "jpg") {
+        options.format = "jpeg";
+        options.encoderId = BitmapEncoder::JpegEncoderId();
+    } else if (options.format == "webp") {
+        // BitmapEncoder ships a WebP decoder only, there is no WebP encoder to hand the bitmap to
+        throw std::runtime_error("WebP encoding is not supported by the Windows imaging encoders. Use 'png' or 'jpeg'");
+    } else {
+        throw std::runtime_error("Unsupported output format '" + options.format + "'. Use 'png' or 'jpeg'");
+    }
+
+    if (optionsObj.Has("quality") && !optionsObj.Get("quality").IsUndefined()) {
+        if (!optionsObj.Get("quality").IsNumber()) {
+            throw std::runtime_error("Output quality must be a number between 0 and 1");
+        }
+        float quality = optionsObj.Get("quality").As<Napi::Number>().FloatValue();
+        if (quality < 0.0f || quality > 1.0f) {
+            throw std::runtime_error("Output quality must be a number between 0 and 1");
+        }
+        options.quality = quality;
+    }
+
+    if (optionsObj.Has("filePath") && !optionsObj.Get("filePath").IsUndefined()) {
+        if (!optionsObj.Get("filePath").IsString()) {
+            throw std::runtime_error("Output filePath must be a string");
+        }
+        options.filePath = winrt::to_hstring(optionsObj.Get("filePath").As<Napi::String>().Utf8Value());
+    }
+
+    return options;
+}
+
+EncodedImage EncodeSoftwareBitmap(const SoftwareBitmap& bitmap, const ImageOutputOptions& options) {
+    auto start = std::chrono::steady_clock::now();
+
+    // The encoders only accept BGRA8 input, model outputs may come back as Gray8 or RGBA
+    auto source = bitmap;
+    if (source.BitmapPixelFormat() != BitmapPixelFormat::Bgra8) {
+        source = SoftwareBitmap::Convert(source, BitmapPixelFormat::Bgra8, BitmapAlphaMode::Premultiplied);
+    }
+
+    IRandomAccessStream stream = nullptr;
+    InMemoryRandomAccessStream memoryStream = nullptr;
+    if (!options.filePath.empty()) {
+        stream = FileRandomAccessStream::OpenAsync(options.filePath, FileAccessMode::ReadWrite, StorageOpenOptions::None, FileOpenDisposition::CreateAlways).get();
+    } else {
+        memoryStream = InMemoryRandomAccessStream();
+        stream = memoryStream;
+    }
+
+    BitmapEncoder encoder = nullptr;
+    if (options.quality.has_value() && options.encoderId == BitmapEncoder::JpegEncoderId()) {
+        BitmapPropertySet properties;
+        properties.Insert(L"ImageQuality", BitmapTypedValue(winrt::box_value(*options.quality), PropertyType::Single));
+        encoder = BitmapEncoder::CreateAsync(options.encoderId, stream, properties).get();
+    } else {
+        encoder = BitmapEncoder::CreateAsync(options.encoderId, stream).get();
+    }
+    encoder.SetSoftwareBitmap(source);
+    encoder.FlushAsync().get();
+
+    EncodedImage result;
+    result.format = options.format;
+    result.width = static_cast<uint32_t>(source.PixelWidth());
+    result.height = static_cast<uint32_t>(source.PixelHeight());
+    result.filePath = options.filePath;
+    result.byteLength = stream.Size();
+
+    if (memoryStream) {
+        auto size = static_cast<uint32_t>(memoryStream.Size());
+        Buffer buffer(size);
+        memoryStream.Seek(0);
+        auto read = memoryStream.ReadAsync(buffer, size, InputStreamOptions::None).get();
+        result.bytes.assign(read.data(), read.data() + read.Length());
+    } else {
+        stream.Close();
+    }
+
+    result.encodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+std::vector<uint8_t> CopySoftwareBitmapPixels(const SoftwareBitmap& bitmap) {
+    auto source = bitmap;
+    if (source.BitmapPixelFormat() != BitmapPixelFormat::Bgra8) {
+        source = SoftwareBitmap::Convert(source, BitmapPixelFormat::Bgra8, BitmapAlphaMode::Premultiplied);
+    }
+    uint32_t size = static_cast<uint32_t>(source.PixelWidth()) * static_cast<uint32_t>(source.PixelHeight()) * 4;
+    Buffer buffer(size);
+    source.CopyToBuffer(buffer);
+    return std::vector<uint8_t>(buffer.data(), buffer.data() + buffer.Length());
+}
+
+Napi::Object EncodedImageToJs(Napi::Env env, const EncodedImage& image) {
+    auto resultObj = Napi::Object::New(env);
+    resultObj.Set("format", Napi::String::New(env, image.format));
+    resultObj.Set("width", Napi::Number::New(env, image.width));
+    resultObj.Set("height", Napi::Number::New(env, image.height));
+    resultObj.Set("byteLength", Napi::Number::New(env, static_cast<double>(image.byteLength)));
+    resultObj.Set("encodeMs", Napi::Number::New(env, image.encodeMs));
+    if (!image.filePath.empty()) {
+        resultObj.Set("filePath", Napi::String::New(env, winrt::to_string(image.filePath)));
+    } else {
+        // Copy rather than wrap: Electron's V8 memory cage rejects externally backed buffers
+        resultObj.Set("buffer", Napi::Buffer<uint8_t>::Copy(env, image.bytes.data(), image.bytes.size()));
+    }
+    return resultObj;
+}
+
+Napi::Object RawPixelsToJs(Napi::Env env, uint32_t width, uint32_t height, const std::vector<uint8_t>& pixels) {
+    auto resultObj = Napi::Object::New(env);
+    resultObj.Set("format", Napi::String::New(env, "bgra8"));
+    resultObj.Set("width", Napi::Number::New(env, width));
+    resultObj.Set("height", Napi::Number::New(env, height));
+    resultObj.Set("byteLength", Napi::Number::New(env, static_cast<double>(pixels.size())));
+    resultObj.Set("buffer", Napi::Buffer<uint8_t>::Copy(env, pixels.data(), pixels.size()));
+    return resultObj;
+}
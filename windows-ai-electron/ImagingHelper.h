@@ -0,0 +1,146 @@
+#pragma once
+
+#include <napi.h>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <winrt/Windows.Foundation.h>
+#include <winrt/Windows.Graphics.Imaging.h>
+#include <winrt/Microsoft.Windows.AI.Imaging.h>
+
+#include "OcrLayout.h"
+#include "OcrModel.h"
+
+// Encoded output requested by the caller of an imaging method (e.g. ScaleAsync)
+struct ImageOutputOptions {
+    winrt::guid encoderId;
+    std::string format;
+    std::optional<float> quality;
+    winrt::hstring filePath;
+};
+
+// Result of encoding a SoftwareBitmap on the worker thread
+struct EncodedImage {
+    std::string format;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> bytes;
+    winrt::hstring filePath;
+    uint64_t byteLength = 0;
+    double encodeMs = 0;
+};
+
+// Two-pass recognition: the whole image at reduced resolution, then full resolution only for unsure lines
+struct AdaptiveRecognitionOptions {
+    float scale = 0.5f;          // size of the first pass relative to the image, in (0, 1]
+    float minConfidence = 0.8f;  // lines with a word or style confidence below this are recognized again
+    float fullFrameRatio = 0.5f; // above this fraction of unsure area the whole image is recognized again
+};
+
+// What one adaptive recognition did, accumulated into TextRecognizer.GetAdaptiveStats()
+struct AdaptiveRecognitionReport {
+    uint32_t refinedRegions = 0; // regions recognized again at full resolution
+    uint32_t refinedLines = 0;   // first-pass lines they replaced
+    bool fullFrame = false;      // the second pass covered the whole image
+    double coarseMs = 0;
+    double refineMs = 0;
+};
+
+// Addon options accepted by TextRecognizer.RecognizeTextFromImageAsync as second parameter
+struct TextRecognitionOptions {
+    std::vector<OcrRect> regions; // original-image pixels, empty means the whole image
+    std::optional<AdaptiveRecognitionOptions> adaptive; // not combined with regions
+    bool textOnly = false;        // resolve with a plain string instead of a RecognizedText
+    bool layout = false;          // resolve with the reading-order layout, or join textOnly text in layout order
+    OcrTextOptions text;          // used when textOnly is set
+};
+
+// Read-only view over the pixels of a BGRA8 SoftwareBitmap without copying them.
+// Bitmaps in other formats are converted first. The view is valid while the object is alive.
+class SoftwareBitmapPixelView {
+public:
+    explicit SoftwareBitmapPixelView(const winrt::Windows::Graphics::Imaging::SoftwareBitmap& bitmap);
+    ~SoftwareBitmapPixelView();
+
+    SoftwareBitmapPixelView(const SoftwareBitmapPixelView&) = delete;
+    SoftwareBitmapPixelView& operator=(const SoftwareBitmapPixelView&) = delete;
+
+    const uint8_t* Data() const { return m_data; }
+    uint32_t Width() const { return m_width; }
+    uint32_t Height() const { return m_height; }
+    uint32_t Stride() const { return m_stride; }
+
+private:
+    winrt::Windows::Graphics::Imaging::SoftwareBitmap m_bitmap{ nullptr };
+    winrt::Windows::Graphics::Imaging::BitmapBuffer m_buffer{ nullptr };
+    winrt::Windows::Foundation::IMemoryBufferReference m_reference{ nullptr };
+    const uint8_t* m_data = nullptr;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint32_t m_stride = 0;
+};
+
+// Decodes the image at filePath into a SoftwareBitmap
+winrt::Windows::Graphics::Imaging::SoftwareBitmap LoadSoftwareBitmapFromFile(const winrt::hstring& filePath);
+
+// Reads the whole file into memory. Throws std::runtime_error when it cannot be read.
+std::vector<uint8_t> ReadFileBytes(const winrt::hstring& filePath);
+
+// Decodes an encoded image (PNG, JPEG, ...) held in memory
+winrt::Windows::Graphics::Imaging::SoftwareBitmap LoadSoftwareBitmapFromBytes(const std::vector<uint8_t>& bytes);
+
+// Creates a BGRA8 bitmap from width x height pixels starting at data, rows stride bytes apart.
+// Passing a pointer into a larger frame crops it.
+winrt::Windows::Graphics::Imaging::SoftwareBitmap CreateSoftwareBitmapFromBgra(const uint8_t* data, uint32_t width, uint32_t height, uint32_t stride);
+
+// Copies a RecognizedText into the native OCR model, translating all coordinates by (offsetX, offsetY)
+OcrPage OcrPageFromRecognizedText(const winrt::Microsoft::Windows::AI::Imaging::RecognizedText& text, float offsetX = 0, float offsetY = 0);
+
+// { X, Y }, the shape of the RecognizedTextBoundingBox corners
+Napi::Object OcrPointToJs(Napi::Env env, const OcrPoint& point);
+
+// [topLeft.x, topLeft.y, topRight.x, topRight.y, bottomLeft.x, bottomLeft.y, bottomRight.x, bottomRight.y]
+Napi::Array OcrQuadToFlatJs(Napi::Env env, const OcrQuad& quad);
+
+// Compact layout object: { textAngle, lines: [{ text, box }], paragraphs: [{ block, firstLine, lineCount }],
+// blocks: [{ box, column, firstParagraph, paragraphCount }] } with boxes as flat arrays of 8 numbers
+Napi::Object OcrLayoutToJs(Napi::Env env, const OcrPage& page, const OcrLayout& layout);
+
+// Parses a raw frame object { width, height, buffer, stride? } holding BGRA8 pixels and copies it tightly packed.
+// Throws std::runtime_error when invalid.
+std::vector<uint8_t> ParseRawFrame(const Napi::Value& value, uint32_t& width, uint32_t& height);
+
+// Parses { regions, adaptive, textOnly, layout, lineSeparator, paragraphSeparator, minWordConfidence }. Undefined/null yields the defaults, throws std::runtime_error when invalid.
+TextRecognitionOptions ParseTextRecognitionOptions(const Napi::Value& value);
+
+// Folds the options that change the recognized output into one value for result store keys
+uint64_t TextRecognitionOptionsKey(const TextRecognitionOptions& options);
+
+// Crops each region out of the bitmap, recognizes the crops concurrently and merges the lines
+// back into one page in original-image coordinates. Regions are clipped to the image.
+OcrPage RecognizeTextInRegions(const winrt::Microsoft::Windows::AI::Imaging::TextRecognizer& recognizer, const winrt::Windows::Graphics::Imaging::SoftwareBitmap& bitmap, const std::vector<OcrRect>& regions);
+
+// Recognizes a downscaled copy of the bitmap, then crops the lines below options.minConfidence out of
+// the full-resolution bitmap and splices their recognition back into the page. A first pass without
+// any line is repeated at full resolution, small text may have vanished entirely.
+OcrPage RecognizeTextAdaptive(const winrt::Microsoft::Windows::AI::Imaging::TextRecognizer& recognizer, const winrt::Windows::Graphics::Imaging::SoftwareBitmap& bitmap, const AdaptiveRecognitionOptions& options, AdaptiveRecognitionReport& report);
+
+// Recognizes the bitmap the way RecognizeTextFromImageAsync does for these options: only the regions
+// when given, adaptively when requested, otherwise in one pass. report is only filled for adaptive runs.
+OcrPage RecognizeTextWithOptions(const winrt::Microsoft::Windows::AI::Imaging::TextRecognizer& recognizer, const winrt::Windows::Graphics::Imaging::SoftwareBitmap& bitmap, const TextRecognitionOptions& options, AdaptiveRecognitionReport& report);
+
+// Parses an { format, quality, filePath } object. Returns std::nullopt for undefined/null, throws std::runtime_error when invalid.
+std::optional<ImageOutputOptions> ParseImageOutputOptions(const Napi::Value& value);
+
+// Encodes the bitmap to PNG/JPEG, either into memory or directly into options.filePath
+EncodedImage EncodeSoftwareBitmap(const winrt::Windows::Graphics::Imaging::SoftwareBitmap& bitmap, const ImageOutputOptions& options);
+
+// Copies the BGRA8 pixels of the bitmap into a byte vector
+std::vector<uint8_t> CopySoftwareBitmapPixels(const winrt::Windows::Graphics::Imaging::SoftwareBitmap& bitmap);
+
+// Marshals an encoded image as { format, width, height, byteLength, encodeMs, buffer? , filePath? }
+Napi::Object EncodedImageToJs(Napi::Env env, const EncodedImage& image);
+
+// Marshals raw BGRA8 pixels as { format: "bgra8", width, height, byteLength, buffer }
+Napi::Object RawPixelsToJs(Napi::Env env, uint32_t width, uint32_t height, const std::vector<uint8_t>& pixels);
@@ -2,6 +2,10 @@
 #include "LanguageModelProjections.h"
 #include "ProjectionHelper.h"
 #include "ContentSeverity.h"
+#include "ImagingHelper.h"
+#include "PixelAnalysis.h"
+#include "ContentHash.h"
+#include "ResultStore.h"
 #include <shobjidl_core.h>
 #include <windows.h>
 #include <winrt/Windows.Data.Xml.Dom.h>
@@ -9,6 +13,8 @@
 #include <winrt/Windows.Storage.Streams.h>
 #include <winrt/Windows.Graphics.Imaging.h>
 #include <winrt/Microsoft.Graphics.Imaging.h>
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <thread>
 
@@ -22,6 +28,10 @@ Napi::FunctionReference MyRecognizedWord::constructor;
 Napi::FunctionReference MyRecognizedTextBoundingBox::constructor;
 Napi::FunctionReference MyImageDescriptionGenerator::constructor;
 Napi::FunctionReference MyTextRecognizer::constructor;
+Napi::FunctionReference MyTextSearchIndex::constructor;
+Napi::FunctionReference MyIncrementalTextRecognizer::constructor;
+Napi::FunctionReference MyImageObjectRemover::constructor;
+Napi::FunctionReference MyImageScaler::constructor;
 
 // MyImageDescriptionResult Implementation
 Napi::Object MyImageDescriptionResult::Init(Napi::Env env, Napi::Object exports) {
@@ -43,12 +53,15 @@ MyImageDescriptionResult::MyImageDescriptionResult(const Napi::CallbackInfo& inf
 }
 
 bool MyImageDescriptionResult::HasResult() const {
-    return m_result.has_value();
+    return m_result.has_value() || m_storedDescription.has_value();
 }
 
 Napi::Value MyImageDescriptionResult::GetDescription(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     try {
+        if (m_storedDescription.has_value()) {
+            return Napi::String::New(env, *m_storedDescription);
+        }
         if (!m_result.has_value()) {
             Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
             return env.Null();
@@ -72,6 +85,9 @@ Napi::Value MyImageDescriptionResult::GetDescription(const Napi::CallbackInfo& i
 Napi::Value MyImageDescriptionResult::GetStatus(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     try {
+        if (m_storedDescription.has_value()) {
+            return Napi::Number::New(env, m_storedStatus);
+        }
         if (!m_result.has_value()) {
             Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
             return env.Null();
@@ -96,11 +112,19 @@ void MyImageDescriptionResult::SetResult(const ImageDescriptionResult& result) {
     m_result = result;
 }
 
+void MyImageDescriptionResult::SetStoredResult(std::string description, int32_t status) {
+    m_storedDescription = std::move(description);
+    m_storedStatus = status;
+}
+
 // MyImageDescriptionGenerator Implementation
 Napi::Object MyImageDescriptionGenerator::Init(Napi::Env env, Napi::Object exports) {
     Napi::Function func = DefineClass(env, "ImageDescriptionGenerator", {
         InstanceMethod("DescribeAsync", &MyImageDescriptionGenerator::MyDescribeAsync),
         InstanceMethod("Close", &MyImageDescriptionGenerator::MyClose),
+        InstanceMethod("ConfigureCache", &MyImageDescriptionGenerator::MyConfigureCache),
+        InstanceMethod("GetCacheStats", &MyImageDescriptionGenerator::MyGetCacheStats),
+        InstanceMethod("ClearCache", &MyImageDescriptionGenerator::MyClearCache),
         StaticMethod("CreateAsync", &MyImageDescriptionGenerator::MyCreateAsync),
         StaticMethod("GetReadyState", &MyImageDescriptionGenerator::MyGetReadyState),
         StaticMethod("EnsureReadyAsync", &MyImageDescriptionGenerator::MyEnsureReadyAsync)
@@ -254,6 +278,7 @@ MyImageDescriptionGenerator::MyImageDescriptionGenerator(const Napi::CallbackInf
     
     auto external = info[0].As<Napi::External<ImageDescriptionGenerator>>();
     m_generator = external.Data();
+    m_cache = std::make_shared<DescriptionCache>();
 }
 
 Napi::Value MyImageDescriptionGenerator::MyDescribeAsync(const Napi::CallbackInfo& info) {
@@ -299,12 +324,58 @@ Napi::Value MyImageDescriptionGenerator::MyDescribeAsync(const Napi::CallbackInf
         std::wstring wFilePath(filePath.begin(), filePath.end());
         
         // Create async operation on background thread
-        std::thread([deferred, tsfn, tsfn_guard, progressTsfn, wFilePath, descriptionKind, contentFilterOptions, generator = m_generator]() {
+        std::thread([deferred, tsfn, tsfn_guard, progressTsfn, wFilePath, descriptionKind, contentFilterOptions, generator = m_generator, cache = m_cache]() {
             try {
-                auto storageFile = Windows::Storage::StorageFile::GetFileFromPathAsync(wFilePath).get();
-                auto stream = storageFile.OpenAsync(Windows::Storage::FileAccessMode::Read).get();
-                auto decoder = Windows::Graphics::Imaging::BitmapDecoder::CreateAsync(stream).get();
-                auto softwareBitmap = decoder.GetSoftwareBitmapAsync().get();
+                uint64_t filterKey = ContentFilterOptionsFingerprint(contentFilterOptions);
+
+                // Identical files are answered from the persistent store before decoding
+                auto store = GetActiveResultStore();
+                std::vector<uint8_t> fileBytes;
+                ResultKey storeKey;
+                if (store) {
+                    fileBytes = ReadFileBytes(winrt::hstring(wFilePath));
+                    storeKey = { ComputeContentHash(fileBytes.data(), fileBytes.size()), filterKey, StoredFeature::ImageDescription, descriptionKind };
+                    if (auto payload = store->Get(storeKey)) {
+                        int32_t status = 0;
+                        std::string description;
+                        if (DeserializeImageDescription(*payload, status, description)) {
+                            tsfn.BlockingCall([deferred, description, status](Napi::Env env, Napi::Function) {
+                                auto resultObj = MyImageDescriptionResult::constructor.New({});
+                                auto resultInstance = Napi::ObjectWrap<MyImageDescriptionResult>::Unwrap(resultObj);
+                                resultInstance->SetStoredResult(description, status);
+                                deferred.Resolve(resultObj);
+                            });
+                            return;
+                        }
+                    }
+                }
+
+                auto softwareBitmap = store ? LoadSoftwareBitmapFromBytes(fileBytes) : LoadSoftwareBitmapFromFile(winrt::hstring(wFilePath));
+
+                // With the cache on, frames within maxDistance bits of a previous one reuse its description
+                uint64_t imageHash = 0;
+                bool cacheEnabled = false;
+                {
+                    std::lock_guard<std::mutex> lock(cache->mutex);
+                    cacheEnabled = cache->enabled;
+                }
+                if (cacheEnabled) {
+                    {
+                        SoftwareBitmapPixelView pixels(softwareBitmap);
+                        imageHash = ComputeDifferenceHash(pixels.Data(), pixels.Width(), pixels.Height(), pixels.Stride());
+                    }
+                    auto cached = cache->Lookup(imageHash, descriptionKind, filterKey);
+                    if (cached) {
+                        tsfn.BlockingCall([deferred, result = *cached](Napi::Env env, Napi::Function) {
+                            auto resultObj = MyImageDescriptionResult::constructor.New({});
+                            auto resultInstance = Napi::ObjectWrap<MyImageDescriptionResult>::Unwrap(resultObj);
+                            resultInstance->SetResult(result);
+                            deferred.Resolve(resultObj);
+                        });
+                        return;
+                    }
+                }
+
                 auto imageBuffer = Microsoft::Graphics::Imaging::ImageBuffer::CreateForSoftwareBitmap(softwareBitmap);
 
                 ImageDescriptionKind kind = static_cast<ImageDescriptionKind>(descriptionKind);
@@ -323,6 +394,16 @@ Napi::Value MyImageDescriptionGenerator::MyDescribeAsync(const Napi::CallbackInf
                 });
                 
                 auto result = asyncOp.get();
+
+                // Failures and filtered results are not cached so a retry still reaches the model
+                if (result.Status() == ImageDescriptionResultStatus::Success) {
+                    if (cacheEnabled) {
+                        cache->Store(imageHash, descriptionKind, filterKey, result);
+                    }
+                    if (store) {
+                        store->Put(storeKey, SerializeImageDescription(static_cast<int32_t>(result.Status()), winrt::to_string(result.Description())));
+                    }
+                }
                 
                 tsfn.BlockingCall([deferred, result](Napi::Env env, Napi::Function) {
                     auto resultObj = MyImageDescriptionResult::constructor.New({});
@@ -379,11 +460,140 @@ Napi::Value MyImageDescriptionGenerator::MyClose(const Napi::CallbackInfo& info)
     }
 }
 
+std::optional<ImageDescriptionResult> DescriptionCache::Lookup(uint64_t hash, int32_t kind, uint64_t filterKey) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto best = entries.end();
+    uint32_t bestDistance = maxDistance + 1;
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->kind != kind || it->filterKey != filterKey) {
+            continue;
+        }
+        uint32_t distance = HammingDistance(it->hash, hash);
+        if (distance < bestDistance) {
+            best = it;
+            bestDistance = distance;
+            if (distance == 0) {
+                break;
+            }
+        }
+    }
+
+    if (best == entries.end()) {
+        misses++;
+        return std::nullopt;
+    }
+
+    hits++;
+    Entry entry = *best;
+    entries.erase(best);
+    entries.push_front(entry);
+    return entry.result;
+}
+
+void DescriptionCache::Store(uint64_t hash, int32_t kind, uint64_t filterKey, const ImageDescriptionResult& result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!enabled || capacity == 0) {
+        return;
+    }
+    entries.push_front({ hash, kind, filterKey, result });
+    while (entries.size() > capacity) {
+        entries.pop_back();
+    }
+}
+
+Napi::Value MyImageDescriptionGenerator::MyConfigureCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "ConfigureCache requires an options object { enabled, maxHammingDistance, capacity }").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    auto optionsObj = info[0].As<Napi::Object>();
+    std::lock_guard<std::mutex> lock(m_cache->mutex);
+
+    if (optionsObj.Has("enabled") && !optionsObj.Get("enabled").IsUndefined()) {
+        if (!optionsObj.Get("enabled").IsBoolean()) {
+            Napi::TypeError::New(env, "enabled must be a boolean").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        m_cache->enabled = optionsObj.Get("enabled").As<Napi::Boolean>().Value();
+        if (!m_cache->enabled) {
+            m_cache->entries.clear();
+        }
+    }
+
+    if (optionsObj.Has("maxHammingDistance") && !optionsObj.Get("maxHammingDistance").IsUndefined()) {
+        if (!optionsObj.Get("maxHammingDistance").IsNumber()) {
+            Napi::TypeError::New(env, "maxHammingDistance must be a number between 0 and 64").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        int32_t distance = optionsObj.Get("maxHammingDistance").As<Napi::Number>().Int32Value();
+        if (distance < 0 || distance > 64) {
+            Napi::RangeError::New(env, "maxHammingDistance must be a number between 0 and 64").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        m_cache->maxDistance = static_cast<uint32_t>(distance);
+    }
+
+    if (optionsObj.Has("capacity") && !optionsObj.Get("capacity").IsUndefined()) {
+        if (!optionsObj.Get("capacity").IsNumber() || optionsObj.Get("capacity").As<Napi::Number>().Int64Value() < 0) {
+            Napi::TypeError::New(env, "capacity must be a non-negative number").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        m_cache->capacity = static_cast<size_t>(optionsObj.Get("capacity").As<Napi::Number>().Int64Value());
+        while (m_cache->entries.size() > m_cache->capacity) {
+            m_cache->entries.pop_back();
+        }
+    }
+
+    return env.Undefined();
+}
+
+Napi::Value MyImageDescriptionGenerator::MyGetCacheStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::lock_guard<std::mutex> lock(m_cache->mutex);
+
+    auto statsObj = Napi::Object::New(env);
+    statsObj.Set("enabled", Napi::Boolean::New(env, m_cache->enabled));
+    statsObj.Set("hits", Napi::Number::New(env, static_cast<double>(m_cache->hits)));
+    statsObj.Set("misses", Napi::Number::New(env, static_cast<double>(m_cache->misses)));
+    statsObj.Set("size", Napi::Number::New(env, static_cast<double>(m_cache->entries.size())));
+    statsObj.Set("capacity", Napi::Number::New(env, static_cast<double>(m_cache->capacity)));
+    statsObj.Set("maxHammingDistance", Napi::Number::New(env, m_cache->maxDistance));
+    return statsObj;
+}
+
+Napi::Value MyImageDescriptionGenerator::MyClearCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::lock_guard<std::mutex> lock(m_cache->mutex);
+    m_cache->entries.clear();
+    m_cache->hits = 0;
+    m_cache->misses = 0;
+    return env.Undefined();
+}
+
+void AdaptiveRecognitionStats::Record(const AdaptiveRecognitionReport& report) {
+    std::lock_guard<std::mutex> lock(mutex);
+    pages++;
+    if (report.refinedRegions > 0) {
+        refinedPages++;
+    }
+    if (report.fullFrame) {
+        fullFramePages++;
+    }
+    refinedRegions += report.refinedRegions;
+    refinedLines += report.refinedLines;
+    coarseMs += report.coarseMs;
+    refineMs += report.refineMs;
+}
+
 // MyTextRecognizer Implementation
 Napi::Object MyTextRecognizer::Init(Napi::Env env, Napi::Object exports) {
     Napi::Function func = DefineClass(env, "TextRecognizer", {
         InstanceMethod("RecognizeTextFromImageAsync", &MyTextRecognizer::MyRecognizeTextFromImageAsync),
         InstanceMethod("RecognizeTextFromImage", &MyTextRecognizer::MyRecognizeTextFromImage),
+        InstanceMethod("GetAdaptiveStats", &MyTextRecognizer::MyGetAdaptiveStats),
         InstanceMethod("Close", &MyTextRecognizer::MyClose),
         InstanceMethod("Dispose", &MyTextRecognizer::MyDispose),
         StaticMethod("CreateAsync", &MyTextRecognizer::MyCreateAsync),
@@ -541,6 +751,14 @@ MyTextRecognizer::MyTextRecognizer(const Napi::CallbackInfo& info) : Napi::Objec
     m_recognizer = external.Data();
 }
 
+TextRecognizer* MyTextRecognizer::GetRecognizer() const {
+    return m_recognizer;
+}
+
+std::shared_ptr<AdaptiveRecognitionStats> MyTextRecognizer::GetAdaptiveStats() const {
+    return m_adaptiveStats;
+}
+
 Napi::Value MyTextRecognizer::MyRecognizeTextFromImageAsync(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
@@ -560,24 +778,77 @@ Napi::Value MyTextRecognizer::MyRecognizeTextFromImageAsync(const Napi::Callback
 
     try {
         std::string filePath = info[0].As<Napi::String>().Utf8Value();
+        auto options = ParseTextRecognitionOptions(info.Length() > 1 ? info[1] : env.Undefined());
         
         // Convert file path to Windows string
         std::wstring wFilePath(filePath.begin(), filePath.end());
         
         // Create async operation on background thread
-        std::thread([deferred, tsfn, tsfn_guard, wFilePath, recognizer = m_recognizer]() {
+        std::thread([deferred, tsfn, tsfn_guard, wFilePath, options, recognizer = m_recognizer, adaptiveStats = m_adaptiveStats]() {
             try {
-                // Load the image file as a StorageFile
-                auto storageFile = Windows::Storage::StorageFile::GetFileFromPathAsync(wFilePath).get();
+                // Resolves with a page-backed RecognizedText, the joined string for textOnly or the layout
+                auto resolvePage = [&deferred, &tsfn, &options](std::shared_ptr<OcrPage> page) {
+                    if (options.textOnly) {
+                        std::string text = options.layout ? JoinOcrLayoutText(*page, AnalyzeOcrLayout(*page), options.text) : JoinOcrPageText(*page, options.text);
+                        tsfn.BlockingCall([deferred, text = std::move(text)](Napi::Env env, Napi::Function) {
+                            deferred.Resolve(Napi::String::New(env, text));
+                        });
+                        return;
+                    }
+                    if (options.layout) {
+                        auto layout = std::make_shared<OcrLayout>(AnalyzeOcrLayout(*page));
+                        tsfn.BlockingCall([deferred, page, layout](Napi::Env env, Napi::Function) {
+                            deferred.Resolve(OcrLayoutToJs(env, *page, *layout));
+                        });
+                        return;
+                    }
+                    tsfn.BlockingCall([deferred, page](Napi::Env env, Napi::Function) {
+                        auto resultObj = MyRecognizedText::constructor.New({});
+                        auto resultInstance = Napi::ObjectWrap<MyRecognizedText>::Unwrap(resultObj);
+                        resultInstance->SetPage(page);
+                        deferred.Resolve(resultObj);
+                    });
+                };
+
+                // Identical files are answered from the persistent store before decoding
+                auto store = GetActiveResultStore();
+                std::vector<uint8_t> fileBytes;
+                ResultKey storeKey;
+                if (store) {
+                    fileBytes = ReadFileBytes(winrt::hstring(wFilePath));
+                    storeKey = { ComputeContentHash(fileBytes.data(), fileBytes.size()), TextRecognitionOptionsKey(options), StoredFeature::TextRecognition, 0 };
+                    if (auto payload = store->Get(storeKey)) {
+                        auto page = std::make_shared<OcrPage>();
+                        if (DeserializeOcrPage(payload->data(), payload->size(), *page)) {
+                            resolvePage(page);
+                            return;
+                        }
+                    }
+                }
                 
-                // Open the file for reading
-                auto stream = storageFile.OpenAsync(Windows::Storage::FileAccessMode::Read).get();
+                // Decode the image into a SoftwareBitmap
+                auto softwareBitmap = store ? LoadSoftwareBitmapFromBytes(fileBytes) : LoadSoftwareBitmapFromFile(winrt::hstring(wFilePath));
                 
-                // Create a BitmapDecoder to decode the image
-                auto decoder = Windows::Graphics::Imaging::BitmapDecoder::CreateAsync(stream).get();
+                if (!options.regions.empty()) {
+                    // Only the requested regions are recognized, the merged page is in original-image coordinates
+                    auto page = std::make_shared<OcrPage>(RecognizeTextInRegions(*recognizer, softwareBitmap, options.regions));
+                    if (store) {
+                        store->Put(storeKey, SerializeOcrPage(*page));
+                    }
+                    resolvePage(page);
+                    return;
+                }
                 
-                // Get the SoftwareBitmap
-                auto softwareBitmap = decoder.GetSoftwareBitmapAsync().get();
+                if (options.adaptive) {
+                    AdaptiveRecognitionReport report;
+                    auto page = std::make_shared<OcrPage>(RecognizeTextAdaptive(*recognizer, softwareBitmap, *options.adaptive, report));
+                    adaptiveStats->Record(report);
+                    if (store) {
+                        store->Put(storeKey, SerializeOcrPage(*page));
+                    }
+                    resolvePage(page);
+                    return;
+                }
                 
                 // Create ImageBuffer from SoftwareBitmap
                 auto imageBuffer = Microsoft::Graphics::Imaging::ImageBuffer::CreateForSoftwareBitmap(softwareBitmap);
@@ -586,6 +857,17 @@ Napi::Value MyTextRecognizer::MyRecognizeTextFromImageAsync(const Napi::Callback
                 auto asyncOp = recognizer->RecognizeTextFromImageAsync(imageBuffer);
                 auto result = asyncOp.get();
                 
+                if (store || options.textOnly || options.layout) {
+                    auto page = std::make_shared<OcrPage>(OcrPageFromRecognizedText(result));
+                    if (store) {
+                        store->Put(storeKey, SerializeOcrPage(*page));
+                    }
+                    if (options.textOnly || options.layout) {
+                        resolvePage(page);
+                        return;
+                    }
+                }
+                
                 // Return result on main thread
                 tsfn.BlockingCall([deferred, result](Napi::Env env, Napi::Function) {
                     auto resultObj = MyRecognizedText::constructor.New({});
@@ -623,6 +905,21 @@ Napi::Value MyTextRecognizer::MyRecognizeTextFromImageAsync(const Napi::Callback
     }
 }
 
+Napi::Value MyTextRecognizer::MyGetAdaptiveStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::lock_guard<std::mutex> lock(m_adaptiveStats->mutex);
+
+    auto statsObj = Napi::Object::New(env);
+    statsObj.Set("pages", Napi::Number::New(env, static_cast<double>(m_adaptiveStats->pages)));
+    statsObj.Set("refinedPages", Napi::Number::New(env, static_cast<double>(m_adaptiveStats->refinedPages)));
+    statsObj.Set("fullFramePages", Napi::Number::New(env, static_cast<double>(m_adaptiveStats->fullFramePages)));
+    statsObj.Set("refinedRegions", Napi::Number::New(env, static_cast<double>(m_adaptiveStats->refinedRegions)));
+    statsObj.Set("refinedLines", Napi::Number::New(env, static_cast<double>(m_adaptiveStats->refinedLines)));
+    statsObj.Set("coarseMs", Napi::Number::New(env, m_adaptiveStats->coarseMs));
+    statsObj.Set("refineMs", Napi::Number::New(env, m_adaptiveStats->refineMs));
+    return statsObj;
+}
+
 Napi::Value MyTextRecognizer::MyRecognizeTextFromImage(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
@@ -710,7 +1007,10 @@ Napi::Value MyTextRecognizer::MyDispose(const Napi::CallbackInfo& info) {
 Napi::Object MyRecognizedText::Init(Napi::Env env, Napi::Object exports) {
     Napi::Function func = DefineClass(env, "RecognizedText", {
         InstanceAccessor("Lines", &MyRecognizedText::GetLines, nullptr),
-        InstanceAccessor("TextAngle", &MyRecognizedText::GetTextAngle, nullptr)
+        InstanceAccessor("TextAngle", &MyRecognizedText::GetTextAngle, nullptr),
+        InstanceMethod("HitTest", &MyRecognizedText::MyHitTest),
+        InstanceMethod("QueryRect", &MyRecognizedText::MyQueryRect),
+        InstanceMethod("Nearest", &MyRecognizedText::MyNearest)
     });
 
     constructor = Napi::Persistent(func);
@@ -726,12 +1026,21 @@ MyRecognizedText::MyRecognizedText(const Napi::CallbackInfo& info) : Napi::Objec
 }
 
 bool MyRecognizedText::HasResult() const {
-    return m_result.has_value();
+    return m_result.has_value() || m_page != nullptr;
 }
 
 Napi::Value MyRecognizedText::GetLines(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     try {
+        if (m_page) {
+            auto array = Napi::Array::New(env, m_page->lines.size());
+            for (uint32_t i = 0; i < m_page->lines.size(); i++) {
+                auto lineWrapper = MyRecognizedLine::constructor.New({});
+                Napi::ObjectWrap<MyRecognizedLine>::Unwrap(lineWrapper)->SetLine(m_page->lines[i]);
+                array.Set(i, lineWrapper);
+            }
+            return array;
+        }
         if (!m_result.has_value()) {
             Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
             return env.Null();
@@ -764,6 +1073,9 @@ Napi::Value MyRecognizedText::GetLines(const Napi::CallbackInfo& info) {
 Napi::Value MyRecognizedText::GetTextAngle(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     try {
+        if (m_page) {
+            return Napi::Number::New(env, m_page->textAngle);
+        }
         if (!m_result.has_value()) {
             Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
             return env.Null();
@@ -786,382 +1098,947 @@ Napi::Value MyRecognizedText::GetTextAngle(const Napi::CallbackInfo& info) {
     }
 }
 
-void MyRecognizedText::SetResult(const RecognizedText& result) {
-    m_result = result;
-}
-
-// MyRecognizedLine Implementation
-Napi::Object MyRecognizedLine::Init(Napi::Env env, Napi::Object exports) {
-    Napi::Function func = DefineClass(env, "RecognizedLine", {
-        InstanceAccessor("BoundingBox", &MyRecognizedLine::GetBoundingBox, nullptr),
-        InstanceAccessor("Style", &MyRecognizedLine::GetStyle, nullptr),
-        InstanceAccessor("LineStyleConfidence", &MyRecognizedLine::GetLineStyleConfidence, nullptr),
-        InstanceAccessor("Text", &MyRecognizedLine::GetText, nullptr),
-        InstanceAccessor("Words", &MyRecognizedLine::GetWords, nullptr)
-    });
-
-    constructor = Napi::Persistent(func);
-    exports.Set("RecognizedLine", func);
-    return exports;
-}
-
-MyRecognizedLine::MyRecognizedLine(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyRecognizedLine>(info) {
-    if (info.Length() == 1 && info[0].IsExternal()) {
-        auto external = info[0].As<Napi::External<RecognizedLine>>();
-        m_result = *external.Data();
+const OcrWordIndex& MyRecognizedText::GetWordIndex() {
+    if (!m_wordIndex) {
+        if (m_page) {
+            m_wordIndex = std::make_unique<OcrWordIndex>(*m_page);
+        } else if (m_result.has_value()) {
+            m_wordIndex = std::make_unique<OcrWordIndex>(OcrPageFromRecognizedText(*m_result));
+        } else {
+            throw std::runtime_error("No result data available");
+        }
     }
+    return *m_wordIndex;
 }
 
-bool MyRecognizedLine::HasResult() const {
-    return m_result.has_value();
-}
-
-Napi::Value MyRecognizedLine::GetBoundingBox(const Napi::CallbackInfo& info) {
+Napi::Value MyRecognizedText::MyHitTest(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
+    if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "HitTest requires x and y numbers").ThrowAsJavaScriptException();
+        return env.Null();
+    }
     try {
-        if (!m_result.has_value()) {
-            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
-            return env.Null();
-        }
-        auto boundingBox = m_result->BoundingBox();
-        auto external = Napi::External<RecognizedTextBoundingBox>::New(env, &boundingBox);
-        return MyRecognizedTextBoundingBox::constructor.New({ external });
+        int64_t word = GetWordIndex().HitTest(info[0].As<Napi::Number>().FloatValue(), info[1].As<Napi::Number>().FloatValue());
+        return Napi::Number::New(env, static_cast<double>(word));
     } catch (const winrt::hresult_error& ex) {
-        std::string errorMsg = "WinRT error getting bounding box: " + winrt::to_string(ex.message());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        Napi::Error::New(env, "WinRT error in HitTest: " + winrt::to_string(ex.message())).ThrowAsJavaScriptException();
         return env.Null();
     } catch (const std::exception& ex) {
-        std::string errorMsg = "Error getting bounding box: " + std::string(ex.what());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
-        return env.Null();
-    } catch (...) {
-        Napi::Error::New(env, "Unknown error getting bounding box").ThrowAsJavaScriptException();
+        Napi::Error::New(env, "Error in HitTest: " + std::string(ex.what())).ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
-Napi::Value MyRecognizedLine::GetStyle(const Napi::CallbackInfo& info) {
+Napi::Value MyRecognizedText::MyQueryRect(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-    try {
-        if (!m_result.has_value()) {
-            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
-            return env.Null();
-        }
-        auto style = m_result->Style();
-        return Napi::Number::New(env, static_cast<int>(style));
-    } catch (const winrt::hresult_error& ex) {
-        std::string errorMsg = "WinRT error getting style: " + winrt::to_string(ex.message());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
-        return env.Null();
-    } catch (const std::exception& ex) {
-        std::string errorMsg = "Error getting style: " + std::string(ex.what());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "QueryRect requires a { x, y, width, height } rectangle").ThrowAsJavaScriptException();
         return env.Null();
-    } catch (...) {
-        Napi::Error::New(env, "Unknown error getting style").ThrowAsJavaScriptException();
+    }
+    auto rectObj = info[0].As<Napi::Object>();
+    if (!rectObj.Get("x").IsNumber() || !rectObj.Get("y").IsNumber() || !rectObj.Get("width").IsNumber() || !rectObj.Get("height").IsNumber()) {
+        Napi::TypeError::New(env, "QueryRect requires a { x, y, width, height } rectangle").ThrowAsJavaScriptException();
         return env.Null();
     }
-}
-
-Napi::Value MyRecognizedLine::GetLineStyleConfidence(const Napi::CallbackInfo& info) {
-    Napi::Env env = info.Env();
     try {
-        if (!m_result.has_value()) {
-            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
-            return env.Null();
+        OcrRect rect;
+        rect.x = rectObj.Get("x").As<Napi::Number>().FloatValue();
+        rect.y = rectObj.Get("y").As<Napi::Number>().FloatValue();
+        rect.width = rectObj.Get("width").As<Napi::Number>().FloatValue();
+        rect.height = rectObj.Get("height").As<Napi::Number>().FloatValue();
+        auto words = GetWordIndex().QueryRect(rect);
+        auto array = Napi::Array::New(env, words.size());
+        for (uint32_t i = 0; i < words.size(); i++) {
+            array.Set(i, Napi::Number::New(env, words[i]));
         }
-        auto confidence = m_result->LineStyleConfidence();
-        return Napi::Number::New(env, confidence);
+        return array;
     } catch (const winrt::hresult_error& ex) {
-        std::string errorMsg = "WinRT error getting line style confidence: " + winrt::to_string(ex.message());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        Napi::Error::New(env, "WinRT error in QueryRect: " + winrt::to_string(ex.message())).ThrowAsJavaScriptException();
         return env.Null();
     } catch (const std::exception& ex) {
-        std::string errorMsg = "Error getting line style confidence: " + std::string(ex.what());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
-        return env.Null();
-    } catch (...) {
-        Napi::Error::New(env, "Unknown error getting line style confidence").ThrowAsJavaScriptException();
+        Napi::Error::New(env, "Error in QueryRect: " + std::string(ex.what())).ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
-Napi::Value MyRecognizedLine::GetText(const Napi::CallbackInfo& info) {
+Napi::Value MyRecognizedText::MyNearest(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-    try {
-        if (!m_result.has_value()) {
-            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
-            return env.Null();
-        }
-        auto text = m_result->Text();
-        return Napi::String::New(env, winrt::to_string(text));
-    } catch (const winrt::hresult_error& ex) {
-        std::string errorMsg = "WinRT error getting text: " + winrt::to_string(ex.message());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
-        return env.Null();
-    } catch (const std::exception& ex) {
-        std::string errorMsg = "Error getting text: " + std::string(ex.what());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+    if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Nearest requires x and y numbers").ThrowAsJavaScriptException();
         return env.Null();
-    } catch (...) {
-        Napi::Error::New(env, "Unknown error getting text").ThrowAsJavaScriptException();
+    }
+    if (info.Length() > 2 && !info[2].IsUndefined() && (!info[2].IsNumber() || info[2].As<Napi::Number>().Int64Value() < 0)) {
+        Napi::TypeError::New(env, "k must be a non-negative number").ThrowAsJavaScriptException();
         return env.Null();
     }
-}
-
-Napi::Value MyRecognizedLine::GetWords(const Napi::CallbackInfo& info) {
-    Napi::Env env = info.Env();
     try {
-        if (!m_result.has_value()) {
-            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
-            return env.Null();
-        }
-        auto words = m_result->Words();
+        size_t k = info.Length() > 2 && info[2].IsNumber() ? static_cast<size_t>(info[2].As<Napi::Number>().Int64Value()) : 1;
+        auto words = GetWordIndex().Nearest(info[0].As<Napi::Number>().FloatValue(), info[1].As<Napi::Number>().FloatValue(), k);
         auto array = Napi::Array::New(env, words.size());
-        
         for (uint32_t i = 0; i < words.size(); i++) {
-            auto word = words[i];
-            auto external = Napi::External<RecognizedWord>::New(env, &word);
-            auto wordWrapper = MyRecognizedWord::constructor.New({ external });
-            array.Set(i, wordWrapper);
+            array.Set(i, Napi::Number::New(env, words[i]));
         }
-        
         return array;
     } catch (const winrt::hresult_error& ex) {
-        std::string errorMsg = "WinRT error getting words: " + winrt::to_string(ex.message());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        Napi::Error::New(env, "WinRT error in Nearest: " + winrt::to_string(ex.message())).ThrowAsJavaScriptException();
         return env.Null();
     } catch (const std::exception& ex) {
-        std::string errorMsg = "Error getting words: " + std::string(ex.what());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
-        return env.Null();
-    } catch (...) {
-        Napi::Error::New(env, "Unknown error getting words").ThrowAsJavaScriptException();
+        Napi::Error::New(env, "Error in Nearest: " + std::string(ex.what())).ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
-// MyRecognizedWord Implementation
-Napi::Object MyRecognizedWord::Init(Napi::Env env, Napi::Object exports) {
-    Napi::Function func = DefineClass(env, "RecognizedWord", {
-        InstanceAccessor("BoundingBox", &MyRecognizedWord::GetBoundingBox, nullptr),
-        InstanceAccessor("MatchConfidence", &MyRecognizedWord::GetConfidence, nullptr),
-        InstanceAccessor("Text", &MyRecognizedWord::GetText, nullptr)
+std::shared_ptr<const OcrPage> MyRecognizedText::GetPage() const {
+    if (m_page) {
+        return m_page;
+    }
+    if (m_result.has_value()) {
+        return std::make_shared<OcrPage>(OcrPageFromRecognizedText(*m_result));
+    }
+    return nullptr;
+}
+
+void MyRecognizedText::SetResult(const RecognizedText& result) {
+    m_result = result;
+    m_wordIndex.reset();
+}
+
+void MyRecognizedText::SetPage(std::shared_ptr<const OcrPage> page) {
+    m_wordIndex.reset();
+    m_page = std::move(page);
+}
+
+// MyIncrementalTextRecognizer Implementation
+Napi::Object MyIncrementalTextRecognizer::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "IncrementalTextRecognizer", {
+        InstanceMethod("RecognizeFrameAsync", &MyIncrementalTextRecognizer::MyRecognizeFrameAsync),
+        InstanceMethod("Reset", &MyIncrementalTextRecognizer::MyReset)
     });
 
     constructor = Napi::Persistent(func);
-    exports.Set("RecognizedWord", func);
+    exports.Set("IncrementalTextRecognizer", func);
     return exports;
 }
 
-MyRecognizedWord::MyRecognizedWord(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyRecognizedWord>(info) {
-    if (info.Length() == 1 && info[0].IsExternal()) {
-        auto external = info[0].As<Napi::External<RecognizedWord>>();
-        m_result = *external.Data();
+MyIncrementalTextRecognizer::MyIncrementalTextRecognizer(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyIncrementalTextRecognizer>(info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsObject() || !info[0].As<Napi::Object>().InstanceOf(MyTextRecognizer::constructor.Value())) {
+        Napi::TypeError::New(env, "IncrementalTextRecognizer requires a TextRecognizer instance").ThrowAsJavaScriptException();
+        return;
+    }
+    
+    // Keep the recognizer alive for the lifetime of the session
+    m_recognizerRef = Napi::Persistent(info[0].As<Napi::Object>());
+    m_state = std::make_shared<IncrementalOcrState>();
+    
+    if (info.Length() < 2 || info[1].IsUndefined()) {
+        return;
+    }
+    if (!info[1].IsObject()) {
+        Napi::TypeError::New(env, "Second parameter must be an options object { blockSize, tolerance, padding, fullFrameRatio }").ThrowAsJavaScriptException();
+        return;
+    }
+    
+    auto optionsObj = info[1].As<Napi::Object>();
+    auto readUint = [&optionsObj](const char* name, uint32_t& target) {
+        if (optionsObj.Has(name) && optionsObj.Get(name).IsNumber()) {
+            int64_t value = optionsObj.Get(name).As<Napi::Number>().Int64Value();
+            if (value >= 0) {
+                target = static_cast<uint32_t>(value);
+            }
+        }
+    };
+    readUint("blockSize", m_state->blockSize);
+    readUint("tolerance", m_state->tolerance);
+    readUint("padding", m_state->padding);
+    if (m_state->blockSize == 0) {
+        m_state->blockSize = 16;
+    }
+    if (optionsObj.Has("fullFrameRatio") && optionsObj.Get("fullFrameRatio").IsNumber()) {
+        m_state->fullFrameRatio = optionsObj.Get("fullFrameRatio").As<Napi::Number>().DoubleValue();
     }
 }
 
-bool MyRecognizedWord::HasResult() const {
-    return m_result.has_value();
-}
-
-Napi::Value MyRecognizedWord::GetBoundingBox(const Napi::CallbackInfo& info) {
+Napi::Value MyIncrementalTextRecognizer::MyRecognizeFrameAsync(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || (!info[0].IsString() && !info[0].IsObject())) {
+        Napi::TypeError::New(env, "RecognizeFrameAsync requires a file path or an object { width, height, buffer, stride? } of BGRA8 pixels").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    auto deferred = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "RecognizeFrameAsync", 0, 1);
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+
     try {
-        if (!m_result.has_value()) {
-            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
-            return env.Null();
+        auto recognizerWrapper = Napi::ObjectWrap<MyTextRecognizer>::Unwrap(m_recognizerRef.Value());
+        TextRecognizer* recognizer = recognizerWrapper ? recognizerWrapper->GetRecognizer() : nullptr;
+        if (!recognizer) {
+            throw std::runtime_error("The TextRecognizer of this session has been disposed");
         }
-        auto boundingBox = m_result->BoundingBox();
-        auto external = Napi::External<RecognizedTextBoundingBox>::New(env, &boundingBox);
-        return MyRecognizedTextBoundingBox::constructor.New({ external });
+        
+        winrt::hstring filePath;
+        std::vector<uint8_t> framePixels;
+        uint32_t frameWidth = 0;
+        uint32_t frameHeight = 0;
+        if (info[0].IsString()) {
+            filePath = winrt::to_hstring(info[0].As<Napi::String>().Utf8Value());
+        } else {
+            // Copy on the JS thread, the caller may reuse the buffer for the next capture
+            framePixels = ParseRawFrame(info[0], frameWidth, frameHeight);
+        }
+        
+        std::thread([deferred, tsfn, tsfn_guard, recognizer, state = m_state, filePath, framePixels = std::move(framePixels), frameWidth, frameHeight]() mutable {
+            try {
+                // Frames are diffed against each other, so a session processes one frame at a time
+                std::lock_guard<std::mutex> lock(state->mutex);
+                
+                if (!filePath.empty()) {
+                    auto softwareBitmap = LoadSoftwareBitmapFromFile(filePath);
+                    frameWidth = static_cast<uint32_t>(softwareBitmap.PixelWidth());
+                    frameHeight = static_cast<uint32_t>(softwareBitmap.PixelHeight());
+                    framePixels = CopySoftwareBitmapPixels(softwareBitmap);
+                }
+                uint32_t stride = frameWidth * 4;
+                
+                auto recognizeRegion = [&](uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+                    auto bitmap = CreateSoftwareBitmapFromBgra(framePixels.data() + static_cast<size_t>(y) * stride + static_cast<size_t>(x) * 4, width, height, stride);
+                    auto imageBuffer = Microsoft::Graphics::Imaging::ImageBuffer::CreateForSoftwareBitmap(bitmap);
+                    auto result = recognizer->RecognizeTextFromImageAsync(imageBuffer).get();
+                    return OcrPageFromRecognizedText(result, static_cast<float>(x), static_cast<float>(y));
+                };
+                
+                bool fullFrame = !state->hasPage || frameWidth != state->width || frameHeight != state->height;
+                std::vector<PixelRect> dirtyRegions;
+                
+                if (!fullFrame) {
+                    auto changed = FindChangedRegions(state->previousFrame.data(), framePixels.data(), frameWidth, frameHeight, stride, state->blockSize, state->tolerance);
+                    
+                    // Pad each change so glyphs cut by a tile edge get some context, then grow it to whole cached lines
+                    std::vector<OcrRect> regions;
+                    for (const auto& rect : changed) {
+                        float left = (std::max)(0.0f, static_cast<float>(rect.x) - state->padding);
+                        float top = (std::max)(0.0f, static_cast<float>(rect.y) - state->padding);
+                        float right = (std::min)(static_cast<float>(frameWidth), static_cast<float>(rect.x + rect.width + state->padding));
+                        float bottom = (std::min)(static_cast<float>(frameHeight), static_cast<float>(rect.y + rect.height + state->padding));
+                        regions.push_back({ left, top, right - left, bottom - top });
+                    }
+                    regions = ExpandToIntersectingLines(std::move(regions), state->page.lines);
+                    
+                    double dirtyArea = 0;
+                    for (const auto& region : regions) {
+                        PixelRect rect;
+                        rect.x = static_cast<uint32_t>((std::max)(0.0f, std::floor(region.x)));
+                        rect.y = static_cast<uint32_t>((std::max)(0.0f, std::floor(region.y)));
+                        uint32_t right = static_cast<uint32_t>((std::min)(static_cast<float>(frameWidth), std::ceil(region.Right())));
+                        uint32_t bottom = static_cast<uint32_t>((std::min)(static_cast<float>(frameHeight), std::ceil(region.Bottom())));
+                        if (right <= rect.x || bottom <= rect.y) {
+                            continue;
+                        }
+                        rect.width = right - rect.x;
+                        rect.height = bottom - rect.y;
+                        dirtyArea += static_cast<double>(rect.width) * rect.height;
+                        dirtyRegions.push_back(rect);
+                    }
+                    
+                    fullFrame = dirtyArea > state->fullFrameRatio * frameWidth * frameHeight;
+                    
+                    if (!fullFrame && !dirtyRegions.empty()) {
+                        std::vector<OcrLine> replacement;
+                        std::vector<OcrRect> replacedRegions;
+                        for (const auto& rect : dirtyRegions) {
+                            auto regionPage = recognizeRegion(rect.x, rect.y, rect.width, rect.height);
+                            for (auto& line : regionPage.lines) {
+                                replacement.push_back(std::move(line));
+                            }
+                            replacedRegions.push_back({ static_cast<float>(rect.x), static_cast<float>(rect.y), static_cast<float>(rect.width), static_cast<float>(rect.height) });
+                        }
+                        SpliceLines(state->page, replacedRegions, std::move(replacement));
+                    }
+                }
+                
+                if (fullFrame) {
+                    state->page = recognizeRegion(0, 0, frameWidth, frameHeight);
+                    dirtyRegions.assign(1, PixelRect{ 0, 0, frameWidth, frameHeight });
+                }
+                
+                state->previousFrame = std::move(framePixels);
+                state->width = frameWidth;
+                state->height = frameHeight;
+                state->hasPage = true;
+                auto page = std::make_shared<const OcrPage>(state->page);
+                
+                tsfn.BlockingCall([deferred, page, dirtyRegions, fullFrame](Napi::Env env, Napi::Function) {
+                    auto textObj = MyRecognizedText::constructor.New({});
+                    auto textInstance = Napi::ObjectWrap<MyRecognizedText>::Unwrap(textObj);
+                    textInstance->SetPage(page);
+                    
+                    auto regionsArray = Napi::Array::New(env, dirtyRegions.size());
+                    for (uint32_t i = 0; i < dirtyRegions.size(); i++) {
+                        auto regionObj = Napi::Object::New(env);
+                        regionObj.Set("x", Napi::Number::New(env, dirtyRegions[i].x));
+                        regionObj.Set("y", Napi::Number::New(env, dirtyRegions[i].y));
+                        regionObj.Set("width", Napi::Number::New(env, dirtyRegions[i].width));
+                        regionObj.Set("height", Napi::Number::New(env, dirtyRegions[i].height));
+                        regionsArray.Set(i, regionObj);
+                    }
+                    
+                    auto resultObj = Napi::Object::New(env);
+                    resultObj.Set("text", textObj);
+                    resultObj.Set("dirtyRegions", regionsArray);
+                    resultObj.Set("fullFrame", Napi::Boolean::New(env, fullFrame));
+                    deferred.Resolve(resultObj);
+                });
+                
+            } catch (const winrt::hresult_error& ex) {
+                tsfn.BlockingCall([deferred, message = winrt::to_string(ex.message())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (const std::exception& ex) {
+                tsfn.BlockingCall([deferred, message = std::string(ex.what())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (...) {
+                tsfn.BlockingCall([deferred](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, "Unknown error occurred in RecognizeFrameAsync").Value());
+                });
+            }
+        }).detach();
+        
+        return deferred.Promise();
+        
     } catch (const winrt::hresult_error& ex) {
-        std::string errorMsg = "WinRT error getting bounding box: " + winrt::to_string(ex.message());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
-        return env.Null();
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return deferred.Promise();
     } catch (const std::exception& ex) {
-        std::string errorMsg = "Error getting bounding box: " + std::string(ex.what());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
-        return env.Null();
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return deferred.Promise();
     } catch (...) {
-        Napi::Error::New(env, "Unknown error getting bounding box").ThrowAsJavaScriptException();
-        return env.Null();
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in RecognizeFrameAsync").Value());
+        return deferred.Promise();
     }
 }
 
-Napi::Value MyRecognizedWord::GetConfidence(const Napi::CallbackInfo& info) {
+Napi::Value MyIncrementalTextRecognizer::MyReset(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->previousFrame.clear();
+    m_state->page = OcrPage();
+    m_state->width = 0;
+    m_state->height = 0;
+    m_state->hasPage = false;
+    return env.Undefined();
+}
+
+// MyTextSearchIndex Implementation
+Napi::Object MyTextSearchIndex::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "TextSearchIndex", {
+        InstanceMethod("Add", &MyTextSearchIndex::MyAdd),
+        InstanceMethod("FlushAsync", &MyTextSearchIndex::MyFlushAsync),
+        InstanceMethod("SearchAsync", &MyTextSearchIndex::MySearchAsync),
+        InstanceMethod("GetStats", &MyTextSearchIndex::MyGetStats),
+        InstanceMethod("Close", &MyTextSearchIndex::MyClose)
+    });
+
+    constructor = Napi::Persistent(func);
+    exports.Set("TextSearchIndex", func);
+    return exports;
+}
+
+MyTextSearchIndex::MyTextSearchIndex(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyTextSearchIndex>(info) {
     Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "TextSearchIndex requires a directory path").ThrowAsJavaScriptException();
+        return;
+    }
+    if (info.Length() > 1 && !info[1].IsUndefined() && !info[1].IsObject()) {
+        Napi::TypeError::New(env, "Second parameter must be an options object { flushDocuments, maxSegments }").ThrowAsJavaScriptException();
+        return;
+    }
+    
+    TextIndexOptions options;
+    if (info.Length() > 1 && info[1].IsObject()) {
+        auto optionsObj = info[1].As<Napi::Object>();
+        auto readUint = [&optionsObj](const char* name, uint32_t& target) {
+            if (optionsObj.Has(name) && optionsObj.Get(name).IsNumber()) {
+                int64_t value = optionsObj.Get(name).As<Napi::Number>().Int64Value();
+                if (value > 0) {
+                    target = static_cast<uint32_t>((std::min)(value, static_cast<int64_t>(UINT32_MAX)));
+                }
+            }
+        };
+        readUint("flushDocuments", options.flushDocuments);
+        readUint("maxSegments", options.maxSegments);
+    }
+    
     try {
-        if (!m_result.has_value()) {
-            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
-            return env.Null();
-        }
-        
-        // Get the actual MatchConfidence property from the Windows AI API
-        auto confidence = m_result->MatchConfidence();
-        return Napi::Number::New(env, confidence);
-    } catch (const winrt::hresult_error& ex) {
-        std::string errorMsg = "WinRT error getting match confidence: " + winrt::to_string(ex.message());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
-        return env.Null();
+        std::string directory = info[0].As<Napi::String>().Utf8Value();
+        m_index = std::make_shared<TextIndex>(std::filesystem::u8path(directory), options);
     } catch (const std::exception& ex) {
-        std::string errorMsg = "Error getting match confidence: " + std::string(ex.what());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
-        return env.Null();
-    } catch (...) {
-        Napi::Error::New(env, "Unknown error getting match confidence").ThrowAsJavaScriptException();
-        return env.Null();
+        Napi::Error::New(env, ex.what()).ThrowAsJavaScriptException();
     }
 }
 
-Napi::Value MyRecognizedWord::GetText(const Napi::CallbackInfo& info) {
+Napi::Value MyTextSearchIndex::MyAdd(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
+    
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsObject() || !info[1].As<Napi::Object>().InstanceOf(MyRecognizedText::constructor.Value())) {
+        Napi::TypeError::New(env, "Add requires an image id string and a RecognizedText").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    
     try {
-        if (!m_result.has_value()) {
-            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
-            return env.Null();
+        auto textInstance = Napi::ObjectWrap<MyRecognizedText>::Unwrap(info[1].As<Napi::Object>());
+        auto page = textInstance->GetPage();
+        if (!page) {
+            Napi::Error::New(env, "RecognizedText has no result data").ThrowAsJavaScriptException();
+            return env.Undefined();
         }
-        auto text = m_result->Text();
-        return Napi::String::New(env, winrt::to_string(text));
+        m_index->Add(info[0].As<Napi::String>().Utf8Value(), *page);
     } catch (const winrt::hresult_error& ex) {
-        std::string errorMsg = "WinRT error getting text: " + winrt::to_string(ex.message());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
-        return env.Null();
+        Napi::Error::New(env, winrt::to_string(ex.message())).ThrowAsJavaScriptException();
     } catch (const std::exception& ex) {
-        std::string errorMsg = "Error getting text: " + std::string(ex.what());
-        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
-        return env.Null();
-    } catch (...) {
-        Napi::Error::New(env, "Unknown error getting text").ThrowAsJavaScriptException();
+        Napi::Error::New(env, ex.what()).ThrowAsJavaScriptException();
+    }
+    return env.Undefined();
+}
+
+Napi::Value MyTextSearchIndex::MyFlushAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto deferred = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "FlushAsync", 0, 1);
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    
+    std::thread([deferred, tsfn, tsfn_guard, index = m_index]() {
+        try {
+            index->Flush();
+            tsfn.BlockingCall([deferred](Napi::Env env, Napi::Function) {
+                deferred.Resolve(env.Undefined());
+            });
+        } catch (const std::exception& ex) {
+            tsfn.BlockingCall([deferred, message = std::string(ex.what())](Napi::Env env, Napi::Function) {
+                deferred.Reject(Napi::Error::New(env, message).Value());
+            });
+        } catch (...) {
+            tsfn.BlockingCall([deferred](Napi::Env env, Napi::Function) {
+                deferred.Reject(Napi::Error::New(env, "Unknown error occurred in FlushAsync").Value());
+            });
+        }
+    }).detach();
+    
+    return deferred.Promise();
+}
+
+Napi::Value MyTextSearchIndex::MySearchAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "SearchAsync requires a query string").ThrowAsJavaScriptException();
         return env.Null();
     }
+    
+    size_t limit = 100;
+    if (info.Length() > 1 && info[1].IsObject()) {
+        auto optionsObj = info[1].As<Napi::Object>();
+        if (optionsObj.Has("limit") && optionsObj.Get("limit").IsNumber()) {
+            int64_t value = optionsObj.Get("limit").As<Napi::Number>().Int64Value();
+            limit = value > 0 ? static_cast<size_t>(value) : 0;
+        }
+    }
+    
+    auto deferred = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "SearchAsync", 0, 1);
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    
+    std::thread([deferred, tsfn, tsfn_guard, index = m_index, query = info[0].As<Napi::String>().Utf8Value(), limit]() {
+        try {
+            auto hits = std::make_shared<std::vector<TextIndexHit>>(index->Search(ParseTextIndexQuery(query), limit));
+            tsfn.BlockingCall([deferred, hits](Napi::Env env, Napi::Function) {
+                auto resultsArray = Napi::Array::New(env, hits->size());
+                for (uint32_t i = 0; i < hits->size(); i++) {
+                    const auto& hit = (*hits)[i];
+                    auto hitObj = Napi::Object::New(env);
+                    hitObj.Set("imageId", Napi::String::New(env, hit.imageId));
+                    auto boxesArray = Napi::Array::New(env, hit.boxes.size());
+                    for (uint32_t j = 0; j < hit.boxes.size(); j++) {
+                        boxesArray.Set(j, OcrQuadToFlatJs(env, hit.boxes[j]));
+                    }
+                    hitObj.Set("boxes", boxesArray);
+                    resultsArray.Set(i, hitObj);
+                }
+                deferred.Resolve(resultsArray);
+            });
+        } catch (const std::exception& ex) {
+            tsfn.BlockingCall([deferred, message = std::string(ex.what())](Napi::Env env, Napi::Function) {
+                deferred.Reject(Napi::Error::New(env, message).Value());
+            });
+        } catch (...) {
+            tsfn.BlockingCall([deferred](Napi::Env env, Napi::Function) {
+                deferred.Reject(Napi::Error::New(env, "Unknown error occurred in SearchAsync").Value());
+            });
+        }
+    }).detach();
+    
+    return deferred.Promise();
 }
 
-// MyRecognizedTextBoundingBox Implementation
-Napi::Object MyRecognizedTextBoundingBox::Init(Napi::Env env, Napi::Object exports) {
-    Napi::Function func = DefineClass(env, "RecognizedTextBoundingBox", {
-        InstanceAccessor("TopLeft", &MyRecognizedTextBoundingBox::GetTopLeft, nullptr),
-        InstanceAccessor("TopRight", &MyRecognizedTextBoundingBox::GetTopRight, nullptr),
-        InstanceAccessor("BottomLeft", &MyRecognizedTextBoundingBox::GetBottomLeft, nullptr),
-        InstanceAccessor("BottomRight", &MyRecognizedTextBoundingBox::GetBottomRight, nullptr)
+Napi::Value MyTextSearchIndex::MyGetStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto stats = m_index->GetStats();
+    auto statsObj = Napi::Object::New(env);
+    statsObj.Set("segments", Napi::Number::New(env, static_cast<double>(stats.segments)));
+    statsObj.Set("documents", Napi::Number::New(env, static_cast<double>(stats.documents)));
+    statsObj.Set("pendingDocuments", Napi::Number::New(env, static_cast<double>(stats.pendingDocuments)));
+    statsObj.Set("bytes", Napi::Number::New(env, static_cast<double>(stats.bytes)));
+    statsObj.Set("flushes", Napi::Number::New(env, static_cast<double>(stats.flushes)));
+    statsObj.Set("merges", Napi::Number::New(env, static_cast<double>(stats.merges)));
+    statsObj.Set("lastError", stats.lastError.empty() ? env.Null() : Napi::String::New(env, stats.lastError));
+    return statsObj;
+}
+
+Napi::Value MyTextSearchIndex::MyClose(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    try {
+        m_index->Close();
+    } catch (const std::exception& ex) {
+        Napi::Error::New(env, ex.what()).ThrowAsJavaScriptException();
+    }
+    return env.Undefined();
+}
+
+// MyRecognizedLine Implementation
+Napi::Object MyRecognizedLine::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "RecognizedLine", {
+        InstanceAccessor("BoundingBox", &MyRecognizedLine::GetBoundingBox, nullptr),
+        InstanceAccessor("Style", &MyRecognizedLine::GetStyle, nullptr),
+        InstanceAccessor("LineStyleConfidence", &MyRecognizedLine::GetLineStyleConfidence, nullptr),
+        InstanceAccessor("Text", &MyRecognizedLine::GetText, nullptr),
+        InstanceAccessor("Words", &MyRecognizedLine::GetWords, nullptr)
     });
 
     constructor = Napi::Persistent(func);
-    exports.Set("RecognizedTextBoundingBox", func);
+    exports.Set("RecognizedLine", func);
     return exports;
 }
 
-MyRecognizedTextBoundingBox::MyRecognizedTextBoundingBox(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyRecognizedTextBoundingBox>(info) {
+MyRecognizedLine::MyRecognizedLine(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyRecognizedLine>(info) {
     if (info.Length() == 1 && info[0].IsExternal()) {
-        auto external = info[0].As<Napi::External<RecognizedTextBoundingBox>>();
+        auto external = info[0].As<Napi::External<RecognizedLine>>();
         m_result = *external.Data();
     }
 }
 
-bool MyRecognizedTextBoundingBox::HasResult() const {
-    return m_result.has_value();
+bool MyRecognizedLine::HasResult() const {
+    return m_result.has_value() || m_line.has_value();
 }
 
-Napi::Value MyRecognizedTextBoundingBox::GetTopLeft(const Napi::CallbackInfo& info) {
+void MyRecognizedLine::SetLine(const OcrLine& line) {
+    m_line = line;
+}
+
+Napi::Value MyRecognizedLine::GetBoundingBox(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     try {
+        if (m_line) {
+            auto boxWrapper = MyRecognizedTextBoundingBox::constructor.New({});
+            Napi::ObjectWrap<MyRecognizedTextBoundingBox>::Unwrap(boxWrapper)->SetQuad(m_line->box);
+            return boxWrapper;
+        }
         if (!m_result.has_value()) {
             Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
             return env.Null();
         }
-        
-        auto topLeft = m_result->TopLeft;
-        auto pointObj = Napi::Object::New(env);
-        pointObj.Set("X", Napi::Number::New(env, topLeft.X));
-        pointObj.Set("Y", Napi::Number::New(env, topLeft.Y));
-        return pointObj;
+        auto boundingBox = m_result->BoundingBox();
+        auto external = Napi::External<RecognizedTextBoundingBox>::New(env, &boundingBox);
+        return MyRecognizedTextBoundingBox::constructor.New({ external });
     } catch (const winrt::hresult_error& ex) {
-        std::string errorMsg = "WinRT error getting TopLeft: " + winrt::to_string(ex.message());
+        std::string errorMsg = "WinRT error getting bounding box: " + winrt::to_string(ex.message());
         Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
         return env.Null();
     } catch (const std::exception& ex) {
-        std::string errorMsg = "Error getting TopLeft: " + std::string(ex.what());
+        std::string errorMsg = "Error getting bounding box: " + std::string(ex.what());
         Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
         return env.Null();
     } catch (...) {
-        Napi::Error::New(env, "Unknown error getting TopLeft").ThrowAsJavaScriptException();
+        Napi::Error::New(env, "Unknown error getting bounding box").ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
-Napi::Value MyRecognizedTextBoundingBox::GetTopRight(const Napi::CallbackInfo& info) {
+Napi::Value MyRecognizedLine::GetStyle(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     try {
+        if (m_line) {
+            return Napi::Number::New(env, m_line->style);
+        }
         if (!m_result.has_value()) {
             Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
             return env.Null();
         }
-        
-        auto topRight = m_result->TopRight;
-        auto pointObj = Napi::Object::New(env);
-        pointObj.Set("X", Napi::Number::New(env, topRight.X));
-        pointObj.Set("Y", Napi::Number::New(env, topRight.Y));
-        return pointObj;
+        auto style = m_result->Style();
+        return Napi::Number::New(env, static_cast<int>(style));
     } catch (const winrt::hresult_error& ex) {
-        std::string errorMsg = "WinRT error getting TopRight: " + winrt::to_string(ex.message());
+        std::string errorMsg = "WinRT error getting style: " + winrt::to_string(ex.message());
         Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
         return env.Null();
     } catch (const std::exception& ex) {
-        std::string errorMsg = "Error getting TopRight: " + std::string(ex.what());
+        std::string errorMsg = "Error getting style: " + std::string(ex.what());
         Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
         return env.Null();
     } catch (...) {
-        Napi::Error::New(env, "Unknown error getting TopRight").ThrowAsJavaScriptException();
+        Napi::Error::New(env, "Unknown error getting style").ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
-Napi::Value MyRecognizedTextBoundingBox::GetBottomLeft(const Napi::CallbackInfo& info) {
+Napi::Value MyRecognizedLine::GetLineStyleConfidence(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     try {
+        if (m_line) {
+            return Napi::Number::New(env, m_line->styleConfidence);
+        }
         if (!m_result.has_value()) {
             Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
             return env.Null();
         }
-        
-        auto bottomLeft = m_result->BottomLeft;
-        auto pointObj = Napi::Object::New(env);
-        pointObj.Set("X", Napi::Number::New(env, bottomLeft.X));
-        pointObj.Set("Y", Napi::Number::New(env, bottomLeft.Y));
-        return pointObj;
+        auto confidence = m_result->LineStyleConfidence();
+        return Napi::Number::New(env, confidence);
     } catch (const winrt::hresult_error& ex) {
-        std::string errorMsg = "WinRT error getting BottomLeft: " + winrt::to_string(ex.message());
+        std::string errorMsg = "WinRT error getting line style confidence: " + winrt::to_string(ex.message());
         Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
         return env.Null();
     } catch (const std::exception& ex) {
-        std::string errorMsg = "Error getting BottomLeft: " + std::string(ex.what());
+        std::string errorMsg = "Error getting line style confidence: " + std::string(ex.what());
         Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
         return env.Null();
     } catch (...) {
-        Napi::Error::New(env, "Unknown error getting BottomLeft").ThrowAsJavaScriptException();
+        Napi::Error::New(env, "Unknown error getting line style confidence").ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
-Napi::Value MyRecognizedTextBoundingBox::GetBottomRight(const Napi::CallbackInfo& info) {
+Napi::Value MyRecognizedLine::GetText(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     try {
+        if (m_line) {
+            return Napi::String::New(env, m_line->text);
+        }
         if (!m_result.has_value()) {
             Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
             return env.Null();
         }
-        
-        auto bottomRight = m_result->BottomRight;
-        auto pointObj = Napi::Object::New(env);
-        pointObj.Set("X", Napi::Number::New(env, bottomRight.X));
-        pointObj.Set("Y", Napi::Number::New(env, bottomRight.Y));
-        return pointObj;
+        auto text = m_result->Text();
+        return Napi::String::New(env, winrt::to_string(text));
     } catch (const winrt::hresult_error& ex) {
-        std::string errorMsg = "WinRT error getting BottomRight: " + winrt::to_string(ex.message());
+        std::string errorMsg = "WinRT error getting text: " + winrt::to_string(ex.message());
         Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
         return env.Null();
     } catch (const std::exception& ex) {
-        std::string errorMsg = "Error getting BottomRight: " + std::string(ex.what());
+        std::string errorMsg = "Error getting text: " + std::string(ex.what());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (...) {
+        Napi::Error::New(env, "Unknown error getting text").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+Napi::Value MyRecognizedLine::GetWords(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    try {
+        if (m_line) {
+            auto array = Napi::Array::New(env, m_line->words.size());
+            for (uint32_t i = 0; i < m_line->words.size(); i++) {
+                auto wordWrapper = MyRecognizedWord::constructor.New({});
+                Napi::ObjectWrap<MyRecognizedWord>::Unwrap(wordWrapper)->SetWord(m_line->words[i]);
+                array.Set(i, wordWrapper);
+            }
+            return array;
+        }
+        if (!m_result.has_value()) {
+            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        auto words = m_result->Words();
+        auto array = Napi::Array::New(env, words.size());
+        
+        for (uint32_t i = 0; i < words.size(); i++) {
+            auto word = words[i];
+            auto external = Napi::External<RecognizedWord>::New(env, &word);
+            auto wordWrapper = MyRecognizedWord::constructor.New({ external });
+            array.Set(i, wordWrapper);
+        }
+        
+        return array;
+    } catch (const winrt::hresult_error& ex) {
+        std::string errorMsg = "WinRT error getting words: " + winrt::to_string(ex.message());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (const std::exception& ex) {
+        std::string errorMsg = "Error getting words: " + std::string(ex.what());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (...) {
+        Napi::Error::New(env, "Unknown error getting words").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+// MyRecognizedWord Implementation
+Napi::Object MyRecognizedWord::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "RecognizedWord", {
+        InstanceAccessor("BoundingBox", &MyRecognizedWord::GetBoundingBox, nullptr),
+        InstanceAccessor("MatchConfidence", &MyRecognizedWord::GetConfidence, nullptr),
+        InstanceAccessor("Text", &MyRecognizedWord::GetText, nullptr)
+    });
+
+    constructor = Napi::Persistent(func);
+    exports.Set("RecognizedWord", func);
+    return exports;
+}
+
+MyRecognizedWord::MyRecognizedWord(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyRecognizedWord>(info) {
+    if (info.Length() == 1 && info[0].IsExternal()) {
+        auto external = info[0].As<Napi::External<RecognizedWord>>();
+        m_result = *external.Data();
+    }
+}
+
+bool MyRecognizedWord::HasResult() const {
+    return m_result.has_value() || m_word.has_value();
+}
+
+void MyRecognizedWord::SetWord(const OcrWord& word) {
+    m_word = word;
+}
+
+Napi::Value MyRecognizedWord::GetBoundingBox(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    try {
+        if (m_word) {
+            auto boxWrapper = MyRecognizedTextBoundingBox::constructor.New({});
+            Napi::ObjectWrap<MyRecognizedTextBoundingBox>::Unwrap(boxWrapper)->SetQuad(m_word->box);
+            return boxWrapper;
+        }
+        if (!m_result.has_value()) {
+            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        auto boundingBox = m_result->BoundingBox();
+        auto external = Napi::External<RecognizedTextBoundingBox>::New(env, &boundingBox);
+        return MyRecognizedTextBoundingBox::constructor.New({ external });
+    } catch (const winrt::hresult_error& ex) {
+        std::string errorMsg = "WinRT error getting bounding box: " + winrt::to_string(ex.message());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (const std::exception& ex) {
+        std::string errorMsg = "Error getting bounding box: " + std::string(ex.what());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (...) {
+        Napi::Error::New(env, "Unknown error getting bounding box").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+Napi::Value MyRecognizedWord::GetConfidence(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    try {
+        if (m_word) {
+            return Napi::Number::New(env, m_word->confidence);
+        }
+        if (!m_result.has_value()) {
+            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        // Get the actual MatchConfidence property from the Windows AI API
+        auto confidence = m_result->MatchConfidence();
+        return Napi::Number::New(env, confidence);
+    } catch (const winrt::hresult_error& ex) {
+        std::string errorMsg = "WinRT error getting match confidence: " + winrt::to_string(ex.message());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (const std::exception& ex) {
+        std::string errorMsg = "Error getting match confidence: " + std::string(ex.what());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (...) {
+        Napi::Error::New(env, "Unknown error getting match confidence").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+Napi::Value MyRecognizedWord::GetText(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    try {
+        if (m_word) {
+            return Napi::String::New(env, m_word->text);
+        }
+        if (!m_result.has_value()) {
+            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        auto text = m_result->Text();
+        return Napi::String::New(env, winrt::to_string(text));
+    } catch (const winrt::hresult_error& ex) {
+        std::string errorMsg = "WinRT error getting text: " + winrt::to_string(ex.message());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (const std::exception& ex) {
+        std::string errorMsg = "Error getting text: " + std::string(ex.what());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (...) {
+        Napi::Error::New(env, "Unknown error getting text").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+// MyRecognizedTextBoundingBox Implementation
+Napi::Object MyRecognizedTextBoundingBox::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "RecognizedTextBoundingBox", {
+        InstanceAccessor("TopLeft", &MyRecognizedTextBoundingBox::GetTopLeft, nullptr),
+        InstanceAccessor("TopRight", &MyRecognizedTextBoundingBox::GetTopRight, nullptr),
+        InstanceAccessor("BottomLeft", &MyRecognizedTextBoundingBox::GetBottomLeft, nullptr),
+        InstanceAccessor("BottomRight", &MyRecognizedTextBoundingBox::GetBottomRight, nullptr)
+    });
+
+    constructor = Napi::Persistent(func);
+    exports.Set("RecognizedTextBoundingBox", func);
+    return exports;
+}
+
+MyRecognizedTextBoundingBox::MyRecognizedTextBoundingBox(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyRecognizedTextBoundingBox>(info) {
+    if (info.Length() == 1 && info[0].IsExternal()) {
+        auto external = info[0].As<Napi::External<RecognizedTextBoundingBox>>();
+        m_result = *external.Data();
+    }
+}
+
+bool MyRecognizedTextBoundingBox::HasResult() const {
+    return m_result.has_value() || m_quad.has_value();
+}
+
+void MyRecognizedTextBoundingBox::SetQuad(const OcrQuad& quad) {
+    m_quad = quad;
+}
+
+Napi::Value MyRecognizedTextBoundingBox::GetTopLeft(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    try {
+        if (m_quad) {
+            return OcrPointToJs(env, m_quad->topLeft);
+        }
+        if (!m_result.has_value()) {
+            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        auto topLeft = m_result->TopLeft;
+        auto pointObj = Napi::Object::New(env);
+        pointObj.Set("X", Napi::Number::New(env, topLeft.X));
+        pointObj.Set("Y", Napi::Number::New(env, topLeft.Y));
+        return pointObj;
+    } catch (const winrt::hresult_error& ex) {
+        std::string errorMsg = "WinRT error getting TopLeft: " + winrt::to_string(ex.message());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (const std::exception& ex) {
+        std::string errorMsg = "Error getting TopLeft: " + std::string(ex.what());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (...) {
+        Napi::Error::New(env, "Unknown error getting TopLeft").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+Napi::Value MyRecognizedTextBoundingBox::GetTopRight(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    try {
+        if (m_quad) {
+            return OcrPointToJs(env, m_quad->topRight);
+        }
+        if (!m_result.has_value()) {
+            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        auto topRight = m_result->TopRight;
+        auto pointObj = Napi::Object::New(env);
+        pointObj.Set("X", Napi::Number::New(env, topRight.X));
+        pointObj.Set("Y", Napi::Number::New(env, topRight.Y));
+        return pointObj;
+    } catch (const winrt::hresult_error& ex) {
+        std::string errorMsg = "WinRT error getting TopRight: " + winrt::to_string(ex.message());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (const std::exception& ex) {
+        std::string errorMsg = "Error getting TopRight: " + std::string(ex.what());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (...) {
+        Napi::Error::New(env, "Unknown error getting TopRight").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+Napi::Value MyRecognizedTextBoundingBox::GetBottomLeft(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    try {
+        if (m_quad) {
+            return OcrPointToJs(env, m_quad->bottomLeft);
+        }
+        if (!m_result.has_value()) {
+            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        auto bottomLeft = m_result->BottomLeft;
+        auto pointObj = Napi::Object::New(env);
+        pointObj.Set("X", Napi::Number::New(env, bottomLeft.X));
+        pointObj.Set("Y", Napi::Number::New(env, bottomLeft.Y));
+        return pointObj;
+    } catch (const winrt::hresult_error& ex) {
+        std::string errorMsg = "WinRT error getting BottomLeft: " + winrt::to_string(ex.message());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (const std::exception& ex) {
+        std::string errorMsg = "Error getting BottomLeft: " + std::string(ex.what());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (...) {
+        Napi::Error::New(env, "Unknown error getting BottomLeft").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+Napi::Value MyRecognizedTextBoundingBox::GetBottomRight(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    try {
+        if (m_quad) {
+            return OcrPointToJs(env, m_quad->bottomRight);
+        }
+        if (!m_result.has_value()) {
+            Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        
+        auto bottomRight = m_result->BottomRight;
+        auto pointObj = Napi::Object::New(env);
+        pointObj.Set("X", Napi::Number::New(env, bottomRight.X));
+        pointObj.Set("Y", Napi::Number::New(env, bottomRight.Y));
+        return pointObj;
+    } catch (const winrt::hresult_error& ex) {
+        std::string errorMsg = "WinRT error getting BottomRight: " + winrt::to_string(ex.message());
+        Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (const std::exception& ex) {
+        std::string errorMsg = "Error getting BottomRight: " + std::string(ex.what());
         Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
         return env.Null();
     } catch (...) {
@@ -1204,6 +2081,8 @@ Napi::Object MyImageObjectRemover::Init(Napi::Env env, Napi::Object exports) {
         StaticMethod("GetReadyState", &MyImageObjectRemover::MyGetReadyState),
         StaticMethod("EnsureReadyAsync", &MyImageObjectRemover::MyEnsureReadyAsync)
     });
+
+    constructor = Napi::Persistent(func);
     exports.Set("ImageObjectRemover", func);
     return exports;
 }
@@ -1216,6 +2095,8 @@ Napi::Object MyImageScaler::Init(Napi::Env env, Napi::Object exports) {
         StaticMethod("GetReadyState", &MyImageScaler::MyGetReadyState),
         StaticMethod("EnsureReadyAsync", &MyImageScaler::MyEnsureReadyAsync)
     });
+
+    constructor = Napi::Persistent(func);
     exports.Set("ImageScaler", func);
     return exports;
 }
@@ -1309,29 +2190,247 @@ void MyImageObjectExtractorHint::SetHeight(const Napi::CallbackInfo& info, const
     // Placeholder setter
 }
 
-// MyImageObjectRemover placeholder methods
+
+// MyImageObjectRemover Implementation
 MyImageObjectRemover::MyImageObjectRemover(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyImageObjectRemover>(info) {
     if (info.Length() == 0 || !info[0].IsExternal()) {
         Napi::Error::New(info.Env(), "Cannot instantiate ImageObjectRemover directly. Use ImageObjectRemover.CreateAsync()").ThrowAsJavaScriptException();
         return;
     }
-    
-    auto external = info[0].As<Napi::External<ImageObjectRemover>>();
-    m_remover = external.Data();
+    
+    auto external = info[0].As<Napi::External<ImageObjectRemover>>();
+    m_remover = external.Data();
+}
+
+Napi::Value MyImageObjectRemover::MyCreateAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto deferred = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(
+        env,
+        Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+        "CreateAsync",
+        0,
+        1 
+    );
+
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    
+    try {
+        auto asyncOp = ImageObjectRemover::CreateAsync();
+        
+        auto completionHandler = [deferred, tsfn, tsfn_guard](auto const& sender, auto const& status) mutable {
+            auto callback = [deferred, sender, status](Napi::Env env, Napi::Function) {
+                try {
+                    if (status == winrt::Windows::Foundation::AsyncStatus::Completed) {
+                        auto remover = sender.GetResults();
+                        if (!remover) {
+                            deferred.Reject(Napi::Error::New(env, "Failed to create ImageObjectRemover instance.").Value());
+                            return;
+                        }
+                        
+                        auto persistentRemover = std::make_shared<ImageObjectRemover>(std::move(remover));
+                        auto external = Napi::External<ImageObjectRemover>::New(env, 
+                            persistentRemover.get(),
+                            [persistentRemover](Napi::Env env, ImageObjectRemover* data) {
+                                // persistentRemover will be destroyed here, releasing the WinRT object
+                            });
+
+                        auto instance = MyImageObjectRemover::constructor.New({ external });
+                        deferred.Resolve(instance);
+                    } else {
+                        deferred.Reject(Napi::Error::New(env, "ImageObjectRemover creation was cancelled or failed.").Value());
+                    }
+                } catch (const winrt::hresult_error& ex) {
+                    deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+                } catch (const std::exception& ex) {
+                    deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+                } catch (...) {
+                    deferred.Reject(Napi::Error::New(env, "Unknown error occurred in CreateAsync").Value());
+                }
+            };
+            
+            tsfn.BlockingCall(callback);
+        };      
+        asyncOp.Completed(completionHandler);
+        return deferred.Promise();
+        
+    } catch (const winrt::hresult_error& ex) {
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return deferred.Promise();
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return deferred.Promise();
+    } catch (...) {
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in CreateAsync").Value());
+        return deferred.Promise();
+    }
+}
+
+Napi::Value MyImageObjectRemover::MyGetReadyState(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    try {
+        auto readyState = ImageObjectRemover::GetReadyState();
+        return Napi::Number::New(env, static_cast<int>(readyState));
+    } catch (const winrt::hresult_error& ex) {
+        Napi::Error::New(env, winrt::to_string(ex.message())).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (const std::exception& ex) {
+        Napi::Error::New(env, ex.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (...) {
+        Napi::Error::New(env, "Unknown error occurred in GetReadyState").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+Napi::Value MyImageObjectRemover::MyEnsureReadyAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto deferred = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(
+        env,
+        Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+        "EnsureReadyAsync",
+        0,
+        1 
+    );
+
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    auto progressPromise = ProgressPromise::Create(env, deferred);
+    auto progressTsfn = progressPromise.GetProgressTsfn();
+    
+    try {
+        auto asyncOp = ImageObjectRemover::EnsureReadyAsync();
+        
+        asyncOp.Progress([progressTsfn](auto const&, auto const& progressValue) {
+            if (progressTsfn && *progressTsfn) {
+                (*progressTsfn)->NonBlockingCall([progressValue](Napi::Env env, Napi::Function jsCallback) {
+                    try {
+                        jsCallback.Call({ env.Null(), Napi::Number::New(env, progressValue) });
+                    } catch (...) {}
+                });
+            }
+        });
+        
+        auto completionHandler = [deferred, tsfn, tsfn_guard](auto const& sender, auto const& status) mutable {
+            auto callback = [deferred, sender, status](Napi::Env env, Napi::Function) {
+                try {
+                    if (status == winrt::Windows::Foundation::AsyncStatus::Completed) {
+                        auto result = sender.GetResults();
+                        auto external = Napi::External<AIFeatureReadyResult>::New(env, &result);
+                        auto resultWrapper = MyAIFeatureReadyResult::constructor.New({ external });
+                        deferred.Resolve(resultWrapper);
+                    } else {
+                        deferred.Reject(Napi::Error::New(env, "EnsureReadyAsync was cancelled or failed.").Value());
+                    }
+                } catch (const winrt::hresult_error& ex) {
+                    deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+                } catch (const std::exception& ex) {
+                    deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+                } catch (...) {
+                    deferred.Reject(Napi::Error::New(env, "Unknown error occurred in EnsureReadyAsync").Value());
+                }
+            };
+            
+            tsfn.BlockingCall(callback);
+        };      
+        asyncOp.Completed(completionHandler);
+        return progressPromise.GetPromiseObject();
+        
+    } catch (const winrt::hresult_error& ex) {
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (...) {
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in EnsureReadyAsync").Value());
+        return progressPromise.GetPromiseObject();
+    }
 }
 
-Napi::Value MyImageObjectRemover::MyCreateAsync(const Napi::CallbackInfo& info) {
+Napi::Value MyImageObjectRemover::MyRemoveAsync(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
+    
+    if (info.Length() < 2) {
+        Napi::TypeError::New(env, "RemoveAsync requires filePath and maskFilePath parameters").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    if (!info[0].IsString() || !info[1].IsString()) {
+        Napi::TypeError::New(env, "First and second parameters must be strings (image and mask file paths)").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
     auto deferred = Napi::Promise::Deferred::New(env);
-    deferred.Reject(Napi::Error::New(env, "ImageObjectRemover.CreateAsync not yet implemented").Value());
-    return deferred.Promise();
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "RemoveAsync", 0, 1);
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+
+    try {
+        auto filePath = winrt::to_hstring(info[0].As<Napi::String>().Utf8Value());
+        auto maskFilePath = winrt::to_hstring(info[1].As<Napi::String>().Utf8Value());
+        auto outputOptions = ParseImageOutputOptions(info.Length() >= 3 ? info[2] : env.Undefined());
+        
+        // Decode, inpaint and encode all happen off the JS thread
+        std::thread([deferred, tsfn, tsfn_guard, filePath, maskFilePath, outputOptions, remover = m_remover]() {
+            try {
+                auto image = LoadSoftwareBitmapFromFile(filePath);
+                auto mask = LoadSoftwareBitmapFromFile(maskFilePath);
+                if (mask.BitmapPixelFormat() != Windows::Graphics::Imaging::BitmapPixelFormat::Gray8) {
+                    mask = Windows::Graphics::Imaging::SoftwareBitmap::Convert(mask, Windows::Graphics::Imaging::BitmapPixelFormat::Gray8);
+                }
+                
+                auto output = remover->RemoveFromSoftwareBitmap(image, mask);
+                
+                if (outputOptions.has_value()) {
+                    auto encoded = EncodeSoftwareBitmap(output, *outputOptions);
+                    tsfn.BlockingCall([deferred, encoded = std::move(encoded)](Napi::Env env, Napi::Function) {
+                        deferred.Resolve(EncodedImageToJs(env, encoded));
+                    });
+                } else {
+                    auto width = static_cast<uint32_t>(output.PixelWidth());
+                    auto height = static_cast<uint32_t>(output.PixelHeight());
+                    auto pixels = CopySoftwareBitmapPixels(output);
+                    tsfn.BlockingCall([deferred, width, height, pixels = std::move(pixels)](Napi::Env env, Napi::Function) {
+                        deferred.Resolve(RawPixelsToJs(env, width, height, pixels));
+                    });
+                }
+                
+            } catch (const winrt::hresult_error& ex) {
+                tsfn.BlockingCall([deferred, message = winrt::to_string(ex.message())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (const std::exception& ex) {
+                tsfn.BlockingCall([deferred, message = std::string(ex.what())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (...) {
+                tsfn.BlockingCall([deferred](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, "Unknown error occurred in RemoveAsync").Value());
+                });
+            }
+        }).detach();
+        
+        return deferred.Promise();
+        
+    } catch (const winrt::hresult_error& ex) {
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return deferred.Promise();
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return deferred.Promise();
+    } catch (...) {
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in RemoveAsync").Value());
+        return deferred.Promise();
+    }
 }
 
-Napi::Value MyImageObjectRemover::MyGetReadyState(const Napi::CallbackInfo& info) {
+Napi::Value MyImageObjectRemover::MyClose(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     try {
-        auto readyState = ImageObjectRemover::GetReadyState();
-        return Napi::Number::New(env, static_cast<int>(readyState));
+        if (m_remover) {
+            m_remover->Close();
+        }
+        return env.Undefined();
     } catch (const winrt::hresult_error& ex) {
         Napi::Error::New(env, winrt::to_string(ex.message())).ThrowAsJavaScriptException();
         return env.Null();
@@ -1339,30 +2438,12 @@ Napi::Value MyImageObjectRemover::MyGetReadyState(const Napi::CallbackInfo& info
         Napi::Error::New(env, ex.what()).ThrowAsJavaScriptException();
         return env.Null();
     } catch (...) {
-        Napi::Error::New(env, "Unknown error occurred in GetReadyState").ThrowAsJavaScriptException();
+        Napi::Error::New(env, "Unknown error occurred in Close").ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
-Napi::Value MyImageObjectRemover::MyEnsureReadyAsync(const Napi::CallbackInfo& info) {
-    Napi::Env env = info.Env();
-    auto deferred = Napi::Promise::Deferred::New(env);
-    deferred.Reject(Napi::Error::New(env, "ImageObjectRemover.EnsureReadyAsync not yet implemented").Value());
-    return deferred.Promise();
-}
-
-Napi::Value MyImageObjectRemover::MyRemoveAsync(const Napi::CallbackInfo& info) {
-    Napi::Env env = info.Env();
-    auto deferred = Napi::Promise::Deferred::New(env);
-    deferred.Reject(Napi::Error::New(env, "ImageObjectRemover.RemoveAsync not yet implemented").Value());
-    return deferred.Promise();
-}
-
-Napi::Value MyImageObjectRemover::MyClose(const Napi::CallbackInfo& info) {
-    Napi::Env env = info.Env();
-    return env.Undefined();
-}
-
+// MyImageScaler Implementation
 MyImageScaler::MyImageScaler(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyImageScaler>(info) {
     if (info.Length() == 0 || !info[0].IsExternal()) {
         Napi::Error::New(info.Env(), "Cannot instantiate ImageScaler directly. Use ImageScaler.CreateAsync()").ThrowAsJavaScriptException();
@@ -1376,8 +2457,65 @@ MyImageScaler::MyImageScaler(const Napi::CallbackInfo& info) : Napi::ObjectWrap<
 Napi::Value MyImageScaler::MyCreateAsync(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     auto deferred = Napi::Promise::Deferred::New(env);
-    deferred.Reject(Napi::Error::New(env, "ImageScaler.CreateAsync not yet implemented").Value());
-    return deferred.Promise();
+    auto tsfn = Napi::ThreadSafeFunction::New(
+        env,
+        Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+        "CreateAsync",
+        0,
+        1 
+    );
+
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    
+    try {
+        auto asyncOp = ImageScaler::CreateAsync();
+        
+        auto completionHandler = [deferred, tsfn, tsfn_guard](auto const& sender, auto const& status) mutable {
+            auto callback = [deferred, sender, status](Napi::Env env, Napi::Function) {
+                try {
+                    if (status == winrt::Windows::Foundation::AsyncStatus::Completed) {
+                        auto scaler = sender.GetResults();
+                        if (!scaler) {
+                            deferred.Reject(Napi::Error::New(env, "Failed to create ImageScaler instance.").Value());
+                            return;
+                        }
+                        
+                        auto persistentScaler = std::make_shared<ImageScaler>(std::move(scaler));
+                        auto external = Napi::External<ImageScaler>::New(env, 
+                            persistentScaler.get(),
+                            [persistentScaler](Napi::Env env, ImageScaler* data) {
+                                // persistentScaler will be destroyed here, releasing the WinRT object
+                            });
+
+                        auto instance = MyImageScaler::constructor.New({ external });
+                        deferred.Resolve(instance);
+                    } else {
+                        deferred.Reject(Napi::Error::New(env, "ImageScaler creation was cancelled or failed.").Value());
+                    }
+                } catch (const winrt::hresult_error& ex) {
+                    deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+                } catch (const std::exception& ex) {
+                    deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+                } catch (...) {
+                    deferred.Reject(Napi::Error::New(env, "Unknown error occurred in CreateAsync").Value());
+                }
+            };
+            
+            tsfn.BlockingCall(callback);
+        };      
+        asyncOp.Completed(completionHandler);
+        return deferred.Promise();
+        
+    } catch (const winrt::hresult_error& ex) {
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return deferred.Promise();
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return deferred.Promise();
+    } catch (...) {
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in CreateAsync").Value());
+        return deferred.Promise();
+    }
 }
 
 Napi::Value MyImageScaler::MyGetReadyState(const Napi::CallbackInfo& info) {
@@ -1400,18 +2538,160 @@ Napi::Value MyImageScaler::MyGetReadyState(const Napi::CallbackInfo& info) {
 Napi::Value MyImageScaler::MyEnsureReadyAsync(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     auto deferred = Napi::Promise::Deferred::New(env);
-    deferred.Reject(Napi::Error::New(env, "ImageScaler.EnsureReadyAsync not yet implemented").Value());
-    return deferred.Promise();
+    auto tsfn = Napi::ThreadSafeFunction::New(
+        env,
+        Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+        "EnsureReadyAsync",
+        0,
+        1 
+    );
+
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    auto progressPromise = ProgressPromise::Create(env, deferred);
+    auto progressTsfn = progressPromise.GetProgressTsfn();
+    
+    try {
+        auto asyncOp = ImageScaler::EnsureReadyAsync();
+        
+        asyncOp.Progress([progressTsfn](auto const&, auto const& progressValue) {
+            if (progressTsfn && *progressTsfn) {
+                (*progressTsfn)->NonBlockingCall([progressValue](Napi::Env env, Napi::Function jsCallback) {
+                    try {
+                        jsCallback.Call({ env.Null(), Napi::Number::New(env, progressValue) });
+                    } catch (...) {}
+                });
+            }
+        });
+        
+        auto completionHandler = [deferred, tsfn, tsfn_guard](auto const& sender, auto const& status) mutable {
+            auto callback = [deferred, sender, status](Napi::Env env, Napi::Function) {
+                try {
+                    if (status == winrt::Windows::Foundation::AsyncStatus::Completed) {
+                        auto result = sender.GetResults();
+                        auto external = Napi::External<AIFeatureReadyResult>::New(env, &result);
+                        auto resultWrapper = MyAIFeatureReadyResult::constructor.New({ external });
+                        deferred.Resolve(resultWrapper);
+                    } else {
+                        deferred.Reject(Napi::Error::New(env, "EnsureReadyAsync was cancelled or failed.").Value());
+                    }
+                } catch (const winrt::hresult_error& ex) {
+                    deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+                } catch (const std::exception& ex) {
+                    deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+                } catch (...) {
+                    deferred.Reject(Napi::Error::New(env, "Unknown error occurred in EnsureReadyAsync").Value());
+                }
+            };
+            
+            tsfn.BlockingCall(callback);
+        };      
+        asyncOp.Completed(completionHandler);
+        return progressPromise.GetPromiseObject();
+        
+    } catch (const winrt::hresult_error& ex) {
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (...) {
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in EnsureReadyAsync").Value());
+        return progressPromise.GetPromiseObject();
+    }
 }
 
 Napi::Value MyImageScaler::MyScaleAsync(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
+    
+    if (info.Length() < 3) {
+        Napi::TypeError::New(env, "ScaleAsync requires filePath, width, and height parameters").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    if (!info[0].IsString()) {
+        Napi::TypeError::New(env, "First parameter must be a string (file path)").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    if (!info[1].IsNumber() || !info[2].IsNumber()) {
+        Napi::TypeError::New(env, "Second and third parameters must be numbers (target width and height)").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
     auto deferred = Napi::Promise::Deferred::New(env);
-    deferred.Reject(Napi::Error::New(env, "ImageScaler.ScaleAsync not yet implemented").Value());
-    return deferred.Promise();
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "ScaleAsync", 0, 1);
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+
+    try {
+        auto filePath = winrt::to_hstring(info[0].As<Napi::String>().Utf8Value());
+        int32_t width = info[1].As<Napi::Number>().Int32Value();
+        int32_t height = info[2].As<Napi::Number>().Int32Value();
+        auto outputOptions = ParseImageOutputOptions(info.Length() >= 4 ? info[3] : env.Undefined());
+        
+        // Decode, scale and encode all happen off the JS thread
+        std::thread([deferred, tsfn, tsfn_guard, filePath, width, height, outputOptions, scaler = m_scaler]() {
+            try {
+                auto image = LoadSoftwareBitmapFromFile(filePath);
+                auto output = scaler->ScaleSoftwareBitmap(image, width, height);
+                
+                if (outputOptions.has_value()) {
+                    auto encoded = EncodeSoftwareBitmap(output, *outputOptions);
+                    tsfn.BlockingCall([deferred, encoded = std::move(encoded)](Napi::Env env, Napi::Function) {
+                        deferred.Resolve(EncodedImageToJs(env, encoded));
+                    });
+                } else {
+                    auto outputWidth = static_cast<uint32_t>(output.PixelWidth());
+                    auto outputHeight = static_cast<uint32_t>(output.PixelHeight());
+                    auto pixels = CopySoftwareBitmapPixels(output);
+                    tsfn.BlockingCall([deferred, outputWidth, outputHeight, pixels = std::move(pixels)](Napi::Env env, Napi::Function) {
+                        deferred.Resolve(RawPixelsToJs(env, outputWidth, outputHeight, pixels));
+                    });
+                }
+                
+            } catch (const winrt::hresult_error& ex) {
+                tsfn.BlockingCall([deferred, message = winrt::to_string(ex.message())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (const std::exception& ex) {
+                tsfn.BlockingCall([deferred, message = std::string(ex.what())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (...) {
+                tsfn.BlockingCall([deferred](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, "Unknown error occurred in ScaleAsync").Value());
+                });
+            }
+        }).detach();
+        
+        return deferred.Promise();
+        
+    } catch (const winrt::hresult_error& ex) {
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return deferred.Promise();
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return deferred.Promise();
+    } catch (...) {
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in ScaleAsync").Value());
+        return deferred.Promise();
+    }
 }
 
 Napi::Value MyImageScaler::MyClose(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-    return env.Undefined();
-}
\ No newline at end of file
+    try {
+        if (m_scaler) {
+            m_scaler->Close();
+        }
+        return env.Undefined();
+    } catch (const winrt::hresult_error& ex) {
+        Napi::Error::New(env, winrt::to_string(ex.message())).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (const std::exception& ex) {
+        Napi::Error::New(env, ex.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (...) {
+        Napi::Error::New(env, "Unknown error occurred in Close").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
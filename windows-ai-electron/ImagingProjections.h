@@ -3,6 +3,8 @@
 #include <napi.h>
 #include <optional>
 #include <memory>
+#include <deque>
+#include <mutex>
 
 #include <winrt/Windows.Foundation.h>
 #include <winrt/Windows.Foundation.Collections.h>
@@ -11,6 +13,10 @@
 #include <winrt/Microsoft.Windows.AI.ContentSafety.h>
 
 #include "ProjectionHelper.h"
+#include "ImagingHelper.h"
+#include "OcrModel.h"
+#include "OcrWordIndex.h"
+#include "TextIndex.h"
 
 using namespace winrt;
 using namespace Microsoft::Windows::AI;
@@ -25,11 +31,36 @@ class MyRecognizedText;
 class MyRecognizedLine;
 class MyRecognizedWord;
 class MyRecognizedTextBoundingBox;
+class MyIncrementalTextRecognizer;
+class MyTextSearchIndex;
 class MyImageObjectExtractor;
 class MyImageObjectExtractorHint;
 class MyImageObjectRemover;
 class MyImageScaler;
 
+// Opt-in cache for DescribeAsync. Entries are keyed by the difference hash of the decoded image plus
+// the description kind and content filter, and matched within maxDistance bits. Off until enabled
+// through ConfigureCache, and exact-hash only unless a distance is given there.
+struct DescriptionCache {
+    struct Entry {
+        uint64_t hash;
+        int32_t kind;
+        uint64_t filterKey;
+        ImageDescriptionResult result;
+    };
+
+    std::mutex mutex;
+    bool enabled = false;
+    uint32_t maxDistance = 0;
+    size_t capacity = 64;
+    std::deque<Entry> entries; // most recently used first
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    std::optional<ImageDescriptionResult> Lookup(uint64_t hash, int32_t kind, uint64_t filterKey);
+    void Store(uint64_t hash, int32_t kind, uint64_t filterKey, const ImageDescriptionResult& result);
+};
+
 // Wrapper for ImageDescriptionGenerator
 class MyImageDescriptionGenerator : public Napi::ObjectWrap<MyImageDescriptionGenerator> {
 public:
@@ -44,9 +75,13 @@ public:
 
 private:
     ImageDescriptionGenerator* m_generator;
+    std::shared_ptr<DescriptionCache> m_cache;
     
     Napi::Value MyDescribeAsync(const Napi::CallbackInfo& info);
     Napi::Value MyClose(const Napi::CallbackInfo& info);
+    Napi::Value MyConfigureCache(const Napi::CallbackInfo& info);
+    Napi::Value MyGetCacheStats(const Napi::CallbackInfo& info);
+    Napi::Value MyClearCache(const Napi::CallbackInfo& info);
 };
 
 // Wrapper for ImageDescriptionResult
@@ -58,14 +93,32 @@ public:
     MyImageDescriptionResult(const Napi::CallbackInfo& info);
     bool HasResult() const;
     void SetResult(const ImageDescriptionResult& result);
+    // Backs the wrapper with values loaded from the result store instead of a WinRT result
+    void SetStoredResult(std::string description, int32_t status);
 
 private:
     std::optional<ImageDescriptionResult> m_result;
+    std::optional<std::string> m_storedDescription;
+    int32_t m_storedStatus = 0;
     
     Napi::Value GetDescription(const Napi::CallbackInfo& info);
     Napi::Value GetStatus(const Napi::CallbackInfo& info);
 };
 
+// Running totals of adaptive recognitions on one TextRecognizer
+struct AdaptiveRecognitionStats {
+    std::mutex mutex;
+    uint64_t pages = 0;
+    uint64_t refinedPages = 0;   // pages that needed a second pass
+    uint64_t fullFramePages = 0; // of those, pages recognized again in full
+    uint64_t refinedRegions = 0;
+    uint64_t refinedLines = 0;
+    double coarseMs = 0;
+    double refineMs = 0;
+
+    void Record(const AdaptiveRecognitionReport& report);
+};
+
 // Wrapper for TextRecognizer
 class MyTextRecognizer : public Napi::ObjectWrap<MyTextRecognizer> {
 public:
@@ -77,12 +130,16 @@ public:
     static Napi::Value MyEnsureReadyAsync(const Napi::CallbackInfo& info);
     
     MyTextRecognizer(const Napi::CallbackInfo& info);
+    TextRecognizer* GetRecognizer() const;
+    std::shared_ptr<AdaptiveRecognitionStats> GetAdaptiveStats() const;
 
 private:
     TextRecognizer* m_recognizer;
+    std::shared_ptr<AdaptiveRecognitionStats> m_adaptiveStats = std::make_shared<AdaptiveRecognitionStats>();
     
     Napi::Value MyRecognizeTextFromImageAsync(const Napi::CallbackInfo& info);
     Napi::Value MyRecognizeTextFromImage(const Napi::CallbackInfo& info);
+    Napi::Value MyGetAdaptiveStats(const Napi::CallbackInfo& info);
     Napi::Value MyClose(const Napi::CallbackInfo& info);
     Napi::Value MyDispose(const Napi::CallbackInfo& info);
 };
@@ -96,12 +153,25 @@ public:
     MyRecognizedText(const Napi::CallbackInfo& info);
     bool HasResult() const;
     void SetResult(const RecognizedText& result);
+    // Backs the wrapper with a native page instead of a WinRT result (e.g. merged or cached OCR output)
+    void SetPage(std::shared_ptr<const OcrPage> page);
+    // Native copy of the result, converted from the WinRT result when the wrapper is not page-backed
+    std::shared_ptr<const OcrPage> GetPage() const;
 
 private:
     std::optional<RecognizedText> m_result;
+    std::shared_ptr<const OcrPage> m_page;
+    std::unique_ptr<OcrWordIndex> m_wordIndex; // built on the first spatial query
+    
+    const OcrWordIndex& GetWordIndex();
     
     Napi::Value GetLines(const Napi::CallbackInfo& info);
     Napi::Value GetTextAngle(const Napi::CallbackInfo& info);
+    
+    // Addon spatial queries over word quads, returning flat word indices
+    Napi::Value MyHitTest(const Napi::CallbackInfo& info);
+    Napi::Value MyQueryRect(const Napi::CallbackInfo& info);
+    Napi::Value MyNearest(const Napi::CallbackInfo& info);
 };
 
 // Wrapper for RecognizedLine
@@ -112,9 +182,12 @@ public:
     
     MyRecognizedLine(const Napi::CallbackInfo& info);
     bool HasResult() const;
+    // Backs the wrapper with a line of a native page, see MyRecognizedText::SetPage
+    void SetLine(const OcrLine& line);
 
 private:
     std::optional<RecognizedLine> m_result;
+    std::optional<OcrLine> m_line;
     
     Napi::Value GetBoundingBox(const Napi::CallbackInfo& info);
     Napi::Value GetStyle(const Napi::CallbackInfo& info);
@@ -131,9 +204,11 @@ public:
     
     MyRecognizedWord(const Napi::CallbackInfo& info);
     bool HasResult() const;
+    void SetWord(const OcrWord& word);
 
 private:
     std::optional<RecognizedWord> m_result;
+    std::optional<OcrWord> m_word;
     
     Napi::Value GetBoundingBox(const Napi::CallbackInfo& info);
     Napi::Value GetConfidence(const Napi::CallbackInfo& info);
@@ -148,9 +223,11 @@ public:
     
     MyRecognizedTextBoundingBox(const Napi::CallbackInfo& info);
     bool HasResult() const;
+    void SetQuad(const OcrQuad& quad);
 
 private:
     std::optional<RecognizedTextBoundingBox> m_result;
+    std::optional<OcrQuad> m_quad;
     
     Napi::Value GetTopLeft(const Napi::CallbackInfo& info);
     Napi::Value GetTopRight(const Napi::CallbackInfo& info);
@@ -158,6 +235,55 @@ private:
     Napi::Value GetBottomRight(const Napi::CallbackInfo& info);
 };
 
+// Session state of an IncrementalTextRecognizer, shared with the worker threads
+struct IncrementalOcrState {
+    std::mutex mutex;
+    uint32_t blockSize = 16;
+    uint32_t tolerance = 0;
+    uint32_t padding = 8;
+    double fullFrameRatio = 0.5;
+    std::vector<uint8_t> previousFrame;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    OcrPage page;
+    bool hasPage = false;
+};
+
+// Stateful OCR session for repeated captures of the same window. Each frame is diffed against the
+// previous one and only the changed regions are re-recognized and spliced into the cached page.
+class MyIncrementalTextRecognizer : public Napi::ObjectWrap<MyIncrementalTextRecognizer> {
+public:
+    static Napi::FunctionReference constructor;
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    
+    MyIncrementalTextRecognizer(const Napi::CallbackInfo& info);
+
+private:
+    Napi::ObjectReference m_recognizerRef;
+    std::shared_ptr<IncrementalOcrState> m_state;
+    
+    Napi::Value MyRecognizeFrameAsync(const Napi::CallbackInfo& info);
+    Napi::Value MyReset(const Napi::CallbackInfo& info);
+};
+
+// Persistent full-text index over OCR results of many images, see TextIndex
+class MyTextSearchIndex : public Napi::ObjectWrap<MyTextSearchIndex> {
+public:
+    static Napi::FunctionReference constructor;
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    
+    MyTextSearchIndex(const Napi::CallbackInfo& info);
+
+private:
+    std::shared_ptr<TextIndex> m_index;
+    
+    Napi::Value MyAdd(const Napi::CallbackInfo& info);
+    Napi::Value MyFlushAsync(const Napi::CallbackInfo& info);
+    Napi::Value MySearchAsync(const Napi::CallbackInfo& info);
+    Napi::Value MyGetStats(const Napi::CallbackInfo& info);
+    Napi::Value MyClose(const Napi::CallbackInfo& info);
+};
+
 // Wrapper for ImageObjectExtractor
 class MyImageObjectExtractor : public Napi::ObjectWrap<MyImageObjectExtractor> {
 public:
@@ -200,6 +326,7 @@ private:
 // Wrapper for ImageObjectRemover
 class MyImageObjectRemover : public Napi::ObjectWrap<MyImageObjectRemover> {
 public:
+    static Napi::FunctionReference constructor;
     static Napi::Object Init(Napi::Env env, Napi::Object exports);
     
     static Napi::Value MyCreateAsync(const Napi::CallbackInfo& info);
@@ -218,6 +345,7 @@ private:
 // Wrapper for ImageScaler
 class MyImageScaler : public Napi::ObjectWrap<MyImageScaler> {
 public:
+    static Napi::FunctionReference constructor;
     static Napi::Object Init(Napi::Env env, Napi::Object exports);
     
     static Napi::Value MyCreateAsync(const Napi::CallbackInfo& info);
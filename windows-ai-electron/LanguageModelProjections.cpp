@@ -1,11 +1,30 @@
 #include "LanguageModelProjections.h"
+#include "ContentHash.h"
 #include "ContentSeverity.h"
+#include "ImagingHelper.h"
+#include "ImagingProjections.h"
+#include "OcrTable.h"
 #include "ProjectionHelper.h"
+#include "PromptPacking.h"
+#include "StopConditions.h"
+#include "TableFormat.h"
+#include "TableMerge.h"
+#include "TableStream.h"
+#include "TextChunking.h"
+#include "TextDiff.h"
 #include <shobjidl_core.h>
 #include <windows.h>
 #include <winrt/Windows.Data.Xml.Dom.h>
 #include <winrt/Windows.Foundation.Collections.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstdlib>
+#include <functional>
+#include <map>
+#include <string_view>
+#include <thread>
 #include "LimitedAccessFeature.h"
 
 using namespace Windows::Data::Xml::Dom;
@@ -16,6 +35,7 @@ Napi::FunctionReference MyAIFeatureReadyResult::constructor;
 Napi::FunctionReference MyLanguageModel::constructor;
 Napi::FunctionReference MyConversationItem::constructor;
 Napi::FunctionReference MyTextSummarizer::constructor;
+Napi::FunctionReference MyConversationSummarySession::constructor;
 Napi::FunctionReference MyTextRewriter::constructor;
 Napi::FunctionReference MyTextToTableConverter::constructor;
 Napi::FunctionReference MyTextToTableResponseResult::constructor;
@@ -43,12 +63,19 @@ MyLanguageModelResponseResult::MyLanguageModelResponseResult(const Napi::Callbac
 }
 
 bool MyLanguageModelResponseResult::HasResult() const {
-    return m_result.has_value();
+    return m_result.has_value() || m_text.has_value();
+}
+
+void MyLanguageModelResponseResult::SetText(std::string text) {
+    m_text = std::move(text);
 }
 
 Napi::Value MyLanguageModelResponseResult::GetText(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     try {
+        if (m_text) {
+            return Napi::String::New(env, *m_text);
+        }
         if (!m_result.has_value()) {
             Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
             return env.Null();
@@ -72,6 +99,9 @@ Napi::Value MyLanguageModelResponseResult::GetText(const Napi::CallbackInfo& inf
 Napi::Value MyLanguageModelResponseResult::GetStatus(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     try {
+        if (!m_result.has_value() && m_text) {
+            return Napi::Number::New(env, static_cast<int>(LanguageModelResponseStatus::Complete));
+        }
         if (!m_result.has_value()) {
             Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
             return env.Null();
@@ -95,6 +125,9 @@ Napi::Value MyLanguageModelResponseResult::GetStatus(const Napi::CallbackInfo& i
 Napi::Value MyLanguageModelResponseResult::GetExtendedError(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     try {
+        if (!m_result.has_value() && m_text) {
+            return env.Null();
+        }
         if (!m_result.has_value()) {
             Napi::Error::New(env, "No result data available").ThrowAsJavaScriptException();
             return env.Null();
@@ -377,10 +410,614 @@ Napi::Value MyAIFeatureReadyResult::GetStatus(const Napi::CallbackInfo& info) {
     }
 }
 
+namespace {
+
+// Reads a JS string straight into UTF-16, without the UTF-8 round trip of Utf8Value
+winrt::hstring ToHString(const Napi::String& value) {
+    std::u16string text = value.Utf16Value();
+    return winrt::hstring(reinterpret_cast<const wchar_t*>(text.data()), static_cast<uint32_t>(text.size()));
+}
+
+// True when options is the { languageModelOptions, stopSequences, ... } object of GenerateResponseAsync
+// rather than a LanguageModelOptions
+bool HasStopConditionKeys(const Napi::Object& options) {
+    return options.Has("languageModelOptions") || options.Has("stopSequences") || options.Has("maxChars") || options.Has("maxSentences");
+}
+
+// Reads { stopSequences, maxChars, maxSentences }; absent keys leave their condition off
+StopConditions ParseStopConditions(const Napi::Object& options) {
+    StopConditions conditions;
+    if (options.Has("stopSequences") && !options.Get("stopSequences").IsUndefined()) {
+        auto value = options.Get("stopSequences");
+        if (!value.IsArray()) {
+            throw std::runtime_error("stopSequences must be an array of non-empty strings");
+        }
+        auto sequences = value.As<Napi::Array>();
+        for (uint32_t i = 0; i < sequences.Length(); i++) {
+            auto sequence = sequences.Get(i);
+            if (!sequence.IsString() || sequence.As<Napi::String>().Utf8Value().empty()) {
+                throw std::runtime_error("stopSequences must be an array of non-empty strings");
+            }
+            conditions.stopSequences.push_back(sequence.As<Napi::String>().Utf8Value());
+        }
+    }
+    auto readLimit = [&options](const char* key, size_t& target) {
+        if (!options.Has(key) || options.Get(key).IsUndefined()) {
+            return;
+        }
+        double value = options.Get(key).IsNumber() ? options.Get(key).As<Napi::Number>().DoubleValue() : 0.0;
+        if (!(value >= 1.0 && value <= 1e9) || value != std::floor(value)) {
+            throw std::runtime_error(std::string(key) + " must be a positive integer");
+        }
+        target = static_cast<size_t>(value);
+    };
+    readLimit("maxChars", conditions.maxChars);
+    readLimit("maxSentences", conditions.maxSentences);
+    return conditions;
+}
+
+// Progress and completion handlers of a text call made with stop conditions. Progress is checked as it
+// arrives; once a condition is met, the fragment that met it is relayed up to the stop point, the WinRT
+// operation is cancelled and later fragments are dropped. The promise resolves with a
+// LanguageModelResponseResult holding the text before the stop point and `stopReason`, null when
+// generation ended on its own. A finished response is checked again in full, in case progress came too
+// coarse to catch a condition.
+template <typename Operation>
+void HandleStoppableResponse(Operation asyncOp, const std::string& name, const StopConditions& conditions, Napi::Promise::Deferred deferred,
+                             Napi::ThreadSafeFunction tsfn, std::shared_ptr<void> tsfn_guard, std::shared_ptr<Napi::ThreadSafeFunction*> progressTsfn) {
+    struct StopState {
+        explicit StopState(const StopConditions& conditions) : stopper(conditions) {}
+        std::mutex mutex;
+        GenerationStopper stopper;
+    };
+    auto state = std::make_shared<StopState>(conditions);
+    
+    asyncOp.Progress([state, progressTsfn](auto const& sender, auto const& progressText) {
+        auto progressStr = winrt::to_string(progressText);
+        bool stopped = false;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->stopper.Stopped()) {
+                return;
+            }
+            if (state->stopper.Append(progressStr)) {
+                // Listeners still get the fragment up to the stop point, so they see the resolved text
+                progressStr = std::string(state->stopper.StopFragment());
+                stopped = true;
+            }
+        }
+        if (stopped) {
+            try {
+                sender.Cancel();
+            } catch (...) {}
+        }
+        if (progressTsfn && *progressTsfn && !progressStr.empty()) {
+            (*progressTsfn)->NonBlockingCall([progressStr](Napi::Env env, Napi::Function jsCallback) {
+                try {
+                    jsCallback.Call({ env.Null(), Napi::String::New(env, progressStr) });
+                } catch (...) {}
+            });
+        }
+    });
+    
+    asyncOp.Completed([deferred, tsfn, tsfn_guard, state, name, conditions](auto const& sender, auto const& status) mutable {
+        std::optional<LanguageModelResponseResult> result;
+        std::optional<std::string> text; // set when the text was cut
+        StopReason reason = StopReason::None;
+        std::string error;
+        try {
+            if (status == winrt::Windows::Foundation::AsyncStatus::Completed) {
+                result = sender.GetResults();
+                GenerationStopper finalCheck(conditions);
+                if (finalCheck.Append(winrt::to_string(result->Text()))) {
+                    reason = finalCheck.Reason();
+                    text = std::string(finalCheck.Text());
+                }
+            } else {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (state->stopper.Stopped()) {
+                    reason = state->stopper.Reason();
+                    text = std::string(state->stopper.Text());
+                } else {
+                    error = name + " was cancelled or failed";
+                }
+            }
+        } catch (const winrt::hresult_error& ex) {
+            error = winrt::to_string(ex.message());
+        } catch (const std::exception& ex) {
+            error = ex.what();
+        } catch (...) {
+            error = "Unknown error occurred in " + name;
+        }
+        
+        tsfn.BlockingCall([deferred, result, text, reason, error, name](Napi::Env env, Napi::Function) {
+            if (!error.empty()) {
+                deferred.Reject(Napi::Error::New(env, error).Value());
+                return;
+            }
+            try {
+                Napi::Object resultWrapper;
+                if (result) {
+                    LanguageModelResponseResult response = *result;
+                    auto external = Napi::External<LanguageModelResponseResult>::New(env, &response);
+                    resultWrapper = MyLanguageModelResponseResult::constructor.New({ external });
+                } else {
+                    resultWrapper = MyLanguageModelResponseResult::constructor.New({});
+                }
+                if (text) {
+                    Napi::ObjectWrap<MyLanguageModelResponseResult>::Unwrap(resultWrapper)->SetText(*text);
+                }
+                const char* reasonName = StopReasonName(reason);
+                resultWrapper.Set("stopReason", reasonName ? Napi::Value(Napi::String::New(env, reasonName)) : env.Null());
+                deferred.Resolve(resultWrapper);
+            } catch (const winrt::hresult_error& ex) {
+                deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+            } catch (const std::exception& ex) {
+                deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+            } catch (...) {
+                deferred.Reject(Napi::Error::New(env, "Unknown error occurred in " + name).Value());
+            }
+        });
+    });
+}
+
+// One input of a *BatchAsync call
+struct BatchItemResult {
+    int32_t status = 0;
+    std::string text;
+    std::optional<std::vector<std::vector<std::string>>> rows; // ConvertBatchAsync only
+    std::string error; // set when the call threw
+    double latencyMs = 0;
+};
+
+using BatchRunner = std::function<BatchItemResult(const winrt::hstring& input)>;
+
+// Finished items waiting for the main thread. One progress call drains everything queued so far, so a
+// burst of results costs one main-thread hop rather than one per item.
+struct BatchStream {
+    std::mutex mutex;
+    std::vector<std::pair<size_t, BatchItemResult>> pending;
+    std::map<size_t, BatchItemResult> held; // ordered mode: finished ahead of their turn
+    size_t nextIndex = 0;
+    bool flushScheduled = false;
+};
+
+Napi::Object BatchItemToJs(Napi::Env env, size_t index, const BatchItemResult& item) {
+    auto itemObj = Napi::Object::New(env);
+    itemObj.Set("index", Napi::Number::New(env, static_cast<double>(index)));
+    if (!item.error.empty()) {
+        itemObj.Set("error", Napi::String::New(env, item.error));
+        return itemObj;
+    }
+    itemObj.Set("status", Napi::Number::New(env, item.status));
+    if (item.rows) {
+        auto rowsArray = Napi::Array::New(env, item.rows->size());
+        for (size_t r = 0; r < item.rows->size(); r++) {
+            const auto& row = (*item.rows)[r];
+            auto rowArray = Napi::Array::New(env, row.size());
+            for (size_t c = 0; c < row.size(); c++) {
+                rowArray.Set(static_cast<uint32_t>(c), Napi::String::New(env, row[c]));
+            }
+            rowsArray.Set(static_cast<uint32_t>(r), rowArray);
+        }
+        itemObj.Set("rows", rowsArray);
+    } else {
+        itemObj.Set("text", Napi::String::New(env, item.text));
+    }
+    return itemObj;
+}
+
+// Shared body of the *BatchAsync methods. Takes the inputs (an array of strings) and the options
+// { concurrency, ordered, ... } from info, then runs the runner makeRunner builds from the options over the
+// inputs on one worker thread, keeping `concurrency` calls in flight. Items are streamed to the progress
+// callback as they finish, or in input order when `ordered`; the promise resolves with every item in input
+// order plus throughput statistics. A failing item is reported, it does not stop the batch.
+//
+// When packInstruction is set the `pack` option is accepted: short inputs are sent several to a call as
+// marked items after the instruction (see PromptPacking.h), and the answer is split back per item. A
+// pack whose answer does not split cleanly is retried one item per call.
+Napi::Value StartBatch(const Napi::CallbackInfo& info, const char* name, const std::function<BatchRunner(const Napi::Value& options)>& makeRunner,
+                       const wchar_t* packInstruction = nullptr) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsArray()) {
+        Napi::TypeError::New(env, std::string(name) + " requires an array of strings").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    auto deferred = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), name, 0, 1);
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    auto progressPromise = ProgressPromise::Create(env, deferred);
+    auto progressTsfn = progressPromise.GetProgressTsfn();
+
+    try {
+        auto inputsArray = info[0].As<Napi::Array>();
+        std::vector<winrt::hstring> inputs;
+        inputs.reserve(inputsArray.Length());
+        for (uint32_t i = 0; i < inputsArray.Length(); i++) {
+            auto value = inputsArray.Get(i);
+            if (!value.IsString()) {
+                throw std::runtime_error("Every input must be a string");
+            }
+            inputs.push_back(ToHString(value.As<Napi::String>()));
+        }
+        
+        size_t concurrency = 2;
+        bool ordered = false;
+        bool pack = false;
+        size_t packMaxItems = 8;
+        size_t packMaxLength = 2000;
+        Napi::Value optionsValue = info.Length() > 1 ? info[1] : env.Undefined();
+        if (optionsValue.IsObject()) {
+            auto optionsObj = optionsValue.As<Napi::Object>();
+            if (optionsObj.Has("concurrency") && !optionsObj.Get("concurrency").IsUndefined()) {
+                double value = optionsObj.Get("concurrency").IsNumber() ? optionsObj.Get("concurrency").As<Napi::Number>().DoubleValue() : 0.0;
+                if (!(value >= 1.0 && value <= 16.0) || value != std::floor(value)) {
+                    throw std::runtime_error("concurrency must be an integer between 1 and 16");
+                }
+                concurrency = static_cast<size_t>(value);
+            }
+            if (optionsObj.Has("ordered") && !optionsObj.Get("ordered").IsUndefined()) {
+                if (!optionsObj.Get("ordered").IsBoolean()) {
+                    throw std::runtime_error("ordered must be a boolean");
+                }
+                ordered = optionsObj.Get("ordered").As<Napi::Boolean>().Value();
+            }
+            if (optionsObj.Has("pack") && !optionsObj.Get("pack").IsUndefined()) {
+                auto packValue = optionsObj.Get("pack");
+                if (packValue.IsBoolean()) {
+                    pack = packValue.As<Napi::Boolean>().Value();
+                } else if (packValue.IsObject()) {
+                    pack = true;
+                    auto packObj = packValue.As<Napi::Object>();
+                    auto readLimit = [&packObj](const char* key, double min, double max, size_t& target) {
+                        if (!packObj.Has(key) || packObj.Get(key).IsUndefined()) {
+                            return;
+                        }
+                        double value = packObj.Get(key).IsNumber() ? packObj.Get(key).As<Napi::Number>().DoubleValue() : 0.0;
+                        if (!(value >= min && value <= max) || value != std::floor(value)) {
+                            throw std::runtime_error("pack." + std::string(key) + " must be an integer between " +
+                                                     std::to_string(static_cast<int>(min)) + " and " + std::to_string(static_cast<int>(max)));
+                        }
+                        target = static_cast<size_t>(value);
+                    };
+                    readLimit("maxItems", 2, 32, packMaxItems);
+                    readLimit("maxLength", 256, 16000, packMaxLength);
+                } else {
+                    throw std::runtime_error("pack must be a boolean or { maxItems, maxLength }");
+                }
+            }
+            if (pack && !packInstruction) {
+                throw std::runtime_error(std::string(name) + " does not support pack");
+            }
+        }
+        BatchRunner run = makeRunner(optionsValue);
+        std::string batchName(name);
+        std::wstring instruction = pack ? std::wstring(packInstruction) : std::wstring();
+        
+        std::thread([deferred, tsfn, tsfn_guard, progressTsfn, inputs = std::move(inputs), concurrency, ordered, run, batchName, pack,
+                     packMaxItems, packMaxLength, instruction]() {
+            try {
+                using Clock = std::chrono::steady_clock;
+                auto batchStart = Clock::now();
+                auto stream = std::make_shared<BatchStream>();
+                
+                auto deliver = [stream, progressTsfn, ordered](size_t index, BatchItemResult item) {
+                    {
+                        std::lock_guard<std::mutex> lock(stream->mutex);
+                        if (ordered) {
+                            stream->held.emplace(index, std::move(item));
+                            for (auto it = stream->held.find(stream->nextIndex); it != stream->held.end(); it = stream->held.find(stream->nextIndex)) {
+                                stream->pending.emplace_back(it->first, std::move(it->second));
+                                stream->held.erase(it);
+                                stream->nextIndex++;
+                            }
+                        } else {
+                            stream->pending.emplace_back(index, std::move(item));
+                        }
+                        if (!progressTsfn || !*progressTsfn) {
+                            stream->pending.clear();
+                            return;
+                        }
+                        if (stream->pending.empty() || stream->flushScheduled) {
+                            return;
+                        }
+                        stream->flushScheduled = true;
+                    }
+                    napi_status status = (*progressTsfn)->NonBlockingCall([stream](Napi::Env env, Napi::Function jsCallback) {
+                        std::vector<std::pair<size_t, BatchItemResult>> items;
+                        {
+                            std::lock_guard<std::mutex> lock(stream->mutex);
+                            items.swap(stream->pending);
+                            stream->flushScheduled = false;
+                        }
+                        for (const auto& [index, item] : items) {
+                            try {
+                                jsCallback.Call({ env.Null(), BatchItemToJs(env, index, item) });
+                            } catch (...) {}
+                        }
+                    });
+                    if (status != napi_ok) {
+                        std::lock_guard<std::mutex> lock(stream->mutex);
+                        stream->pending.clear();
+                        stream->flushScheduled = false;
+                    }
+                };
+                
+                // Kept for the resolved value, so items are not lost when no progress callback was attached in time
+                auto results = std::make_shared<std::vector<BatchItemResult>>(inputs.size());
+                std::mutex statsMutex;
+                uint32_t completed = 0;
+                uint32_t failed = 0;
+                double latencySum = 0;
+                double maxLatency = 0;
+                size_t inputLength = 0;
+                size_t outputLength = 0;
+                for (const auto& input : inputs) {
+                    inputLength += input.size();
+                }
+                
+                uint32_t modelCalls = 0;
+                uint32_t packedCalls = 0;
+                uint32_t packedItems = 0;
+                uint32_t fallbackItems = 0;
+                double packedMs = 0;
+                double baselineMs = 0; // unpacked calls of packable inputs, the baseline for the packing gain
+                uint32_t baselineCalls = 0;
+                
+                auto call = [&run, &batchName](const winrt::hstring& input) {
+                    BatchItemResult item;
+                    try {
+                        item = run(input);
+                    } catch (const winrt::hresult_error& ex) {
+                        item.error = winrt::to_string(ex.message());
+                    } catch (const std::exception& ex) {
+                        item.error = ex.what();
+                    } catch (...) {
+                        item.error = "Unknown error occurred in " + batchName;
+                    }
+                    return item;
+                };
+                auto finish = [&](size_t i, BatchItemResult item) {
+                    {
+                        std::lock_guard<std::mutex> lock(statsMutex);
+                        if (!item.error.empty()) {
+                            failed++;
+                        } else if (item.status == static_cast<int32_t>(LanguageModelResponseStatus::Complete)) {
+                            completed++;
+                        }
+                        latencySum += item.latencyMs;
+                        maxLatency = (std::max)(maxLatency, item.latencyMs);
+                        outputLength += Utf16Length(item.text);
+                        if (item.rows) {
+                            for (const auto& row : *item.rows) {
+                                for (const auto& cell : row) {
+                                    outputLength += Utf16Length(cell);
+                                }
+                            }
+                        }
+                    }
+                    (*results)[i] = item;
+                    deliver(i, std::move(item));
+                };
+                auto runSingle = [&](size_t i) {
+                    auto itemStart = Clock::now();
+                    BatchItemResult item = call(inputs[i]);
+                    item.latencyMs = std::chrono::duration<double, std::milli>(Clock::now() - itemStart).count();
+                    {
+                        std::lock_guard<std::mutex> lock(statsMutex);
+                        modelCalls++;
+                        if (pack && IsPackable(inputs[i], packMaxLength)) {
+                            baselineCalls++;
+                            baselineMs += item.latencyMs;
+                        }
+                    }
+                    finish(i, std::move(item));
+                };
+                
+                std::vector<PackGroup> groups;
+                if (pack) {
+                    std::vector<std::wstring_view> views(inputs.begin(), inputs.end());
+                    groups = PlanPackGroups(views, packMaxItems, packMaxLength);
+                } else {
+                    groups.reserve(inputs.size());
+                    for (size_t i = 0; i < inputs.size(); i++) {
+                        groups.push_back({ i, i + 1 });
+                    }
+                }
+                
+                RunConcurrently(groups.size(), concurrency, [&](size_t g) {
+                    const PackGroup& group = groups[g];
+                    size_t size = group.end - group.begin;
+                    if (size == 1) {
+                        runSingle(group.begin);
+                        return;
+                    }
+                    
+                    std::vector<std::wstring_view> views(inputs.begin() + group.begin, inputs.begin() + group.end);
+                    auto callStart = Clock::now();
+                    BatchItemResult packed = call(winrt::hstring(PackPrompt(views, instruction)));
+                    double callMs = std::chrono::duration<double, std::milli>(Clock::now() - callStart).count();
+                    std::vector<std::wstring> texts;
+                    bool split = packed.error.empty() && packed.status == static_cast<int32_t>(LanguageModelResponseStatus::Complete) &&
+                                 SplitPackedOutput(winrt::to_hstring(packed.text), size, texts);
+                    {
+                        std::lock_guard<std::mutex> lock(statsMutex);
+                        modelCalls++;
+                        if (split) {
+                            packedCalls++;
+                            packedItems += static_cast<uint32_t>(size);
+                            packedMs += callMs;
+                        } else {
+                            fallbackItems += static_cast<uint32_t>(size);
+                        }
+                    }
+                    for (size_t k = 0; k < size; k++) {
+                        if (!split) {
+                            runSingle(group.begin + k);
+                            continue;
+                        }
+                        BatchItemResult item;
+                        item.status = packed.status;
+                        item.text = winrt::to_string(texts[k]);
+                        item.latencyMs = callMs / size;
+                        finish(group.begin + k, std::move(item));
+                    }
+                });
+                
+                double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - batchStart).count();
+                size_t count = inputs.size();
+                // Gain estimate: what the packed items would have taken at the mean latency of packable inputs
+                // sent alone. PlanPackGroups leaves at least one of those whenever something is packed.
+                double packingGain = packedMs > 0 && baselineCalls > 0 ? packedItems * (baselineMs / baselineCalls) / packedMs : 0.0;
+                // Queued behind the progress flushes when a callback is attached, so every item reaches it
+                // before the promise resolves
+                Napi::ThreadSafeFunction* resolveTsfn = progressTsfn && *progressTsfn ? *progressTsfn : &tsfn;
+                resolveTsfn->BlockingCall([deferred, results, count, completed, failed, totalMs, latencySum, maxLatency, inputLength, outputLength, modelCalls, pack,
+                                           packedCalls, packedItems, fallbackItems, packingGain](Napi::Env env, Napi::Function) {
+                    auto statsObj = Napi::Object::New(env);
+                    auto resultsArray = Napi::Array::New(env, results->size());
+                    for (size_t i = 0; i < results->size(); i++) {
+                        resultsArray.Set(static_cast<uint32_t>(i), BatchItemToJs(env, i, (*results)[i]));
+                    }
+                    statsObj.Set("results", resultsArray);
+                    statsObj.Set("count", Napi::Number::New(env, static_cast<double>(count)));
+                    statsObj.Set("completed", Napi::Number::New(env, completed));
+                    statsObj.Set("failed", Napi::Number::New(env, failed));
+                    statsObj.Set("totalMs", Napi::Number::New(env, totalMs));
+                    statsObj.Set("itemsPerSecond", Napi::Number::New(env, totalMs > 0 ? count * 1000.0 / totalMs : 0.0));
+                    statsObj.Set("meanLatencyMs", Napi::Number::New(env, count > 0 ? latencySum / count : 0.0));
+                    statsObj.Set("maxLatencyMs", Napi::Number::New(env, maxLatency));
+                    statsObj.Set("inputLength", Napi::Number::New(env, static_cast<double>(inputLength)));
+                    statsObj.Set("outputLength", Napi::Number::New(env, static_cast<double>(outputLength)));
+                    statsObj.Set("modelCalls", Napi::Number::New(env, modelCalls));
+                    if (pack) {
+                        auto packingObj = Napi::Object::New(env);
+                        packingObj.Set("packedCalls", Napi::Number::New(env, packedCalls));
+                        packingObj.Set("packedItems", Napi::Number::New(env, packedItems));
+                        packingObj.Set("fallbackItems", Napi::Number::New(env, fallbackItems));
+                        packingObj.Set("itemsPerCall", Napi::Number::New(env, modelCalls > 0 ? static_cast<double>(count) / modelCalls : 0.0));
+                        packingObj.Set("estimatedGain", packingGain > 0 ? Napi::Number::New(env, packingGain) : env.Null());
+                        statsObj.Set("packing", packingObj);
+                    }
+                    deferred.Resolve(statsObj);
+                });
+                
+            } catch (const winrt::hresult_error& ex) {
+                tsfn.BlockingCall([deferred, message = winrt::to_string(ex.message())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (const std::exception& ex) {
+                tsfn.BlockingCall([deferred, message = std::string(ex.what())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (...) {
+                tsfn.BlockingCall([deferred, batchName](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, "Unknown error occurred in " + batchName).Value());
+                });
+            }
+        }).detach();
+        
+        return progressPromise.GetPromiseObject();
+        
+    } catch (const winrt::hresult_error& ex) {
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (...) {
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in " + std::string(name)).Value());
+        return progressPromise.GetPromiseObject();
+    }
+}
+
+// Image argument of SummarizeImageTextAsync and ConvertImageAsync: a TextRecognizer, a file path or raw
+// frame, and recognition options. Parsed on the JS thread, decoded and recognized on the worker thread.
+struct ImageTextSource {
+    TextRecognizer* recognizer = nullptr;
+    std::shared_ptr<AdaptiveRecognitionStats> adaptiveStats;
+    TextRecognitionOptions options;
+    winrt::hstring filePath;
+    std::vector<uint8_t> framePixels;
+    uint32_t frameWidth = 0;
+    uint32_t frameHeight = 0;
+};
+
+// Type checks of (recognizer, image, options?). Throws a JS TypeError and returns false when they fail.
+bool CheckImageTextArguments(const Napi::CallbackInfo& info, const std::string& method) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 2 || !info[0].IsObject() || !info[0].As<Napi::Object>().InstanceOf(MyTextRecognizer::constructor.Value())) {
+        Napi::TypeError::New(env, method + " requires a TextRecognizer and an image").ThrowAsJavaScriptException();
+        return false;
+    }
+    if (!info[1].IsString() && !info[1].IsObject()) {
+        Napi::TypeError::New(env, "Second parameter must be a file path or an object { width, height, buffer, stride? } of BGRA8 pixels").ThrowAsJavaScriptException();
+        return false;
+    }
+    return true;
+}
+
+// Throws std::runtime_error when the recognizer is disposed or the frame or options are invalid
+ImageTextSource ParseImageTextSource(const Napi::CallbackInfo& info) {
+    ImageTextSource source;
+    auto recognizerWrapper = Napi::ObjectWrap<MyTextRecognizer>::Unwrap(info[0].As<Napi::Object>());
+    source.recognizer = recognizerWrapper->GetRecognizer();
+    if (!source.recognizer) {
+        throw std::runtime_error("The TextRecognizer has been disposed");
+    }
+    source.adaptiveStats = recognizerWrapper->GetAdaptiveStats();
+    source.options = ParseTextRecognitionOptions(info.Length() > 2 ? info[2] : info.Env().Undefined());
+    if (info[1].IsString()) {
+        source.filePath = winrt::to_hstring(info[1].As<Napi::String>().Utf8Value());
+    } else {
+        source.framePixels = ParseRawFrame(info[1], source.frameWidth, source.frameHeight);
+    }
+    return source;
+}
+
+// Decodes and recognizes the image, timing both stages. Adaptive runs are recorded in the recognizer's stats.
+OcrPage RecognizeImageTextSource(const ImageTextSource& source, double& decodeMs, double& recognizeMs) {
+    using Clock = std::chrono::steady_clock;
+    auto stageStart = Clock::now();
+    auto softwareBitmap = source.filePath.empty() ? CreateSoftwareBitmapFromBgra(source.framePixels.data(), source.frameWidth, source.frameHeight, source.frameWidth * 4) : LoadSoftwareBitmapFromFile(source.filePath);
+    decodeMs = std::chrono::duration<double, std::milli>(Clock::now() - stageStart).count();
+
+    stageStart = Clock::now();
+    AdaptiveRecognitionReport report;
+    OcrPage page = RecognizeTextWithOptions(*source.recognizer, softwareBitmap, source.options, report);
+    if (source.options.adaptive) {
+        source.adaptiveStats->Record(report);
+    }
+    recognizeMs = std::chrono::duration<double, std::milli>(Clock::now() - stageStart).count();
+    return page;
+}
+
+// Rejects deferred from a worker thread with the exception being handled. Only valid inside a catch block.
+void RejectWithCurrentException(const Napi::ThreadSafeFunction& tsfn, const Napi::Promise::Deferred& deferred, const std::string& method) {
+    std::string message;
+    try {
+        throw;
+    } catch (const winrt::hresult_error& ex) {
+        message = winrt::to_string(ex.message());
+    } catch (const std::exception& ex) {
+        message = ex.what();
+    } catch (...) {
+        message = "Unknown error occurred in " + method;
+    }
+    tsfn.BlockingCall([deferred, message = std::move(message)](Napi::Env env, Napi::Function) {
+        deferred.Reject(Napi::Error::New(env, message).Value());
+    });
+}
+
+} // namespace
+
 // MyLanguageModel Implementation
 Napi::Object MyLanguageModel::Init(Napi::Env env, Napi::Object exports) {
     Napi::Function func = DefineClass(env, "LanguageModel", {
         InstanceMethod("GenerateResponseAsync", &MyLanguageModel::MyGenerateResponseAsync),
+        InstanceMethod("GenerateResponseBatchAsync", &MyLanguageModel::MyGenerateResponseBatchAsync),
         StaticMethod("CreateAsync", &MyLanguageModel::MyCreateAsync),
         StaticMethod("GetReadyState", &MyLanguageModel::MyGetReadyState),
         StaticMethod("EnsureReadyAsync", &MyLanguageModel::MyEnsureReadyAsync)
@@ -565,9 +1202,27 @@ Napi::Value MyLanguageModel::MyGenerateResponseAsync(const Napi::CallbackInfo& i
     auto progressTsfn = progressPromise.GetProgressTsfn();
 
     try {
+        // The second parameter is a LanguageModelOptions, or { languageModelOptions, stopSequences, maxChars, maxSentences }
+        StopConditions stopConditions;
+        std::optional<Napi::Object> modelOptions;
+        if (info.Length() >= 2 && info[1].IsObject()) {
+            auto optionsObj = info[1].As<Napi::Object>();
+            if (HasStopConditionKeys(optionsObj)) {
+                stopConditions = ParseStopConditions(optionsObj);
+                if (optionsObj.Has("languageModelOptions") && !optionsObj.Get("languageModelOptions").IsUndefined()) {
+                    if (!optionsObj.Get("languageModelOptions").IsObject()) {
+                        throw std::runtime_error("languageModelOptions must be a LanguageModelOptions object");
+                    }
+                    modelOptions = optionsObj.Get("languageModelOptions").As<Napi::Object>();
+                }
+            } else {
+                modelOptions = optionsObj;
+            }
+        }
+
         auto asyncOp = [&]() {
-            if (info.Length() >= 2 && info[1].IsObject()) {
-                auto optionsWrapper = Napi::ObjectWrap<MyLanguageModelOptions>::Unwrap(info[1].As<Napi::Object>());
+            if (modelOptions) {
+                auto optionsWrapper = Napi::ObjectWrap<MyLanguageModelOptions>::Unwrap(*modelOptions);
                 if (!optionsWrapper) throw std::runtime_error("Invalid options: Please provide a LanguageModelOptions object.");
                 return m_languagemodel->GenerateResponseAsync(winrt::to_hstring(prompt), optionsWrapper->GetOptions());
             } else {
@@ -575,6 +1230,11 @@ Napi::Value MyLanguageModel::MyGenerateResponseAsync(const Napi::CallbackInfo& i
             }
         }();
 
+        if (stopConditions.Any()) {
+            HandleStoppableResponse(asyncOp, "GenerateResponseAsync", stopConditions, deferred, tsfn, tsfn_guard, progressTsfn);
+            return progressPromise.GetPromiseObject();
+        }
+
         asyncOp.Progress([progressTsfn](auto const&, auto const& progressText) {
             if (progressTsfn && *progressTsfn) {
                 auto progressStr = winrt::to_string(progressText);
@@ -617,6 +1277,35 @@ Napi::Value MyLanguageModel::MyGenerateResponseAsync(const Napi::CallbackInfo& i
     }
 }
 
+Napi::Value MyLanguageModel::MyGenerateResponseBatchAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (!MyLimitedAccessFeatures::IsFeatureUnlocked()) {
+        Napi::Error::New(env, "GenerateResponseBatchAsync requires the Limited Access Feature to be unlocked. Call LimitedAccessFeatures.TryUnlockFeature() with a valid token before using this API. Request a token at: https://go.microsoft.com/fwlink/?linkid=2271232").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    LanguageModel languageModel = *m_languagemodel;
+    return StartBatch(info, "GenerateResponseBatchAsync", [languageModel](const Napi::Value& options) -> BatchRunner {
+        std::optional<LanguageModelOptions> modelOptions;
+        if (options.IsObject() && options.As<Napi::Object>().Has("languageModelOptions")) {
+            auto optionsValue = options.As<Napi::Object>().Get("languageModelOptions");
+            if (!optionsValue.IsObject()) {
+                throw std::runtime_error("languageModelOptions must be a LanguageModelOptions object");
+            }
+            modelOptions = Napi::ObjectWrap<MyLanguageModelOptions>::Unwrap(optionsValue.As<Napi::Object>())->GetOptions();
+        }
+        return [languageModel, modelOptions](const winrt::hstring& prompt) {
+            auto result = (modelOptions ? languageModel.GenerateResponseAsync(prompt, *modelOptions) : languageModel.GenerateResponseAsync(prompt)).get();
+            BatchItemResult item;
+            item.status = static_cast<int32_t>(result.Status());
+            item.text = winrt::to_string(result.Text());
+            return item;
+        };
+    }, L"Answer each numbered item below on its own. Start every answer with the item's marker, such as [[1]], on a line by itself, "
+       L"keep the markers in order and write nothing else.\n");
+}
+
 // MyConversationItem Implementation
 Napi::Object MyConversationItem::Init(Napi::Env env, Napi::Object exports) {
     Napi::Function func = DefineClass(env, "ConversationItem", {
@@ -688,72 +1377,376 @@ void MyConversationItem::MySetParticipant(const Napi::CallbackInfo& info, const
     }
 }
 
-// MyTextSummarizer Implementation
-
-Napi::Object MyTextSummarizer::Init(Napi::Env env, Napi::Object exports) {
-    Napi::Function func = DefineClass(env, "TextSummarizer", {
-        InstanceMethod("SummarizeAsync", &MyTextSummarizer::MySummarizeAsync),
-        InstanceMethod("SummarizeConversationAsync", &MyTextSummarizer::MySummarizeConversationAsync),
-        InstanceMethod("SummarizeParagraphAsync", &MyTextSummarizer::MySummarizeParagraphAsync),
-        InstanceMethod("IsPromptLargerThanContext", &MyTextSummarizer::MyIsPromptLargerThanContext)
-    });
+namespace {
 
-    constructor = Napi::Persistent(func);
-    exports.Set("TextSummarizer", func);
-    return exports;
+ConversationItem MakeConversationItem(const Napi::Value& participant, const Napi::Value& message) {
+    if (!message.IsString() || (!participant.IsString() && !participant.IsUndefined())) {
+        throw std::runtime_error("Conversation messages and participants must be strings");
+    }
+    ConversationItem item;
+    if (participant.IsString()) {
+        item.Participant(ToHString(participant.As<Napi::String>()));
+    }
+    item.Message(ToHString(message.As<Napi::String>()));
+    return item;
 }
 
-MyTextSummarizer::MyTextSummarizer(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyTextSummarizer>(info) {
-    if (info.Length() == 0) {
-        Napi::Error::New(info.Env(), "TextSummarizer constructor requires a LanguageModel instance").ThrowAsJavaScriptException();
-        return;
+// Conversation items from an array of ConversationItem instances or { participant, message } objects, or
+// from parallel string arrays { participants, messages }. Plain strings are converted in a single pass,
+// so long histories do not need a ConversationItem wrapper per message.
+std::vector<ConversationItem> ParseConversationItems(const Napi::Value& value) {
+    std::vector<ConversationItem> items;
+    if (value.IsArray()) {
+        auto itemsArray = value.As<Napi::Array>();
+        uint32_t length = itemsArray.Length();
+        items.reserve(length);
+        Napi::Function itemConstructor = MyConversationItem::constructor.Value();
+        for (uint32_t i = 0; i < length; i++) {
+            auto itemValue = itemsArray.Get(i);
+            if (!itemValue.IsObject()) {
+                continue;
+            }
+            auto itemObj = itemValue.As<Napi::Object>();
+            if (itemObj.InstanceOf(itemConstructor)) {
+                items.push_back(Napi::ObjectWrap<MyConversationItem>::Unwrap(itemObj)->GetConversationItem());
+            } else {
+                items.push_back(MakeConversationItem(itemObj.Get("participant"), itemObj.Get("message")));
+            }
+        }
+        return items;
     }
-    
-    // Check if first parameter is an External<TextSummarizer> (for internal use)
-    if (info[0].IsExternal()) {
-        auto external = info[0].As<Napi::External<TextSummarizer>>();
-        m_summarizer = std::make_shared<TextSummarizer>(*external.Data());
-        return;
+
+    auto columnsObj = value.As<Napi::Object>();
+    auto participants = columnsObj.Get("participants");
+    auto messages = columnsObj.Get("messages");
+    if (!messages.IsArray() || (!participants.IsArray() && !participants.IsUndefined())) {
+        throw std::runtime_error("Conversation columns must be { participants: string[], messages: string[] }");
     }
-    
-    // Check if first parameter is a MyLanguageModel instance (for direct instantiation)
-    if (info[0].IsObject()) {
-        auto languageModelObj = info[0].As<Napi::Object>();
-        auto languageModelWrapper = Napi::ObjectWrap<MyLanguageModel>::Unwrap(languageModelObj);
-        if (languageModelWrapper) {
-            try {
-                auto languageModel = languageModelWrapper->GetLanguageModel();
-                if (languageModel) {
-                    m_summarizer = std::make_shared<TextSummarizer>(*languageModel);
-                    return;
-                }
-            } catch (const winrt::hresult_error& ex) {
-                std::string errorMsg = "Failed to create TextSummarizer: " + winrt::to_string(ex.message());
-                Napi::Error::New(info.Env(), errorMsg).ThrowAsJavaScriptException();
-                return;
-            } catch (const std::exception& ex) {
-                std::string errorMsg = "Failed to create TextSummarizer: " + std::string(ex.what());
-                Napi::Error::New(info.Env(), errorMsg).ThrowAsJavaScriptException();
-                return;
-            } catch (...) {
-                Napi::Error::New(info.Env(), "Unknown error creating TextSummarizer").ThrowAsJavaScriptException();
-                return;
-            }
+    auto messagesArray = messages.As<Napi::Array>();
+    uint32_t length = messagesArray.Length();
+    if (participants.IsArray() && participants.As<Napi::Array>().Length() != length) {
+        throw std::runtime_error("participants and messages must have the same length");
+    }
+    items.reserve(length);
+    for (uint32_t i = 0; i < length; i++) {
+        Napi::Value participant = participants.IsArray() ? participants.As<Napi::Array>().Get(i) : columnsObj.Env().Undefined();
+        items.push_back(MakeConversationItem(participant, messagesArray.Get(i)));
+    }
+    return items;
+}
+
+ConversationSummaryOptions ParseConversationSummaryOptions(const Napi::Value& value) {
+    ConversationSummaryOptions options;
+    if (value.IsObject()) {
+        auto optionsObj = value.As<Napi::Object>();
+        if (optionsObj.Has("includeMessageCitations") && optionsObj.Get("includeMessageCitations").IsBoolean()) {
+            options.IncludeMessageCitations(optionsObj.Get("includeMessageCitations").As<Napi::Boolean>().Value());
+        }
+        if (optionsObj.Has("includeParticipantAttribution") && optionsObj.Get("includeParticipantAttribution").IsBoolean()) {
+            options.IncludeParticipantAttribution(optionsObj.Get("includeParticipantAttribution").As<Napi::Boolean>().Value());
         }
     }
-    
-    Napi::Error::New(info.Env(), "TextSummarizer constructor requires a valid LanguageModel instance").ThrowAsJavaScriptException();
+    return options;
 }
 
-Napi::Value MyTextSummarizer::MySummarizeAsync(const Napi::CallbackInfo& info) {
-    Napi::Env env = info.Env();
-    
-    if (info.Length() < 1 || !info[0].IsString()) {
-        Napi::TypeError::New(env, "SummarizeAsync requires a string parameter").ThrowAsJavaScriptException();
-        return env.Null();
+// A ConversationSummarySession checkpoint { summary, itemCount }, false when the value is not one
+bool ReadConversationCheckpoint(const Napi::Value& value, winrt::hstring& summary, uint64_t& itemCount) {
+    if (!value.IsObject()) {
+        return false;
     }
-    
-    auto deferred = Napi::Promise::Deferred::New(env);
+    auto stateObj = value.As<Napi::Object>();
+    auto summaryValue = stateObj.Get("summary");
+    auto itemCountValue = stateObj.Get("itemCount");
+    if (!summaryValue.IsString() || !itemCountValue.IsNumber() || itemCountValue.As<Napi::Number>().DoubleValue() < 0) {
+        return false;
+    }
+    summary = ToHString(summaryValue.As<Napi::String>());
+    itemCount = static_cast<uint64_t>(itemCountValue.As<Napi::Number>().Int64Value());
+    return true;
+}
+
+bool IsHighSurrogate(wchar_t c) {
+    return c >= 0xD800 && c <= 0xDBFF;
+}
+
+// Length in UTF-16 units of the longest prefix that fits the summarizer context: ending at a sentence
+// boundary when one fits, else before a space, else anywhere outside a surrogate pair. Every probe is a
+// model check, so candidates are binary searched below the cutoff the model reports for the whole text,
+// trying the largest first since that estimate is usually right. Returns text.size() when all of it fits.
+size_t LongestFittingPrefix(const TextSummarizer& summarizer, std::wstring_view text, uint32_t& checks) {
+    checks = 0;
+    uint64_t cutoffPosition = 0;
+    auto fits = [&](size_t length) {
+        checks++;
+        return !summarizer.IsPromptLargerThanContext(winrt::hstring(text.substr(0, length)), cutoffPosition);
+    };
+    if (text.empty() || fits(text.size())) {
+        return text.size();
+    }
+    // Smallest length known or reported not to fit; prefixes of a fitting prefix are assumed to fit
+    size_t tooLong = text.size();
+    if (cutoffPosition > 0 && cutoffPosition < text.size()) {
+        tooLong = static_cast<size_t>(cutoffPosition) + 1;
+    }
+
+    auto searchCandidates = [&](const std::vector<size_t>& candidates) -> size_t {
+        auto last = std::lower_bound(candidates.begin(), candidates.end(), tooLong);
+        size_t count = static_cast<size_t>(last - candidates.begin());
+        if (count == 0) {
+            return 0;
+        }
+        if (fits(candidates[count - 1])) {
+            return candidates[count - 1];
+        }
+        tooLong = (std::min)(tooLong, candidates[count - 1]);
+        size_t low = 0; // candidates below low fit
+        size_t high = count - 1; // candidates from high on do not
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            if (fits(candidates[middle])) {
+                low = middle + 1;
+            } else {
+                high = middle;
+                tooLong = (std::min)(tooLong, candidates[middle]);
+            }
+        }
+        return low > 0 ? candidates[low - 1] : 0;
+    };
+
+    size_t length = searchCandidates(FindSentenceBoundaries(text));
+    if (length == 0) {
+        std::vector<size_t> spaces;
+        for (size_t i = 1; i < tooLong; i++) {
+            if (text[i] == L' ' && text[i - 1] != L' ') {
+                spaces.push_back(i);
+            }
+        }
+        length = searchCandidates(spaces);
+    }
+    if (length == 0) {
+        size_t low = 0;
+        size_t high = tooLong;
+        while (high - low > 1) {
+            size_t middle = low + (high - low) / 2;
+            if (fits(middle)) {
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+        length = low;
+        if (length > 0 && IsHighSurrogate(text[length - 1])) {
+            length--; // never split a surrogate pair
+        }
+    }
+    return length;
+}
+
+// Cuts text to the longest prefix that fits the summarizer context, at a sentence boundary when possible
+winrt::hstring FitTextToSummarizerContext(const TextSummarizer& summarizer, winrt::hstring text, bool& truncated) {
+    uint32_t checks = 0;
+    std::wstring_view view(text);
+    size_t length = LongestFittingPrefix(summarizer, view, checks);
+    truncated = length < view.size();
+    return truncated ? winrt::hstring(view.substr(0, length)) : text;
+}
+
+// Splits text into chunks that each fit the summarizer context. The cutoff reported for the whole text
+// gives the first size budget; a chunk that still does not fit is split again at three quarters of its size.
+std::vector<std::string> ChunkForSummarizer(const TextSummarizer& summarizer, const std::string& text) {
+    std::vector<std::string> chunks;
+    winrt::hstring whole = winrt::to_hstring(text);
+    uint64_t cutoffPosition = 0;
+    if (!summarizer.IsPromptLargerThanContext(whole, cutoffPosition)) {
+        chunks.push_back(text);
+        return chunks;
+    }
+
+    std::wstring_view view(whole);
+    size_t fitting = static_cast<size_t>((std::min)(cutoffPosition, static_cast<uint64_t>(view.size())));
+    size_t budget = (std::max)(winrt::to_string(view.substr(0, fitting)).size() * 9 / 10, static_cast<size_t>(256));
+
+    std::function<void(std::string_view, size_t)> split = [&](std::string_view piece, size_t maxBytes) {
+        for (const auto& chunk : ChunkText(piece, maxBytes)) {
+            std::string_view part = piece.substr(chunk.offset, chunk.length);
+            uint64_t partCutoff = 0;
+            if (part.size() > 64 && summarizer.IsPromptLargerThanContext(winrt::to_hstring(part), partCutoff)) {
+                split(part, part.size() * 3 / 4);
+            } else {
+                chunks.emplace_back(part);
+            }
+        }
+    };
+    split(text, budget);
+    return chunks;
+}
+
+enum class ConversationFitMode {
+    None,
+    DropOldest,
+    SummarizeOldest
+};
+
+struct ConversationFitReport {
+    uint32_t droppedItems = 0;
+    uint32_t condensedItems = 0;
+    uint32_t summarizeCalls = 0;
+    uint32_t checks = 0;
+};
+
+// Participant of the item that carries a summary of earlier messages
+constexpr wchar_t kEarlierConversationParticipant[] = L"Earlier conversation";
+
+// Nesting limit for summarizing the overflow of the overflow; items past it are dropped
+constexpr int kMaxConversationCondenseDepth = 8;
+
+// Drops the oldest items after the first `pinned` until the conversation fits, never the newest one. The
+// cutoff the summarizer reports is a position in the prompt built from the items in order, so as many
+// characters as lie past it are dropped from the front in one pass. The prompt also has framing the
+// character count cannot see, so the result is checked again and the pass repeated with the new cutoff.
+std::vector<ConversationItem> DropOldestToFit(const TextSummarizer& summarizer, std::vector<ConversationItem> items, size_t pinned,
+                                              const ConversationSummaryOptions& options, ConversationFitReport& report, size_t& dropped) {
+    dropped = 0;
+    while (items.size() > pinned + 1) {
+        uint64_t cutoffPosition = 0;
+        report.checks++;
+        if (!summarizer.IsPromptLargerThanContext(winrt::array_view<ConversationItem const>(items), options, cutoffPosition)) {
+            break;
+        }
+        std::vector<size_t> lengths(items.size());
+        uint64_t total = 0;
+        for (size_t i = 0; i < items.size(); i++) {
+            lengths[i] = items[i].Participant().size() + items[i].Message().size() + 2;
+            total += lengths[i];
+        }
+        uint64_t overflow = total > cutoffPosition ? total - cutoffPosition : 0;
+        size_t count = 0;
+        uint64_t removed = 0;
+        while (pinned + count + 1 < items.size() && (count == 0 || removed < overflow)) {
+            removed += lengths[pinned + count];
+            count++;
+        }
+        items.erase(items.begin() + pinned, items.begin() + pinned + count);
+        dropped += count;
+    }
+    return items;
+}
+
+// Replaces the oldest items that do not fit with one item holding their summary. When the overflow does not
+// fit one prompt either, its own overflow is condensed first. Items are counted in the report once: as
+// condensed when their text reached the top-level summary, otherwise as dropped.
+std::vector<ConversationItem> CondenseOldestToFit(const TextSummarizer& summarizer, const std::vector<ConversationItem>& items,
+                                                  const ConversationSummaryOptions& options, ConversationFitReport& report, int depth) {
+    size_t dropped = 0;
+    std::vector<ConversationItem> kept = DropOldestToFit(summarizer, items, 0, options, report, dropped);
+    if (dropped == 0) {
+        return kept;
+    }
+    if (depth >= kMaxConversationCondenseDepth) {
+        report.droppedItems += static_cast<uint32_t>(dropped);
+        return kept;
+    }
+
+    uint32_t lostBefore = report.droppedItems;
+    std::vector<ConversationItem> overflow(items.begin(), items.begin() + dropped);
+    overflow = CondenseOldestToFit(summarizer, overflow, options, report, depth + 1);
+    uint32_t lostInside = report.droppedItems - lostBefore;
+
+    report.summarizeCalls++;
+    auto result = summarizer.SummarizeConversationAsync(winrt::single_threaded_vector(std::move(overflow)).GetView(), options).get();
+    if (result.Status() != LanguageModelResponseStatus::Complete || result.Text().empty()) {
+        report.droppedItems += static_cast<uint32_t>(dropped) - lostInside;
+        return kept;
+    }
+
+    ConversationItem summaryItem;
+    summaryItem.Participant(kEarlierConversationParticipant);
+    summaryItem.Message(result.Text());
+    kept.insert(kept.begin(), summaryItem);
+
+    // The summary takes room of its own, the newest items stay
+    size_t squeezed = 0;
+    kept = DropOldestToFit(summarizer, std::move(kept), 1, options, report, squeezed);
+    report.droppedItems += static_cast<uint32_t>(squeezed);
+    if (depth == 0) {
+        report.condensedItems += static_cast<uint32_t>(dropped) - lostInside;
+    }
+    return kept;
+}
+
+} // namespace
+
+// MyTextSummarizer Implementation
+
+Napi::Object MyTextSummarizer::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "TextSummarizer", {
+        InstanceMethod("SummarizeAsync", &MyTextSummarizer::MySummarizeAsync),
+        InstanceMethod("SummarizeConversationAsync", &MyTextSummarizer::MySummarizeConversationAsync),
+        InstanceMethod("SummarizeParagraphAsync", &MyTextSummarizer::MySummarizeParagraphAsync),
+        InstanceMethod("IsPromptLargerThanContext", &MyTextSummarizer::MyIsPromptLargerThanContext),
+        InstanceMethod("SummarizeImageTextAsync", &MyTextSummarizer::MySummarizeImageTextAsync),
+        InstanceMethod("SummarizeLongTextAsync", &MyTextSummarizer::MySummarizeLongTextAsync),
+        InstanceMethod("FitToContextAsync", &MyTextSummarizer::MyFitToContextAsync),
+        InstanceMethod("SummarizeDocumentAsync", &MyTextSummarizer::MySummarizeDocumentAsync),
+        InstanceMethod("SummarizeBatchAsync", &MyTextSummarizer::MySummarizeBatchAsync)
+    });
+
+    constructor = Napi::Persistent(func);
+    exports.Set("TextSummarizer", func);
+    return exports;
+}
+
+MyTextSummarizer::MyTextSummarizer(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyTextSummarizer>(info) {
+    if (info.Length() == 0) {
+        Napi::Error::New(info.Env(), "TextSummarizer constructor requires a LanguageModel instance").ThrowAsJavaScriptException();
+        return;
+    }
+    
+    // Check if first parameter is an External<TextSummarizer> (for internal use)
+    if (info[0].IsExternal()) {
+        auto external = info[0].As<Napi::External<TextSummarizer>>();
+        m_summarizer = std::make_shared<TextSummarizer>(*external.Data());
+        return;
+    }
+    
+    // Check if first parameter is a MyLanguageModel instance (for direct instantiation)
+    if (info[0].IsObject()) {
+        auto languageModelObj = info[0].As<Napi::Object>();
+        auto languageModelWrapper = Napi::ObjectWrap<MyLanguageModel>::Unwrap(languageModelObj);
+        if (languageModelWrapper) {
+            try {
+                auto languageModel = languageModelWrapper->GetLanguageModel();
+                if (languageModel) {
+                    m_summarizer = std::make_shared<TextSummarizer>(*languageModel);
+                    return;
+                }
+            } catch (const winrt::hresult_error& ex) {
+                std::string errorMsg = "Failed to create TextSummarizer: " + winrt::to_string(ex.message());
+                Napi::Error::New(info.Env(), errorMsg).ThrowAsJavaScriptException();
+                return;
+            } catch (const std::exception& ex) {
+                std::string errorMsg = "Failed to create TextSummarizer: " + std::string(ex.what());
+                Napi::Error::New(info.Env(), errorMsg).ThrowAsJavaScriptException();
+                return;
+            } catch (...) {
+                Napi::Error::New(info.Env(), "Unknown error creating TextSummarizer").ThrowAsJavaScriptException();
+                return;
+            }
+        }
+    }
+    
+    Napi::Error::New(info.Env(), "TextSummarizer constructor requires a valid LanguageModel instance").ThrowAsJavaScriptException();
+}
+
+Napi::Value MyTextSummarizer::MySummarizeAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "SummarizeAsync requires a string parameter").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    auto deferred = Napi::Promise::Deferred::New(env);
     auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "SummarizeAsync", 0, 1);
     auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
     auto progressPromise = ProgressPromise::Create(env, deferred);
@@ -762,9 +1755,15 @@ Napi::Value MyTextSummarizer::MySummarizeAsync(const Napi::CallbackInfo& info) {
     try {
         std::string text = info[0].As<Napi::String>().Utf8Value();
         winrt::hstring wText = winrt::to_hstring(text);
+        StopConditions stopConditions = info.Length() >= 2 && info[1].IsObject() ? ParseStopConditions(info[1].As<Napi::Object>()) : StopConditions();
         
         auto asyncOp = m_summarizer->SummarizeAsync(wText);
         
+        if (stopConditions.Any()) {
+            HandleStoppableResponse(asyncOp, "SummarizeAsync", stopConditions, deferred, tsfn, tsfn_guard, progressTsfn);
+            return progressPromise.GetPromiseObject();
+        }
+        
         asyncOp.Progress([progressTsfn](auto const&, auto const& progressText) {
             if (progressTsfn && *progressTsfn) {
                 auto progressStr = winrt::to_string(progressText);
@@ -828,9 +1827,15 @@ Napi::Value MyTextSummarizer::MySummarizeParagraphAsync(const Napi::CallbackInfo
     try {
         std::string text = info[0].As<Napi::String>().Utf8Value();
         winrt::hstring wText = winrt::to_hstring(text);
+        StopConditions stopConditions = info.Length() >= 2 && info[1].IsObject() ? ParseStopConditions(info[1].As<Napi::Object>()) : StopConditions();
         
         auto asyncOp = m_summarizer->SummarizeParagraphAsync(wText);
         
+        if (stopConditions.Any()) {
+            HandleStoppableResponse(asyncOp, "SummarizeParagraphAsync", stopConditions, deferred, tsfn, tsfn_guard, progressTsfn);
+            return progressPromise.GetPromiseObject();
+        }
+        
         asyncOp.Progress([progressTsfn](auto const&, auto const& progressText) {
             if (progressTsfn && *progressTsfn) {
                 auto progressStr = winrt::to_string(progressText);
@@ -885,8 +1890,8 @@ Napi::Value MyTextSummarizer::MySummarizeConversationAsync(const Napi::CallbackI
         return env.Null();
     }
     
-    if (!info[0].IsArray()) {
-        Napi::TypeError::New(env, "First parameter must be an array of ConversationItem objects").ThrowAsJavaScriptException();
+    if (!info[0].IsObject()) {
+        Napi::TypeError::New(env, "First parameter must be an array of ConversationItem or { participant, message } objects, or { participants, messages } string arrays").ThrowAsJavaScriptException();
         return env.Null();
     }
     
@@ -897,33 +1902,85 @@ Napi::Value MyTextSummarizer::MySummarizeConversationAsync(const Napi::CallbackI
     auto progressTsfn = progressPromise.GetProgressTsfn();
 
     try {
-        auto messagesArray = info[0].As<Napi::Array>();
-        auto messages = winrt::single_threaded_vector<ConversationItem>();
+        std::vector<ConversationItem> messages = ParseConversationItems(info[0]);
         
-        for (uint32_t i = 0; i < messagesArray.Length(); i++) {
-            auto itemValue = messagesArray.Get(i);
-            if (itemValue.IsObject()) {
-                auto itemObj = itemValue.As<Napi::Object>();
-                
-                auto conversationItemWrapper = Napi::ObjectWrap<MyConversationItem>::Unwrap(itemObj);
-                if (conversationItemWrapper) {
-                    messages.Append(conversationItemWrapper->GetConversationItem());
+        ConversationSummaryOptions options = ParseConversationSummaryOptions(info[1]);
+        ConversationFitMode fitMode = ConversationFitMode::None;
+        if (info[1].IsObject()) {
+            auto optionsObj = info[1].As<Napi::Object>();
+            if (optionsObj.Has("fitToContext") && !optionsObj.Get("fitToContext").IsUndefined()) {
+                std::string mode = optionsObj.Get("fitToContext").IsString() ? optionsObj.Get("fitToContext").As<Napi::String>().Utf8Value() : std::string();
+                if (mode == "dropOldest") {
+                    fitMode = ConversationFitMode::DropOldest;
+                } else if (mode == "summarizeOldest") {
+                    fitMode = ConversationFitMode::SummarizeOldest;
+                } else {
+                    throw std::runtime_error("fitToContext must be 'dropOldest' or 'summarizeOldest'");
                 }
             }
         }
         
-        ConversationSummaryOptions options;
-        if (info[1].IsObject()) {
-            auto optionsObj = info[1].As<Napi::Object>();
-            if (optionsObj.Has("includeMessageCitations") && optionsObj.Get("includeMessageCitations").IsBoolean()) {
-                options.IncludeMessageCitations(optionsObj.Get("includeMessageCitations").As<Napi::Boolean>().Value());
-            }
-            if (optionsObj.Has("includeParticipantAttribution") && optionsObj.Get("includeParticipantAttribution").IsBoolean()) {
-                options.IncludeParticipantAttribution(optionsObj.Get("includeParticipantAttribution").As<Napi::Boolean>().Value());
-            }
+        if (fitMode != ConversationFitMode::None) {
+            std::thread([deferred, tsfn, tsfn_guard, progressTsfn, summarizer = m_summarizer, messages = std::move(messages), options, fitMode]() {
+                try {
+                    ConversationFitReport report;
+                    std::vector<ConversationItem> fitted;
+                    if (fitMode == ConversationFitMode::DropOldest) {
+                        size_t dropped = 0;
+                        fitted = DropOldestToFit(*summarizer, messages, 0, options, report, dropped);
+                        report.droppedItems = static_cast<uint32_t>(dropped);
+                    } else {
+                        fitted = CondenseOldestToFit(*summarizer, messages, options, report, 0);
+                    }
+                    uint32_t itemCount = static_cast<uint32_t>(fitted.size());
+                    
+                    auto asyncOp = summarizer->SummarizeConversationAsync(winrt::single_threaded_vector(std::move(fitted)).GetView(), options);
+                    asyncOp.Progress([progressTsfn](auto const&, auto const& progressText) {
+                        if (progressTsfn && *progressTsfn) {
+                            auto progressStr = winrt::to_string(progressText);
+                            (*progressTsfn)->NonBlockingCall([progressStr](Napi::Env env, Napi::Function jsCallback) {
+                                try {
+                                    jsCallback.Call({ env.Null(), Napi::String::New(env, progressStr) });
+                                } catch (...) {}
+                            });
+                        }
+                    });
+                    auto result = asyncOp.get();
+                    
+                    tsfn.BlockingCall([deferred, result, report, itemCount, fitMode](Napi::Env env, Napi::Function) {
+                        auto resultCopy = result;
+                        auto external = Napi::External<LanguageModelResponseResult>::New(env, &resultCopy);
+                        auto resultWrapper = MyLanguageModelResponseResult::constructor.New({ external });
+                        auto fitObj = Napi::Object::New(env);
+                        fitObj.Set("mode", Napi::String::New(env, fitMode == ConversationFitMode::DropOldest ? "dropOldest" : "summarizeOldest"));
+                        fitObj.Set("itemCount", Napi::Number::New(env, itemCount));
+                        fitObj.Set("droppedItems", Napi::Number::New(env, report.droppedItems));
+                        fitObj.Set("condensedItems", Napi::Number::New(env, report.condensedItems));
+                        fitObj.Set("summarizeCalls", Napi::Number::New(env, report.summarizeCalls));
+                        fitObj.Set("checks", Napi::Number::New(env, report.checks));
+                        resultWrapper.Set("fitToContext", fitObj);
+                        deferred.Resolve(resultWrapper);
+                    });
+                    
+                } catch (const winrt::hresult_error& ex) {
+                    tsfn.BlockingCall([deferred, message = winrt::to_string(ex.message())](Napi::Env env, Napi::Function) {
+                        deferred.Reject(Napi::Error::New(env, message).Value());
+                    });
+                } catch (const std::exception& ex) {
+                    tsfn.BlockingCall([deferred, message = std::string(ex.what())](Napi::Env env, Napi::Function) {
+                        deferred.Reject(Napi::Error::New(env, message).Value());
+                    });
+                } catch (...) {
+                    tsfn.BlockingCall([deferred](Napi::Env env, Napi::Function) {
+                        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in SummarizeConversationAsync").Value());
+                    });
+                }
+            }).detach();
+            
+            return progressPromise.GetPromiseObject();
         }
         
-        auto messagesView = messages.GetView();
+        auto messagesView = winrt::single_threaded_vector(std::move(messages)).GetView();
         auto asyncOp = m_summarizer->SummarizeConversationAsync(messagesView, options);
         
         asyncOp.Progress([progressTsfn](auto const&, auto const& progressText) {
@@ -984,38 +2041,20 @@ Napi::Value MyTextSummarizer::MyIsPromptLargerThanContext(const Napi::CallbackIn
         uint64_t cutoffPosition = 0;
         bool result = false;
         
-        if (info[0].IsArray() && info.Length() >= 2) {
-            auto messagesArray = info[0].As<Napi::Array>();
-            std::vector<ConversationItem> messages;
-            
-            for (uint32_t i = 0; i < messagesArray.Length(); i++) {
-                auto itemValue = messagesArray.Get(i);
-                if (itemValue.IsObject()) {
-                    auto itemObj = itemValue.As<Napi::Object>();
-                    
-                    auto conversationItemWrapper = Napi::ObjectWrap<MyConversationItem>::Unwrap(itemObj);
-                    if (conversationItemWrapper) {
-                        messages.push_back(conversationItemWrapper->GetConversationItem());
-                    }
-                }
-            }
-            
-            ConversationSummaryOptions options;
-            if (info[1].IsObject()) {
-                auto optionsObj = info[1].As<Napi::Object>();
-                if (optionsObj.Has("includeMessageCitations") && optionsObj.Get("includeMessageCitations").IsBoolean()) {
-                    options.IncludeMessageCitations(optionsObj.Get("includeMessageCitations").As<Napi::Boolean>().Value());
-                }
-                if (optionsObj.Has("includeParticipantAttribution") && optionsObj.Get("includeParticipantAttribution").IsBoolean()) {
-                    options.IncludeParticipantAttribution(optionsObj.Get("includeParticipantAttribution").As<Napi::Boolean>().Value());
-                }
-            }
+        if (info[0].IsString()) {
+            result = m_summarizer->IsPromptLargerThanContext(winrt::to_hstring(info[0].As<Napi::String>().Utf8Value()), cutoffPosition);
+            return Napi::Boolean::New(env, result);
+        }
+        
+        if (info[0].IsObject() && info.Length() >= 2) {
+            std::vector<ConversationItem> messages = ParseConversationItems(info[0]);
             
+            ConversationSummaryOptions options = ParseConversationSummaryOptions(info[1]);
             winrt::array_view<ConversationItem const> messagesView(messages);
             result = m_summarizer->IsPromptLargerThanContext(messagesView, options, cutoffPosition);
         } 
         else {
-            Napi::TypeError::New(env, "Invalid parameters. Expected either (string) or (ConversationItem[], ConversationSummaryOptions)").ThrowAsJavaScriptException();
+            Napi::TypeError::New(env, "Invalid parameters. Expected either (string) or (conversation items, ConversationSummaryOptions)").ThrowAsJavaScriptException();
             return env.Null();
         }
         
@@ -1036,106 +2075,921 @@ Napi::Value MyTextSummarizer::MyIsPromptLargerThanContext(const Napi::CallbackIn
     }
 }
 
-// MyTextRewriter Implementation
-
-Napi::Object MyTextRewriter::Init(Napi::Env env, Napi::Object exports) {
-    Napi::Function func = DefineClass(env, "TextRewriter", {
-        InstanceMethod("RewriteAsync", &MyTextRewriter::MyRewriteAsync)
-    });
-
-    constructor = Napi::Persistent(func);
-    exports.Set("TextRewriter", func);
-    return exports;
-}
-
-MyTextRewriter::MyTextRewriter(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyTextRewriter>(info) {
-    if (info.Length() == 0) {
-        Napi::Error::New(info.Env(), "TextRewriter constructor requires a LanguageModel instance").ThrowAsJavaScriptException();
-        return;
-    }
+Napi::Value MyTextSummarizer::MySummarizeImageTextAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
     
-    // Check if first parameter is an External<TextRewriter> (for internal use)
-    if (info[0].IsExternal()) {
-        auto external = info[0].As<Napi::External<TextRewriter>>();
-        m_rewriter = std::make_shared<TextRewriter>(*external.Data());
-        return;
+    if (!CheckImageTextArguments(info, "SummarizeImageTextAsync")) {
+        return env.Null();
     }
     
-    // Check if first parameter is a MyLanguageModel instance (for direct instantiation)
-    if (info[0].IsObject()) {
-        auto languageModelObj = info[0].As<Napi::Object>();
-        auto languageModelWrapper = Napi::ObjectWrap<MyLanguageModel>::Unwrap(languageModelObj);
-        if (languageModelWrapper) {
+    auto deferred = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "SummarizeImageTextAsync", 0, 1);
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    auto progressPromise = ProgressPromise::Create(env, deferred);
+    auto progressTsfn = progressPromise.GetProgressTsfn();
+
+    try {
+        auto source = std::make_shared<ImageTextSource>(ParseImageTextSource(info));
+        
+        std::thread([deferred, tsfn, tsfn_guard, progressTsfn, summarizer = m_summarizer, source]() {
             try {
-                auto languageModel = languageModelWrapper->GetLanguageModel();
-                if (languageModel) {
-                    m_rewriter = std::make_shared<TextRewriter>(*languageModel);
-                    return;
+                using Clock = std::chrono::steady_clock;
+                auto elapsedMs = [](Clock::time_point start) {
+                    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                };
+                auto totalStart = Clock::now();
+                
+                double decodeMs = 0;
+                double recognizeMs = 0;
+                OcrPage page = RecognizeImageTextSource(*source, decodeMs, recognizeMs);
+                
+                auto stageStart = Clock::now();
+                std::string text = JoinOcrLayoutText(page, AnalyzeOcrLayout(page), source->options.text);
+                double layoutMs = elapsedMs(stageStart);
+                
+                stageStart = Clock::now();
+                winrt::hstring sourceText = winrt::to_hstring(text);
+                bool truncated = false;
+                winrt::hstring promptText = FitTextToSummarizerContext(*summarizer, sourceText, truncated);
+                double fitMs = elapsedMs(stageStart);
+                
+                stageStart = Clock::now();
+                std::optional<LanguageModelResponseResult> result;
+                if (!promptText.empty()) {
+                    auto asyncOp = summarizer->SummarizeAsync(promptText);
+                    asyncOp.Progress([progressTsfn](auto const&, auto const& progressText) {
+                        if (progressTsfn && *progressTsfn) {
+                            auto progressStr = winrt::to_string(progressText);
+                            (*progressTsfn)->NonBlockingCall([progressStr](Napi::Env env, Napi::Function jsCallback) {
+                                try {
+                                    jsCallback.Call({ env.Null(), Napi::String::New(env, progressStr) });
+                                } catch (...) {}
+                            });
+                        }
+                    });
+                    result = asyncOp.get();
                 }
-            } catch (const winrt::hresult_error& ex) {
-                std::string errorMsg = "Failed to create TextRewriter: " + winrt::to_string(ex.message());
-                Napi::Error::New(info.Env(), errorMsg).ThrowAsJavaScriptException();
-                return;
-            } catch (const std::exception& ex) {
-                std::string errorMsg = "Failed to create TextRewriter: " + std::string(ex.what());
-                Napi::Error::New(info.Env(), errorMsg).ThrowAsJavaScriptException();
-                return;
+                double summarizeMs = elapsedMs(stageStart);
+                double totalMs = elapsedMs(totalStart);
+                
+                std::string summary = result ? winrt::to_string(result->Text()) : std::string();
+                int32_t status = result ? static_cast<int32_t>(result->Status()) : 0;
+                uint32_t lineCount = static_cast<uint32_t>(page.lines.size());
+                size_t sourceLength = sourceText.size();
+                size_t promptLength = promptText.size();
+                
+                tsfn.BlockingCall([deferred, summary = std::move(summary), status, lineCount, sourceLength, promptLength, truncated,
+                                   decodeMs, recognizeMs, layoutMs, fitMs, summarizeMs, totalMs](Napi::Env env, Napi::Function) {
+                    auto resultObj = Napi::Object::New(env);
+                    resultObj.Set("text", Napi::String::New(env, summary));
+                    resultObj.Set("status", Napi::Number::New(env, status));
+                    resultObj.Set("lineCount", Napi::Number::New(env, lineCount));
+                    resultObj.Set("sourceLength", Napi::Number::New(env, static_cast<double>(sourceLength)));
+                    resultObj.Set("promptLength", Napi::Number::New(env, static_cast<double>(promptLength)));
+                    resultObj.Set("truncated", Napi::Boolean::New(env, truncated));
+                    auto timingsObj = Napi::Object::New(env);
+                    timingsObj.Set("decodeMs", Napi::Number::New(env, decodeMs));
+                    timingsObj.Set("recognizeMs", Napi::Number::New(env, recognizeMs));
+                    timingsObj.Set("layoutMs", Napi::Number::New(env, layoutMs));
+                    timingsObj.Set("fitMs", Napi::Number::New(env, fitMs));
+                    timingsObj.Set("summarizeMs", Napi::Number::New(env, summarizeMs));
+                    timingsObj.Set("totalMs", Napi::Number::New(env, totalMs));
+                    resultObj.Set("timings", timingsObj);
+                    deferred.Resolve(resultObj);
+                });
+                
             } catch (...) {
-                Napi::Error::New(info.Env(), "Unknown error creating TextRewriter").ThrowAsJavaScriptException();
-                return;
+                RejectWithCurrentException(tsfn, deferred, "SummarizeImageTextAsync");
             }
-        }
+        }).detach();
+        
+        return progressPromise.GetPromiseObject();
+        
+    } catch (const winrt::hresult_error& ex) {
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (...) {
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in SummarizeImageTextAsync").Value());
+        return progressPromise.GetPromiseObject();
     }
-    
-    Napi::Error::New(info.Env(), "TextRewriter constructor requires a valid LanguageModel instance").ThrowAsJavaScriptException();
 }
 
-Napi::Value MyTextRewriter::MyRewriteAsync(const Napi::CallbackInfo& info) {
+Napi::Value MyTextSummarizer::MySummarizeLongTextAsync(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     if (info.Length() < 1 || !info[0].IsString()) {
-        Napi::TypeError::New(env, "RewriteAsync requires at least one string parameter").ThrowAsJavaScriptException();
+        Napi::TypeError::New(env, "SummarizeLongTextAsync requires a string parameter").ThrowAsJavaScriptException();
         return env.Null();
     }
     
     auto deferred = Napi::Promise::Deferred::New(env);
-    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "RewriteAsync", 0, 1);
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "SummarizeLongTextAsync", 0, 1);
     auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
     auto progressPromise = ProgressPromise::Create(env, deferred);
     auto progressTsfn = progressPromise.GetProgressTsfn();
 
     try {
         std::string text = info[0].As<Napi::String>().Utf8Value();
-        winrt::hstring wText = winrt::to_hstring(text);
         
-        // Determine which overload to use based on parameters
-        auto asyncOp = [&]() {
-            if (info.Length() >= 2) {
-                // Debug: Check what type the second parameter is
-                Napi::Value secondParam = info[1];
-                
-                // Check if second parameter is a number or can be converted to number
-                if (secondParam.IsNumber()) {
-                    // RewriteAsync(String, TextRewriteTone) overload
-                    int32_t toneValue = secondParam.As<Napi::Number>().Int32Value();
-                    TextRewriteTone tone = static_cast<TextRewriteTone>(toneValue);
-                    return m_rewriter->RewriteAsync(wText, tone);
-                } else {
-                    throw std::runtime_error("Second parameter must be a TextRewriteTone value");
+        size_t maxParallel = 2;
+        if (info.Length() > 1 && info[1].IsObject()) {
+            auto optionsObj = info[1].As<Napi::Object>();
+            if (optionsObj.Has("maxParallel") && !optionsObj.Get("maxParallel").IsUndefined()) {
+                double value = optionsObj.Get("maxParallel").IsNumber() ? optionsObj.Get("maxParallel").As<Napi::Number>().DoubleValue() : 0.0;
+                if (!(value >= 1.0 && value <= 16.0) || value != std::floor(value)) {
+                    throw std::runtime_error("maxParallel must be an integer between 1 and 16");
                 }
+                maxParallel = static_cast<size_t>(value);
             }
-            // RewriteAsync(String) overload - uses default tone
-            return m_rewriter->RewriteAsync(wText);
-        }();
+        }
         
-        asyncOp.Progress([progressTsfn](auto const&, auto const& progressText) {
-            if (progressTsfn && *progressTsfn) {
-                auto progressStr = winrt::to_string(progressText);
-                (*progressTsfn)->NonBlockingCall([progressStr](Napi::Env env, Napi::Function jsCallback) {
-                    try {
-                        jsCallback.Call({ env.Null(), Napi::String::New(env, progressStr) });
-                    } catch (...) {}
-                });
+        std::thread([deferred, tsfn, tsfn_guard, progressTsfn, summarizer = m_summarizer, text = std::move(text), maxParallel]() {
+            try {
+                // Progress reports each finished chunk summary as { level, chunk, chunkCount, text }
+                auto reportChunk = [progressTsfn](uint32_t level, uint32_t chunk, uint32_t chunkCount, std::string summary) {
+                    if (progressTsfn && *progressTsfn) {
+                        (*progressTsfn)->NonBlockingCall([level, chunk, chunkCount, summary = std::move(summary)](Napi::Env env, Napi::Function jsCallback) {
+                            try {
+                                auto progressObj = Napi::Object::New(env);
+                                progressObj.Set("level", Napi::Number::New(env, level));
+                                progressObj.Set("chunk", Napi::Number::New(env, chunk));
+                                progressObj.Set("chunkCount", Napi::Number::New(env, chunkCount));
+                                progressObj.Set("text", Napi::String::New(env, summary));
+                                jsCallback.Call({ env.Null(), progressObj });
+                            } catch (...) {}
+                        });
+                    }
+                };
+                
+                // Map the chunks of each level to summaries, then reduce the joined summaries until one chunk is left
+                std::string current = text;
+                uint32_t level = 0;
+                uint32_t chunkCount = 0;
+                uint32_t summarizeCalls = 0;
+                std::atomic<uint32_t> skippedChunks{ 0 };
+                std::vector<std::string> chunks = ChunkForSummarizer(*summarizer, current);
+                chunkCount = static_cast<uint32_t>(chunks.size());
+                while (chunks.size() > 1) {
+                    std::vector<std::string> partials(chunks.size());
+                    uint32_t count = static_cast<uint32_t>(chunks.size());
+                    RunConcurrently(chunks.size(), maxParallel, [&](size_t i) {
+                        auto result = summarizer->SummarizeAsync(winrt::to_hstring(chunks[i])).get();
+                        if (result.Status() == LanguageModelResponseStatus::Complete) {
+                            partials[i] = winrt::to_string(result.Text());
+                        } else {
+                            skippedChunks++;
+                        }
+                        reportChunk(level, static_cast<uint32_t>(i), count, partials[i]);
+                    });
+                    summarizeCalls += count;
+                    
+                    std::string next;
+                    for (const auto& partial : partials) {
+                        if (partial.empty()) {
+                            continue;
+                        }
+                        if (!next.empty()) {
+                            next += "\n\n";
+                        }
+                        next += partial;
+                    }
+                    if (next.empty()) {
+                        throw std::runtime_error("The summarizer rejected every chunk of the text");
+                    }
+                    level++;
+                    
+                    // Summaries that do not shrink the text would never converge, keep what fits instead
+                    if (next.size() >= current.size()) {
+                        bool truncated = false;
+                        chunks = { winrt::to_string(FitTextToSummarizerContext(*summarizer, winrt::to_hstring(next), truncated)) };
+                        break;
+                    }
+                    current = std::move(next);
+                    chunks = ChunkForSummarizer(*summarizer, current);
+                }
+                
+                std::string finalText;
+                int32_t status = 0;
+                if (!chunks.empty() && !chunks[0].empty()) {
+                    auto result = summarizer->SummarizeAsync(winrt::to_hstring(chunks[0])).get();
+                    summarizeCalls++;
+                    finalText = winrt::to_string(result.Text());
+                    status = static_cast<int32_t>(result.Status());
+                    reportChunk(level, 0, 1, finalText);
+                }
+                uint32_t levels = level + 1;
+                uint32_t skipped = skippedChunks.load();
+                
+                tsfn.BlockingCall([deferred, finalText = std::move(finalText), status, chunkCount, levels, summarizeCalls, skipped](Napi::Env env, Napi::Function) {
+                    auto resultObj = Napi::Object::New(env);
+                    resultObj.Set("text", Napi::String::New(env, finalText));
+                    resultObj.Set("status", Napi::Number::New(env, status));
+                    resultObj.Set("chunkCount", Napi::Number::New(env, chunkCount));
+                    resultObj.Set("levels", Napi::Number::New(env, levels));
+                    resultObj.Set("summarizeCalls", Napi::Number::New(env, summarizeCalls));
+                    resultObj.Set("skippedChunks", Napi::Number::New(env, skipped));
+                    deferred.Resolve(resultObj);
+                });
+                
+            } catch (const winrt::hresult_error& ex) {
+                tsfn.BlockingCall([deferred, message = winrt::to_string(ex.message())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (const std::exception& ex) {
+                tsfn.BlockingCall([deferred, message = std::string(ex.what())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (...) {
+                tsfn.BlockingCall([deferred](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, "Unknown error occurred in SummarizeLongTextAsync").Value());
+                });
+            }
+        }).detach();
+        
+        return progressPromise.GetPromiseObject();
+        
+    } catch (const winrt::hresult_error& ex) {
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (...) {
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in SummarizeLongTextAsync").Value());
+        return progressPromise.GetPromiseObject();
+    }
+}
+
+std::optional<ContextFitCache::Entry> ContextFitCache::Lookup(uint64_t hash, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(hash);
+    if (it == entries.end() || it->second.length != length) {
+        misses++;
+        return std::nullopt;
+    }
+    hits++;
+    return it->second;
+}
+
+void ContextFitCache::Store(uint64_t hash, const Entry& entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (capacity == 0) {
+        return;
+    }
+    if (entries.insert_or_assign(hash, entry).second) {
+        order.push_back(hash);
+    }
+    while (entries.size() > capacity) {
+        entries.erase(order.front());
+        order.pop_front();
+    }
+}
+
+Napi::Value MyTextSummarizer::MyFitToContextAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || (!info[0].IsString() && !info[0].IsArray())) {
+        Napi::TypeError::New(env, "FitToContextAsync requires a string or an array of strings").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    auto deferred = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "FitToContextAsync", 0, 1);
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    
+    try {
+        bool single = info[0].IsString();
+        std::vector<winrt::hstring> texts;
+        if (single) {
+            texts.push_back(winrt::to_hstring(info[0].As<Napi::String>().Utf8Value()));
+        } else {
+            auto textsArray = info[0].As<Napi::Array>();
+            texts.reserve(textsArray.Length());
+            for (uint32_t i = 0; i < textsArray.Length(); i++) {
+                auto value = textsArray.Get(i);
+                if (!value.IsString()) {
+                    throw std::runtime_error("Every entry of the array must be a string");
+                }
+                texts.push_back(winrt::to_hstring(value.As<Napi::String>().Utf8Value()));
+            }
+        }
+        
+        std::thread([deferred, tsfn, tsfn_guard, summarizer = m_summarizer, cache = m_fitCache, texts = std::move(texts), single]() {
+            try {
+                struct Fit {
+                    size_t length = 0;
+                    size_t prefixLength = 0;
+                    uint32_t checks = 0;
+                    bool cached = false;
+                };
+                std::vector<Fit> fits(texts.size());
+                
+                // Each text needs at least one model check; independent texts are checked side by side
+                RunConcurrently(texts.size(), 4, [&](size_t i) {
+                    std::wstring_view view(texts[i]);
+                    Fit& fit = fits[i];
+                    fit.length = view.size();
+                    uint64_t hash = ComputeContentHash(view.data(), view.size() * sizeof(wchar_t));
+                    if (auto entry = cache->Lookup(hash, view.size())) {
+                        fit.prefixLength = entry->prefixLength;
+                        fit.cached = true;
+                        return;
+                    }
+                    fit.prefixLength = LongestFittingPrefix(*summarizer, view, fit.checks);
+                    cache->Store(hash, { view.size(), fit.prefixLength });
+                });
+                
+                tsfn.BlockingCall([deferred, fits = std::move(fits), single](Napi::Env env, Napi::Function) {
+                    auto toObject = [&env](const Fit& fit) {
+                        auto fitObj = Napi::Object::New(env);
+                        fitObj.Set("fits", Napi::Boolean::New(env, fit.prefixLength == fit.length));
+                        fitObj.Set("length", Napi::Number::New(env, static_cast<double>(fit.length)));
+                        fitObj.Set("prefixLength", Napi::Number::New(env, static_cast<double>(fit.prefixLength)));
+                        fitObj.Set("checks", Napi::Number::New(env, fit.checks));
+                        fitObj.Set("cached", Napi::Boolean::New(env, fit.cached));
+                        return fitObj;
+                    };
+                    if (single) {
+                        deferred.Resolve(toObject(fits.front()));
+                        return;
+                    }
+                    auto resultArray = Napi::Array::New(env, fits.size());
+                    for (size_t i = 0; i < fits.size(); i++) {
+                        resultArray.Set(static_cast<uint32_t>(i), toObject(fits[i]));
+                    }
+                    deferred.Resolve(resultArray);
+                });
+                
+            } catch (const winrt::hresult_error& ex) {
+                tsfn.BlockingCall([deferred, message = winrt::to_string(ex.message())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (const std::exception& ex) {
+                tsfn.BlockingCall([deferred, message = std::string(ex.what())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (...) {
+                tsfn.BlockingCall([deferred](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, "Unknown error occurred in FitToContextAsync").Value());
+                });
+            }
+        }).detach();
+        
+        return deferred.Promise();
+        
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return deferred.Promise();
+    }
+}
+
+
+std::optional<std::string> ParagraphCache::Lookup(uint64_t hash) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(hash);
+    if (it == entries.end()) {
+        misses++;
+        return std::nullopt;
+    }
+    hits++;
+    return it->second;
+}
+
+void ParagraphCache::Store(uint64_t hash, const std::string& value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (capacity == 0) {
+        return;
+    }
+    if (entries.insert_or_assign(hash, value).second) {
+        order.push_back(hash);
+    }
+    while (entries.size() > capacity) {
+        entries.erase(order.front());
+        order.pop_front();
+    }
+}
+
+Napi::Value MyTextSummarizer::MySummarizeDocumentAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "SummarizeDocumentAsync requires a string parameter").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    auto deferred = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "SummarizeDocumentAsync", 0, 1);
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    auto progressPromise = ProgressPromise::Create(env, deferred);
+    auto progressTsfn = progressPromise.GetProgressTsfn();
+
+    try {
+        std::string text = info[0].As<Napi::String>().Utf8Value();
+        
+        size_t maxParallel = 2;
+        size_t minParagraphLength = 200;
+        if (info.Length() > 1 && info[1].IsObject()) {
+            auto optionsObj = info[1].As<Napi::Object>();
+            if (optionsObj.Has("maxParallel") && !optionsObj.Get("maxParallel").IsUndefined()) {
+                double value = optionsObj.Get("maxParallel").IsNumber() ? optionsObj.Get("maxParallel").As<Napi::Number>().DoubleValue() : 0.0;
+                if (!(value >= 1.0 && value <= 16.0) || value != std::floor(value)) {
+                    throw std::runtime_error("maxParallel must be an integer between 1 and 16");
+                }
+                maxParallel = static_cast<size_t>(value);
+            }
+            if (optionsObj.Has("minParagraphLength") && !optionsObj.Get("minParagraphLength").IsUndefined()) {
+                double value = optionsObj.Get("minParagraphLength").IsNumber() ? optionsObj.Get("minParagraphLength").As<Napi::Number>().DoubleValue() : -1.0;
+                if (!(value >= 0.0) || value != std::floor(value)) {
+                    throw std::runtime_error("minParagraphLength must be a non-negative integer");
+                }
+                minParagraphLength = static_cast<size_t>(value);
+            }
+        }
+        
+        std::thread([deferred, tsfn, tsfn_guard, progressTsfn, summarizer = m_summarizer, cache = m_paragraphCache, text = std::move(text), maxParallel, minParagraphLength]() {
+            try {
+                // Progress reports each recomputed paragraph summary as { paragraph, paragraphCount, text }
+                auto reportParagraph = [progressTsfn](uint32_t paragraph, uint32_t paragraphCount, std::string summary) {
+                    if (progressTsfn && *progressTsfn) {
+                        (*progressTsfn)->NonBlockingCall([paragraph, paragraphCount, summary = std::move(summary)](Napi::Env env, Napi::Function jsCallback) {
+                            try {
+                                auto progressObj = Napi::Object::New(env);
+                                progressObj.Set("paragraph", Napi::Number::New(env, paragraph));
+                                progressObj.Set("paragraphCount", Napi::Number::New(env, paragraphCount));
+                                progressObj.Set("text", Napi::String::New(env, summary));
+                                jsCallback.Call({ env.Null(), progressObj });
+                            } catch (...) {}
+                        });
+                    }
+                };
+                
+                // Short paragraphs (headings, captions) are kept as they are, the rest are looked up by content hash
+                std::vector<TextChunk> paragraphs = SplitParagraphs(text);
+                uint32_t paragraphCount = static_cast<uint32_t>(paragraphs.size());
+                std::vector<std::string> parts(paragraphs.size());
+                std::vector<uint64_t> hashes(paragraphs.size());
+                std::vector<size_t> stale;
+                uint32_t verbatimParagraphs = 0;
+                for (size_t i = 0; i < paragraphs.size(); i++) {
+                    std::string_view paragraph = std::string_view(text).substr(paragraphs[i].offset, paragraphs[i].length);
+                    if (paragraph.size() < minParagraphLength) {
+                        parts[i] = std::string(paragraph);
+                        verbatimParagraphs++;
+                        continue;
+                    }
+                    hashes[i] = ComputeContentHash(paragraph.data(), paragraph.size());
+                    if (auto summary = cache->Lookup(hashes[i])) {
+                        parts[i] = std::move(*summary);
+                    } else {
+                        stale.push_back(i);
+                    }
+                }
+                
+                std::atomic<uint32_t> skippedParagraphs{ 0 };
+                std::atomic<uint32_t> truncatedParagraphs{ 0 };
+                RunConcurrently(stale.size(), maxParallel, [&](size_t j) {
+                    size_t i = stale[j];
+                    bool truncated = false;
+                    winrt::hstring paragraph = FitTextToSummarizerContext(*summarizer, winrt::to_hstring(std::string_view(text).substr(paragraphs[i].offset, paragraphs[i].length)), truncated);
+                    if (truncated) {
+                        truncatedParagraphs++;
+                    }
+                    auto result = summarizer->SummarizeParagraphAsync(paragraph).get();
+                    if (result.Status() == LanguageModelResponseStatus::Complete && !result.Text().empty()) {
+                        parts[i] = winrt::to_string(result.Text());
+                        cache->Store(hashes[i], parts[i]);
+                    } else {
+                        // Not cached, so the paragraph is tried again next time
+                        parts[i] = std::string(std::string_view(text).substr(paragraphs[i].offset, paragraphs[i].length));
+                        skippedParagraphs++;
+                    }
+                    reportParagraph(static_cast<uint32_t>(i), paragraphCount, parts[i]);
+                });
+                
+                std::string joined;
+                for (const auto& part : parts) {
+                    if (!joined.empty()) {
+                        joined += "\n\n";
+                    }
+                    joined += part;
+                }
+                
+                // The document summary is keyed by the joined paragraph summaries, so it is reused when no paragraph changed
+                std::string summary;
+                int32_t status = static_cast<int32_t>(LanguageModelResponseStatus::Complete);
+                bool truncated = false;
+                bool combinedFromCache = false;
+                uint32_t summarizeCalls = static_cast<uint32_t>(stale.size());
+                if (!joined.empty()) {
+                    uint64_t combinedHash = ComputeContentHash(joined.data(), joined.size(), 1);
+                    if (auto cached = cache->Lookup(combinedHash)) {
+                        summary = std::move(*cached);
+                        combinedFromCache = true;
+                    } else {
+                        winrt::hstring prompt = FitTextToSummarizerContext(*summarizer, winrt::to_hstring(joined), truncated);
+                        auto result = summarizer->SummarizeAsync(prompt).get();
+                        summarizeCalls++;
+                        summary = winrt::to_string(result.Text());
+                        status = static_cast<int32_t>(result.Status());
+                        if (result.Status() == LanguageModelResponseStatus::Complete && skippedParagraphs == 0) {
+                            cache->Store(combinedHash, summary);
+                        }
+                    }
+                }
+                
+                uint32_t recomputed = static_cast<uint32_t>(stale.size());
+                uint32_t cachedParagraphs = paragraphCount - verbatimParagraphs - recomputed;
+                uint32_t skipped = skippedParagraphs.load();
+                uint32_t truncatedCount = truncatedParagraphs.load();
+                tsfn.BlockingCall([deferred, summary = std::move(summary), status, paragraphCount, recomputed, cachedParagraphs, verbatimParagraphs,
+                                   skipped, truncatedCount, truncated, combinedFromCache, summarizeCalls](Napi::Env env, Napi::Function) {
+                    auto resultObj = Napi::Object::New(env);
+                    resultObj.Set("text", Napi::String::New(env, summary));
+                    resultObj.Set("status", Napi::Number::New(env, status));
+                    resultObj.Set("paragraphCount", Napi::Number::New(env, paragraphCount));
+                    resultObj.Set("recomputedParagraphs", Napi::Number::New(env, recomputed));
+                    resultObj.Set("cachedParagraphs", Napi::Number::New(env, cachedParagraphs));
+                    resultObj.Set("verbatimParagraphs", Napi::Number::New(env, verbatimParagraphs));
+                    resultObj.Set("skippedParagraphs", Napi::Number::New(env, skipped));
+                    resultObj.Set("truncatedParagraphs", Napi::Number::New(env, truncatedCount));
+                    resultObj.Set("truncated", Napi::Boolean::New(env, truncated));
+                    resultObj.Set("combinedFromCache", Napi::Boolean::New(env, combinedFromCache));
+                    resultObj.Set("summarizeCalls", Napi::Number::New(env, summarizeCalls));
+                    deferred.Resolve(resultObj);
+                });
+                
+            } catch (const winrt::hresult_error& ex) {
+                tsfn.BlockingCall([deferred, message = winrt::to_string(ex.message())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (const std::exception& ex) {
+                tsfn.BlockingCall([deferred, message = std::string(ex.what())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (...) {
+                tsfn.BlockingCall([deferred](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, "Unknown error occurred in SummarizeDocumentAsync").Value());
+                });
+            }
+        }).detach();
+        
+        return progressPromise.GetPromiseObject();
+        
+    } catch (const winrt::hresult_error& ex) {
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (...) {
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in SummarizeDocumentAsync").Value());
+        return progressPromise.GetPromiseObject();
+    }
+}
+
+Napi::Value MyTextSummarizer::MySummarizeBatchAsync(const Napi::CallbackInfo& info) {
+    return StartBatch(info, "SummarizeBatchAsync", [summarizer = m_summarizer](const Napi::Value& options) -> BatchRunner {
+        bool paragraph = false;
+        if (options.IsObject() && options.As<Napi::Object>().Has("paragraph") && !options.As<Napi::Object>().Get("paragraph").IsUndefined()) {
+            if (!options.As<Napi::Object>().Get("paragraph").IsBoolean()) {
+                throw std::runtime_error("paragraph must be a boolean");
+            }
+            paragraph = options.As<Napi::Object>().Get("paragraph").As<Napi::Boolean>().Value();
+        }
+        return [summarizer, paragraph](const winrt::hstring& text) {
+            auto result = (paragraph ? summarizer->SummarizeParagraphAsync(text) : summarizer->SummarizeAsync(text)).get();
+            BatchItemResult item;
+            item.status = static_cast<int32_t>(result.Status());
+            item.text = winrt::to_string(result.Text());
+            return item;
+        };
+    });
+}
+
+// MyConversationSummarySession Implementation
+
+Napi::Object MyConversationSummarySession::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "ConversationSummarySession", {
+        InstanceMethod("AppendAsync", &MyConversationSummarySession::MyAppendAsync),
+        InstanceMethod("GetSummary", &MyConversationSummarySession::MyGetSummary),
+        InstanceMethod("Checkpoint", &MyConversationSummarySession::MyCheckpoint),
+        InstanceMethod("Restore", &MyConversationSummarySession::MyRestore),
+        InstanceMethod("Reset", &MyConversationSummarySession::MyReset)
+    });
+
+    constructor = Napi::Persistent(func);
+    exports.Set("ConversationSummarySession", func);
+    return exports;
+}
+
+MyConversationSummarySession::MyConversationSummarySession(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyConversationSummarySession>(info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsObject() || !info[0].As<Napi::Object>().InstanceOf(MyTextSummarizer::constructor.Value())) {
+        Napi::TypeError::New(env, "ConversationSummarySession requires a TextSummarizer instance").ThrowAsJavaScriptException();
+        return;
+    }
+    if (info.Length() > 1 && !info[1].IsUndefined() && !info[1].IsObject()) {
+        Napi::TypeError::New(env, "Second parameter must be an options object { includeMessageCitations, includeParticipantAttribution, state }").ThrowAsJavaScriptException();
+        return;
+    }
+    
+    try {
+        m_summarizer = Napi::ObjectWrap<MyTextSummarizer>::Unwrap(info[0].As<Napi::Object>())->GetSummarizer();
+        m_options = ParseConversationSummaryOptions(info.Length() > 1 ? info[1] : env.Undefined());
+        if (info.Length() > 1 && info[1].IsObject() && info[1].As<Napi::Object>().Has("state")) {
+            if (!ReadConversationCheckpoint(info[1].As<Napi::Object>().Get("state"), m_state->summary, m_state->itemCount)) {
+                Napi::TypeError::New(env, "state must be a checkpoint { summary: string, itemCount: number }").ThrowAsJavaScriptException();
+            }
+        }
+    } catch (const winrt::hresult_error& ex) {
+        Napi::Error::New(env, winrt::to_string(ex.message())).ThrowAsJavaScriptException();
+    }
+}
+
+Napi::Value MyConversationSummarySession::MyAppendAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "AppendAsync requires conversation items: ConversationItem or { participant, message } objects, or { participants, messages } string arrays").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    auto deferred = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "AppendAsync", 0, 1);
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    auto progressPromise = ProgressPromise::Create(env, deferred);
+    auto progressTsfn = progressPromise.GetProgressTsfn();
+
+    try {
+        std::vector<ConversationItem> items = ParseConversationItems(info[0]);
+        
+        uint64_t ticket = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            ticket = m_state->nextTicket++;
+        }
+        
+        std::thread([deferred, tsfn, tsfn_guard, progressTsfn, summarizer = m_summarizer, options = m_options, state = m_state, items = std::move(items), ticket]() {
+            // Lets the next append run however this one ends
+            auto turn_guard = std::shared_ptr<void>(nullptr, [state](void*) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->servingTicket++;
+                state->turn.notify_all();
+            });
+            try {
+                winrt::hstring previous;
+                uint64_t itemCount = 0;
+                uint64_t generation = 0;
+                {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    state->turn.wait(lock, [&state, ticket]() { return state->servingTicket == ticket; });
+                    previous = state->summary;
+                    itemCount = state->itemCount;
+                    generation = state->generation;
+                }
+                
+                // Only the new items are summarized, after the previous summary standing in for everything before them
+                winrt::hstring summary = previous;
+                int32_t status = static_cast<int32_t>(LanguageModelResponseStatus::Complete);
+                ConversationFitReport report;
+                if (!items.empty()) {
+                    std::vector<ConversationItem> prompt;
+                    prompt.reserve(items.size() + 1);
+                    if (!previous.empty()) {
+                        ConversationItem summaryItem;
+                        summaryItem.Participant(kEarlierConversationParticipant);
+                        summaryItem.Message(previous);
+                        prompt.push_back(summaryItem);
+                    }
+                    prompt.insert(prompt.end(), items.begin(), items.end());
+                    prompt = CondenseOldestToFit(*summarizer, prompt, options, report, 0);
+                    
+                    report.summarizeCalls++;
+                    auto asyncOp = summarizer->SummarizeConversationAsync(winrt::single_threaded_vector(std::move(prompt)).GetView(), options);
+                    asyncOp.Progress([progressTsfn](auto const&, auto const& progressText) {
+                        if (progressTsfn && *progressTsfn) {
+                            auto progressStr = winrt::to_string(progressText);
+                            (*progressTsfn)->NonBlockingCall([progressStr](Napi::Env env, Napi::Function jsCallback) {
+                                try {
+                                    jsCallback.Call({ env.Null(), Napi::String::New(env, progressStr) });
+                                } catch (...) {}
+                            });
+                        }
+                    });
+                    auto result = asyncOp.get();
+                    status = static_cast<int32_t>(result.Status());
+                    
+                    // A refused or empty summary leaves the session where it was, so the items can be appended again
+                    if (result.Status() == LanguageModelResponseStatus::Complete && !result.Text().empty()) {
+                        std::lock_guard<std::mutex> lock(state->mutex);
+                        if (state->generation == generation) {
+                            summary = result.Text();
+                            itemCount += items.size();
+                            state->summary = summary;
+                            state->itemCount = itemCount;
+                        }
+                    }
+                }
+                
+                std::string text = winrt::to_string(summary);
+                uint32_t appendedItems = static_cast<uint32_t>(items.size());
+                tsfn.BlockingCall([deferred, text = std::move(text), status, itemCount, appendedItems, report](Napi::Env env, Napi::Function) {
+                    auto resultObj = Napi::Object::New(env);
+                    resultObj.Set("text", Napi::String::New(env, text));
+                    resultObj.Set("status", Napi::Number::New(env, status));
+                    resultObj.Set("itemCount", Napi::Number::New(env, static_cast<double>(itemCount)));
+                    resultObj.Set("appendedItems", Napi::Number::New(env, appendedItems));
+                    resultObj.Set("condensedItems", Napi::Number::New(env, report.condensedItems));
+                    resultObj.Set("droppedItems", Napi::Number::New(env, report.droppedItems));
+                    resultObj.Set("summarizeCalls", Napi::Number::New(env, report.summarizeCalls));
+                    deferred.Resolve(resultObj);
+                });
+                
+            } catch (const winrt::hresult_error& ex) {
+                tsfn.BlockingCall([deferred, message = winrt::to_string(ex.message())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (const std::exception& ex) {
+                tsfn.BlockingCall([deferred, message = std::string(ex.what())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (...) {
+                tsfn.BlockingCall([deferred](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, "Unknown error occurred in AppendAsync").Value());
+                });
+            }
+        }).detach();
+        
+        return progressPromise.GetPromiseObject();
+        
+    } catch (const winrt::hresult_error& ex) {
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (...) {
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in AppendAsync").Value());
+        return progressPromise.GetPromiseObject();
+    }
+}
+
+Napi::Value MyConversationSummarySession::MyGetSummary(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return Napi::String::New(env, winrt::to_string(m_state->summary));
+}
+
+Napi::Value MyConversationSummarySession::MyCheckpoint(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    auto stateObj = Napi::Object::New(env);
+    stateObj.Set("summary", Napi::String::New(env, winrt::to_string(m_state->summary)));
+    stateObj.Set("itemCount", Napi::Number::New(env, static_cast<double>(m_state->itemCount)));
+    return stateObj;
+}
+
+Napi::Value MyConversationSummarySession::MyRestore(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    winrt::hstring summary;
+    uint64_t itemCount = 0;
+    if (info.Length() < 1 || !ReadConversationCheckpoint(info[0], summary, itemCount)) {
+        Napi::TypeError::New(env, "Restore requires a checkpoint { summary: string, itemCount: number }").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->summary = summary;
+    m_state->itemCount = itemCount;
+    m_state->generation++;
+    return env.Undefined();
+}
+
+Napi::Value MyConversationSummarySession::MyReset(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->summary = winrt::hstring();
+    m_state->itemCount = 0;
+    m_state->generation++;
+    return env.Undefined();
+}
+
+// MyTextRewriter Implementation
+
+Napi::Object MyTextRewriter::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "TextRewriter", {
+        InstanceMethod("RewriteAsync", &MyTextRewriter::MyRewriteAsync),
+        InstanceMethod("RewriteDocumentAsync", &MyTextRewriter::MyRewriteDocumentAsync),
+        InstanceMethod("RewriteBatchAsync", &MyTextRewriter::MyRewriteBatchAsync)
+    });
+
+    constructor = Napi::Persistent(func);
+    exports.Set("TextRewriter", func);
+    return exports;
+}
+
+MyTextRewriter::MyTextRewriter(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyTextRewriter>(info) {
+    if (info.Length() == 0) {
+        Napi::Error::New(info.Env(), "TextRewriter constructor requires a LanguageModel instance").ThrowAsJavaScriptException();
+        return;
+    }
+    
+    // Check if first parameter is an External<TextRewriter> (for internal use)
+    if (info[0].IsExternal()) {
+        auto external = info[0].As<Napi::External<TextRewriter>>();
+        m_rewriter = std::make_shared<TextRewriter>(*external.Data());
+        return;
+    }
+    
+    // Check if first parameter is a MyLanguageModel instance (for direct instantiation)
+    if (info[0].IsObject()) {
+        auto languageModelObj = info[0].As<Napi::Object>();
+        auto languageModelWrapper = Napi::ObjectWrap<MyLanguageModel>::Unwrap(languageModelObj);
+        if (languageModelWrapper) {
+            try {
+                auto languageModel = languageModelWrapper->GetLanguageModel();
+                if (languageModel) {
+                    m_rewriter = std::make_shared<TextRewriter>(*languageModel);
+                    return;
+                }
+            } catch (const winrt::hresult_error& ex) {
+                std::string errorMsg = "Failed to create TextRewriter: " + winrt::to_string(ex.message());
+                Napi::Error::New(info.Env(), errorMsg).ThrowAsJavaScriptException();
+                return;
+            } catch (const std::exception& ex) {
+                std::string errorMsg = "Failed to create TextRewriter: " + std::string(ex.what());
+                Napi::Error::New(info.Env(), errorMsg).ThrowAsJavaScriptException();
+                return;
+            } catch (...) {
+                Napi::Error::New(info.Env(), "Unknown error creating TextRewriter").ThrowAsJavaScriptException();
+                return;
+            }
+        }
+    }
+    
+    Napi::Error::New(info.Env(), "TextRewriter constructor requires a valid LanguageModel instance").ThrowAsJavaScriptException();
+}
+
+Napi::Value MyTextRewriter::MyRewriteAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "RewriteAsync requires at least one string parameter").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    auto deferred = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "RewriteAsync", 0, 1);
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    auto progressPromise = ProgressPromise::Create(env, deferred);
+    auto progressTsfn = progressPromise.GetProgressTsfn();
+
+    try {
+        std::string text = info[0].As<Napi::String>().Utf8Value();
+        winrt::hstring wText = winrt::to_hstring(text);
+        
+        // Stop options follow the tone, or take its place
+        size_t optionsIndex = info.Length() >= 2 && info[1].IsObject() ? 1 : 2;
+        StopConditions stopConditions = info.Length() > optionsIndex && info[optionsIndex].IsObject() ? ParseStopConditions(info[optionsIndex].As<Napi::Object>()) : StopConditions();
+        
+        // Determine which overload to use based on parameters
+        auto asyncOp = [&]() {
+            if (info.Length() >= 2 && optionsIndex == 2 && !info[1].IsUndefined()) {
+                // Debug: Check what type the second parameter is
+                Napi::Value secondParam = info[1];
+                
+                // Check if second parameter is a number or can be converted to number
+                if (secondParam.IsNumber()) {
+                    // RewriteAsync(String, TextRewriteTone) overload
+                    int32_t toneValue = secondParam.As<Napi::Number>().Int32Value();
+                    TextRewriteTone tone = static_cast<TextRewriteTone>(toneValue);
+                    return m_rewriter->RewriteAsync(wText, tone);
+                } else {
+                    throw std::runtime_error("Second parameter must be a TextRewriteTone value");
+                }
+            }
+            // RewriteAsync(String) overload - uses default tone
+            return m_rewriter->RewriteAsync(wText);
+        }();
+        
+        if (stopConditions.Any()) {
+            HandleStoppableResponse(asyncOp, "RewriteAsync", stopConditions, deferred, tsfn, tsfn_guard, progressTsfn);
+            return progressPromise.GetPromiseObject();
+        }
+        
+        asyncOp.Progress([progressTsfn](auto const&, auto const& progressText) {
+            if (progressTsfn && *progressTsfn) {
+                auto progressStr = winrt::to_string(progressText);
+                (*progressTsfn)->NonBlockingCall([progressStr](Napi::Env env, Napi::Function jsCallback) {
+                    try {
+                        jsCallback.Call({ env.Null(), Napi::String::New(env, progressStr) });
+                    } catch (...) {}
+                });
             }
         });
         
@@ -1174,10 +3028,398 @@ Napi::Value MyTextRewriter::MyRewriteAsync(const Napi::CallbackInfo& info) {
     }
 }
 
+Napi::Value MyTextRewriter::MyRewriteDocumentAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "RewriteDocumentAsync requires a string parameter").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    auto deferred = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "RewriteDocumentAsync", 0, 1);
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    auto progressPromise = ProgressPromise::Create(env, deferred);
+    auto progressTsfn = progressPromise.GetProgressTsfn();
+
+    try {
+        std::string text = info[0].As<Napi::String>().Utf8Value();
+        
+        std::optional<TextRewriteTone> tone;
+        size_t maxParallel = 2;
+        if (info.Length() > 1 && info[1].IsObject()) {
+            auto optionsObj = info[1].As<Napi::Object>();
+            if (optionsObj.Has("tone") && !optionsObj.Get("tone").IsUndefined()) {
+                if (!optionsObj.Get("tone").IsNumber()) {
+                    throw std::runtime_error("tone must be a TextRewriteTone value");
+                }
+                tone = static_cast<TextRewriteTone>(optionsObj.Get("tone").As<Napi::Number>().Int32Value());
+            }
+            if (optionsObj.Has("maxParallel") && !optionsObj.Get("maxParallel").IsUndefined()) {
+                double value = optionsObj.Get("maxParallel").IsNumber() ? optionsObj.Get("maxParallel").As<Napi::Number>().DoubleValue() : 0.0;
+                if (!(value >= 1.0 && value <= 16.0) || value != std::floor(value)) {
+                    throw std::runtime_error("maxParallel must be an integer between 1 and 16");
+                }
+                maxParallel = static_cast<size_t>(value);
+            }
+        }
+        
+        std::thread([deferred, tsfn, tsfn_guard, progressTsfn, rewriter = m_rewriter, cache = m_paragraphCache, text = std::move(text), tone, maxParallel]() {
+            try {
+                // Progress reports each rewritten paragraph as { paragraph, paragraphCount, text }
+                auto reportParagraph = [progressTsfn](uint32_t paragraph, uint32_t paragraphCount, std::string rewrite) {
+                    if (progressTsfn && *progressTsfn) {
+                        (*progressTsfn)->NonBlockingCall([paragraph, paragraphCount, rewrite = std::move(rewrite)](Napi::Env env, Napi::Function jsCallback) {
+                            try {
+                                auto progressObj = Napi::Object::New(env);
+                                progressObj.Set("paragraph", Napi::Number::New(env, paragraph));
+                                progressObj.Set("paragraphCount", Napi::Number::New(env, paragraphCount));
+                                progressObj.Set("text", Napi::String::New(env, rewrite));
+                                jsCallback.Call({ env.Null(), progressObj });
+                            } catch (...) {}
+                        });
+                    }
+                };
+                // Rewrites are keyed by paragraph content and tone
+                uint64_t toneKey = tone ? static_cast<uint64_t>(static_cast<int32_t>(*tone)) : UINT64_MAX;
+                auto keyOf = [toneKey](std::string_view paragraph) {
+                    return CombineHash(ComputeContentHash(paragraph.data(), paragraph.size()), toneKey);
+                };
+                
+                std::vector<TextChunk> paragraphs = SplitParagraphs(text);
+                uint32_t paragraphCount = static_cast<uint32_t>(paragraphs.size());
+                std::vector<std::string> rewrites(paragraphs.size());
+                std::vector<size_t> stale;
+                for (size_t i = 0; i < paragraphs.size(); i++) {
+                    std::string_view paragraph = std::string_view(text).substr(paragraphs[i].offset, paragraphs[i].length);
+                    if (auto rewrite = cache->Lookup(keyOf(paragraph))) {
+                        rewrites[i] = std::move(*rewrite);
+                    } else {
+                        stale.push_back(i);
+                    }
+                }
+                
+                std::atomic<uint32_t> skippedParagraphs{ 0 };
+                RunConcurrently(stale.size(), maxParallel, [&](size_t j) {
+                    size_t i = stale[j];
+                    std::string_view paragraph = std::string_view(text).substr(paragraphs[i].offset, paragraphs[i].length);
+                    winrt::hstring source = winrt::to_hstring(paragraph);
+                    auto result = (tone ? rewriter->RewriteAsync(source, *tone) : rewriter->RewriteAsync(source)).get();
+                    std::string rewrite = result.Status() == LanguageModelResponseStatus::Complete ? winrt::to_string(result.Text()) : std::string();
+                    size_t first = rewrite.find_first_not_of(" \t\r\n");
+                    rewrite = first == std::string::npos ? std::string() : rewrite.substr(first, rewrite.find_last_not_of(" \t\r\n") - first + 1);
+                    if (rewrite.empty()) {
+                        // Left as it is and not cached, so the paragraph is tried again next time
+                        rewrites[i] = std::string(paragraph);
+                        skippedParagraphs++;
+                        return;
+                    }
+                    cache->Store(keyOf(paragraph), rewrite);
+                    // Once the caller applies the edits the rewrite is the paragraph, which must not be rewritten again
+                    cache->Store(keyOf(rewrite), rewrite);
+                    rewrites[i] = std::move(rewrite);
+                    reportParagraph(static_cast<uint32_t>(i), paragraphCount, rewrites[i]);
+                });
+                
+                // Edits in UTF-16 offsets of the input, so they apply to the JS string directly
+                struct Edit {
+                    size_t start;
+                    size_t end;
+                    std::string replacement;
+                };
+                std::vector<Edit> edits;
+                size_t bytesCounted = 0;
+                size_t unitsCounted = 0;
+                for (size_t i = 0; i < paragraphs.size(); i++) {
+                    std::string_view paragraph = std::string_view(text).substr(paragraphs[i].offset, paragraphs[i].length);
+                    unitsCounted += Utf16Length(std::string_view(text).substr(bytesCounted, paragraphs[i].offset - bytesCounted));
+                    bytesCounted = paragraphs[i].offset;
+                    if (rewrites[i] != paragraph) {
+                        winrt::hstring before = winrt::to_hstring(paragraph);
+                        winrt::hstring after = winrt::to_hstring(rewrites[i]);
+                        std::wstring_view afterView(after);
+                        for (const auto& edit : DiffWords(before, afterView)) {
+                            edits.push_back({ unitsCounted + edit.start, unitsCounted + edit.end,
+                                              winrt::to_string(afterView.substr(edit.replacementStart, edit.replacementEnd - edit.replacementStart)) });
+                        }
+                    }
+                }
+                
+                uint32_t rewritten = static_cast<uint32_t>(stale.size()) - skippedParagraphs.load();
+                uint32_t cachedParagraphs = paragraphCount - static_cast<uint32_t>(stale.size());
+                uint32_t skipped = skippedParagraphs.load();
+                tsfn.BlockingCall([deferred, edits = std::move(edits), paragraphCount, rewritten, cachedParagraphs, skipped](Napi::Env env, Napi::Function) {
+                    auto editsArray = Napi::Array::New(env, edits.size());
+                    for (size_t i = 0; i < edits.size(); i++) {
+                        auto rangeArray = Napi::Array::New(env, 2);
+                        rangeArray.Set(uint32_t(0), Napi::Number::New(env, static_cast<double>(edits[i].start)));
+                        rangeArray.Set(uint32_t(1), Napi::Number::New(env, static_cast<double>(edits[i].end)));
+                        auto editObj = Napi::Object::New(env);
+                        editObj.Set("range", rangeArray);
+                        editObj.Set("replacement", Napi::String::New(env, edits[i].replacement));
+                        editsArray.Set(static_cast<uint32_t>(i), editObj);
+                    }
+                    auto resultObj = Napi::Object::New(env);
+                    resultObj.Set("edits", editsArray);
+                    resultObj.Set("paragraphCount", Napi::Number::New(env, paragraphCount));
+                    resultObj.Set("rewrittenParagraphs", Napi::Number::New(env, rewritten));
+                    resultObj.Set("cachedParagraphs", Napi::Number::New(env, cachedParagraphs));
+                    resultObj.Set("skippedParagraphs", Napi::Number::New(env, skipped));
+                    deferred.Resolve(resultObj);
+                });
+                
+            } catch (const winrt::hresult_error& ex) {
+                tsfn.BlockingCall([deferred, message = winrt::to_string(ex.message())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (const std::exception& ex) {
+                tsfn.BlockingCall([deferred, message = std::string(ex.what())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (...) {
+                tsfn.BlockingCall([deferred](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, "Unknown error occurred in RewriteDocumentAsync").Value());
+                });
+            }
+        }).detach();
+        
+        return progressPromise.GetPromiseObject();
+        
+    } catch (const winrt::hresult_error& ex) {
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (...) {
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in RewriteDocumentAsync").Value());
+        return progressPromise.GetPromiseObject();
+    }
+}
+
+Napi::Value MyTextRewriter::MyRewriteBatchAsync(const Napi::CallbackInfo& info) {
+    return StartBatch(info, "RewriteBatchAsync", [rewriter = m_rewriter](const Napi::Value& options) -> BatchRunner {
+        std::optional<TextRewriteTone> tone;
+        if (options.IsObject() && options.As<Napi::Object>().Has("tone") && !options.As<Napi::Object>().Get("tone").IsUndefined()) {
+            if (!options.As<Napi::Object>().Get("tone").IsNumber()) {
+                throw std::runtime_error("tone must be a TextRewriteTone value");
+            }
+            tone = static_cast<TextRewriteTone>(options.As<Napi::Object>().Get("tone").As<Napi::Number>().Int32Value());
+        }
+        return [rewriter, tone](const winrt::hstring& text) {
+            auto result = (tone ? rewriter->RewriteAsync(text, *tone) : rewriter->RewriteAsync(text)).get();
+            BatchItemResult item;
+            item.status = static_cast<int32_t>(result.Status());
+            item.text = winrt::to_string(result.Text());
+            return item;
+        };
+    }, L""); // the marked items are rewritten as one text; the rewriter keeps the [[n]] lines or the pack falls back
+}
+
+namespace {
+
+// Plain result shapes of ConvertAsync and ConvertLongAsync, in place of the row wrapper objects
+enum class TableShape {
+    Columns, // columns[c][r]
+    Blob, // one UTF-8 buffer with Uint32Array cell offsets
+    Csv,
+    Tsv
+};
+
+TableShape ParseTableShape(const Napi::Value& value) {
+    std::string shape = value.IsString() ? value.As<Napi::String>().Utf8Value() : std::string();
+    if (shape == "columns") {
+        return TableShape::Columns;
+    }
+    if (shape == "blob") {
+        return TableShape::Blob;
+    }
+    if (shape == "csv") {
+        return TableShape::Csv;
+    }
+    if (shape == "tsv") {
+        return TableShape::Tsv;
+    }
+    throw std::runtime_error("shape must be 'columns', 'blob', 'csv' or 'tsv'");
+}
+
+TableRows ReadTableRows(const TextToTableResponseResult& result) {
+    TableRows rows;
+    for (auto const& row : result.GetRows()) {
+        std::vector<std::string> values;
+        for (auto const& column : row.GetColumns()) {
+            values.push_back(winrt::to_string(column));
+        }
+        rows.push_back(std::move(values));
+    }
+    return rows;
+}
+
+// A table flattened on the worker thread, so the main thread only copies it out
+struct TablePayload {
+    TableShape shape = TableShape::Columns;
+    size_t rowCount = 0;
+    size_t columnCount = 0;
+    TableRows rows; // Columns
+    std::string data; // Blob, Csv and Tsv
+    std::vector<uint32_t> offsets; // Blob
+};
+
+TablePayload BuildTablePayload(TableRows rows, TableShape shape) {
+    TablePayload payload;
+    payload.shape = shape;
+    payload.rowCount = rows.size();
+    for (const auto& row : rows) {
+        payload.columnCount = (std::max)(payload.columnCount, row.size());
+    }
+    switch (shape) {
+    case TableShape::Columns:
+        payload.rows = std::move(rows);
+        break;
+    case TableShape::Blob:
+        PackTableCells(rows, payload.columnCount, payload.data, payload.offsets);
+        break;
+    case TableShape::Csv:
+        payload.data = FormatTableCsv(rows, payload.columnCount);
+        break;
+    case TableShape::Tsv:
+        payload.data = FormatTableTsv(rows, payload.columnCount);
+        break;
+    }
+    return payload;
+}
+
+// Sets columns (padded with "" for short rows), or data and offsets, plus rowCount and columnCount
+void SetTablePayload(Napi::Env env, Napi::Object& resultObj, const TablePayload& payload) {
+    if (payload.shape == TableShape::Columns) {
+        auto columnsArray = Napi::Array::New(env, payload.columnCount);
+        for (uint32_t c = 0; c < payload.columnCount; c++) {
+            auto columnArray = Napi::Array::New(env, payload.rowCount);
+            for (uint32_t r = 0; r < payload.rowCount; r++) {
+                const auto& row = payload.rows[r];
+                columnArray.Set(r, Napi::String::New(env, c < row.size() ? row[c] : std::string()));
+            }
+            columnsArray.Set(c, columnArray);
+        }
+        resultObj.Set("columns", columnsArray);
+    } else {
+        resultObj.Set("data", Napi::Buffer<char>::Copy(env, payload.data.data(), payload.data.size()));
+        if (payload.shape == TableShape::Blob) {
+            auto offsetsArray = Napi::Uint32Array::New(env, payload.offsets.size());
+            std::copy(payload.offsets.begin(), payload.offsets.end(), offsetsArray.Data());
+            resultObj.Set("offsets", offsetsArray);
+        }
+    }
+    resultObj.Set("rowCount", Napi::Number::New(env, static_cast<double>(payload.rowCount)));
+    resultObj.Set("columnCount", Napi::Number::New(env, static_cast<double>(payload.columnCount)));
+}
+
+// A row of ConvertAsync's stream mode. A row sent again under the same index replaces the earlier one.
+struct StreamedRow {
+    size_t index = 0;
+    std::vector<std::string> cells;
+    bool revised = false;
+    double elapsedMs = 0; // since the call started
+};
+
+// Stream mode state of one ConvertAsync call, shared by its progress and completion handlers. The
+// iterator is owned by the functions it installs on the promise, so the WinRT threads that hold this never
+// free N-API handles.
+struct TableRowStream {
+    std::mutex mutex;
+    TableStreamParser parser;
+    TableRows sent; // cells last sent for each index
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::weak_ptr<AsyncIteratorQueue> iterator;
+};
+
+// Rows closed by a progress fragment
+std::vector<StreamedRow> ParseStreamedRows(TableRowStream& stream, std::string_view progress) {
+    std::lock_guard<std::mutex> lock(stream.mutex);
+    stream.parser.Append(progress);
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - stream.start).count();
+    std::vector<StreamedRow> rows;
+    for (auto& cells : stream.parser.TakeRows()) {
+        rows.push_back({ stream.sent.size(), cells, false, elapsedMs });
+        stream.sent.push_back(std::move(cells));
+    }
+    return rows;
+}
+
+// Rows of the final result that were not sent, or were sent with other cells
+std::vector<StreamedRow> ReconcileStreamedRows(TableRowStream& stream, const TableRows& finalRows) {
+    std::lock_guard<std::mutex> lock(stream.mutex);
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - stream.start).count();
+    std::vector<StreamedRow> rows;
+    for (size_t i = 0; i < finalRows.size(); i++) {
+        if (i >= stream.sent.size()) {
+            rows.push_back({ i, finalRows[i], false, elapsedMs });
+            stream.sent.push_back(finalRows[i]);
+        } else if (stream.sent[i] != finalRows[i]) {
+            rows.push_back({ i, finalRows[i], true, elapsedMs });
+            stream.sent[i] = finalRows[i];
+        }
+    }
+    return rows;
+}
+
+Napi::Object StreamedRowToJs(Napi::Env env, const StreamedRow& row) {
+    auto rowObj = Napi::Object::New(env);
+    rowObj.Set("index", Napi::Number::New(env, static_cast<double>(row.index)));
+    auto cellsArray = Napi::Array::New(env, row.cells.size());
+    for (uint32_t c = 0; c < row.cells.size(); c++) {
+        cellsArray.Set(c, Napi::String::New(env, row.cells[c]));
+    }
+    rowObj.Set("cells", cellsArray);
+    rowObj.Set("revised", Napi::Boolean::New(env, row.revised));
+    rowObj.Set("elapsedMs", Napi::Number::New(env, row.elapsedMs));
+    return rowObj;
+}
+
+// Hands rows to the async iterator, and to the progress callback when jsCallback is it. Main thread only.
+void DeliverStreamedRows(Napi::Env env, Napi::Function jsCallback, bool toProgress, const std::weak_ptr<AsyncIteratorQueue>& iterator,
+                         const std::vector<StreamedRow>& rows) {
+    auto queue = iterator.lock();
+    bool toIterator = queue && queue->Requested();
+    for (const auto& row : rows) {
+        if (!toIterator && !toProgress) {
+            break;
+        }
+        auto rowObj = StreamedRowToJs(env, row);
+        if (toIterator) {
+            queue->Push(env, rowObj);
+        }
+        if (toProgress) {
+            try {
+                jsCallback.Call({ env.Null(), rowObj });
+            } catch (...) {}
+        }
+    }
+}
+
+// Queues rows for the main thread on the progress callback's function when one is attached, else on tsfn,
+// so they stay ahead of the completion call queued the same way
+void EmitStreamedRows(Napi::ThreadSafeFunction tsfn, std::shared_ptr<Napi::ThreadSafeFunction*> progressTsfn, const std::shared_ptr<TableRowStream>& stream,
+                      std::vector<StreamedRow> rows) {
+    if (rows.empty()) {
+        return;
+    }
+    bool toProgress = progressTsfn && *progressTsfn;
+    Napi::ThreadSafeFunction* target = toProgress ? *progressTsfn : &tsfn;
+    target->NonBlockingCall([iterator = stream->iterator, rows = std::move(rows), toProgress](Napi::Env env, Napi::Function jsCallback) {
+        DeliverStreamedRows(env, jsCallback, toProgress, iterator, rows);
+    });
+}
+
+} // namespace
+
 // MyTextToTableConverter Implementation
 Napi::Object MyTextToTableConverter::Init(Napi::Env env, Napi::Object exports) {
     Napi::Function func = DefineClass(env, "TextToTableConverter", {
-        InstanceMethod("ConvertAsync", &MyTextToTableConverter::MyConvertAsync)
+        InstanceMethod("ConvertAsync", &MyTextToTableConverter::MyConvertAsync),
+        InstanceMethod("ConvertImageAsync", &MyTextToTableConverter::MyConvertImageAsync),
+        InstanceMethod("ConvertLongAsync", &MyTextToTableConverter::MyConvertLongAsync),
+        InstanceMethod("ConvertBatchAsync", &MyTextToTableConverter::MyConvertBatchAsync)
     });
 
     constructor = Napi::Persistent(func);
@@ -1231,10 +3473,34 @@ Napi::Value MyTextToTableConverter::MyConvertAsync(const Napi::CallbackInfo& inf
         std::string text = info[0].As<Napi::String>().Utf8Value();
         winrt::hstring wText = winrt::to_hstring(text);
         
+        std::optional<TableShape> shape;
+        std::shared_ptr<TableRowStream> rowStream;
+        if (info.Length() > 1 && info[1].IsObject()) {
+            auto optionsObj = info[1].As<Napi::Object>();
+            if (optionsObj.Has("shape") && !optionsObj.Get("shape").IsUndefined()) {
+                shape = ParseTableShape(optionsObj.Get("shape"));
+            }
+            if (optionsObj.Has("stream") && !optionsObj.Get("stream").IsUndefined()) {
+                if (!optionsObj.Get("stream").IsBoolean()) {
+                    throw std::runtime_error("stream must be a boolean");
+                }
+                if (optionsObj.Get("stream").As<Napi::Boolean>().Value()) {
+                    rowStream = std::make_shared<TableRowStream>();
+                    auto iterator = std::make_shared<AsyncIteratorQueue>();
+                    iterator->Attach(env, progressPromise.GetPromiseObject());
+                    rowStream->iterator = iterator;
+                }
+            }
+        }
+        
         // Call the ConvertAsync method
         auto asyncOp = m_converter->ConvertAsync(wText);
         
-        asyncOp.Progress([progressTsfn](auto const&, auto const& progressText) {
+        asyncOp.Progress([progressTsfn, tsfn, rowStream](auto const&, auto const& progressText) {
+            if (rowStream) {
+                EmitStreamedRows(tsfn, progressTsfn, rowStream, ParseStreamedRows(*rowStream, winrt::to_string(progressText)));
+                return;
+            }
             if (progressTsfn && *progressTsfn) {
                 auto progressStr = winrt::to_string(progressText);
                 (*progressTsfn)->NonBlockingCall([progressStr](Napi::Env env, Napi::Function jsCallback) {
@@ -1245,7 +3511,73 @@ Napi::Value MyTextToTableConverter::MyConvertAsync(const Napi::CallbackInfo& inf
             }
         });
         
-        asyncOp.Completed([deferred, tsfn, tsfn_guard](auto const& sender, auto const& status) mutable {
+        asyncOp.Completed([deferred, tsfn, tsfn_guard, progressTsfn, shape, rowStream](auto const& sender, auto const& status) mutable {
+            if (shape || rowStream) {
+                // Read the rows here, off the main thread: the final rows settle the streamed ones, and a
+                // shape is flattened into one plain object
+                std::shared_ptr<TablePayload> payload;
+                int32_t resultStatus = 0;
+                int32_t extendedError = 0;
+                std::string error;
+                std::vector<StreamedRow> finalRows;
+                if (status == winrt::Windows::Foundation::AsyncStatus::Completed) {
+                    try {
+                        auto result = sender.GetResults();
+                        resultStatus = static_cast<int32_t>(result.Status());
+                        extendedError = static_cast<int32_t>(result.ExtendedError());
+                        TableRows rows = ReadTableRows(result);
+                        if (rowStream) {
+                            finalRows = ReconcileStreamedRows(*rowStream, rows);
+                        }
+                        if (shape) {
+                            payload = std::make_shared<TablePayload>(BuildTablePayload(std::move(rows), *shape));
+                        }
+                    } catch (const winrt::hresult_error& ex) {
+                        error = winrt::to_string(ex.message());
+                    } catch (const std::exception& ex) {
+                        error = ex.what();
+                    } catch (...) {
+                        error = "Unknown error occurred in ConvertAsync completion";
+                    }
+                } else {
+                    error = "ConvertAsync operation failed";
+                }
+                
+                // Queued behind the streamed rows, so the final ones follow them and every row reaches the progress
+                // callback and the iterator before the promise settles
+                bool toProgress = rowStream && progressTsfn && *progressTsfn;
+                Napi::ThreadSafeFunction* settleTsfn = toProgress ? *progressTsfn : &tsfn;
+                std::weak_ptr<AsyncIteratorQueue> iterator = rowStream ? rowStream->iterator : std::weak_ptr<AsyncIteratorQueue>();
+                settleTsfn->BlockingCall([deferred, sender, payload, resultStatus, extendedError, error, iterator, finalRows = std::move(finalRows),
+                                          toProgress](Napi::Env env, Napi::Function jsCallback) {
+                    DeliverStreamedRows(env, jsCallback, toProgress, iterator, finalRows);
+                    try {
+                        if (!error.empty()) {
+                            deferred.Reject(Napi::Error::New(env, error).Value());
+                        } else if (payload) {
+                            auto resultObj = Napi::Object::New(env);
+                            SetTablePayload(env, resultObj, *payload);
+                            resultObj.Set("status", Napi::Number::New(env, resultStatus));
+                            resultObj.Set("extendedError", Napi::Number::New(env, extendedError));
+                            deferred.Resolve(resultObj);
+                        } else {
+                            auto result = sender.GetResults();
+                            auto external = Napi::External<TextToTableResponseResult>::New(env, &result);
+                            deferred.Resolve(MyTextToTableResponseResult::constructor.New({ external }));
+                        }
+                    } catch (const winrt::hresult_error& ex) {
+                        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+                    } catch (const std::exception& ex) {
+                        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+                    } catch (...) {
+                        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in ConvertAsync completion").Value());
+                    }
+                    if (auto queue = iterator.lock()) {
+                        queue->Finish(env, error);
+                    }
+                });
+                return;
+            }
             tsfn.BlockingCall([deferred, sender, status](Napi::Env env, Napi::Function) {
                 try {
                     if (status == winrt::Windows::Foundation::AsyncStatus::Completed) {
@@ -1280,6 +3612,340 @@ Napi::Value MyTextToTableConverter::MyConvertAsync(const Napi::CallbackInfo& inf
     }
 }
 
+Napi::Value MyTextToTableConverter::MyConvertImageAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (!CheckImageTextArguments(info, "ConvertImageAsync")) {
+        return env.Null();
+    }
+    
+    auto deferred = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "ConvertImageAsync", 0, 1);
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    auto progressPromise = ProgressPromise::Create(env, deferred);
+    auto progressTsfn = progressPromise.GetProgressTsfn();
+
+    try {
+        auto source = std::make_shared<ImageTextSource>(ParseImageTextSource(info));
+        
+        std::thread([deferred, tsfn, tsfn_guard, progressTsfn, converter = m_converter, source]() {
+            try {
+                using Clock = std::chrono::steady_clock;
+                auto elapsedMs = [](Clock::time_point start) {
+                    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                };
+                auto totalStart = Clock::now();
+                
+                double decodeMs = 0;
+                double recognizeMs = 0;
+                OcrPage page = RecognizeImageTextSource(*source, decodeMs, recognizeMs);
+                
+                // Row-hinting form: one line per detected row, cells separated by " | "
+                auto stageStart = Clock::now();
+                OcrTableGrid grid = BuildOcrTableGrid(page, source->options.text.minWordConfidence);
+                std::string sourceText = FormatOcrTableText(grid);
+                double serializeMs = elapsedMs(stageStart);
+                
+                stageStart = Clock::now();
+                TableRows rows;
+                int32_t status = 0;
+                int32_t extendedError = 0;
+                if (!sourceText.empty()) {
+                    auto asyncOp = converter->ConvertAsync(winrt::to_hstring(sourceText));
+                    asyncOp.Progress([progressTsfn](auto const&, auto const& progressText) {
+                        if (progressTsfn && *progressTsfn) {
+                            auto progressStr = winrt::to_string(progressText);
+                            (*progressTsfn)->NonBlockingCall([progressStr](Napi::Env env, Napi::Function jsCallback) {
+                                try {
+                                    jsCallback.Call({ env.Null(), Napi::String::New(env, progressStr) });
+                                } catch (...) {}
+                            });
+                        }
+                    });
+                    auto result = asyncOp.get();
+                    status = static_cast<int32_t>(result.Status());
+                    extendedError = static_cast<int32_t>(result.ExtendedError());
+                    rows = ReadTableRows(result);
+                }
+                double convertMs = elapsedMs(stageStart);
+                size_t sourceLength = sourceText.size();
+                uint32_t gridColumns = grid.columnCount;
+                auto table = std::make_shared<TablePayload>(BuildTablePayload(std::move(rows), TableShape::Columns));
+                
+                tsfn.BlockingCall([deferred, table, status, extendedError, sourceLength, gridColumns, decodeMs, recognizeMs, serializeMs, convertMs, totalStart, elapsedMs](Napi::Env env, Napi::Function) {
+                    auto marshalStart = Clock::now();
+                    auto resultObj = Napi::Object::New(env);
+                    SetTablePayload(env, resultObj, *table);
+                    resultObj.Set("status", Napi::Number::New(env, status));
+                    resultObj.Set("extendedError", Napi::Number::New(env, extendedError));
+                    resultObj.Set("detectedColumns", Napi::Number::New(env, gridColumns));
+                    resultObj.Set("sourceLength", Napi::Number::New(env, static_cast<double>(sourceLength)));
+                    auto timingsObj = Napi::Object::New(env);
+                    timingsObj.Set("decodeMs", Napi::Number::New(env, decodeMs));
+                    timingsObj.Set("recognizeMs", Napi::Number::New(env, recognizeMs));
+                    timingsObj.Set("serializeMs", Napi::Number::New(env, serializeMs));
+                    timingsObj.Set("convertMs", Napi::Number::New(env, convertMs));
+                    timingsObj.Set("marshalMs", Napi::Number::New(env, elapsedMs(marshalStart)));
+                    timingsObj.Set("totalMs", Napi::Number::New(env, elapsedMs(totalStart)));
+                    resultObj.Set("timings", timingsObj);
+                    deferred.Resolve(resultObj);
+                });
+                
+            } catch (...) {
+                RejectWithCurrentException(tsfn, deferred, "ConvertImageAsync");
+            }
+        }).detach();
+        
+        return progressPromise.GetPromiseObject();
+        
+    } catch (const winrt::hresult_error& ex) {
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (...) {
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in ConvertImageAsync").Value());
+        return progressPromise.GetPromiseObject();
+    }
+}
+
+Napi::Value MyTextToTableConverter::MyConvertLongAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "ConvertLongAsync requires a string parameter").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    auto deferred = Napi::Promise::Deferred::New(env);
+    auto tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "ConvertLongAsync", 0, 1);
+    auto tsfn_guard = std::shared_ptr<void>(nullptr, [tsfn](void*) mutable { tsfn.Release(); });
+    auto progressPromise = ProgressPromise::Create(env, deferred);
+    auto progressTsfn = progressPromise.GetProgressTsfn();
+
+    try {
+        std::string text = info[0].As<Napi::String>().Utf8Value();
+        
+        size_t maxChunkLength = 6000;
+        size_t concurrency = 2;
+        TableShape shape = TableShape::Columns;
+        if (info.Length() > 1 && info[1].IsObject()) {
+            auto optionsObj = info[1].As<Napi::Object>();
+            if (optionsObj.Has("shape") && !optionsObj.Get("shape").IsUndefined()) {
+                shape = ParseTableShape(optionsObj.Get("shape"));
+            }
+            auto readInteger = [&optionsObj](const char* key, double min, double max, size_t& target) {
+                if (!optionsObj.Has(key) || optionsObj.Get(key).IsUndefined()) {
+                    return;
+                }
+                double value = optionsObj.Get(key).IsNumber() ? optionsObj.Get(key).As<Napi::Number>().DoubleValue() : 0.0;
+                if (!(value >= min && value <= max) || value != std::floor(value)) {
+                    throw std::runtime_error(std::string(key) + " must be an integer between " + std::to_string(static_cast<int>(min)) + " and " +
+                                             std::to_string(static_cast<int>(max)));
+                }
+                target = static_cast<size_t>(value);
+            };
+            readInteger("maxChunkLength", 256, 65536, maxChunkLength);
+            readInteger("concurrency", 1, 16, concurrency);
+        }
+        
+        std::thread([deferred, tsfn, tsfn_guard, progressTsfn, converter = m_converter, text = std::move(text), maxChunkLength, concurrency, shape]() {
+            try {
+                using Clock = std::chrono::steady_clock;
+                auto elapsedMs = [](Clock::time_point start) {
+                    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                };
+                auto totalStart = Clock::now();
+                
+                auto stageStart = Clock::now();
+                // Later chunks are sent after the first record, usually the header line, so they see the same
+                // columns; the chunk budget leaves room for it
+                TextChunk leading = FirstRecord(text);
+                std::string_view leadingRecord = leading.length <= maxChunkLength / 4 ? std::string_view(text).substr(leading.offset, leading.length) : std::string_view();
+                size_t chunkBudget = leadingRecord.empty() ? maxChunkLength : maxChunkLength - leadingRecord.size() - 1;
+                std::vector<TextChunk> ranges = ChunkRecords(text, chunkBudget);
+                double splitMs = elapsedMs(stageStart);
+                
+                struct ChunkResult {
+                    size_t offset = 0; // UTF-16
+                    size_t length = 0;
+                    int32_t status = 0;
+                    TableRows rows;
+                    std::string error;
+                    double convertMs = 0;
+                };
+                std::vector<ChunkResult> chunks(ranges.size());
+                size_t utf16Offset = 0;
+                size_t byteOffset = 0;
+                for (size_t i = 0; i < ranges.size(); i++) {
+                    utf16Offset += Utf16Length(std::string_view(text).substr(byteOffset, ranges[i].offset - byteOffset));
+                    chunks[i].offset = utf16Offset;
+                    chunks[i].length = Utf16Length(std::string_view(text).substr(ranges[i].offset, ranges[i].length));
+                    byteOffset = ranges[i].offset;
+                }
+                
+                size_t chunkCount = ranges.size();
+                
+                stageStart = Clock::now();
+                RunConcurrently(ranges.size(), concurrency, [&](size_t i) {
+                    ChunkResult& chunk = chunks[i];
+                    auto chunkStart = Clock::now();
+                    try {
+                        std::string chunkText(std::string_view(text).substr(ranges[i].offset, ranges[i].length));
+                        if (i > 0 && !leadingRecord.empty()) {
+                            chunkText = std::string(leadingRecord) + "\n" + chunkText;
+                        }
+                        auto result = converter->ConvertAsync(winrt::to_hstring(chunkText)).get();
+                        chunk.status = static_cast<int32_t>(result.Status());
+                        chunk.rows = ReadTableRows(result);
+                    } catch (const winrt::hresult_error& ex) {
+                        chunk.error = winrt::to_string(ex.message());
+                    } catch (const std::exception& ex) {
+                        chunk.error = ex.what();
+                    } catch (...) {
+                        chunk.error = "Unknown error occurred in ConvertLongAsync";
+                    }
+                    chunk.convertMs = elapsedMs(chunkStart);
+                    
+                    if (!progressTsfn || !*progressTsfn) {
+                        return;
+                    }
+                    size_t rowCount = chunk.rows.size();
+                    (*progressTsfn)->NonBlockingCall([i, chunkCount, rowCount, chunkStatus = chunk.status, error = chunk.error,
+                                                                          convertMs = chunk.convertMs](Napi::Env env, Napi::Function jsCallback) {
+                        try {
+                            auto progressObj = Napi::Object::New(env);
+                            progressObj.Set("index", Napi::Number::New(env, static_cast<double>(i)));
+                            progressObj.Set("chunkCount", Napi::Number::New(env, static_cast<double>(chunkCount)));
+                            if (error.empty()) {
+                                progressObj.Set("status", Napi::Number::New(env, chunkStatus));
+                                progressObj.Set("rowCount", Napi::Number::New(env, static_cast<double>(rowCount)));
+                            } else {
+                                progressObj.Set("error", Napi::String::New(env, error));
+                            }
+                            progressObj.Set("convertMs", Napi::Number::New(env, convertMs));
+                            jsCallback.Call({ env.Null(), progressObj });
+                        } catch (...) {}
+                    });
+                });
+                double convertMs = elapsedMs(stageStart);
+                
+                size_t failed = 0;
+                for (const auto& chunk : chunks) {
+                    failed += chunk.error.empty() ? 0 : 1;
+                }
+                if (!chunks.empty() && failed == chunks.size()) {
+                    throw std::runtime_error(chunks[0].error);
+                }
+                
+                // Complete when every chunk is; otherwise the first other status, Error for a chunk that threw
+                int32_t status = static_cast<int32_t>(LanguageModelResponseStatus::Complete);
+                for (const auto& chunk : chunks) {
+                    int32_t chunkStatus = chunk.error.empty() ? chunk.status : static_cast<int32_t>(LanguageModelResponseStatus::Error);
+                    if (chunkStatus != static_cast<int32_t>(LanguageModelResponseStatus::Complete)) {
+                        status = chunkStatus;
+                        break;
+                    }
+                }
+                
+                stageStart = Clock::now();
+                std::vector<TableRows> chunkRows;
+                chunkRows.reserve(chunks.size());
+                for (auto& chunk : chunks) {
+                    chunkRows.push_back(std::move(chunk.rows));
+                }
+                MergedTable merged = MergeTableChunks(chunkRows, leadingRecord);
+                size_t droppedHeaderRows = merged.droppedHeaderRows;
+                size_t addedColumns = merged.addedColumns;
+                auto table = std::make_shared<TablePayload>(BuildTablePayload(std::move(merged.rows), shape));
+                double mergeMs = elapsedMs(stageStart);
+                auto chunkInfo = std::make_shared<std::vector<ChunkResult>>(std::move(chunks)); // rows already moved out
+                auto chunkRowCounts = std::make_shared<std::vector<size_t>>();
+                for (const auto& rows : chunkRows) {
+                    chunkRowCounts->push_back(rows.size());
+                }
+                
+                // Queued behind the chunk progress calls when a callback is attached, so every chunk reaches it
+                // before the promise resolves
+                Napi::ThreadSafeFunction* resolveTsfn = progressTsfn && *progressTsfn ? *progressTsfn : &tsfn;
+                resolveTsfn->BlockingCall([deferred, table, droppedHeaderRows, addedColumns, chunkInfo, chunkRowCounts, status, splitMs, convertMs, mergeMs, totalStart, elapsedMs](Napi::Env env, Napi::Function) {
+                    auto marshalStart = Clock::now();
+                    
+                    auto chunksArray = Napi::Array::New(env, chunkInfo->size());
+                    for (uint32_t i = 0; i < chunkInfo->size(); i++) {
+                        const auto& chunk = (*chunkInfo)[i];
+                        auto chunkObj = Napi::Object::New(env);
+                        chunkObj.Set("offset", Napi::Number::New(env, static_cast<double>(chunk.offset)));
+                        chunkObj.Set("length", Napi::Number::New(env, static_cast<double>(chunk.length)));
+                        if (chunk.error.empty()) {
+                            chunkObj.Set("status", Napi::Number::New(env, chunk.status));
+                            chunkObj.Set("rowCount", Napi::Number::New(env, static_cast<double>((*chunkRowCounts)[i])));
+                        } else {
+                            chunkObj.Set("error", Napi::String::New(env, chunk.error));
+                        }
+                        chunkObj.Set("convertMs", Napi::Number::New(env, chunk.convertMs));
+                        chunksArray.Set(i, chunkObj);
+                    }
+                    
+                    // Header in row 0
+                    auto resultObj = Napi::Object::New(env);
+                    SetTablePayload(env, resultObj, *table);
+                    resultObj.Set("status", Napi::Number::New(env, status));
+                    resultObj.Set("droppedHeaderRows", Napi::Number::New(env, static_cast<double>(droppedHeaderRows)));
+                    resultObj.Set("addedColumns", Napi::Number::New(env, static_cast<double>(addedColumns)));
+                    resultObj.Set("chunks", chunksArray);
+                    auto timingsObj = Napi::Object::New(env);
+                    timingsObj.Set("splitMs", Napi::Number::New(env, splitMs));
+                    timingsObj.Set("convertMs", Napi::Number::New(env, convertMs));
+                    timingsObj.Set("mergeMs", Napi::Number::New(env, mergeMs));
+                    timingsObj.Set("marshalMs", Napi::Number::New(env, elapsedMs(marshalStart)));
+                    timingsObj.Set("totalMs", Napi::Number::New(env, elapsedMs(totalStart)));
+                    resultObj.Set("timings", timingsObj);
+                    deferred.Resolve(resultObj);
+                });
+                
+            } catch (const winrt::hresult_error& ex) {
+                tsfn.BlockingCall([deferred, message = winrt::to_string(ex.message())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (const std::exception& ex) {
+                tsfn.BlockingCall([deferred, message = std::string(ex.what())](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, message).Value());
+                });
+            } catch (...) {
+                tsfn.BlockingCall([deferred](Napi::Env env, Napi::Function) {
+                    deferred.Reject(Napi::Error::New(env, "Unknown error occurred in ConvertLongAsync").Value());
+                });
+            }
+        }).detach();
+        
+        return progressPromise.GetPromiseObject();
+        
+    } catch (const winrt::hresult_error& ex) {
+        deferred.Reject(Napi::Error::New(env, winrt::to_string(ex.message())).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (const std::exception& ex) {
+        deferred.Reject(Napi::Error::New(env, ex.what()).Value());
+        return progressPromise.GetPromiseObject();
+    } catch (...) {
+        deferred.Reject(Napi::Error::New(env, "Unknown error occurred in ConvertLongAsync").Value());
+        return progressPromise.GetPromiseObject();
+    }
+}
+
+Napi::Value MyTextToTableConverter::MyConvertBatchAsync(const Napi::CallbackInfo& info) {
+    return StartBatch(info, "ConvertBatchAsync", [converter = m_converter](const Napi::Value&) -> BatchRunner {
+        return [converter](const winrt::hstring& text) {
+            auto result = converter->ConvertAsync(text).get();
+            BatchItemResult item;
+            item.status = static_cast<int32_t>(result.Status());
+            item.rows = ReadTableRows(result);
+            return item;
+        };
+    });
+}
+
 // MyTextToTableResponseResult Implementation
 Napi::Object MyTextToTableResponseResult::Init(Napi::Env env, Napi::Object exports) {
     Napi::Function func = DefineClass(env, "TextToTableResponseResult", {
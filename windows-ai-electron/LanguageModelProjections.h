@@ -3,6 +3,10 @@
 #include <napi.h>
 #include <optional>
 #include <memory>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 
 #include <winrt/Windows.Foundation.h>
 #include <winrt/Microsoft.Windows.AI.Text.h>
@@ -26,6 +30,7 @@ class MyAIFeatureReadyResult;
 class MyLanguageModel;
 class MyConversationItem;
 class MyTextSummarizer;
+class MyConversationSummarySession;
 class MyTextRewriter;
 class MyTextToTableConverter;
 class MyTextToTableResponseResult;
@@ -39,9 +44,12 @@ public:
     
     MyLanguageModelResponseResult(const Napi::CallbackInfo& info);
     bool HasResult() const;
+    // Replaces the model text, for a response cut short by stop conditions
+    void SetText(std::string text);
 
 private:
     std::optional<LanguageModelResponseResult> m_result;
+    std::optional<std::string> m_text; // without m_result: generation was cancelled at a stop condition
     
     Napi::Value GetText(const Napi::CallbackInfo& info);
     Napi::Value GetStatus(const Napi::CallbackInfo& info);
@@ -104,6 +112,7 @@ private:
     LanguageModel* m_languagemodel;
     
     Napi::Value MyGenerateResponseAsync(const Napi::CallbackInfo& info);
+    Napi::Value MyGenerateResponseBatchAsync(const Napi::CallbackInfo& info);
 };
 
 // Wrapper for ConversationItem
@@ -124,6 +133,38 @@ private:
     void MySetParticipant(const Napi::CallbackInfo& info, const Napi::Value& value);
 };
 
+// Results of FitToContextAsync keyed by the content hash of the UTF-16 text, oldest evicted first
+struct ContextFitCache {
+    struct Entry {
+        size_t length;
+        size_t prefixLength;
+    };
+
+    std::mutex mutex;
+    size_t capacity = 1024;
+    std::unordered_map<uint64_t, Entry> entries;
+    std::deque<uint64_t> order; // insertion order
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    std::optional<Entry> Lookup(uint64_t hash, size_t length);
+    void Store(uint64_t hash, const Entry& entry);
+};
+
+// Per-paragraph model results (SummarizeDocumentAsync summaries, RewriteDocumentAsync rewrites) keyed by
+// content hash, oldest evicted first
+struct ParagraphCache {
+    std::mutex mutex;
+    size_t capacity = 4096;
+    std::unordered_map<uint64_t, std::string> entries;
+    std::deque<uint64_t> order; // insertion order
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    std::optional<std::string> Lookup(uint64_t hash);
+    void Store(uint64_t hash, const std::string& value);
+};
+
 // Wrapper for TextSummarizer
 class MyTextSummarizer : public Napi::ObjectWrap<MyTextSummarizer> {
 public:
@@ -131,13 +172,52 @@ public:
     static Napi::Object Init(Napi::Env env, Napi::Object exports);
     
     MyTextSummarizer(const Napi::CallbackInfo& info);
+    std::shared_ptr<TextSummarizer> GetSummarizer() const { return m_summarizer; }
 private:
     std::shared_ptr<TextSummarizer> m_summarizer;
+    std::shared_ptr<ContextFitCache> m_fitCache = std::make_shared<ContextFitCache>();
+    std::shared_ptr<ParagraphCache> m_paragraphCache = std::make_shared<ParagraphCache>();
     
     Napi::Value MySummarizeAsync(const Napi::CallbackInfo& info);
     Napi::Value MySummarizeConversationAsync(const Napi::CallbackInfo& info);
     Napi::Value MySummarizeParagraphAsync(const Napi::CallbackInfo& info);
     Napi::Value MyIsPromptLargerThanContext(const Napi::CallbackInfo& info);
+    Napi::Value MySummarizeImageTextAsync(const Napi::CallbackInfo& info);
+    Napi::Value MySummarizeLongTextAsync(const Napi::CallbackInfo& info);
+    Napi::Value MyFitToContextAsync(const Napi::CallbackInfo& info);
+    Napi::Value MySummarizeDocumentAsync(const Napi::CallbackInfo& info);
+    Napi::Value MySummarizeBatchAsync(const Napi::CallbackInfo& info);
+};
+
+// Rolling summary of a ConversationSummarySession. Appends take a ticket and run one at a time in call
+// order; Restore and Reset bump the generation so an append started before them does not commit.
+struct ConversationSessionState {
+    std::mutex mutex;
+    std::condition_variable turn;
+    uint64_t nextTicket = 0;
+    uint64_t servingTicket = 0;
+    uint64_t generation = 0;
+    winrt::hstring summary;
+    uint64_t itemCount = 0; // items covered by the summary
+};
+
+// Conversation summary kept up to date incrementally, built on a TextSummarizer
+class MyConversationSummarySession : public Napi::ObjectWrap<MyConversationSummarySession> {
+public:
+    static Napi::FunctionReference constructor;
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    
+    MyConversationSummarySession(const Napi::CallbackInfo& info);
+private:
+    std::shared_ptr<TextSummarizer> m_summarizer;
+    ConversationSummaryOptions m_options{ nullptr };
+    std::shared_ptr<ConversationSessionState> m_state = std::make_shared<ConversationSessionState>();
+    
+    Napi::Value MyAppendAsync(const Napi::CallbackInfo& info);
+    Napi::Value MyGetSummary(const Napi::CallbackInfo& info);
+    Napi::Value MyCheckpoint(const Napi::CallbackInfo& info);
+    Napi::Value MyRestore(const Napi::CallbackInfo& info);
+    Napi::Value MyReset(const Napi::CallbackInfo& info);
 };
 
 // Wrapper for TextRewriter
@@ -150,8 +230,11 @@ public:
     
 private:
     std::shared_ptr<TextRewriter> m_rewriter;
+    std::shared_ptr<ParagraphCache> m_paragraphCache = std::make_shared<ParagraphCache>();
     
     Napi::Value MyRewriteAsync(const Napi::CallbackInfo& info);
+    Napi::Value MyRewriteDocumentAsync(const Napi::CallbackInfo& info);
+    Napi::Value MyRewriteBatchAsync(const Napi::CallbackInfo& info);
 };
 
 // Wrapper for TextToTableConverter
@@ -166,6 +249,9 @@ private:
     std::shared_ptr<TextToTableConverter> m_converter;
     
     Napi::Value MyConvertAsync(const Napi::CallbackInfo& info);
+    Napi::Value MyConvertImageAsync(const Napi::CallbackInfo& info);
+    Napi::Value MyConvertLongAsync(const Napi::CallbackInfo& info);
+    Napi::Value MyConvertBatchAsync(const Napi::CallbackInfo& info);
 };
 
 // Wrapper for TextToTableResponseResult
@@ -0,0 +1,91 @@
+#include "MappedFile.h"
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed to open " + path.string() + " (error " + std::to_string(GetLastError()) + ")");
+    }
+    m_file = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw std::runtime_error("Failed to read the size of " + path.string());
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+    if (m_size == 0) {
+        return;
+    }
+
+    m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping) {
+        CloseHandle(file);
+        throw std::runtime_error("Failed to map " + path.string() + " (error " + std::to_string(GetLastError()) + ")");
+    }
+    m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_data) {
+        CloseHandle(m_mapping);
+        CloseHandle(file);
+        throw std::runtime_error("Failed to map " + path.string() + " (error " + std::to_string(GetLastError()) + ")");
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+    }
+    if (m_file) {
+        CloseHandle(m_file);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    m_fd = open(path.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+    struct stat info;
+    if (fstat(m_fd, &info) != 0) {
+        close(m_fd);
+        throw std::runtime_error("Failed to read the size of " + path.string());
+    }
+    m_size = static_cast<size_t>(info.st_size);
+    if (m_size == 0) {
+        return;
+    }
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED) {
+        close(m_fd);
+        throw std::runtime_error("Failed to map " + path.string());
+    }
+    m_data = static_cast<const uint8_t*>(data);
+}
+
+MappedFile::~MappedFile() {
+    if (m_data) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+}
+
+#endif
@@ -0,0 +1,282 @@
+#include "OcrLayout.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+
+struct Rotation {
+    float cosine;
+    float sine;
+
+    OcrPoint Apply(const OcrPoint& point) const {
+        return { point.x * cosine - point.y * sine, point.x * sine + point.y * cosine };
+    }
+};
+
+// Working state of a block while lines are swept into it, in deskewed coordinates
+struct BlockBuilder {
+    OcrRect bounds;
+    std::vector<uint32_t> lines; // page line indices, top to bottom
+    bool open = true;
+};
+
+float HorizontalOverlap(const OcrRect& a, const OcrRect& b) {
+    return std::min(a.Right(), b.Right()) - std::max(a.x, b.x);
+}
+
+// A line continues a block when it sits close below it and is either left-aligned with it or covers most of it
+bool ContinuesBlock(const OcrRect& block, const OcrRect& line, float lineHeight) {
+    if (line.y - block.Bottom() > lineHeight * 2) {
+        return false;
+    }
+    float overlap = HorizontalOverlap(block, line);
+    if (overlap <= 0) {
+        return false;
+    }
+    return std::abs(line.x - block.x) <= lineHeight * 1.5f || overlap >= std::max(block.width, line.width) * 0.6f;
+}
+
+// Recursive XY-cut over blocks. Vertical cuts (columns) are tried first so that columns whose
+// paragraph gaps happen to line up are not interleaved; horizontal cuts separate bands such as a
+// heading or footer spanning several columns. byX and byY hold the same blocks sorted by left and by
+// top edge; the parts of a cut keep both orders, so a level costs O(m) over its m blocks.
+void OrderBlocks(const std::vector<uint32_t>& byX, const std::vector<uint32_t>& byY, const std::vector<OcrRect>& bounds,
+                 std::vector<uint32_t>& partOf, std::vector<uint32_t>& order, std::vector<uint32_t>& columns) {
+    if (byX.size() < 2) {
+        order.insert(order.end(), byX.begin(), byX.end());
+        return;
+    }
+
+    // Labels each block with its part along the sorted order; returns the number of parts
+    auto split = [&bounds, &partOf](const std::vector<uint32_t>& items, bool vertical) {
+        uint32_t part = 0;
+        float extent = vertical ? bounds[items[0]].Right() : bounds[items[0]].Bottom();
+        partOf[items[0]] = 0;
+        for (size_t i = 1; i < items.size(); i++) {
+            const OcrRect& rect = bounds[items[i]];
+            if ((vertical ? rect.x : rect.y) >= extent) {
+                part++;
+            }
+            partOf[items[i]] = part;
+            extent = std::max(extent, vertical ? rect.Right() : rect.Bottom());
+        }
+        return part + 1;
+    };
+    // Distributes a sorted list over the parts, keeping its order
+    auto distribute = [&partOf](const std::vector<uint32_t>& items, uint32_t partCount) {
+        std::vector<std::vector<uint32_t>> parts(partCount);
+        for (uint32_t block : items) {
+            parts[partOf[block]].push_back(block);
+        }
+        return parts;
+    };
+
+    uint32_t partCount = split(byX, true);
+    bool vertical = partCount > 1;
+    if (!vertical) {
+        partCount = split(byY, false);
+    }
+    if (partCount > 1) {
+        auto partsByX = distribute(byX, partCount);
+        auto partsByY = distribute(byY, partCount);
+        for (uint32_t part = 0; part < partCount; part++) {
+            if (vertical) {
+                for (uint32_t block : partsByX[part]) {
+                    columns[block] = part;
+                }
+            }
+            OrderBlocks(partsByX[part], partsByY[part], bounds, partOf, order, columns);
+        }
+        return;
+    }
+
+    // Overlapping in both directions, fall back to top-to-bottom, left-to-right
+    std::vector<uint32_t> blocks = byY;
+    std::sort(blocks.begin(), blocks.end(), [&bounds](uint32_t a, uint32_t b) {
+        return bounds[a].y != bounds[b].y ? bounds[a].y < bounds[b].y : bounds[a].x < bounds[b].x;
+    });
+    order.insert(order.end(), blocks.begin(), blocks.end());
+}
+
+// Paragraph break between consecutive lines of one block: a blank-line sized gap, a short previous
+// line (the end of a paragraph), or a first-line indent
+bool StartsParagraph(const OcrRect& block, const OcrRect& previous, const OcrRect& line) {
+    float lineHeight = std::max(previous.height, line.height);
+    if (line.y - previous.Bottom() > lineHeight * 0.8f) {
+        return true;
+    }
+    if (previous.Right() < block.Right() - block.width * 0.25f) {
+        return true;
+    }
+    return line.x - block.x > lineHeight && previous.x - block.x <= lineHeight / 2;
+}
+
+} // namespace
+
+OcrLayout AnalyzeOcrLayout(const OcrPage& page) {
+    OcrLayout layout;
+    layout.textAngle = page.textAngle;
+    uint32_t lineCount = static_cast<uint32_t>(page.lines.size());
+    if (lineCount == 0) {
+        return layout;
+    }
+
+    float radians = page.textAngle * kPi / 180.0f;
+    Rotation deskew{ std::cos(-radians), std::sin(-radians) };
+    Rotation skew{ std::cos(radians), std::sin(radians) };
+
+    std::vector<OcrRect> lineBounds(lineCount);
+    std::vector<float> heights(lineCount);
+    for (uint32_t i = 0; i < lineCount; i++) {
+        const OcrQuad& box = page.lines[i].box;
+        lineBounds[i] = QuadBounds({ deskew.Apply(box.topLeft), deskew.Apply(box.topRight), deskew.Apply(box.bottomLeft), deskew.Apply(box.bottomRight) });
+        heights[i] = lineBounds[i].height;
+    }
+    std::nth_element(heights.begin(), heights.begin() + heights.size() / 2, heights.end());
+    float lineHeight = std::max(heights[heights.size() / 2], 1.0f);
+
+    std::vector<uint32_t> sorted(lineCount);
+    for (uint32_t i = 0; i < lineCount; i++) {
+        sorted[i] = i;
+    }
+    std::sort(sorted.begin(), sorted.end(), [&lineBounds](uint32_t a, uint32_t b) {
+        return lineBounds[a].y != lineBounds[b].y ? lineBounds[a].y < lineBounds[b].y : lineBounds[a].x < lineBounds[b].x;
+    });
+
+    // Sweep bands of lines starting at about the same height. Within a band each line picks the open
+    // block it continues. Every other open block under the line is closed, and so is a block claimed
+    // by two lines of one band (a column split), so later lines never jump over a line to rejoin it.
+    std::vector<BlockBuilder> builders;
+    std::vector<size_t> active;
+    std::vector<int64_t> claims;
+    std::vector<uint32_t> claimCounts;
+    size_t bandStart = 0;
+    while (bandStart < sorted.size()) {
+        size_t bandEnd = bandStart + 1;
+        while (bandEnd < sorted.size() && lineBounds[sorted[bandEnd]].y - lineBounds[sorted[bandStart]].y <= lineHeight / 2) {
+            bandEnd++;
+        }
+
+        float bandTop = lineBounds[sorted[bandStart]].y;
+        active.erase(std::remove_if(active.begin(), active.end(), [&](size_t block) {
+            return !builders[block].open || bandTop - builders[block].bounds.Bottom() > lineHeight * 2;
+        }), active.end());
+
+        // claimCounts is indexed by block and cleared below only where this band claimed, so a band
+        // costs its lines times the open blocks, not the number of blocks created so far
+        claims.assign(bandEnd - bandStart, -1);
+        claimCounts.resize(builders.size(), 0);
+        for (size_t i = bandStart; i < bandEnd; i++) {
+            const OcrRect& line = lineBounds[sorted[i]];
+            int64_t claim = -1;
+            size_t overlapped = 0;
+            for (size_t block : active) {
+                if (HorizontalOverlap(builders[block].bounds, line) > 0) {
+                    overlapped++;
+                    if (claim < 0 && ContinuesBlock(builders[block].bounds, line, lineHeight)) {
+                        claim = static_cast<int64_t>(block);
+                    }
+                }
+            }
+            if (overlapped > 1) {
+                claim = -1;
+            }
+            for (size_t block : active) {
+                if (static_cast<int64_t>(block) != claim && HorizontalOverlap(builders[block].bounds, line) > 0) {
+                    builders[block].open = false;
+                }
+            }
+            if (claim >= 0) {
+                claimCounts[static_cast<size_t>(claim)]++;
+            }
+            claims[i - bandStart] = claim;
+        }
+
+        for (size_t i = bandStart; i < bandEnd; i++) {
+            uint32_t lineIndex = sorted[i];
+            int64_t claim = claims[i - bandStart];
+            if (claim >= 0 && claimCounts[static_cast<size_t>(claim)] > 1) {
+                builders[static_cast<size_t>(claim)].open = false;
+            }
+            if (claim >= 0 && builders[static_cast<size_t>(claim)].open) {
+                BlockBuilder& builder = builders[static_cast<size_t>(claim)];
+                builder.bounds = RectUnion(builder.bounds, lineBounds[lineIndex]);
+                builder.lines.push_back(lineIndex);
+            } else {
+                builders.push_back({ lineBounds[lineIndex], { lineIndex }, true });
+                active.push_back(builders.size() - 1);
+            }
+        }
+        for (int64_t claim : claims) {
+            if (claim >= 0) {
+                claimCounts[static_cast<size_t>(claim)] = 0;
+            }
+        }
+        bandStart = bandEnd;
+    }
+
+    std::vector<OcrRect> blockBounds;
+    blockBounds.reserve(builders.size());
+    std::vector<uint32_t> byX;
+    for (uint32_t i = 0; i < builders.size(); i++) {
+        blockBounds.push_back(builders[i].bounds);
+        byX.push_back(i);
+    }
+    std::vector<uint32_t> byY = byX;
+    std::stable_sort(byX.begin(), byX.end(), [&blockBounds](uint32_t a, uint32_t b) { return blockBounds[a].x < blockBounds[b].x; });
+    std::stable_sort(byY.begin(), byY.end(), [&blockBounds](uint32_t a, uint32_t b) { return blockBounds[a].y < blockBounds[b].y; });
+    std::vector<uint32_t> blockOrder;
+    std::vector<uint32_t> columns(builders.size(), 0);
+    std::vector<uint32_t> partOf(builders.size(), 0);
+    OrderBlocks(byX, byY, blockBounds, partOf, blockOrder, columns);
+
+    layout.lineOrder.reserve(lineCount);
+    layout.blocks.reserve(blockOrder.size());
+    for (uint32_t builderIndex : blockOrder) {
+        const BlockBuilder& builder = builders[builderIndex];
+        const OcrRect& bounds = builder.bounds;
+
+        OcrLayoutBlock block;
+        block.box = {
+            skew.Apply({ bounds.x, bounds.y }),
+            skew.Apply({ bounds.Right(), bounds.y }),
+            skew.Apply({ bounds.x, bounds.Bottom() }),
+            skew.Apply({ bounds.Right(), bounds.Bottom() })
+        };
+        block.column = columns[builderIndex];
+        block.firstParagraph = static_cast<uint32_t>(layout.paragraphs.size());
+
+        uint32_t blockIndex = static_cast<uint32_t>(layout.blocks.size());
+        for (size_t i = 0; i < builder.lines.size(); i++) {
+            if (i == 0 || StartsParagraph(bounds, lineBounds[builder.lines[i - 1]], lineBounds[builder.lines[i]])) {
+                layout.paragraphs.push_back({ blockIndex, static_cast<uint32_t>(layout.lineOrder.size()), 0 });
+            }
+            layout.paragraphs.back().lineCount++;
+            layout.lineOrder.push_back(builder.lines[i]);
+        }
+        block.paragraphCount = static_cast<uint32_t>(layout.paragraphs.size()) - block.firstParagraph;
+        layout.blocks.push_back(block);
+    }
+    return layout;
+}
+
+std::string JoinOcrLayoutText(const OcrPage& page, const OcrLayout& layout, const OcrTextOptions& options) {
+    std::string text;
+    for (const auto& paragraph : layout.paragraphs) {
+        bool paragraphStarted = false;
+        for (uint32_t i = paragraph.firstLine; i < paragraph.firstLine + paragraph.lineCount; i++) {
+            std::string lineText = FilteredLineText(page.lines[layout.lineOrder[i]], options.minWordConfidence);
+            if (lineText.empty()) {
+                continue;
+            }
+            if (!text.empty()) {
+                text.append(paragraphStarted ? options.lineSeparator : options.paragraphSeparator);
+            }
+            text.append(lineText);
+            paragraphStarted = true;
+        }
+    }
+    return text;
+}
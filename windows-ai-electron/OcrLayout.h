@@ -0,0 +1,40 @@
+#pragma once
+
+#include "OcrModel.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Reading-order and layout reconstruction for an OcrPage.
+//
+// Lines are deskewed by -textAngle, swept top to bottom into blocks of vertically stacked lines,
+// blocks are ordered by recursive XY-cut (columns before bands), and each block is split into
+// paragraphs. Lines and paragraphs are stored as contiguous ranges so the result stays flat.
+
+struct OcrLayoutParagraph {
+    uint32_t block = 0;
+    uint32_t firstLine = 0; // index into OcrLayout::lineOrder
+    uint32_t lineCount = 0;
+};
+
+struct OcrLayoutBlock {
+    OcrQuad box;            // in image coordinates, rotated by textAngle like the lines
+    uint32_t column = 0;    // left-to-right column index within the band the block belongs to
+    uint32_t firstParagraph = 0;
+    uint32_t paragraphCount = 0;
+};
+
+struct OcrLayout {
+    float textAngle = 0;
+    std::vector<uint32_t> lineOrder; // indices into OcrPage::lines, in reading order
+    std::vector<OcrLayoutParagraph> paragraphs;
+    std::vector<OcrLayoutBlock> blocks;
+};
+
+// O(n log n + n*k) over n lines, where k is the number of blocks open side by side at a line's height
+// (about the number of columns), plus O(b) per level of XY-cut nesting over the b blocks
+OcrLayout AnalyzeOcrLayout(const OcrPage& page);
+
+// Joins the page text in layout order: lineSeparator within a paragraph, paragraphSeparator between
+// paragraphs and blocks. minWordConfidence is applied as in JoinOcrPageText.
+std::string JoinOcrLayoutText(const OcrPage& page, const OcrLayout& layout, const OcrTextOptions& options);
@@ -0,0 +1,376 @@
+#include "OcrModel.h"
+#include <algorithm>
+#include <cstring>
+
+OcrRect QuadBounds(const OcrQuad& quad) {
+    float left = std::min({ quad.topLeft.x, quad.topRight.x, quad.bottomLeft.x, quad.bottomRight.x });
+    float top = std::min({ quad.topLeft.y, quad.topRight.y, quad.bottomLeft.y, quad.bottomRight.y });
+    float right = std::max({ quad.topLeft.x, quad.topRight.x, quad.bottomLeft.x, quad.bottomRight.x });
+    float bottom = std::max({ quad.topLeft.y, quad.topRight.y, quad.bottomLeft.y, quad.bottomRight.y });
+    return { left, top, right - left, bottom - top };
+}
+
+bool RectsIntersect(const OcrRect& a, const OcrRect& b) {
+    return a.x < b.Right() && b.x < a.Right() && a.y < b.Bottom() && b.y < a.Bottom();
+}
+
+OcrRect RectUnion(const OcrRect& a, const OcrRect& b) {
+    float left = std::min(a.x, b.x);
+    float top = std::min(a.y, b.y);
+    float right = std::max(a.Right(), b.Right());
+    float bottom = std::max(a.Bottom(), b.Bottom());
+    return { left, top, right - left, bottom - top };
+}
+
+namespace {
+
+void OffsetQuad(OcrQuad& quad, float dx, float dy) {
+    for (OcrPoint* point : { &quad.topLeft, &quad.topRight, &quad.bottomLeft, &quad.bottomRight }) {
+        point->x += dx;
+        point->y += dy;
+    }
+}
+
+// Merges overlapping rectangles until none overlap. Returns true if anything was merged.
+bool MergeOverlapping(std::vector<OcrRect>& rects) {
+    bool mergedAny = false;
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < rects.size() && !merged; i++) {
+            for (size_t j = i + 1; j < rects.size(); j++) {
+                if (RectsIntersect(rects[i], rects[j])) {
+                    rects[i] = RectUnion(rects[i], rects[j]);
+                    rects.erase(rects.begin() + j);
+                    merged = true;
+                    mergedAny = true;
+                    break;
+                }
+            }
+        }
+    }
+    return mergedAny;
+}
+
+} // namespace
+
+void OffsetLine(OcrLine& line, float dx, float dy) {
+    OffsetQuad(line.box, dx, dy);
+    for (auto& word : line.words) {
+        OffsetQuad(word.box, dx, dy);
+    }
+}
+
+void ScaleOcrPage(OcrPage& page, float scaleX, float scaleY) {
+    auto scaleQuad = [scaleX, scaleY](OcrQuad& quad) {
+        for (OcrPoint* point : { &quad.topLeft, &quad.topRight, &quad.bottomLeft, &quad.bottomRight }) {
+            point->x *= scaleX;
+            point->y *= scaleY;
+        }
+    };
+    for (auto& line : page.lines) {
+        scaleQuad(line.box);
+        for (auto& word : line.words) {
+            scaleQuad(word.box);
+        }
+    }
+}
+
+std::vector<OcrRect> FindLowConfidenceLines(const OcrPage& page, float minConfidence, float padding) {
+    std::vector<OcrRect> rects;
+    for (const auto& line : page.lines) {
+        bool unsure = line.styleConfidence < minConfidence;
+        for (size_t i = 0; i < line.words.size() && !unsure; i++) {
+            unsure = line.words[i].confidence < minConfidence;
+        }
+        if (!unsure) {
+            continue;
+        }
+        OcrRect bounds = QuadBounds(line.box);
+        float margin = bounds.height * padding;
+        rects.push_back({ bounds.x - margin, bounds.y - margin, bounds.width + 2 * margin, bounds.height + 2 * margin });
+    }
+    return rects;
+}
+
+void SortLinesInReadingOrder(std::vector<OcrLine>& lines) {
+    if (lines.size() < 2) {
+        return;
+    }
+
+    std::vector<std::pair<OcrRect, size_t>> order;
+    order.reserve(lines.size());
+    for (size_t i = 0; i < lines.size(); i++) {
+        order.emplace_back(QuadBounds(lines[i].box), i);
+    }
+    std::stable_sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+        return a.first.y + a.first.height / 2 < b.first.y + b.first.height / 2;
+    });
+
+    // Group lines whose vertical centres fall within half a line height of the band, then sort each band left-to-right
+    size_t bandStart = 0;
+    for (size_t i = 1; i <= order.size(); i++) {
+        bool closeBand = i == order.size();
+        if (!closeBand) {
+            const OcrRect& first = order[bandStart].first;
+            const OcrRect& current = order[i].first;
+            float bandCenter = first.y + first.height / 2;
+            float currentCenter = current.y + current.height / 2;
+            closeBand = currentCenter - bandCenter > std::max(first.height, current.height) / 2;
+        }
+        if (closeBand) {
+            std::stable_sort(order.begin() + bandStart, order.begin() + i, [](const auto& a, const auto& b) {
+                return a.first.x < b.first.x;
+            });
+            bandStart = i;
+        }
+    }
+
+    std::vector<OcrLine> sorted;
+    sorted.reserve(lines.size());
+    for (const auto& entry : order) {
+        sorted.push_back(std::move(lines[entry.second]));
+    }
+    lines = std::move(sorted);
+}
+
+std::vector<OcrRect> ExpandToIntersectingLines(std::vector<OcrRect> rects, const std::vector<OcrLine>& lines) {
+    std::vector<OcrRect> lineBounds;
+    lineBounds.reserve(lines.size());
+    for (const auto& line : lines) {
+        lineBounds.push_back(QuadBounds(line.box));
+    }
+
+    MergeOverlapping(rects);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto& rect : rects) {
+            for (const auto& bounds : lineBounds) {
+                if (RectsIntersect(rect, bounds)) {
+                    OcrRect grown = RectUnion(rect, bounds);
+                    if (grown.x != rect.x || grown.y != rect.y || grown.width != rect.width || grown.height != rect.height) {
+                        rect = grown;
+                        changed = true;
+                    }
+                }
+            }
+        }
+        if (MergeOverlapping(rects)) {
+            changed = true;
+        }
+    }
+    return rects;
+}
+
+void SpliceLines(OcrPage& page, const std::vector<OcrRect>& regions, std::vector<OcrLine> replacement) {
+    auto isReplaced = [&regions](const OcrLine& line) {
+        OcrRect bounds = QuadBounds(line.box);
+        return std::any_of(regions.begin(), regions.end(), [&bounds](const OcrRect& region) {
+            return RectsIntersect(region, bounds);
+        });
+    };
+    page.lines.erase(std::remove_if(page.lines.begin(), page.lines.end(), isReplaced), page.lines.end());
+
+    for (auto& line : replacement) {
+        page.lines.push_back(std::move(line));
+    }
+    SortLinesInReadingOrder(page.lines);
+}
+
+std::vector<OcrLine> MergeRegionLines(std::vector<std::vector<OcrLine>> regionLines) {
+    std::vector<OcrLine> merged;
+    std::vector<OcrRect> mergedBounds;
+    for (auto& lines : regionLines) {
+        for (auto& line : lines) {
+            OcrRect bounds = QuadBounds(line.box);
+            bool duplicate = false;
+            for (size_t i = 0; i < merged.size() && !duplicate; i++) {
+                if (merged[i].text != line.text || !RectsIntersect(mergedBounds[i], bounds)) {
+                    continue;
+                }
+                float overlapWidth = std::min(mergedBounds[i].Right(), bounds.Right()) - std::max(mergedBounds[i].x, bounds.x);
+                float overlapHeight = std::min(mergedBounds[i].Bottom(), bounds.Bottom()) - std::max(mergedBounds[i].y, bounds.y);
+                float smallerArea = std::min(mergedBounds[i].Area(), bounds.Area());
+                duplicate = smallerArea > 0 && overlapWidth * overlapHeight > smallerArea / 2;
+            }
+            if (!duplicate) {
+                mergedBounds.push_back(bounds);
+                merged.push_back(std::move(line));
+            }
+        }
+    }
+    SortLinesInReadingOrder(merged);
+    return merged;
+}
+
+std::string FilteredLineText(const OcrLine& line, float minWordConfidence) {
+    if (minWordConfidence <= 0) {
+        return line.text;
+    }
+    std::string filtered;
+    for (const auto& word : line.words) {
+        if (word.confidence >= minWordConfidence) {
+            if (!filtered.empty()) {
+                filtered.push_back(' ');
+            }
+            filtered.append(word.text);
+        }
+    }
+    return filtered;
+}
+
+std::string JoinOcrPageText(const OcrPage& page, const OcrTextOptions& options) {
+    std::string text;
+    const OcrLine* previous = nullptr;
+    for (const auto& line : page.lines) {
+        std::string lineText = FilteredLineText(line, options.minWordConfidence);
+        if (lineText.empty()) {
+            continue;
+        }
+
+        if (previous) {
+            OcrRect before = QuadBounds(previous->box);
+            OcrRect current = QuadBounds(line.box);
+            float lineHeight = std::max(before.height, current.height);
+            bool paragraphBreak = current.y - before.Bottom() > lineHeight * 0.8f || current.Bottom() <= before.y;
+            text.append(paragraphBreak ? options.paragraphSeparator : options.lineSeparator);
+        }
+        text.append(lineText);
+        previous = &line;
+    }
+    return text;
+}
+
+namespace {
+
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    template <typename T>
+    void Write(T value) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        m_out.insert(m_out.end(), bytes, bytes + sizeof(T));
+    }
+
+    void WriteString(const std::string& value) {
+        Write<uint32_t>(static_cast<uint32_t>(value.size()));
+        m_out.insert(m_out.end(), value.begin(), value.end());
+    }
+
+    void WriteQuad(const OcrQuad& quad) {
+        for (const OcrPoint* point : { &quad.topLeft, &quad.topRight, &quad.bottomLeft, &quad.bottomRight }) {
+            Write<float>(point->x);
+            Write<float>(point->y);
+        }
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+};
+
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t length) : m_data(data), m_remaining(length) {}
+
+    template <typename T>
+    bool Read(T& value) {
+        if (m_remaining < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, m_data, sizeof(T));
+        m_data += sizeof(T);
+        m_remaining -= sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::string& value) {
+        uint32_t size = 0;
+        if (!Read(size) || m_remaining < size) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(m_data), size);
+        m_data += size;
+        m_remaining -= size;
+        return true;
+    }
+
+    bool ReadQuad(OcrQuad& quad) {
+        for (OcrPoint* point : { &quad.topLeft, &quad.topRight, &quad.bottomLeft, &quad.bottomRight }) {
+            if (!Read(point->x) || !Read(point->y)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Guards reserve() against counts that cannot possibly fit in the remaining bytes
+    bool CanHold(uint32_t count, size_t minimumItemSize) const {
+        return static_cast<uint64_t>(count) * minimumItemSize <= m_remaining;
+    }
+
+    bool AtEnd() const { return m_remaining == 0; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_remaining;
+};
+
+constexpr uint32_t kOcrPageFormatVersion = 1;
+
+} // namespace
+
+std::vector<uint8_t> SerializeOcrPage(const OcrPage& page) {
+    std::vector<uint8_t> out;
+    ByteWriter writer(out);
+    writer.Write<uint32_t>(kOcrPageFormatVersion);
+    writer.Write<float>(page.textAngle);
+    writer.Write<uint32_t>(static_cast<uint32_t>(page.lines.size()));
+    for (const auto& line : page.lines) {
+        writer.WriteString(line.text);
+        writer.WriteQuad(line.box);
+        writer.Write<int32_t>(line.style);
+        writer.Write<float>(line.styleConfidence);
+        writer.Write<uint32_t>(static_cast<uint32_t>(line.words.size()));
+        for (const auto& word : line.words) {
+            writer.WriteString(word.text);
+            writer.WriteQuad(word.box);
+            writer.Write<float>(word.confidence);
+        }
+    }
+    return out;
+}
+
+bool DeserializeOcrPage(const uint8_t* data, size_t length, OcrPage& page) {
+    ByteReader reader(data, length);
+    uint32_t version = 0;
+    uint32_t lineCount = 0;
+    if (!reader.Read(version) || version != kOcrPageFormatVersion) {
+        return false;
+    }
+    if (!reader.Read(page.textAngle) || !reader.Read(lineCount) || !reader.CanHold(lineCount, 48)) {
+        return false;
+    }
+
+    page.lines.clear();
+    page.lines.reserve(lineCount);
+    for (uint32_t i = 0; i < lineCount; i++) {
+        OcrLine line;
+        uint32_t wordCount = 0;
+        if (!reader.ReadString(line.text) || !reader.ReadQuad(line.box) || !reader.Read(line.style) ||
+            !reader.Read(line.styleConfidence) || !reader.Read(wordCount) || !reader.CanHold(wordCount, 40)) {
+            return false;
+        }
+        line.words.reserve(wordCount);
+        for (uint32_t j = 0; j < wordCount; j++) {
+            OcrWord word;
+            if (!reader.ReadString(word.text) || !reader.ReadQuad(word.box) || !reader.Read(word.confidence)) {
+                return false;
+            }
+            line.words.push_back(std::move(word));
+        }
+        page.lines.push_back(std::move(line));
+    }
+    return reader.AtEnd();
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Native copy of a RecognizedText result. RecognizedText and its lines are immutable WinRT
+// objects, so anything that needs to merge, filter or persist OCR output works on this model.
+// Conversion from the WinRT types lives in ImagingHelper.
+
+struct OcrPoint {
+    float x = 0;
+    float y = 0;
+};
+
+// Same corner layout as RecognizedTextBoundingBox
+struct OcrQuad {
+    OcrPoint topLeft;
+    OcrPoint topRight;
+    OcrPoint bottomLeft;
+    OcrPoint bottomRight;
+};
+
+// Axis-aligned rectangle in image pixels
+struct OcrRect {
+    float x = 0;
+    float y = 0;
+    float width = 0;
+    float height = 0;
+
+    float Right() const { return x + width; }
+    float Bottom() const { return y + height; }
+    float Area() const { return width * height; }
+};
+
+struct OcrWord {
+    std::string text; // UTF-8
+    OcrQuad box;
+    float confidence = 0;
+};
+
+struct OcrLine {
+    std::string text; // UTF-8
+    OcrQuad box;
+    int32_t style = 0;
+    float styleConfidence = 0;
+    std::vector<OcrWord> words;
+};
+
+struct OcrPage {
+    float textAngle = 0;
+    std::vector<OcrLine> lines;
+};
+
+// Smallest axis-aligned rectangle containing the quad
+OcrRect QuadBounds(const OcrQuad& quad);
+
+// True when the rectangles overlap by a non-empty area
+bool RectsIntersect(const OcrRect& a, const OcrRect& b);
+
+// Smallest rectangle containing both
+OcrRect RectUnion(const OcrRect& a, const OcrRect& b);
+
+// Translates a line and its words, used to map results of a cropped image back to the source image
+void OffsetLine(OcrLine& line, float dx, float dy);
+
+// Multiplies every coordinate of the page by (scaleX, scaleY), used to map results of a resized image back to the source image
+void ScaleOcrPage(OcrPage& page, float scaleX, float scaleY);
+
+// Bounds of the lines the recognizer was unsure about: a word or the line style confidence below
+// minConfidence. Each rectangle is grown by padding times the line height on every side.
+std::vector<OcrRect> FindLowConfidenceLines(const OcrPage& page, float minConfidence, float padding);
+
+// Orders lines top-to-bottom, then left-to-right for lines sharing a baseline band
+void SortLinesInReadingOrder(std::vector<OcrLine>& lines);
+
+// Grows each rectangle to fully contain every line it touches, then merges overlapping rectangles.
+// Re-recognizing the grown rectangles replaces whole lines instead of fragments of them.
+std::vector<OcrRect> ExpandToIntersectingLines(std::vector<OcrRect> rects, const std::vector<OcrLine>& lines);
+
+// Replaces every line of the page that intersects one of the regions with the given lines
+void SpliceLines(OcrPage& page, const std::vector<OcrRect>& regions, std::vector<OcrLine> replacement);
+
+// Combines lines recognized in separate, possibly overlapping regions of one image into reading order.
+// A line recognized twice (same text, boxes overlapping by more than half) is kept once.
+std::vector<OcrLine> MergeRegionLines(std::vector<std::vector<OcrLine>> regionLines);
+
+// How a page is flattened into plain text
+struct OcrTextOptions {
+    std::string lineSeparator = "\n";
+    std::string paragraphSeparator = "\n\n";
+    // Words below this confidence are dropped and the line is rebuilt from the remaining words
+    // separated by single spaces. 0 keeps the recognized line text unchanged.
+    float minWordConfidence = 0;
+};
+
+// Line text with words below minWordConfidence removed, see OcrTextOptions
+std::string FilteredLineText(const OcrLine& line, float minWordConfidence);
+
+// Joins the lines of the page in their stored order. A paragraph separator is used instead of the
+// line separator when the vertical gap to the previous line exceeds 0.8 line heights or the line
+// starts above the previous one (a new column). Lines left without words are skipped.
+std::string JoinOcrPageText(const OcrPage& page, const OcrTextOptions& options);
+
+// Compact little-endian binary form of a page, used by the persistent result store
+std::vector<uint8_t> SerializeOcrPage(const OcrPage& page);
+
+// Inverse of SerializeOcrPage. Returns false when the payload is truncated or malformed.
+bool DeserializeOcrPage(const uint8_t* data, size_t length, OcrPage& page);
@@ -0,0 +1,179 @@
+#include "OcrTable.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+
+struct Cell {
+    OcrRect bounds; // deskewed
+    std::string text;
+};
+
+OcrRect DeskewedBounds(const OcrQuad& quad, float cosine, float sine) {
+    auto apply = [cosine, sine](const OcrPoint& point) {
+        return OcrPoint{ point.x * cosine - point.y * sine, point.x * sine + point.y * cosine };
+    };
+    return QuadBounds({ apply(quad.topLeft), apply(quad.topRight), apply(quad.bottomLeft), apply(quad.bottomRight) });
+}
+
+float CenterY(const OcrRect& rect) {
+    return rect.y + rect.height / 2;
+}
+
+} // namespace
+
+OcrTableGrid BuildOcrTableGrid(const OcrPage& page, float minWordConfidence) {
+    OcrTableGrid grid;
+    float radians = -page.textAngle * kPi / 180.0f;
+    float cosine = std::cos(radians);
+    float sine = std::sin(radians);
+
+    // A gap wider than the line height inside a line separates two cells the recognizer read as one line
+    std::vector<Cell> cells;
+    for (const auto& line : page.lines) {
+        if (line.words.empty()) {
+            if (!line.text.empty()) {
+                cells.push_back({ DeskewedBounds(line.box, cosine, sine), line.text });
+            }
+            continue;
+        }
+        float lineHeight = std::max(DeskewedBounds(line.box, cosine, sine).height, 1.0f);
+        bool open = false;
+        Cell current;
+        for (const auto& word : line.words) {
+            if (minWordConfidence > 0 && word.confidence < minWordConfidence) {
+                continue;
+            }
+            OcrRect bounds = DeskewedBounds(word.box, cosine, sine);
+            if (open && bounds.x - current.bounds.Right() > lineHeight) {
+                cells.push_back(std::move(current));
+                open = false;
+            }
+            if (!open) {
+                current = { bounds, word.text };
+                open = true;
+            } else {
+                current.bounds = RectUnion(current.bounds, bounds);
+                current.text += ' ';
+                current.text += word.text;
+            }
+        }
+        if (open) {
+            cells.push_back(std::move(current));
+        }
+    }
+    if (cells.empty()) {
+        return grid;
+    }
+
+    // Rows: cells whose vertical centres fall within half a cell height of the first cell of the band
+    std::vector<uint32_t> order(cells.size());
+    for (uint32_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&cells](uint32_t a, uint32_t b) {
+        return CenterY(cells[a].bounds) < CenterY(cells[b].bounds);
+    });
+    std::vector<std::vector<uint32_t>> rows;
+    for (uint32_t cell : order) {
+        if (!rows.empty()) {
+            const OcrRect& first = cells[rows.back().front()].bounds;
+            const OcrRect& current = cells[cell].bounds;
+            if (CenterY(current) - CenterY(first) <= std::max(first.height, current.height) / 2) {
+                rows.back().push_back(cell);
+                continue;
+            }
+        }
+        rows.push_back({ cell });
+    }
+    bool anyMultiCellRow = false;
+    for (auto& row : rows) {
+        std::sort(row.begin(), row.end(), [&cells](uint32_t a, uint32_t b) {
+            return cells[a].bounds.x < cells[b].bounds.x;
+        });
+        anyMultiCellRow = anyMultiCellRow || row.size() > 1;
+    }
+
+    // Columns: merged horizontal extents. Single-cell rows (titles, notes) would bridge every gap, and so
+    // would a cell spanning columns, so cells are merged narrowest first and one that overlaps two columns
+    // already found is left out.
+    std::vector<std::pair<float, float>> spans;
+    for (const auto& row : rows) {
+        if (row.size() > 1 || !anyMultiCellRow) {
+            for (uint32_t cell : row) {
+                spans.emplace_back(cells[cell].bounds.x, cells[cell].bounds.Right());
+            }
+        }
+    }
+    std::stable_sort(spans.begin(), spans.end(), [](const auto& a, const auto& b) {
+        return a.second - a.first < b.second - b.first;
+    });
+    std::vector<std::pair<float, float>> columns;
+    for (const auto& span : spans) {
+        size_t overlapping = 0;
+        size_t match = 0;
+        for (size_t i = 0; i < columns.size(); i++) {
+            if (span.first <= columns[i].second && columns[i].first <= span.second) {
+                overlapping++;
+                match = i;
+            }
+        }
+        if (overlapping == 0) {
+            columns.push_back(span);
+        } else if (overlapping == 1) {
+            columns[match] = { std::min(columns[match].first, span.first), std::max(columns[match].second, span.second) };
+        }
+    }
+    std::sort(columns.begin(), columns.end());
+    grid.columnCount = static_cast<uint32_t>(columns.size());
+
+    auto columnOf = [&columns](const OcrRect& bounds) {
+        size_t best = 0;
+        float bestScore = -std::numeric_limits<float>::infinity();
+        for (size_t i = 0; i < columns.size(); i++) {
+            float overlap = std::min(bounds.Right(), columns[i].second) - std::max(bounds.x, columns[i].first);
+            // Without overlap the score is minus the distance, so the nearest column wins
+            if (overlap > bestScore) {
+                bestScore = overlap;
+                best = i;
+            }
+        }
+        return best;
+    };
+
+    grid.rows.reserve(rows.size());
+    for (const auto& row : rows) {
+        std::vector<std::string> values(columns.size());
+        for (uint32_t cell : row) {
+            std::string& value = values[columnOf(cells[cell].bounds)];
+            if (!value.empty()) {
+                value += ' ';
+            }
+            value += cells[cell].text;
+        }
+        grid.rows.push_back(std::move(values));
+    }
+    return grid;
+}
+
+std::string FormatOcrTableText(const OcrTableGrid& grid) {
+    std::string text;
+    for (const auto& row : grid.rows) {
+        if (std::all_of(row.begin(), row.end(), [](const std::string& value) { return value.empty(); })) {
+            continue;
+        }
+        if (!text.empty()) {
+            text += '\n';
+        }
+        for (size_t i = 0; i < row.size(); i++) {
+            if (i > 0) {
+                text += " | ";
+            }
+            text += row[i];
+        }
+    }
+    return text;
+}
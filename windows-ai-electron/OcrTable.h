@@ -0,0 +1,25 @@
+#pragma once
+
+#include "OcrModel.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Table structure recovered from OCR geometry, used to give TextToTableConverter row and column
+// hints it cannot see in plain text.
+//
+// Words are deskewed by -textAngle and split into cells at gaps wider than a line height. Cells
+// whose vertical centres share a band form a row. Columns are the gaps in the horizontal projection
+// of all cells of multi-cell rows, so left-, right- and centre-aligned columns are found alike. A cell
+// that spans columns is left out of the projection and placed in the column it overlaps most.
+
+struct OcrTableGrid {
+    uint32_t columnCount = 0;
+    std::vector<std::vector<std::string>> rows; // top to bottom, columnCount cells each, "" when empty
+};
+
+// Words below minWordConfidence are left out, 0 keeps every word
+OcrTableGrid BuildOcrTableGrid(const OcrPage& page, float minWordConfidence);
+
+// One line per row with cells separated by " | ". Rows without text are skipped.
+std::string FormatOcrTableText(const OcrTableGrid& grid);
@@ -0,0 +1,222 @@
+#include "OcrWordIndex.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+float Cross(const OcrPoint& a, const OcrPoint& b, float x, float y) {
+    return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+}
+
+// Corners in winding order; the quad may be wound either way depending on TextAngle
+bool PointInQuad(const OcrQuad& quad, float x, float y) {
+    const OcrPoint* corners[4] = { &quad.topLeft, &quad.topRight, &quad.bottomRight, &quad.bottomLeft };
+    bool anyPositive = false;
+    bool anyNegative = false;
+    for (int i = 0; i < 4; i++) {
+        float cross = Cross(*corners[i], *corners[(i + 1) % 4], x, y);
+        anyPositive = anyPositive || cross > 0;
+        anyNegative = anyNegative || cross < 0;
+    }
+    return !(anyPositive && anyNegative);
+}
+
+float DistanceToSegment(const OcrPoint& a, const OcrPoint& b, float x, float y) {
+    float dx = b.x - a.x;
+    float dy = b.y - a.y;
+    float lengthSquared = dx * dx + dy * dy;
+    float t = lengthSquared > 0 ? ((x - a.x) * dx + (y - a.y) * dy) / lengthSquared : 0;
+    t = std::clamp(t, 0.0f, 1.0f);
+    float px = a.x + t * dx - x;
+    float py = a.y + t * dy - y;
+    return std::sqrt(px * px + py * py);
+}
+
+bool Contains(const OcrRect& rect, float x, float y) {
+    return x >= rect.x && x <= rect.Right() && y >= rect.y && y <= rect.Bottom();
+}
+
+bool Touches(const OcrRect& a, const OcrRect& b) {
+    return a.x <= b.Right() && b.x <= a.Right() && a.y <= b.Bottom() && b.y <= a.Bottom();
+}
+
+uint32_t CellCoordinate(float value, float origin, float cellSize, uint32_t count) {
+    double cell = std::floor((static_cast<double>(value) - origin) / cellSize);
+    return static_cast<uint32_t>(std::clamp(cell, 0.0, static_cast<double>(count - 1)));
+}
+
+} // namespace
+
+OcrWordIndex::OcrWordIndex(const OcrPage& page) {
+    for (const auto& line : page.lines) {
+        for (const auto& word : line.words) {
+            m_quads.push_back(word.box);
+            m_bounds.push_back(QuadBounds(word.box));
+        }
+    }
+    if (m_quads.empty()) {
+        m_cellStart.push_back(0);
+        return;
+    }
+
+    OcrRect extent = m_bounds[0];
+    for (const auto& bounds : m_bounds) {
+        extent = RectUnion(extent, bounds);
+    }
+    m_originX = extent.x;
+    m_originY = extent.y;
+    float width = std::max(extent.width, 1.0f);
+    float height = std::max(extent.height, 1.0f);
+    m_cellSize = std::max(std::sqrt(width * height / static_cast<float>(m_quads.size())), 1.0f);
+    m_columns = static_cast<uint32_t>(std::ceil(width / m_cellSize));
+    m_rows = static_cast<uint32_t>(std::ceil(height / m_cellSize));
+    m_columns = std::max(m_columns, 1u);
+    m_rows = std::max(m_rows, 1u);
+
+    // Counting pass, prefix sums, then fill: one contiguous array for all cells
+    m_cellStart.assign(static_cast<size_t>(m_columns) * m_rows + 1, 0);
+    for (const auto& bounds : m_bounds) {
+        CellRange range = CellsCovering(bounds);
+        for (uint32_t row = range.firstRow; row <= range.lastRow; row++) {
+            for (uint32_t column = range.firstColumn; column <= range.lastColumn; column++) {
+                m_cellStart[static_cast<size_t>(row) * m_columns + column + 1]++;
+            }
+        }
+    }
+    for (size_t i = 1; i < m_cellStart.size(); i++) {
+        m_cellStart[i] += m_cellStart[i - 1];
+    }
+    m_cellWords.resize(m_cellStart.back());
+    std::vector<uint32_t> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (uint32_t word = 0; word < m_bounds.size(); word++) {
+        CellRange range = CellsCovering(m_bounds[word]);
+        for (uint32_t row = range.firstRow; row <= range.lastRow; row++) {
+            for (uint32_t column = range.firstColumn; column <= range.lastColumn; column++) {
+                m_cellWords[fill[static_cast<size_t>(row) * m_columns + column]++] = word;
+            }
+        }
+    }
+}
+
+OcrWordIndex::CellRange OcrWordIndex::CellsCovering(const OcrRect& rect) const {
+    return {
+        CellCoordinate(rect.x, m_originX, m_cellSize, m_columns),
+        CellCoordinate(rect.Right(), m_originX, m_cellSize, m_columns),
+        CellCoordinate(rect.y, m_originY, m_cellSize, m_rows),
+        CellCoordinate(rect.Bottom(), m_originY, m_cellSize, m_rows)
+    };
+}
+
+float OcrWordIndex::DistanceToWord(uint32_t word, float x, float y) const {
+    const OcrQuad& quad = m_quads[word];
+    if (PointInQuad(quad, x, y)) {
+        return 0;
+    }
+    return std::min({
+        DistanceToSegment(quad.topLeft, quad.topRight, x, y),
+        DistanceToSegment(quad.topRight, quad.bottomRight, x, y),
+        DistanceToSegment(quad.bottomRight, quad.bottomLeft, x, y),
+        DistanceToSegment(quad.bottomLeft, quad.topLeft, x, y)
+    });
+}
+
+int64_t OcrWordIndex::HitTest(float x, float y) const {
+    if (m_quads.empty() || !Contains({ m_originX, m_originY, m_columns * m_cellSize, m_rows * m_cellSize }, x, y)) {
+        return -1;
+    }
+
+    size_t cell = static_cast<size_t>(CellCoordinate(y, m_originY, m_cellSize, m_rows)) * m_columns + CellCoordinate(x, m_originX, m_cellSize, m_columns);
+    int64_t hit = -1;
+    float hitArea = 0;
+    for (uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; i++) {
+        uint32_t word = m_cellWords[i];
+        if (Contains(m_bounds[word], x, y) && PointInQuad(m_quads[word], x, y) && (hit < 0 || m_bounds[word].Area() < hitArea)) {
+            hit = word;
+            hitArea = m_bounds[word].Area();
+        }
+    }
+    return hit;
+}
+
+std::vector<uint32_t> OcrWordIndex::QueryRect(const OcrRect& rect) const {
+    std::vector<uint32_t> words;
+    if (m_quads.empty() || !Touches({ m_originX, m_originY, m_columns * m_cellSize, m_rows * m_cellSize }, rect)) {
+        return words;
+    }
+
+    // A word spanning several cells is listed in each of them
+    std::vector<bool> seen(m_quads.size(), false);
+    CellRange range = CellsCovering(rect);
+    for (uint32_t row = range.firstRow; row <= range.lastRow; row++) {
+        for (uint32_t column = range.firstColumn; column <= range.lastColumn; column++) {
+            size_t cell = static_cast<size_t>(row) * m_columns + column;
+            for (uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; i++) {
+                uint32_t word = m_cellWords[i];
+                if (!seen[word] && Touches(m_bounds[word], rect)) {
+                    seen[word] = true;
+                    words.push_back(word);
+                }
+            }
+        }
+    }
+    std::sort(words.begin(), words.end());
+    return words;
+}
+
+std::vector<uint32_t> OcrWordIndex::Nearest(float x, float y, size_t k) const {
+    std::vector<uint32_t> words;
+    k = std::min(k, m_quads.size());
+    if (k == 0) {
+        return words;
+    }
+
+    // Visit rings of cells around the point. Every cell outside ring r is at least r cells away,
+    // so the search stops once k words are known and the k-th distance is within that bound.
+    int64_t centerColumn = CellCoordinate(x, m_originX, m_cellSize, m_columns);
+    int64_t centerRow = CellCoordinate(y, m_originY, m_cellSize, m_rows);
+    int64_t maxRing = std::max<int64_t>(m_columns, m_rows);
+    std::vector<bool> seen(m_quads.size(), false);
+    std::vector<std::pair<float, uint32_t>> candidates;
+
+    auto visit = [&](int64_t column, int64_t row) {
+        if (column < 0 || row < 0 || column >= m_columns || row >= m_rows) {
+            return;
+        }
+        size_t cell = static_cast<size_t>(row) * m_columns + static_cast<size_t>(column);
+        for (uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; i++) {
+            uint32_t word = m_cellWords[i];
+            if (!seen[word]) {
+                seen[word] = true;
+                candidates.emplace_back(DistanceToWord(word, x, y), word);
+            }
+        }
+    };
+
+    for (int64_t ring = 0; ring <= maxRing; ring++) {
+        for (int64_t row = centerRow - ring; row <= centerRow + ring; row++) {
+            if (row == centerRow - ring || row == centerRow + ring) {
+                for (int64_t column = centerColumn - ring; column <= centerColumn + ring; column++) {
+                    visit(column, row);
+                }
+            } else {
+                visit(centerColumn - ring, row);
+                if (ring > 0) {
+                    visit(centerColumn + ring, row);
+                }
+            }
+        }
+        if (candidates.size() >= k) {
+            std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end());
+            if (candidates[k - 1].first <= ring * m_cellSize) {
+                break;
+            }
+        }
+    }
+
+    std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end());
+    words.reserve(k);
+    for (size_t i = 0; i < k; i++) {
+        words.push_back(candidates[i].second);
+    }
+    return words;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "OcrModel.h"
+#include <cstdint>
+#include <vector>
+
+// Uniform grid over the word quads of an OcrPage for hit-testing. Words are numbered in flat order:
+// every word of line 0, then every word of line 1, and so on. The grid has about one cell per word
+// and stores cell contents contiguously, so queries only touch the cells around the query.
+// Immutable after construction and safe to query from several threads.
+class OcrWordIndex {
+public:
+    explicit OcrWordIndex(const OcrPage& page);
+
+    size_t WordCount() const { return m_quads.size(); }
+
+    // Word whose quad contains the point, the smallest one when several do. -1 when none does.
+    int64_t HitTest(float x, float y) const;
+
+    // Words whose quad bounds intersect the rectangle, in ascending flat order
+    std::vector<uint32_t> QueryRect(const OcrRect& rect) const;
+
+    // Up to k words closest to the point (distance 0 inside a quad), nearest first
+    std::vector<uint32_t> Nearest(float x, float y, size_t k) const;
+
+private:
+    struct CellRange {
+        uint32_t firstColumn, lastColumn, firstRow, lastRow;
+    };
+
+    CellRange CellsCovering(const OcrRect& rect) const;
+    float DistanceToWord(uint32_t word, float x, float y) const;
+
+    std::vector<OcrQuad> m_quads;
+    std::vector<OcrRect> m_bounds;
+    float m_originX = 0;
+    float m_originY = 0;
+    float m_cellSize = 1;
+    uint32_t m_columns = 0;
+    uint32_t m_rows = 0;
+    std::vector<uint32_t> m_cellStart; // m_columns * m_rows + 1 offsets into m_cellWords
+    std::vector<uint32_t> m_cellWords;
+};
@@ -0,0 +1,290 @@
+#include "PixelAnalysis.h"
+#include <algorithm>
+#include <bitset>
+#include <cstdlib>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define PIXEL_ANALYSIS_SSE2 1
+#include <emmintrin.h>
+#elif defined(_M_ARM64) || defined(__ARM_NEON)
+#define PIXEL_ANALYSIS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+// Luma weights scaled by 256 (BT.601), the sums below are therefore 256 * luma
+constexpr uint32_t kBlueWeight = 29;
+constexpr uint32_t kGreenWeight = 150;
+constexpr uint32_t kRedWeight = 77;
+
+constexpr uint32_t kHashColumns = 9;
+constexpr uint32_t kHashRows = 8;
+
+// Sum of 256 * luma over `count` consecutive BGRA8 pixels
+uint64_t SumWeightedLuma(const uint8_t* pixels, uint32_t count) {
+    uint64_t total = 0;
+    uint32_t i = 0;
+
+#if defined(PIXEL_ANALYSIS_SSE2)
+    const __m128i weights = _mm_setr_epi16(kBlueWeight, kGreenWeight, kRedWeight, 0, kBlueWeight, kGreenWeight, kRedWeight, 0);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i accumulator = _mm_setzero_si128();
+    uint32_t pending = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4));
+        __m128i low = _mm_madd_epi16(_mm_unpacklo_epi8(block, zero), weights);
+        __m128i high = _mm_madd_epi16(_mm_unpackhi_epi8(block, zero), weights);
+        accumulator = _mm_add_epi32(accumulator, _mm_add_epi32(low, high));
+        // Each iteration adds at most 4 * 65280 per lane, flush well before int32 overflow
+        if (++pending == 4096) {
+            alignas(16) uint32_t lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), accumulator);
+            total += static_cast<uint64_t>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+            accumulator = _mm_setzero_si128();
+            pending = 0;
+        }
+    }
+    alignas(16) uint32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), accumulator);
+    total += static_cast<uint64_t>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+#elif defined(PIXEL_ANALYSIS_NEON)
+    const uint8x8_t blueWeight = vdup_n_u8(kBlueWeight);
+    const uint8x8_t greenWeight = vdup_n_u8(kGreenWeight);
+    const uint8x8_t redWeight = vdup_n_u8(kRedWeight);
+    uint32x4_t accumulator = vdupq_n_u32(0);
+    uint32_t pending = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint8x8x4_t block = vld4_u8(pixels + i * 4);
+        uint16x8_t luma = vmull_u8(block.val[0], blueWeight);
+        luma = vmlal_u8(luma, block.val[1], greenWeight);
+        luma = vmlal_u8(luma, block.val[2], redWeight);
+        accumulator = vpadalq_u16(accumulator, luma);
+        if (++pending == 4096) {
+            total += vaddvq_u32(accumulator);
+            accumulator = vdupq_n_u32(0);
+            pending = 0;
+        }
+    }
+    total += vaddvq_u32(accumulator);
+#endif
+
+    for (; i < count; i++) {
+        const uint8_t* pixel = pixels + i * 4;
+        total += pixel[0] * kBlueWeight + pixel[1] * kGreenWeight + pixel[2] * kRedWeight;
+    }
+    return total;
+}
+
+// Sum of absolute byte differences between two spans of `length` bytes
+uint64_t SumAbsoluteDifference(const uint8_t* a, const uint8_t* b, size_t length) {
+    uint64_t total = 0;
+    size_t i = 0;
+
+#if defined(PIXEL_ANALYSIS_SSE2)
+    __m128i accumulator = _mm_setzero_si128();
+    for (; i + 16 <= length; i += 16) {
+        __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        // Two 64-bit lanes, each at most 8 * 255 per iteration, so a single row can never overflow them
+        accumulator = _mm_add_epi64(accumulator, _mm_sad_epu8(left, right));
+    }
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), accumulator);
+    total += lanes[0] + lanes[1];
+#elif defined(PIXEL_ANALYSIS_NEON)
+    uint32x4_t accumulator = vdupq_n_u32(0);
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t difference = vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+        accumulator = vpadalq_u16(accumulator, vpaddlq_u8(difference));
+    }
+    total += vaddvq_u32(accumulator);
+#endif
+
+    for (; i < length; i++) {
+        total += static_cast<uint64_t>(std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])));
+    }
+    return total;
+}
+
+} // namespace
+
+uint64_t ComputeDifferenceHash(const uint8_t* bgra, uint32_t width, uint32_t height, uint32_t stride) {
+    if (bgra == nullptr || width == 0 || height == 0) {
+        return 0;
+    }
+
+    // Area-average the image into a 9x8 grid. Column boundaries are fixed per image, so each
+    // row contributes one contiguous span per cell which keeps the inner loop vectorizable.
+    uint32_t columnStart[kHashColumns + 1];
+    for (uint32_t c = 0; c <= kHashColumns; c++) {
+        columnStart[c] = static_cast<uint32_t>(static_cast<uint64_t>(c) * width / kHashColumns);
+    }
+
+    double cells[kHashRows][kHashColumns] = {};
+    for (uint32_t r = 0; r < kHashRows; r++) {
+        uint32_t rowBegin = static_cast<uint32_t>(static_cast<uint64_t>(r) * height / kHashRows);
+        uint32_t rowEnd = static_cast<uint32_t>(static_cast<uint64_t>(r + 1) * height / kHashRows);
+        if (rowEnd == rowBegin) {
+            rowEnd = rowBegin + 1;
+        }
+
+        uint64_t sums[kHashColumns] = {};
+        for (uint32_t y = rowBegin; y < rowEnd && y < height; y++) {
+            const uint8_t* row = bgra + static_cast<size_t>(y) * stride;
+            for (uint32_t c = 0; c < kHashColumns; c++) {
+                uint32_t begin = columnStart[c];
+                uint32_t end = columnStart[c + 1] > begin ? columnStart[c + 1] : begin + 1;
+                if (end > width) {
+                    end = width;
+                    begin = end - 1;
+                }
+                sums[c] += SumWeightedLuma(row + static_cast<size_t>(begin) * 4, end - begin);
+            }
+        }
+
+        for (uint32_t c = 0; c < kHashColumns; c++) {
+            uint32_t spanWidth = columnStart[c + 1] > columnStart[c] ? columnStart[c + 1] - columnStart[c] : 1;
+            cells[r][c] = static_cast<double>(sums[c]) / (static_cast<double>(spanWidth) * (rowEnd - rowBegin));
+        }
+    }
+
+    uint64_t hash = 0;
+    for (uint32_t r = 0; r < kHashRows; r++) {
+        for (uint32_t c = 0; c + 1 < kHashColumns; c++) {
+            hash = (hash << 1) | (cells[r][c] > cells[r][c + 1] ? 1u : 0u);
+        }
+    }
+    return hash;
+}
+
+uint32_t HammingDistance(uint64_t a, uint64_t b) {
+    return static_cast<uint32_t>(std::bitset<64>(a ^ b).count());
+}
+
+std::vector<PixelRect> FindChangedRegions(const uint8_t* previous, const uint8_t* current, uint32_t width, uint32_t height, uint32_t stride, uint32_t blockSize, uint32_t tolerance) {
+    std::vector<PixelRect> regions;
+    if (previous == nullptr || current == nullptr || width == 0 || height == 0) {
+        return regions;
+    }
+    if (blockSize == 0) {
+        blockSize = 16;
+    }
+
+    uint32_t columns = (width + blockSize - 1) / blockSize;
+    uint32_t rows = (height + blockSize - 1) / blockSize;
+    std::vector<uint8_t> dirty(static_cast<size_t>(columns) * rows, 0);
+
+    for (uint32_t by = 0; by < rows; by++) {
+        uint32_t top = by * blockSize;
+        uint32_t bottom = top + blockSize < height ? top + blockSize : height;
+        for (uint32_t bx = 0; bx < columns; bx++) {
+            uint32_t left = bx * blockSize;
+            uint32_t right = left + blockSize < width ? left + blockSize : width;
+            size_t spanBytes = static_cast<size_t>(right - left) * 4;
+            uint64_t limit = static_cast<uint64_t>(tolerance) * spanBytes * (bottom - top);
+
+            uint64_t difference = 0;
+            for (uint32_t y = top; y < bottom; y++) {
+                size_t offset = static_cast<size_t>(y) * stride + static_cast<size_t>(left) * 4;
+                difference += SumAbsoluteDifference(previous + offset, current + offset, spanBytes);
+                // Exact comparison can stop at the first differing row
+                if (difference > limit && tolerance == 0) {
+                    break;
+                }
+            }
+            dirty[static_cast<size_t>(by) * columns + bx] = difference > limit ? 1 : 0;
+        }
+    }
+
+    // Flood fill 8-connected dirty tiles into one rectangle per component
+    std::vector<uint32_t> stack;
+    for (uint32_t start = 0; start < dirty.size(); start++) {
+        if (dirty[start] != 1) {
+            continue;
+        }
+        uint32_t minX = columns, minY = rows, maxX = 0, maxY = 0;
+        dirty[start] = 2;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            uint32_t index = stack.back();
+            stack.pop_back();
+            uint32_t cx = index % columns;
+            uint32_t cy = index / columns;
+            minX = cx < minX ? cx : minX;
+            minY = cy < minY ? cy : minY;
+            maxX = cx > maxX ? cx : maxX;
+            maxY = cy > maxY ? cy : maxY;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    int nx = static_cast<int>(cx) + dx;
+                    int ny = static_cast<int>(cy) + dy;
+                    if (nx < 0 || ny < 0 || nx >= static_cast<int>(columns) || ny >= static_cast<int>(rows)) {
+                        continue;
+                    }
+                    uint32_t neighbour = static_cast<uint32_t>(ny) * columns + static_cast<uint32_t>(nx);
+                    if (dirty[neighbour] == 1) {
+                        dirty[neighbour] = 2;
+                        stack.push_back(neighbour);
+                    }
+                }
+            }
+        }
+
+        PixelRect rect;
+        rect.x = minX * blockSize;
+        rect.y = minY * blockSize;
+        uint32_t right = (maxX + 1) * blockSize;
+        uint32_t bottom = (maxY + 1) * blockSize;
+        rect.width = (right < width ? right : width) - rect.x;
+        rect.height = (bottom < height ? bottom : height) - rect.y;
+        regions.push_back(rect);
+    }
+    return regions;
+}
+
+std::vector<uint8_t> DownscaleBgra(const uint8_t* bgra, uint32_t width, uint32_t height, uint32_t stride, uint32_t targetWidth, uint32_t targetHeight) {
+    std::vector<uint8_t> result;
+    if (bgra == nullptr || width == 0 || height == 0 || targetWidth == 0 || targetHeight == 0) {
+        return result;
+    }
+    targetWidth = targetWidth < width ? targetWidth : width;
+    targetHeight = targetHeight < height ? targetHeight : height;
+
+    // Source column span of every target column, [columnStart[i], columnStart[i + 1])
+    std::vector<uint32_t> columnStart(targetWidth + 1);
+    for (uint32_t x = 0; x <= targetWidth; x++) {
+        columnStart[x] = static_cast<uint32_t>(static_cast<uint64_t>(x) * width / targetWidth);
+    }
+
+    result.resize(static_cast<size_t>(targetWidth) * targetHeight * 4);
+    std::vector<uint32_t> sums(static_cast<size_t>(targetWidth) * 4);
+    for (uint32_t ty = 0; ty < targetHeight; ty++) {
+        uint32_t top = static_cast<uint32_t>(static_cast<uint64_t>(ty) * height / targetHeight);
+        uint32_t bottom = static_cast<uint32_t>(static_cast<uint64_t>(ty + 1) * height / targetHeight);
+        std::fill(sums.begin(), sums.end(), 0u);
+        for (uint32_t y = top; y < bottom; y++) {
+            const uint8_t* row = bgra + static_cast<size_t>(y) * stride;
+            for (uint32_t tx = 0; tx < targetWidth; tx++) {
+                uint32_t* sum = &sums[static_cast<size_t>(tx) * 4];
+                for (uint32_t x = columnStart[tx]; x < columnStart[tx + 1]; x++) {
+                    const uint8_t* pixel = row + static_cast<size_t>(x) * 4;
+                    sum[0] += pixel[0];
+                    sum[1] += pixel[1];
+                    sum[2] += pixel[2];
+                    sum[3] += pixel[3];
+                }
+            }
+        }
+
+        uint8_t* output = result.data() + static_cast<size_t>(ty) * targetWidth * 4;
+        uint32_t rowCount = bottom - top;
+        for (uint32_t tx = 0; tx < targetWidth; tx++) {
+            uint32_t count = rowCount * (columnStart[tx + 1] - columnStart[tx]);
+            for (uint32_t channel = 0; channel < 4; channel++) {
+                output[tx * 4 + channel] = static_cast<uint8_t>((sums[tx * 4 + channel] + count / 2) / count);
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Pixel routines used by the imaging projections. Everything here works on raw BGRA8 memory.
+
+// 64-bit difference hash (dHash) of a BGRA8 image: the image is reduced to a 9x8 luma grid
+// and each bit records whether a cell is brighter than its right-hand neighbour
+uint64_t ComputeDifferenceHash(const uint8_t* bgra, uint32_t width, uint32_t height, uint32_t stride);
+
+// Number of differing bits between two hashes
+uint32_t HammingDistance(uint64_t a, uint64_t b);
+
+// Rectangle in pixels
+struct PixelRect {
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+// Compares two BGRA8 frames of the same size in blockSize x blockSize tiles. A tile is dirty when the
+// mean absolute per-channel difference exceeds tolerance (0 flags any change). Connected dirty tiles
+// are returned as one bounding rectangle each, clipped to the frame.
+std::vector<PixelRect> FindChangedRegions(const uint8_t* previous, const uint8_t* current, uint32_t width, uint32_t height, uint32_t stride, uint32_t blockSize, uint32_t tolerance);
+
+// Shrinks a BGRA8 image to targetWidth x targetHeight by averaging the source pixels that fall into each
+// target pixel (box filter), which keeps thin strokes such as text legible. Targets larger than the
+// source are clamped to it. Returns tightly packed BGRA8 pixels.
+std::vector<uint8_t> DownscaleBgra(const uint8_t* bgra, uint32_t width, uint32_t height, uint32_t stride, uint32_t targetWidth, uint32_t targetHeight);
@@ -0,0 +1,55 @@
+#include "ProgressText.h"
+
+namespace {
+
+// A previous fragment this long that the next one starts with is text so far, not a coincidence
+constexpr size_t kSettlingPrefix = 16;
+
+bool StartsWith(std::string_view text, std::string_view prefix) {
+    return text.size() >= prefix.size() && text.substr(0, prefix.size()) == prefix;
+}
+
+} // namespace
+
+std::string_view ProgressText::Append(std::string_view progress) {
+    size_t before = m_text.size();
+    m_fragmentOffset = before;
+    switch (m_mode) {
+    case Mode::Delta:
+        m_text.append(progress);
+        break;
+    case Mode::Accumulated:
+        // Text so far only grows; a repeat or a rewrite adds nothing
+        if (progress.size() > m_text.size() && StartsWith(progress, m_text)) {
+            m_text.append(progress.substr(m_text.size()));
+            m_fragmentOffset = 0;
+        }
+        break;
+    case Mode::Unknown:
+        if (m_pending.empty()) {
+            m_pending = progress;
+            m_last = progress;
+        } else if (StartsWith(m_last, progress)) {
+            // Identical or shorter repeat, consistent with either form
+        } else if (StartsWith(progress, m_last)) {
+            if (m_last.size() >= kSettlingPrefix || ++m_extensions >= 2) {
+                m_mode = Mode::Accumulated;
+                m_text.assign(progress);
+                m_fragmentOffset = 0;
+            } else {
+                m_pending.append(progress);
+                m_last = progress;
+            }
+        } else {
+            m_mode = Mode::Delta;
+            m_text = m_pending + std::string(progress);
+            m_fragmentOffset = m_text.size() - progress.size();
+        }
+        if (m_mode != Mode::Unknown) {
+            m_pending.clear();
+            m_last.clear();
+        }
+        break;
+    }
+    return std::string_view(m_text).substr(before);
+}
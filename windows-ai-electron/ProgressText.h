@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Text of a WinRT progress stream as UTF-8. WinAppSDK documents progress as the newly generated text,
+// but some releases report everything generated so far, so the form is detected. Until a fragment
+// settles it, fragments are held back: one that does not extend the previous one means new text, and one
+// that extends a previous fragment of 16 bytes or more, or a second extension in a row, means text so
+// far. A fragment that repeats the previous one or a prefix of it adds nothing.
+class ProgressText {
+public:
+    // Adds a fragment and returns the text it added, valid until the next call. Held-back fragments are
+    // returned together once the form is settled.
+    std::string_view Append(std::string_view progress);
+
+    const std::string& Text() const { return m_text; }
+
+    // Where the last fragment, in the form it was given, starts in Text(): the start of its new text for
+    // new-text progress, 0 for text so far, and Text().size() when it added nothing
+    size_t FragmentOffset() const { return m_fragmentOffset; }
+
+private:
+    enum class Mode {
+        Unknown,
+        Accumulated,
+        Delta
+    };
+
+    std::string m_text;
+    std::string m_pending; // held-back fragments concatenated, as new-text progress would read them
+    std::string m_last; // last held-back fragment
+    size_t m_extensions = 0; // held-back fragments in a row extending their predecessor
+    size_t m_fragmentOffset = 0;
+    Mode m_mode = Mode::Unknown;
+};
@@ -1,4 +1,9 @@
 #include "ProjectionHelper.h"
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 // ProgressPromise Implementation
 ProgressPromise ProgressPromise::Create(Napi::Env env, Napi::Promise::Deferred deferred) {
@@ -57,4 +62,124 @@ Napi::Object ProgressPromise::GetPromiseObject() const {
 
 std::shared_ptr<Napi::ThreadSafeFunction*> ProgressPromise::GetProgressTsfn() const {
     return m_progressTsfn;
-}
\ No newline at end of file
+}
+
+// AsyncIteratorQueue Implementation
+namespace {
+
+Napi::Object IteratorResult(Napi::Env env, Napi::Value value, bool done) {
+    auto result = Napi::Object::New(env);
+    result.Set("value", value);
+    result.Set("done", Napi::Boolean::New(env, done));
+    return result;
+}
+
+} // namespace
+
+void AsyncIteratorQueue::Attach(Napi::Env env, Napi::Object target) {
+    auto self = shared_from_this();
+    auto iterator = Napi::Object::New(env);
+    iterator.Set("next", Napi::Function::New(env, [self](const Napi::CallbackInfo& info) { return self->Next(info.Env()); }));
+    iterator.Set("return", Napi::Function::New(env, [self](const Napi::CallbackInfo& info) { return self->Return(info.Env()); }));
+    iterator.Set(Napi::Symbol::WellKnown(env, "asyncIterator"), Napi::Function::New(env, [](const Napi::CallbackInfo& info) { return info.This(); }));
+    
+    target.Set("_iterator", iterator);
+    target.Set(Napi::Symbol::WellKnown(env, "asyncIterator"), Napi::Function::New(env, [self](const Napi::CallbackInfo& info) {
+        self->m_requested = true;
+        return info.This().As<Napi::Object>().Get("_iterator");
+    }));
+}
+
+void AsyncIteratorQueue::Push(Napi::Env env, Napi::Object value) {
+    if (!m_requested || m_closed || m_finished) {
+        return;
+    }
+    if (!m_waiting.empty()) {
+        auto deferred = m_waiting.front();
+        m_waiting.pop_front();
+        deferred.Resolve(IteratorResult(env, value, false));
+        return;
+    }
+    m_values.push_back(Napi::Persistent(value));
+}
+
+void AsyncIteratorQueue::Finish(Napi::Env env, const std::string& error) {
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+    m_error = error;
+    while (!m_waiting.empty()) {
+        auto deferred = m_waiting.front();
+        m_waiting.pop_front();
+        if (!m_error.empty()) {
+            deferred.Reject(Napi::Error::New(env, m_error).Value());
+            m_error.clear();
+        } else {
+            deferred.Resolve(IteratorResult(env, env.Undefined(), true));
+        }
+    }
+}
+
+Napi::Value AsyncIteratorQueue::Next(Napi::Env env) {
+    m_requested = true;
+    auto deferred = Napi::Promise::Deferred::New(env);
+    if (!m_values.empty()) {
+        Napi::Object value = m_values.front().Value();
+        m_values.pop_front();
+        deferred.Resolve(IteratorResult(env, value, false));
+    } else if (m_finished && !m_error.empty() && !m_closed) {
+        deferred.Reject(Napi::Error::New(env, m_error).Value());
+        m_error.clear();
+    } else if (m_finished || m_closed) {
+        deferred.Resolve(IteratorResult(env, env.Undefined(), true));
+    } else {
+        m_waiting.push_back(deferred);
+    }
+    return deferred.Promise();
+}
+
+Napi::Value AsyncIteratorQueue::Return(Napi::Env env) {
+    m_closed = true;
+    m_values.clear();
+    while (!m_waiting.empty()) {
+        m_waiting.front().Resolve(IteratorResult(env, env.Undefined(), true));
+        m_waiting.pop_front();
+    }
+    auto deferred = Napi::Promise::Deferred::New(env);
+    deferred.Resolve(IteratorResult(env, env.Undefined(), true));
+    return deferred.Promise();
+}
+
+void RunConcurrently(size_t count, size_t maxConcurrency, const std::function<void(size_t)>& work) {
+    std::atomic<size_t> next{ 0 };
+    std::mutex errorMutex;
+    std::exception_ptr firstError;
+
+    auto drain = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            try {
+                work(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+            }
+        }
+    };
+
+    size_t threadCount = count < maxConcurrency ? count : maxConcurrency;
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < threadCount; i++) {
+        helpers.emplace_back(drain);
+    }
+    drain();
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
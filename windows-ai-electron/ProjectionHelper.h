@@ -1,7 +1,10 @@
 #pragma once
 
 #include <napi.h>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <string>
 
 // Helper class for Promise-like object with progress support
 class ProgressPromise {
@@ -15,4 +18,35 @@ public:
     
     Napi::Object GetPromiseObject() const;
     std::shared_ptr<Napi::ThreadSafeFunction*> GetProgressTsfn() const;
-};
\ No newline at end of file
+};
+
+// Objects streamed from a worker thread and read in JS with for await. Every member runs on the main
+// thread, in practice from ThreadSafeFunction callbacks; calls keep the order of the values. The queue
+// holds N-API handles, so after Attach only the functions it installs own it and it is freed by the
+// garbage collector on the main thread; worker-side code keeps a weak_ptr and locks it in a callback.
+class AsyncIteratorQueue : public std::enable_shared_from_this<AsyncIteratorQueue> {
+public:
+    // Makes target async-iterable; every target[Symbol.asyncIterator]() returns the same iterator
+    void Attach(Napi::Env env, Napi::Object target);
+    // Queues a value for the iterator. Values pushed before the iterator was first requested are dropped,
+    // so nothing is kept alive for callers that never iterate.
+    void Push(Napi::Env env, Napi::Object value);
+    bool Requested() const { return m_requested; }
+    // Ends the iteration after the values already pushed. With an error, the next read after them rejects.
+    void Finish(Napi::Env env, const std::string& error = std::string());
+
+private:
+    Napi::Value Next(Napi::Env env);
+    Napi::Value Return(Napi::Env env);
+
+    std::deque<Napi::ObjectReference> m_values;
+    std::deque<Napi::Promise::Deferred> m_waiting; // next() calls made before their value arrived
+    bool m_requested = false;
+    bool m_finished = false;
+    bool m_closed = false; // the consumer stopped early through return()
+    std::string m_error;
+};
+
+// Runs work(0) .. work(count - 1) on up to maxConcurrency threads, the calling thread included.
+// Blocks until every item has finished and rethrows the first exception thrown by any item.
+void RunConcurrently(size_t count, size_t maxConcurrency, const std::function<void(size_t)>& work);
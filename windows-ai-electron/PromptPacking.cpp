@@ -0,0 +1,116 @@
+#include "PromptPacking.h"
+
+namespace {
+
+// Marker line overhead per item: "[[nn]]\n" plus the separating newline
+constexpr size_t kMarkerOverhead = 8;
+
+std::wstring Marker(size_t number) {
+    return L"[[" + std::to_wstring(number) + L"]]";
+}
+
+bool IsSpace(wchar_t c) {
+    return c == L' ' || c == L'\t' || c == L'\n' || c == L'\r' || c == 0xA0 || c == 0x3000;
+}
+
+std::wstring_view Trim(std::wstring_view text) {
+    while (!text.empty() && IsSpace(text.front())) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && IsSpace(text.back())) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+} // namespace
+
+bool IsPackable(std::wstring_view input, size_t maxLength) {
+    return input.size() + kMarkerOverhead <= maxLength / 4 && input.find(L"[[") == std::wstring_view::npos &&
+           input.find(L"]]") == std::wstring_view::npos && !Trim(input).empty();
+}
+
+std::vector<PackGroup> PlanPackGroups(const std::vector<std::wstring_view>& inputs, size_t maxItems, size_t maxLength) {
+    std::vector<PackGroup> groups;
+    auto packable = [maxLength](std::wstring_view input) { return IsPackable(input, maxLength); };
+
+    size_t i = 0;
+    while (i < inputs.size()) {
+        PackGroup group = { i, i + 1 };
+        if (packable(inputs[i])) {
+            size_t length = inputs[i].size() + kMarkerOverhead;
+            while (group.end < inputs.size() && group.end - group.begin < maxItems && packable(inputs[group.end]) &&
+                   length + inputs[group.end].size() + kMarkerOverhead <= maxLength) {
+                length += inputs[group.end].size() + kMarkerOverhead;
+                group.end++;
+            }
+        }
+        groups.push_back(group);
+        i = group.end;
+    }
+
+    // Without a packable input sent alone there is nothing to compare the packed calls with. The first
+    // item of the largest group goes alone; it costs no extra call, only one item less packed.
+    bool calibrated = false;
+    size_t largest = groups.size();
+    for (size_t g = 0; g < groups.size(); g++) {
+        size_t size = groups[g].end - groups[g].begin;
+        if (size == 1 && packable(inputs[groups[g].begin])) {
+            calibrated = true;
+        }
+        if (size > 1 && (largest == groups.size() || size > groups[largest].end - groups[largest].begin)) {
+            largest = g;
+        }
+    }
+    if (!calibrated && largest < groups.size()) {
+        PackGroup alone = { groups[largest].begin, groups[largest].begin + 1 };
+        groups[largest].begin++;
+        groups.insert(groups.begin() + largest, alone);
+    }
+    return groups;
+}
+
+std::wstring PackPrompt(const std::vector<std::wstring_view>& items, std::wstring_view instruction) {
+    std::wstring prompt(instruction);
+    for (size_t i = 0; i < items.size(); i++) {
+        if (!prompt.empty()) {
+            prompt += L"\n";
+        }
+        prompt += Marker(i + 1);
+        prompt += L"\n";
+        prompt += Trim(items[i]);
+        prompt += L"\n";
+    }
+    return prompt;
+}
+
+bool SplitPackedOutput(std::wstring_view output, size_t count, std::vector<std::wstring>& items) {
+    items.clear();
+    if (count == 0) {
+        return true;
+    }
+    std::vector<size_t> starts(count); // where each marker begins
+    std::vector<size_t> textStarts(count); // where the text after it begins
+    size_t position = 0;
+    for (size_t i = 0; i < count; i++) {
+        std::wstring marker = Marker(i + 1);
+        size_t found = output.find(marker, position);
+        if (found == std::wstring_view::npos) {
+            return false;
+        }
+        starts[i] = found;
+        textStarts[i] = found + marker.size();
+        position = textStarts[i];
+    }
+    items.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        size_t end = i + 1 < count ? starts[i + 1] : output.size();
+        std::wstring_view text = Trim(output.substr(textStarts[i], end - textStarts[i]));
+        if (text.empty()) {
+            items.clear();
+            return false;
+        }
+        items.emplace_back(text);
+    }
+    return true;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Packing of several short inputs into one model prompt and splitting the answer back per input, for
+// the pack mode of the *BatchAsync methods.
+//
+// Each item is introduced by a marker "[[n]]" on its own line, numbered from 1. The answer is accepted
+// only when every marker comes back in order with text after it; otherwise the caller falls back to
+// one call per item.
+
+// Inputs [begin, end) sent as one call
+struct PackGroup {
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+// True when the input may share a call: not blank, at most a quarter of maxLength UTF-16 units with its
+// marker, and free of "[[" and "]]"
+bool IsPackable(std::wstring_view input, size_t maxLength);
+
+// Groups consecutive packable inputs, at most maxItems per group and about maxLength UTF-16 units of
+// packed text. Other inputs form groups of their own. When no packable input ended up alone, the first
+// item of the largest group is split off, so the batch always has an unpacked call of a packable input
+// to estimate the packing gain against.
+std::vector<PackGroup> PlanPackGroups(const std::vector<std::wstring_view>& inputs, size_t maxItems, size_t maxLength);
+
+// The instruction followed by the marked items
+std::wstring PackPrompt(const std::vector<std::wstring_view>& items, std::wstring_view instruction);
+
+// Splits output at the markers [[1]] .. [[count]] into trimmed item texts. Text before [[1]] is ignored.
+// Returns false when a marker is missing or out of order, or an item is empty.
+bool SplitPackedOutput(std::wstring_view output, size_t count, std::vector<std::wstring>& items);
@@ -0,0 +1,514 @@
+#include "ResultStore.h"
+#include "ContentHash.h"
+#include <winrt/base.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// Static member definitions
+Napi::FunctionReference MyResultStore::constructor;
+
+namespace {
+
+constexpr char kFileMagic[8] = { 'W', 'A', 'I', 'R', 'S', 'T', 'O', 'R' };
+constexpr uint32_t kFileVersion = 1;
+constexpr uint64_t kFileHeaderSize = 16;
+constexpr uint32_t kRecordMagic = 0x43455253; // "SREC"
+constexpr uint64_t kDefaultMaxBytes = 256ull * 1024 * 1024;
+
+#pragma pack(push, 1)
+struct RecordHeader {
+    uint32_t magic;
+    uint32_t payloadLength;
+    uint64_t contentHash;
+    uint64_t optionsKey;
+    uint32_t feature;
+    int32_t kind;
+    uint64_t checksum;
+};
+#pragma pack(pop)
+static_assert(sizeof(RecordHeader) == 40, "RecordHeader layout is part of the file format");
+
+uint64_t RecordSize(uint32_t payloadLength) {
+    return (sizeof(RecordHeader) + payloadLength + 7) & ~static_cast<uint64_t>(7);
+}
+
+std::runtime_error LastError(const std::string& what) {
+    return std::runtime_error(what + " (error " + std::to_string(GetLastError()) + ")");
+}
+
+std::mutex g_activeStoreMutex;
+std::shared_ptr<ResultStore> g_activeStore;
+
+} // namespace
+
+size_t ResultKeyHasher::operator()(const ResultKey& key) const {
+    uint64_t hash = CombineHash(key.contentHash, key.optionsKey);
+    hash = CombineHash(hash, (static_cast<uint64_t>(key.feature) << 32) | static_cast<uint32_t>(key.kind));
+    return static_cast<size_t>(hash);
+}
+
+ResultStore::ResultStore(std::wstring path, uint64_t maxBytes) : m_path(std::move(path)), m_maxBytes(maxBytes) {
+    OpenFile();
+    try {
+        LoadIndex();
+    } catch (...) {
+        CloseFile();
+        throw;
+    }
+}
+
+ResultStore::~ResultStore() {
+    CloseFile();
+}
+
+void ResultStore::OpenFile() {
+    m_file = CreateFileW(m_path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        throw LastError("Failed to open result store file");
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size)) {
+        throw LastError("Failed to read result store size");
+    }
+    m_fileSize = static_cast<uint64_t>(size.QuadPart);
+
+    if (m_fileSize == 0) {
+        uint8_t header[kFileHeaderSize] = {};
+        std::memcpy(header, kFileMagic, sizeof(kFileMagic));
+        std::memcpy(header + 8, &kFileVersion, sizeof(kFileVersion));
+        DWORD written = 0;
+        if (!WriteFile(m_file, header, static_cast<DWORD>(kFileHeaderSize), &written, nullptr) || written != kFileHeaderSize) {
+            throw LastError("Failed to initialize result store file");
+        }
+        m_fileSize = kFileHeaderSize;
+    }
+}
+
+void ResultStore::CloseFile() {
+    UnmapView();
+    if (m_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+}
+
+void ResultStore::MapView() {
+    UnmapView();
+    if (m_fileSize == 0) {
+        return;
+    }
+    m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping) {
+        throw LastError("Failed to map result store");
+    }
+    m_view = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_view) {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+        throw LastError("Failed to map result store");
+    }
+    m_viewSize = m_fileSize;
+}
+
+void ResultStore::UnmapView() {
+    if (m_view) {
+        UnmapViewOfFile(m_view);
+        m_view = nullptr;
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+    m_viewSize = 0;
+}
+
+void ResultStore::LoadIndex() {
+    MapView();
+    if (m_fileSize < kFileHeaderSize || std::memcmp(m_view, kFileMagic, sizeof(kFileMagic)) != 0) {
+        throw std::runtime_error("File is not a result store");
+    }
+    uint32_t version = 0;
+    std::memcpy(&version, m_view + 8, sizeof(version));
+    if (version != kFileVersion) {
+        throw std::runtime_error("Unsupported result store version " + std::to_string(version));
+    }
+
+    m_index.clear();
+    m_liveBytes = 0;
+    uint64_t offset = kFileHeaderSize;
+    while (offset + sizeof(RecordHeader) <= m_fileSize) {
+        RecordHeader header;
+        std::memcpy(&header, m_view + offset, sizeof(header));
+        uint64_t size = RecordSize(header.payloadLength);
+        if (header.magic != kRecordMagic || offset + size > m_fileSize ||
+            ComputeContentHash(m_view + offset + sizeof(RecordHeader), header.payloadLength) != header.checksum) {
+            break;
+        }
+
+        ResultKey key{ header.contentHash, header.optionsKey, static_cast<StoredFeature>(header.feature), header.kind };
+        auto existing = m_index.find(key);
+        if (existing != m_index.end()) {
+            m_liveBytes -= RecordSize(existing->second.length);
+        }
+        // Later records are newer, so file order doubles as the initial recency order
+        m_index[key] = { offset, header.payloadLength, ++m_clock };
+        m_liveBytes += size;
+        offset += size;
+    }
+
+    if (offset != m_fileSize) {
+        TruncateTo(offset);
+    }
+}
+
+void ResultStore::TruncateTo(uint64_t size) {
+    // A mapped file cannot be shortened, drop the view first
+    UnmapView();
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(m_file, position, nullptr, FILE_BEGIN) || !SetEndOfFile(m_file)) {
+        throw LastError("Failed to truncate result store");
+    }
+    m_fileSize = size;
+    MapView();
+}
+
+bool ResultStore::AppendRecord(HANDLE file, uint64_t& fileSize, const ResultKey& key, const uint8_t* payload, uint32_t length) {
+    RecordHeader header{};
+    header.magic = kRecordMagic;
+    header.payloadLength = length;
+    header.contentHash = key.contentHash;
+    header.optionsKey = key.optionsKey;
+    header.feature = static_cast<uint32_t>(key.feature);
+    header.kind = key.kind;
+    header.checksum = ComputeContentHash(payload, length);
+
+    std::vector<uint8_t> record(RecordSize(length), 0);
+    std::memcpy(record.data(), &header, sizeof(header));
+    if (length > 0) {
+        std::memcpy(record.data() + sizeof(header), payload, length);
+    }
+
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(fileSize);
+    DWORD written = 0;
+    if (!SetFilePointerEx(file, position, nullptr, FILE_BEGIN) ||
+        !WriteFile(file, record.data(), static_cast<DWORD>(record.size()), &written, nullptr) || written != record.size()) {
+        return false;
+    }
+    fileSize += record.size();
+    return true;
+}
+
+std::optional<std::vector<uint8_t>> ResultStore::Get(const ResultKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    try {
+        auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            m_misses++;
+            return std::nullopt;
+        }
+
+        Slot& slot = it->second;
+        uint64_t payloadOffset = slot.offset + sizeof(RecordHeader);
+        if (payloadOffset + slot.length > m_viewSize) {
+            // Appended after the view was created
+            MapView();
+        }
+        slot.lastUsed = ++m_clock;
+        m_hits++;
+        return std::vector<uint8_t>(m_view + payloadOffset, m_view + payloadOffset + slot.length);
+    } catch (...) {
+        return std::nullopt;
+    }
+}
+
+bool ResultStore::Put(const ResultKey& key, const std::vector<uint8_t>& payload) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    try {
+        if (!m_error.empty()) {
+            return false;
+        }
+        if (payload.size() > UINT32_MAX) {
+            return false;
+        }
+        uint64_t size = RecordSize(static_cast<uint32_t>(payload.size()));
+        if (size > m_maxBytes / 2) {
+            return false;
+        }
+        if (m_fileSize + size > m_maxBytes) {
+            CompactLocked(m_maxBytes / 4 * 3);
+        }
+
+        uint64_t offset = m_fileSize;
+        if (!AppendRecord(m_file, m_fileSize, key, payload.data(), static_cast<uint32_t>(payload.size()))) {
+            return false;
+        }
+
+        auto existing = m_index.find(key);
+        if (existing != m_index.end()) {
+            m_liveBytes -= RecordSize(existing->second.length);
+        }
+        m_index[key] = { offset, static_cast<uint32_t>(payload.size()), ++m_clock };
+        m_liveBytes += size;
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+void ResultStore::Compact() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_error.empty()) {
+        ReopenLocked();
+    }
+    CompactLocked(m_maxBytes);
+}
+
+void ResultStore::ReopenLocked() {
+    CloseFile();
+    try {
+        OpenFile();
+        LoadIndex();
+        m_error.clear();
+    } catch (const std::exception& ex) {
+        CloseFile();
+        m_index.clear();
+        m_fileSize = 0;
+        m_liveBytes = 0;
+        m_error = ex.what();
+        throw;
+    }
+}
+
+void ResultStore::CompactLocked(uint64_t targetBytes) {
+    if (m_viewSize < m_fileSize) {
+        MapView();
+    }
+
+    std::vector<std::pair<ResultKey, Slot>> slots(m_index.begin(), m_index.end());
+    std::sort(slots.begin(), slots.end(), [](const auto& a, const auto& b) {
+        return a.second.lastUsed > b.second.lastUsed;
+    });
+
+    std::wstring tempPath = m_path + L".compact";
+    HANDLE temp = CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (temp == INVALID_HANDLE_VALUE) {
+        throw LastError("Failed to create compacted result store");
+    }
+
+    // The header is copied verbatim from the current file
+    uint64_t newSize = 0;
+    DWORD written = 0;
+    bool ok = WriteFile(temp, m_view, static_cast<DWORD>(kFileHeaderSize), &written, nullptr) && written == kFileHeaderSize;
+    newSize = kFileHeaderSize;
+
+    std::unordered_map<ResultKey, Slot, ResultKeyHasher> newIndex;
+    uint64_t newLiveBytes = 0;
+    for (const auto& [key, slot] : slots) {
+        if (!ok) {
+            break;
+        }
+        uint64_t size = RecordSize(slot.length);
+        if (newSize + size > targetBytes) {
+            continue;
+        }
+        uint64_t offset = newSize;
+        ok = AppendRecord(temp, newSize, key, m_view + slot.offset + sizeof(RecordHeader), slot.length);
+        newIndex[key] = { offset, slot.length, slot.lastUsed };
+        newLiveBytes += size;
+    }
+    CloseHandle(temp);
+
+    if (!ok) {
+        DeleteFileW(tempPath.c_str());
+        throw std::runtime_error("Failed to write compacted result store");
+    }
+
+    CloseFile();
+    if (!MoveFileExW(tempPath.c_str(), m_path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        auto error = LastError("Failed to replace result store with compacted file");
+        DeleteFileW(tempPath.c_str());
+        ReopenLocked();
+        throw error;
+    }
+
+    m_compactions++;
+    try {
+        OpenFile();
+        MapView();
+    } catch (...) {
+        // The compacted file is in place; index whatever of it can be read
+        ReopenLocked();
+        return;
+    }
+    m_index = std::move(newIndex);
+    m_liveBytes = newLiveBytes;
+}
+
+void ResultStore::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_error.empty()) {
+        ReopenLocked();
+    }
+    TruncateTo(kFileHeaderSize);
+    m_index.clear();
+    m_liveBytes = 0;
+}
+
+ResultStoreStats ResultStore::GetStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ResultStoreStats stats;
+    stats.path = m_path;
+    stats.maxBytes = m_maxBytes;
+    stats.fileBytes = m_fileSize;
+    stats.liveBytes = m_liveBytes;
+    stats.entries = m_index.size();
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.compactions = m_compactions;
+    stats.lastError = m_error;
+    return stats;
+}
+
+std::shared_ptr<ResultStore> GetActiveResultStore() {
+    std::lock_guard<std::mutex> lock(g_activeStoreMutex);
+    return g_activeStore;
+}
+
+std::vector<uint8_t> SerializeImageDescription(int32_t status, const std::string& description) {
+    std::vector<uint8_t> payload(sizeof(status) + description.size());
+    std::memcpy(payload.data(), &status, sizeof(status));
+    std::memcpy(payload.data() + sizeof(status), description.data(), description.size());
+    return payload;
+}
+
+bool DeserializeImageDescription(const std::vector<uint8_t>& payload, int32_t& status, std::string& description) {
+    if (payload.size() < sizeof(status)) {
+        return false;
+    }
+    std::memcpy(&status, payload.data(), sizeof(status));
+    description.assign(reinterpret_cast<const char*>(payload.data()) + sizeof(status), payload.size() - sizeof(status));
+    return true;
+}
+
+// MyResultStore Implementation
+Napi::Object MyResultStore::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "ResultStore", {
+        StaticMethod("Open", &MyResultStore::Open),
+        StaticMethod("Close", &MyResultStore::Close),
+        StaticMethod("GetStats", &MyResultStore::GetStats),
+        StaticMethod("Compact", &MyResultStore::Compact),
+        StaticMethod("Clear", &MyResultStore::Clear)
+    });
+
+    constructor = Napi::Persistent(func);
+    exports.Set("ResultStore", func);
+    return exports;
+}
+
+MyResultStore::MyResultStore(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MyResultStore>(info) {
+    // This is a static-only class, so constructor doesn't need to do anything special
+}
+
+Napi::Value MyResultStore::Open(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Open requires a file path for the store").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    uint64_t maxBytes = kDefaultMaxBytes;
+    if (info.Length() > 1 && info[1].IsObject()) {
+        auto optionsObj = info[1].As<Napi::Object>();
+        if (optionsObj.Has("maxBytes") && optionsObj.Get("maxBytes").IsNumber()) {
+            int64_t value = optionsObj.Get("maxBytes").As<Napi::Number>().Int64Value();
+            if (value < 64 * 1024) {
+                Napi::RangeError::New(env, "maxBytes must be at least 65536").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            maxBytes = static_cast<uint64_t>(value);
+        }
+    }
+
+    try {
+        std::wstring path = winrt::to_hstring(info[0].As<Napi::String>().Utf8Value()).c_str();
+        auto store = std::make_shared<ResultStore>(path, maxBytes);
+
+        std::lock_guard<std::mutex> lock(g_activeStoreMutex);
+        // Workers that already picked up the previous store keep it alive until they finish
+        g_activeStore = store;
+        return env.Undefined();
+    } catch (const std::exception& ex) {
+        Napi::Error::New(env, ex.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    } catch (...) {
+        Napi::Error::New(env, "Unknown error occurred in Open").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+Napi::Value MyResultStore::Close(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::lock_guard<std::mutex> lock(g_activeStoreMutex);
+    g_activeStore.reset();
+    return env.Undefined();
+}
+
+Napi::Value MyResultStore::GetStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto store = GetActiveResultStore();
+    if (!store) {
+        return env.Null();
+    }
+
+    auto stats = store->GetStats();
+    auto statsObj = Napi::Object::New(env);
+    statsObj.Set("path", Napi::String::New(env, winrt::to_string(stats.path)));
+    statsObj.Set("maxBytes", Napi::Number::New(env, static_cast<double>(stats.maxBytes)));
+    statsObj.Set("fileBytes", Napi::Number::New(env, static_cast<double>(stats.fileBytes)));
+    statsObj.Set("liveBytes", Napi::Number::New(env, static_cast<double>(stats.liveBytes)));
+    statsObj.Set("entries", Napi::Number::New(env, static_cast<double>(stats.entries)));
+    statsObj.Set("hits", Napi::Number::New(env, static_cast<double>(stats.hits)));
+    statsObj.Set("misses", Napi::Number::New(env, static_cast<double>(stats.misses)));
+    statsObj.Set("compactions", Napi::Number::New(env, static_cast<double>(stats.compactions)));
+    statsObj.Set("lastError", stats.lastError.empty() ? env.Null() : Napi::String::New(env, stats.lastError));
+    return statsObj;
+}
+
+Napi::Value MyResultStore::Compact(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto store = GetActiveResultStore();
+    if (!store) {
+        Napi::Error::New(env, "No result store is open. Call ResultStore.Open() first").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    try {
+        store->Compact();
+        return env.Undefined();
+    } catch (const std::exception& ex) {
+        Napi::Error::New(env, ex.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+Napi::Value MyResultStore::Clear(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto store = GetActiveResultStore();
+    if (!store) {
+        Napi::Error::New(env, "No result store is open. Call ResultStore.Open() first").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    try {
+        store->Clear();
+        return env.Undefined();
+    } catch (const std::exception& ex) {
+        Napi::Error::New(env, ex.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
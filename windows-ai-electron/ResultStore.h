@@ -0,0 +1,129 @@
+#pragma once
+
+#include <napi.h>
+#include <windows.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Feature that produced a stored payload, part of the store key
+enum class StoredFeature : uint32_t {
+    TextRecognition = 1,
+    ImageDescription = 2
+};
+
+// Identifies a stored result: content hash of the encoded image plus everything that changes the output
+struct ResultKey {
+    uint64_t contentHash = 0;
+    uint64_t optionsKey = 0;
+    StoredFeature feature = StoredFeature::TextRecognition;
+    int32_t kind = 0;
+
+    bool operator==(const ResultKey& other) const {
+        return contentHash == other.contentHash && optionsKey == other.optionsKey && feature == other.feature && kind == other.kind;
+    }
+};
+
+struct ResultKeyHasher {
+    size_t operator()(const ResultKey& key) const;
+};
+
+struct ResultStoreStats {
+    std::wstring path;
+    uint64_t maxBytes = 0;
+    uint64_t fileBytes = 0;
+    uint64_t liveBytes = 0;
+    uint64_t entries = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t compactions = 0;
+    std::string lastError; // why the store is unusable, empty while it works
+};
+
+// Append-only, memory-mapped result log. Records are read through a read-only view of the file and
+// appended with regular writes; a later record for the same key supersedes the earlier one. When the
+// file would exceed maxBytes it is compacted: live records are rewritten most recently used first
+// until 3/4 of the cap, superseded and least recently used records are dropped. A torn record at the
+// end of the file (e.g. after a crash) is truncated on open. If the file cannot be reopened after a
+// compaction the store is marked broken: Get misses, Put fails, and Compact and Clear retry the reopen
+// and throw when it fails again.
+class ResultStore {
+public:
+    // Opens or creates the store file. Throws std::runtime_error when the file cannot be opened or is not a store.
+    ResultStore(std::wstring path, uint64_t maxBytes);
+    ~ResultStore();
+
+    ResultStore(const ResultStore&) = delete;
+    ResultStore& operator=(const ResultStore&) = delete;
+
+    // Returns a copy of the payload stored for key. Never throws.
+    std::optional<std::vector<uint8_t>> Get(const ResultKey& key);
+
+    // Appends the payload for key. Returns false when it was not stored (too large, an I/O error or a broken store). Never throws.
+    bool Put(const ResultKey& key, const std::vector<uint8_t>& payload);
+
+    void Compact();
+    void Clear();
+    ResultStoreStats GetStats();
+
+private:
+    struct Slot {
+        uint64_t offset;
+        uint32_t length;
+        uint64_t lastUsed;
+    };
+
+    void OpenFile();
+    void CloseFile();
+    void MapView();
+    void UnmapView();
+    void LoadIndex();
+    void TruncateTo(uint64_t size);
+    bool AppendRecord(HANDLE file, uint64_t& fileSize, const ResultKey& key, const uint8_t* payload, uint32_t length);
+    void CompactLocked(uint64_t targetBytes);
+    // Reopens the file and rebuilds the index from it, marking the store broken when that fails
+    void ReopenLocked();
+
+    std::mutex m_mutex;
+    std::wstring m_path;
+    uint64_t m_maxBytes;
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+    const uint8_t* m_view = nullptr;
+    uint64_t m_viewSize = 0;
+    uint64_t m_fileSize = 0;
+    uint64_t m_liveBytes = 0;
+    uint64_t m_clock = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_compactions = 0;
+    std::string m_error; // set while the store is broken
+    std::unordered_map<ResultKey, Slot, ResultKeyHasher> m_index;
+};
+
+// Process-wide store consulted by the projections. Null until ResultStore.Open() is called from JS.
+std::shared_ptr<ResultStore> GetActiveResultStore();
+
+// Payload format of a stored ImageDescriptionResult
+std::vector<uint8_t> SerializeImageDescription(int32_t status, const std::string& description);
+bool DeserializeImageDescription(const std::vector<uint8_t>& payload, int32_t& status, std::string& description);
+
+// Static-only JS class: ResultStore.Open/Close/GetStats/Compact/Clear
+class MyResultStore : public Napi::ObjectWrap<MyResultStore> {
+public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    static Napi::FunctionReference constructor;
+
+    MyResultStore(const Napi::CallbackInfo& info);
+
+    // Static methods
+    static Napi::Value Open(const Napi::CallbackInfo& info);
+    static Napi::Value Close(const Napi::CallbackInfo& info);
+    static Napi::Value GetStats(const Napi::CallbackInfo& info);
+    static Napi::Value Compact(const Napi::CallbackInfo& info);
+    static Napi::Value Clear(const Napi::CallbackInfo& info);
+};
@@ -0,0 +1,142 @@
+#include "StopConditions.h"
+#include <algorithm>
+#include <deque>
+
+const char* StopReasonName(StopReason reason) {
+    switch (reason) {
+    case StopReason::StopSequence: return "stopSequence";
+    case StopReason::MaxChars: return "maxChars";
+    case StopReason::MaxSentences: return "maxSentences";
+    default: return nullptr;
+    }
+}
+
+GenerationStopper::GenerationStopper(const StopConditions& conditions) : m_conditions(conditions) {
+    m_nodes.emplace_back();
+    for (size_t s = 0; s < m_conditions.stopSequences.size(); s++) {
+        const std::string& sequence = m_conditions.stopSequences[s];
+        if (sequence.empty()) {
+            continue;
+        }
+        size_t node = 0;
+        for (char c : sequence) {
+            auto byte = static_cast<unsigned char>(c);
+            auto it = m_nodes[node].next.find(byte);
+            if (it == m_nodes[node].next.end()) {
+                m_nodes.emplace_back();
+                it = m_nodes[node].next.emplace(byte, m_nodes.size() - 1).first;
+            }
+            node = it->second;
+        }
+        size_t current = m_nodes[node].match;
+        if (current == 0 || m_conditions.stopSequences[current - 1].size() < sequence.size()) {
+            m_nodes[node].match = s + 1;
+        }
+    }
+
+    // Failure links breadth first; a node also reports the longest sequence ending at its failure node
+    std::deque<size_t> queue;
+    for (const auto& [byte, child] : m_nodes[0].next) {
+        queue.push_back(child);
+    }
+    while (!queue.empty()) {
+        size_t node = queue.front();
+        queue.pop_front();
+        for (const auto& [byte, child] : m_nodes[node].next) {
+            size_t fail = m_nodes[node].fail;
+            while (fail != 0 && m_nodes[fail].next.count(byte) == 0) {
+                fail = m_nodes[fail].fail;
+            }
+            auto it = m_nodes[fail].next.find(byte);
+            m_nodes[child].fail = it != m_nodes[fail].next.end() && it->second != child ? it->second : 0;
+            size_t inherited = m_nodes[m_nodes[child].fail].match;
+            if (inherited != 0 && (m_nodes[child].match == 0 ||
+                                   m_conditions.stopSequences[inherited - 1].size() > m_conditions.stopSequences[m_nodes[child].match - 1].size())) {
+                m_nodes[child].match = inherited;
+            }
+            queue.push_back(child);
+        }
+    }
+}
+
+bool GenerationStopper::Append(std::string_view progress) {
+    if (Stopped()) {
+        return true;
+    }
+    size_t from = m_progress.Text().size();
+    m_progress.Append(progress);
+    Scan(from);
+    if (Stopped()) {
+        m_fragmentOffset = m_progress.FragmentOffset();
+    }
+    return Stopped();
+}
+
+std::string_view GenerationStopper::Text() const {
+    std::string_view text(m_progress.Text());
+    return Stopped() ? text.substr(0, m_cut) : text;
+}
+
+std::string_view GenerationStopper::StopFragment() const {
+    if (!Stopped()) {
+        return std::string_view();
+    }
+    return std::string_view(m_progress.Text()).substr(0, m_cut).substr((std::min)(m_fragmentOffset, m_cut));
+}
+
+void GenerationStopper::Stop(StopReason reason, size_t cut) {
+    m_reason = reason;
+    m_cut = cut;
+}
+
+void GenerationStopper::Scan(size_t from) {
+    const std::string& text = m_progress.Text();
+    for (size_t i = from; i < text.size() && !Stopped(); i++) {
+        auto byte = static_cast<unsigned char>(text[i]);
+
+        if (m_nodes.size() > 1) {
+            while (m_state != 0 && m_nodes[m_state].next.count(byte) == 0) {
+                m_state = m_nodes[m_state].fail;
+            }
+            auto it = m_nodes[m_state].next.find(byte);
+            m_state = it != m_nodes[m_state].next.end() ? it->second : 0;
+            if (m_nodes[m_state].match != 0) {
+                m_sequence = m_conditions.stopSequences[m_nodes[m_state].match - 1];
+                Stop(StopReason::StopSequence, i + 1 - m_sequence.size());
+                break;
+            }
+        }
+
+        bool lead = (byte & 0xC0) != 0x80;
+        if (m_conditions.maxChars > 0 && lead) {
+            size_t units = byte >= 0xF0 ? 2 : 1; // four-byte sequences become surrogate pairs
+            if (m_units + units > m_conditions.maxChars) {
+                Stop(StopReason::MaxChars, i);
+                break;
+            }
+            m_units += units;
+        }
+
+        if (m_conditions.maxSentences > 0) {
+            bool space = byte == ' ' || byte == '\t' || byte == '\n' || byte == '\r';
+            size_t boundary = std::string::npos;
+            if (space && (m_afterTerminator || ((byte == '\n' || byte == '\r') && m_sentenceOpen))) {
+                boundary = i;
+            } else if (i >= 2 && (text.compare(i - 2, 3, "\xE3\x80\x82") == 0 || text.compare(i - 2, 3, "\xEF\xBC\x81") == 0 ||
+                                  text.compare(i - 2, 3, "\xEF\xBC\x9F") == 0)) {
+                boundary = i + 1;
+            }
+            m_afterTerminator = byte == '.' || byte == '!' || byte == '?';
+            if (boundary != std::string::npos) {
+                m_sentenceOpen = false;
+                m_afterTerminator = false;
+                if (++m_sentences >= m_conditions.maxSentences) {
+                    Stop(StopReason::MaxSentences, boundary);
+                    break;
+                }
+            } else if (!space) {
+                m_sentenceOpen = true;
+            }
+        }
+    }
+}
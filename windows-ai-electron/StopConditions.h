@@ -0,0 +1,78 @@
+#pragma once
+
+#include "ProgressText.h"
+#include <cstddef>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Early stopping of text generation, checked against the progress stream so the WinRT operation can be
+// cancelled as soon as the caller has what it asked for.
+//
+// Stop sequences are matched with one Aho-Corasick automaton over the UTF-8 bytes of all of them, so each
+// generated byte costs one transition whatever the number of sequences. Sentence ends follow
+// FindSentenceBoundaries: '.', '!' or '?' followed by whitespace, U+3002, U+FF01 and U+FF1F, and line
+// breaks after text.
+
+struct StopConditions {
+    std::vector<std::string> stopSequences; // UTF-8, non-empty
+    size_t maxChars = 0; // UTF-16 code units, 0 for no limit
+    size_t maxSentences = 0; // 0 for no limit
+
+    bool Any() const { return !stopSequences.empty() || maxChars > 0 || maxSentences > 0; }
+};
+
+enum class StopReason {
+    None,
+    StopSequence,
+    MaxChars,
+    MaxSentences
+};
+
+// "stopSequence", "maxChars" or "maxSentences", nullptr for None
+const char* StopReasonName(StopReason reason);
+
+class GenerationStopper {
+public:
+    explicit GenerationStopper(const StopConditions& conditions);
+
+    // Adds a progress fragment (see ProgressText). Returns true once a condition is met; later fragments
+    // are ignored.
+    bool Append(std::string_view progress);
+
+    bool Stopped() const { return m_reason != StopReason::None; }
+    StopReason Reason() const { return m_reason; }
+    // The stop sequence that matched
+    const std::string& Sequence() const { return m_sequence; }
+    // Text before the stop point: before the stop sequence, the first maxChars units, or through the end
+    // of sentence maxSentences. All the text while not stopped.
+    std::string_view Text() const;
+    // The part of the fragment that met the condition that comes before the stop point, in the form the
+    // fragment was given (see ProgressText::FragmentOffset), so it can still be relayed. Empty while not
+    // stopped.
+    std::string_view StopFragment() const;
+
+private:
+    struct Node {
+        std::map<unsigned char, size_t> next;
+        size_t fail = 0;
+        size_t match = 0; // index + 1 of the longest sequence ending here, 0 for none
+    };
+
+    void Stop(StopReason reason, size_t cut);
+    void Scan(size_t from);
+
+    StopConditions m_conditions;
+    std::vector<Node> m_nodes; // Aho-Corasick automaton, node 0 is the root
+    ProgressText m_progress;
+    size_t m_state = 0;
+    size_t m_units = 0; // UTF-16 units so far
+    size_t m_sentences = 0;
+    bool m_sentenceOpen = false; // text since the last sentence end
+    bool m_afterTerminator = false; // the last byte was '.', '!' or '?'
+    StopReason m_reason = StopReason::None;
+    size_t m_cut = 0;
+    size_t m_fragmentOffset = 0; // of the fragment that met the condition
+    std::string m_sequence;
+};
@@ -0,0 +1,76 @@
+#include "TableFormat.h"
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+const std::string& CellAt(const std::vector<std::string>& row, size_t column) {
+    static const std::string empty;
+    return column < row.size() ? row[column] : empty;
+}
+
+} // namespace
+
+std::string FormatTableCsv(const TableRows& rows, size_t columnCount) {
+    std::string csv;
+    for (const auto& row : rows) {
+        for (size_t c = 0; c < columnCount; c++) {
+            if (c > 0) {
+                csv += ',';
+            }
+            const std::string& cell = CellAt(row, c);
+            if (cell.find_first_of(",\"\r\n") == std::string::npos) {
+                csv += cell;
+                continue;
+            }
+            csv += '"';
+            for (char ch : cell) {
+                if (ch == '"') {
+                    csv += '"';
+                }
+                csv += ch;
+            }
+            csv += '"';
+        }
+        csv += "\r\n";
+    }
+    return csv;
+}
+
+std::string FormatTableTsv(const TableRows& rows, size_t columnCount) {
+    std::string tsv;
+    for (const auto& row : rows) {
+        for (size_t c = 0; c < columnCount; c++) {
+            if (c > 0) {
+                tsv += '\t';
+            }
+            for (char ch : CellAt(row, c)) {
+                switch (ch) {
+                case '\t': tsv += "\\t"; break;
+                case '\n': tsv += "\\n"; break;
+                case '\r': tsv += "\\r"; break;
+                case '\\': tsv += "\\\\"; break;
+                default: tsv += ch; break;
+                }
+            }
+        }
+        tsv += '\n';
+    }
+    return tsv;
+}
+
+void PackTableCells(const TableRows& rows, size_t columnCount, std::string& data, std::vector<uint32_t>& offsets) {
+    data.clear();
+    offsets.clear();
+    offsets.reserve(rows.size() * columnCount + 1);
+    offsets.push_back(0);
+    for (const auto& row : rows) {
+        for (size_t c = 0; c < columnCount; c++) {
+            data += CellAt(row, c);
+            if (data.size() > (std::numeric_limits<uint32_t>::max)()) {
+                throw std::length_error("Table text is too large for 32-bit cell offsets");
+            }
+            offsets.push_back(static_cast<uint32_t>(data.size()));
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "TableMerge.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Flat encodings of converted tables, built on the worker thread so a large table reaches JS as a few
+// buffers instead of one string per cell. Rows shorter than columnCount
+// are padded with empty cells.
+
+// RFC 4180 CSV: fields containing a comma, double quote, CR or LF are quoted with quotes doubled, and
+// rows end with CRLF
+std::string FormatTableCsv(const TableRows& rows, size_t columnCount);
+
+// Tab-separated values with tab, LF, CR and backslash inside cells escaped as \t, \n, \r and \\, and
+// rows ending with LF
+std::string FormatTableTsv(const TableRows& rows, size_t columnCount);
+
+// Every cell, row-major, concatenated into data. Cell (r, c) is the byte range
+// [offsets[r * columnCount + c], offsets[r * columnCount + c + 1]), so offsets has one more entry than
+// there are cells. Throws std::length_error when data would pass 4 GiB.
+void PackTableCells(const TableRows& rows, size_t columnCount, std::string& data, std::vector<uint32_t>& offsets);
@@ -0,0 +1,157 @@
+#include "TableMerge.h"
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+namespace {
+
+// Header names compared without surrounding whitespace and ASCII case
+std::string HeaderKey(const std::string& name) {
+    size_t begin = name.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    size_t end = name.find_last_not_of(" \t\r\n");
+    std::string key = name.substr(begin, end - begin + 1);
+    std::transform(key.begin(), key.end(), key.begin(), [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; });
+    return key;
+}
+
+// Whether the row could have been built from the record: every non-empty cell occurs in it
+bool RowFromRecord(const std::vector<std::string>& row, std::string_view record) {
+    size_t cells = 0;
+    for (const auto& cell : row) {
+        size_t begin = cell.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos) {
+            continue;
+        }
+        size_t end = cell.find_last_not_of(" \t\r\n");
+        cells++;
+        if (record.find(std::string_view(cell).substr(begin, end - begin + 1)) == std::string_view::npos) {
+            return false;
+        }
+    }
+    return cells > 0;
+}
+
+// Rows equal cell by cell under HeaderKey, missing cells counting as empty
+bool SameCells(const std::vector<std::string>& a, const std::vector<std::string>& b) {
+    for (size_t c = 0; c < (std::max)(a.size(), b.size()); c++) {
+        if (HeaderKey(c < a.size() ? a[c] : std::string()) != HeaderKey(c < b.size() ? b[c] : std::string())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+MergedTable MergeTableChunks(const std::vector<TableRows>& chunks, std::string_view leadingRecord) {
+    MergedTable table;
+    std::vector<std::string> header;
+    std::unordered_map<std::string, size_t> columnOf; // header key -> column
+    bool haveHeader = false;
+    std::vector<std::string> leadingRow; // merged row of the leading record, empty when it was only a header
+
+    auto addColumn = [&](const std::string& name) {
+        header.push_back(name);
+        std::string key = HeaderKey(name);
+        if (!key.empty()) {
+            columnOf.emplace(key, header.size() - 1);
+        }
+        return header.size() - 1;
+    };
+
+    for (const auto& chunk : chunks) {
+        if (chunk.empty()) {
+            continue;
+        }
+        size_t first = 0;
+        std::vector<size_t> mapping; // chunk column -> merged column, empty for by position
+        bool firstChunk = !haveHeader;
+        if (firstChunk) {
+            for (const auto& name : chunk[0]) {
+                addColumn(name);
+            }
+            haveHeader = true;
+            first = 1;
+        } else {
+            size_t nonEmpty = 0;
+            size_t matches = 0;
+            for (const auto& cell : chunk[0]) {
+                std::string key = HeaderKey(cell);
+                if (!key.empty()) {
+                    nonEmpty++;
+                    matches += columnOf.count(key);
+                }
+            }
+            if (nonEmpty > 0 && matches * 2 > nonEmpty && matches >= (std::min)(static_cast<size_t>(2), columnOf.size())) {
+                std::vector<bool> claimed(header.size(), false);
+                mapping.assign(chunk[0].size(), SIZE_MAX);
+                for (size_t c = 0; c < chunk[0].size(); c++) {
+                    auto it = columnOf.find(HeaderKey(chunk[0][c]));
+                    if (it != columnOf.end() && !claimed[it->second]) {
+                        mapping[c] = it->second;
+                        claimed[it->second] = true;
+                    }
+                }
+                for (size_t c = 0; c < chunk[0].size(); c++) {
+                    if (mapping[c] != SIZE_MAX) {
+                        continue;
+                    }
+                    if (c < claimed.size() && !claimed[c]) {
+                        mapping[c] = c;
+                        claimed[c] = true;
+                    } else {
+                        mapping[c] = addColumn(chunk[0][c]);
+                        table.addedColumns++;
+                    }
+                }
+                table.droppedHeaderRows++;
+                first = 1;
+            }
+        }
+
+        for (size_t r = first; r < chunk.size(); r++) {
+            const auto& row = chunk[r];
+            std::vector<std::string> merged(header.size());
+            for (size_t c = 0; c < row.size(); c++) {
+                if (!mapping.empty() && c >= mapping.size()) {
+                    // Past the chunk's header: a new column rather than whichever one holds this position
+                    mapping.push_back(addColumn(std::string()));
+                    table.addedColumns++;
+                }
+                size_t column = c < mapping.size() ? mapping[c] : c;
+                while (column >= header.size()) {
+                    addColumn(std::string());
+                    table.addedColumns++;
+                }
+                if (column >= merged.size()) {
+                    merged.resize(header.size());
+                }
+                merged[column] = row[c];
+            }
+            if (r == first && !leadingRecord.empty()) {
+                if (firstChunk) {
+                    if (RowFromRecord(row, leadingRecord)) {
+                        leadingRow = merged;
+                    }
+                } else if (!leadingRow.empty() && SameCells(merged, leadingRow)) {
+                    table.droppedLeadingRows++;
+                    continue;
+                }
+            }
+            table.rows.push_back(std::move(merged));
+        }
+    }
+
+    if (!haveHeader) {
+        return table;
+    }
+    table.columnCount = header.size();
+    table.rows.insert(table.rows.begin(), std::move(header));
+    for (auto& row : table.rows) {
+        row.resize(table.columnCount);
+    }
+    return table;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Reconciliation of the tables TextToTableConverter returns for the chunks of one long text, so they
+// come back as a single table.
+//
+// The first row of the first non-empty chunk is the header. A later chunk whose first row repeats most
+// of the header names is taken to start with its own header: that row is dropped and its columns are
+// mapped by name, unknown names keeping their position when it is free and otherwise becoming new
+// columns; cells past its last header name become new columns too. Other chunks are mapped by position.
+//
+// leadingRecord is the source text every chunk after the first was sent with in front of its own
+// records, so the model saw the same columns. When it held data rather than only a header, the first
+// chunk's first row was built from it (every non-empty cell occurs in it), and a later chunk whose
+// first row repeats that row has the repeat dropped.
+
+using TableRows = std::vector<std::vector<std::string>>;
+
+struct MergedTable {
+    TableRows rows; // header first, every row padded to columnCount with ""
+    size_t columnCount = 0;
+    size_t droppedHeaderRows = 0; // repeated headers of later chunks
+    size_t droppedLeadingRows = 0; // rows of later chunks repeating the leading record
+    size_t addedColumns = 0; // columns the first header did not have
+};
+
+MergedTable MergeTableChunks(const std::vector<TableRows>& chunks, std::string_view leadingRecord = {});
@@ -0,0 +1,152 @@
+#include "TableStream.h"
+
+namespace {
+
+std::string_view TrimSpaces(std::string_view text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string_view::npos) {
+        return std::string_view();
+    }
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+bool IsMarkdownSeparator(std::string_view line) {
+    bool dash = false;
+    for (char c : line) {
+        if (c == '-') {
+            dash = true;
+        } else if (c != '|' && c != ':' && c != ' ' && c != '\t') {
+            return false;
+        }
+    }
+    return dash;
+}
+
+std::vector<std::string> SplitMarkdown(std::string_view line) {
+    if (!line.empty() && line.front() == '|') {
+        line.remove_prefix(1);
+    }
+    if (!line.empty() && line.back() == '|' && (line.size() < 2 || line[line.size() - 2] != '\\')) {
+        line.remove_suffix(1);
+    }
+    std::vector<std::string> cells;
+    std::string cell;
+    for (size_t i = 0; i < line.size(); i++) {
+        if (line[i] == '\\' && i + 1 < line.size() && line[i + 1] == '|') {
+            cell += '|';
+            i++;
+        } else if (line[i] == '|') {
+            cells.emplace_back(TrimSpaces(cell));
+            cell.clear();
+        } else {
+            cell += line[i];
+        }
+    }
+    cells.emplace_back(TrimSpaces(cell));
+    return cells;
+}
+
+std::vector<std::string> SplitCsv(std::string_view line) {
+    std::vector<std::string> cells;
+    std::string cell;
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); i++) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                cell += '"';
+                i++;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                cell += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            cells.push_back(std::move(cell));
+            cell.clear();
+        } else if (c != '\r') {
+            cell += c;
+        }
+    }
+    cells.push_back(std::move(cell));
+    return cells;
+}
+
+// Whether the first line, read up to its first quote, can still be a CSV header. The header decides
+// the layout, so a quoted header field holding a line break has to be read whole.
+bool MayBeCsv(std::string_view linePrefix) {
+    std::string_view trimmed = TrimSpaces(linePrefix);
+    return trimmed.empty() || (trimmed.front() != '|' && trimmed.front() != '[' && trimmed.front() != '{');
+}
+
+} // namespace
+
+void TableStreamParser::Append(std::string_view progress) {
+    m_text.Append(progress);
+    ParseLines();
+}
+
+std::vector<std::vector<std::string>> TableStreamParser::TakeRows() {
+    std::vector<std::vector<std::string>> rows;
+    rows.swap(m_rows);
+    return rows;
+}
+
+void TableStreamParser::ParseLines() {
+    const std::string& text = m_text.Text();
+    bool quoted = false; // CSV fields may hold line breaks
+    size_t lineStart = m_parsed;
+    for (size_t i = m_parsed; i < text.size() && m_layout != Layout::Unsupported; i++) {
+        char c = text[i];
+        if (c == '"' && (m_layout == Layout::Csv || (m_layout == Layout::Unknown && MayBeCsv(std::string_view(text).substr(lineStart, i - lineStart))))) {
+            quoted = !quoted;
+        } else if (c == '\n' && !quoted) {
+            ParseLine(std::string_view(text).substr(lineStart, i - lineStart));
+            lineStart = i + 1;
+            m_parsed = lineStart;
+        }
+    }
+}
+
+void TableStreamParser::ParseLine(std::string_view line) {
+    std::string_view trimmed = TrimSpaces(line);
+    if (trimmed.empty()) {
+        return;
+    }
+    if (m_layout == Layout::Unknown) {
+        if (trimmed.front() == '[' || trimmed.front() == '{') {
+            m_layout = Layout::Unsupported;
+            return;
+        }
+        m_layout = trimmed.front() == '|' ? Layout::Markdown : line.find('\t') != std::string_view::npos ? Layout::Tsv : Layout::Csv;
+    }
+    switch (m_layout) {
+    case Layout::Markdown:
+        if (!IsMarkdownSeparator(trimmed)) {
+            m_rows.push_back(SplitMarkdown(trimmed));
+        }
+        break;
+    case Layout::Tsv: {
+        std::vector<std::string> cells;
+        size_t start = 0;
+        while (true) {
+            size_t tab = line.find('\t', start);
+            cells.emplace_back(TrimSpaces(line.substr(start, tab == std::string_view::npos ? std::string_view::npos : tab - start)));
+            if (tab == std::string_view::npos) {
+                break;
+            }
+            start = tab + 1;
+        }
+        m_rows.push_back(std::move(cells));
+        break;
+    }
+    case Layout::Csv:
+        m_rows.push_back(SplitCsv(line));
+        break;
+    default:
+        break;
+    }
+}
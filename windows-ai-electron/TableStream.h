@@ -0,0 +1,40 @@
+#pragma once
+
+#include "ProgressText.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Incremental parse of the text TextToTableConverter streams while it generates, so complete rows can
+// be shown before the conversion finishes.
+//
+// A row is closed by its line break. The layout is taken from the first non-blank line: Markdown when
+// it starts with '|' (separator lines skipped, "\|" unescaped), tab-separated when it has a tab, and CSV
+// with RFC 4180 quoting otherwise. Output starting with '[' or '{' is structured data this parser does
+// not read; no rows are produced for it.
+
+class TableStreamParser {
+public:
+    // Adds a progress fragment, either everything generated so far or only the new text (see ProgressText)
+    void Append(std::string_view progress);
+
+    // Rows closed since the last call, in order
+    std::vector<std::vector<std::string>> TakeRows();
+
+private:
+    enum class Layout {
+        Unknown,
+        Markdown,
+        Tsv,
+        Csv,
+        Unsupported
+    };
+    void ParseLines();
+    void ParseLine(std::string_view line);
+
+    ProgressText m_text;
+    size_t m_parsed = 0; // start of the first line not yet closed
+    Layout m_layout = Layout::Unknown;
+    std::vector<std::vector<std::string>> m_rows;
+};
@@ -0,0 +1,224 @@
+#include "TextChunking.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+bool IsContinuationByte(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+// Ends of sentences: ASCII terminators followed by whitespace, and the ideographic and fullwidth
+// terminators (U+3002, U+FF01, U+FF1F) which are not followed by a space
+size_t SentenceEndBefore(std::string_view text, size_t from, size_t limit) {
+    for (size_t i = limit; i > from; i--) {
+        size_t end = i; // candidate cut, the terminator is text[end - 1]
+        char c = text[end - 1];
+        if ((c == '.' || c == '!' || c == '?') && end < text.size() && IsSpace(text[end])) {
+            return end;
+        }
+        if (end >= 3 && end - 3 >= from) {
+            std::string_view tail = text.substr(end - 3, 3);
+            if (tail == "\xE3\x80\x82" || tail == "\xEF\xBC\x81" || tail == "\xEF\xBC\x9F") {
+                return end;
+            }
+        }
+    }
+    return std::string_view::npos;
+}
+
+// Latest cut in (from, limit] right after a run matching the boundary, npos when there is none
+size_t CutBefore(std::string_view text, size_t from, size_t limit, std::string_view boundary) {
+    if (limit < from + boundary.size()) {
+        return std::string_view::npos;
+    }
+    size_t position = text.rfind(boundary, limit - boundary.size());
+    if (position == std::string_view::npos || position < from) {
+        return std::string_view::npos;
+    }
+    return position + boundary.size();
+}
+
+// Records as ChunkRecords defines them, trimmed, stopping once maxRecords are complete
+std::vector<TextChunk> SplitRecords(std::string_view text, size_t maxRecords) {
+    std::vector<TextChunk> records;
+    bool open = false; // the last record may take continuation lines
+    bool inQuotes = false;
+    size_t lineStart = 0;
+    while (lineStart < text.size()) {
+        size_t lineEnd = text.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) {
+            lineEnd = text.size();
+        }
+        std::string_view line = text.substr(lineStart, lineEnd - lineStart);
+        size_t first = 0;
+        while (first < line.size() && IsSpace(line[first])) {
+            first++;
+        }
+        bool blank = first == line.size();
+        if (open && (inQuotes || (!blank && first > 0))) {
+            records.back().length = lineEnd - records.back().offset;
+        } else if (!blank) {
+            if (records.size() == maxRecords) {
+                break;
+            }
+            records.push_back({ lineStart + first, lineEnd - lineStart - first });
+        }
+        open = !blank || inQuotes;
+        inQuotes ^= std::count(line.begin(), line.end(), '"') % 2 == 1;
+        lineStart = lineEnd + 1;
+    }
+
+    for (auto& record : records) {
+        while (record.length > 0 && IsSpace(text[record.offset + record.length - 1])) {
+            record.length--;
+        }
+    }
+    return records;
+}
+
+} // namespace
+
+std::vector<TextChunk> ChunkText(std::string_view text, size_t maxBytes) {
+    std::vector<TextChunk> chunks;
+    maxBytes = std::max<size_t>(maxBytes, 4);
+
+    size_t start = 0;
+    while (true) {
+        while (start < text.size() && IsSpace(text[start])) {
+            start++;
+        }
+        if (start >= text.size()) {
+            break;
+        }
+
+        size_t end = text.size();
+        if (end - start > maxBytes) {
+            size_t limit = start + maxBytes;
+            // Only cuts in the second half of the window, so a boundary near the start does not produce a tiny chunk
+            size_t floor = start + maxBytes / 2;
+            size_t cut = CutBefore(text, floor, limit, "\n\n");
+            if (cut == std::string_view::npos) {
+                cut = CutBefore(text, floor, limit, "\n");
+            }
+            if (cut == std::string_view::npos) {
+                cut = SentenceEndBefore(text, floor, limit);
+            }
+            if (cut == std::string_view::npos) {
+                cut = CutBefore(text, floor, limit, " ");
+            }
+            if (cut == std::string_view::npos) {
+                cut = limit;
+                while (cut > start + 1 && IsContinuationByte(text[cut])) {
+                    cut--;
+                }
+            }
+            end = cut;
+        }
+
+        size_t trimmed = end;
+        while (trimmed > start && IsSpace(text[trimmed - 1])) {
+            trimmed--;
+        }
+        chunks.push_back({ start, trimmed - start });
+        start = end;
+    }
+    return chunks;
+}
+
+std::vector<TextChunk> ChunkRecords(std::string_view text, size_t maxBytes) {
+    maxBytes = std::max<size_t>(maxBytes, 4);
+
+    std::vector<TextChunk> chunks;
+    for (const auto& record : SplitRecords(text, SIZE_MAX)) {
+        if (record.length > maxBytes) {
+            for (const auto& piece : ChunkText(text.substr(record.offset, record.length), maxBytes)) {
+                chunks.push_back({ record.offset + piece.offset, piece.length });
+            }
+        } else if (!chunks.empty() && record.offset + record.length - chunks.back().offset <= maxBytes) {
+            chunks.back().length = record.offset + record.length - chunks.back().offset;
+        } else {
+            chunks.push_back(record);
+        }
+    }
+    return chunks;
+}
+
+TextChunk FirstRecord(std::string_view text) {
+    auto records = SplitRecords(text, 1);
+    return records.empty() ? TextChunk{ text.size(), 0 } : records[0];
+}
+
+std::vector<TextChunk> SplitParagraphs(std::string_view text) {
+    std::vector<TextChunk> paragraphs;
+    size_t start = std::string_view::npos; // first byte of the open paragraph
+    size_t end = 0; // past its last non-space byte
+    size_t lineStart = 0;
+    while (lineStart < text.size()) {
+        size_t lineEnd = text.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) {
+            lineEnd = text.size();
+        }
+        size_t first = lineStart;
+        while (first < lineEnd && IsSpace(text[first])) {
+            first++;
+        }
+        if (first == lineEnd) {
+            if (start != std::string_view::npos) {
+                paragraphs.push_back({ start, end - start });
+                start = std::string_view::npos;
+            }
+        } else {
+            size_t last = lineEnd;
+            while (last > first && IsSpace(text[last - 1])) {
+                last--;
+            }
+            if (start == std::string_view::npos) {
+                start = first;
+            }
+            end = last;
+        }
+        lineStart = lineEnd + 1;
+    }
+    if (start != std::string_view::npos) {
+        paragraphs.push_back({ start, end - start });
+    }
+    return paragraphs;
+}
+
+size_t Utf16Length(std::string_view text) {
+    size_t length = 0;
+    for (char c : text) {
+        unsigned char byte = static_cast<unsigned char>(c);
+        if ((byte & 0xC0) != 0x80) {
+            length += byte >= 0xF0 ? 2 : 1; // four-byte sequences become surrogate pairs
+        }
+    }
+    return length;
+}
+
+std::vector<size_t> FindSentenceBoundaries(std::wstring_view text) {
+    std::vector<size_t> boundaries;
+    for (size_t i = 0; i < text.size(); i++) {
+        wchar_t c = text[i];
+        if (c == L'\n' || c == L'\r') {
+            bool crlf = c == L'\n' && i > 0 && text[i - 1] == L'\r';
+            if (i > 0 && !crlf && (boundaries.empty() || boundaries.back() != i)) {
+                boundaries.push_back(i);
+            }
+            continue;
+        }
+        bool terminator = c == 0x3002 || c == 0xFF01 || c == 0xFF1F;
+        if ((c == L'.' || c == L'!' || c == L'?') && (i + 1 == text.size() || text[i + 1] == L' ' || text[i + 1] == L'\t' || text[i + 1] == L'\n' || text[i + 1] == L'\r')) {
+            terminator = true;
+        }
+        if (terminator) {
+            boundaries.push_back(i + 1);
+        }
+    }
+    return boundaries;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+// Boundary-aware splitting of long UTF-8 text into pieces of bounded size, used to feed documents
+// larger than the model context through the text APIs.
+
+// Byte range of a chunk within the source text
+struct TextChunk {
+    size_t offset = 0;
+    size_t length = 0;
+};
+
+// Splits text into chunks of at most maxBytes, cutting at the latest paragraph break in the second half
+// of the window, else the latest line break, sentence end or space, else at a code point boundary.
+// Whitespace between chunks is dropped. Chunks cover the text in order.
+std::vector<TextChunk> ChunkText(std::string_view text, size_t maxBytes);
+
+// Groups whole records into chunks of at most maxBytes, for line-oriented input such as logs and CSV
+// exports. A record is a line together with the lines that continue it: lines starting with whitespace
+// (stack traces, wrapped fields) and lines inside an open double-quoted field. Blank lines end a record.
+// A record longer than maxBytes is split with ChunkText. Chunks are trimmed and cover the records in order.
+std::vector<TextChunk> ChunkRecords(std::string_view text, size_t maxBytes);
+
+// The first record of the text as ChunkRecords delimits it, such as the header line of a CSV export.
+// Empty at the end of the text when it has no record.
+TextChunk FirstRecord(std::string_view text);
+
+// Paragraphs separated by blank (or whitespace-only) lines, as byte ranges without their leading and
+// trailing whitespace. Empty paragraphs are not returned.
+std::vector<TextChunk> SplitParagraphs(std::string_view text);
+
+// Length in UTF-16 code units of UTF-8 text, to turn byte offsets into JS string offsets
+size_t Utf16Length(std::string_view text);
+
+// Positions in UTF-16 text where a sentence ends: right after '.', '!' or '?' followed by whitespace
+// or the end of the text, after U+3002, U+FF01 and U+FF1F, and before every line break. Ascending.
+std::vector<size_t> FindSentenceBoundaries(std::wstring_view text);
@@ -0,0 +1,164 @@
+#include "TextDiff.h"
+#include <algorithm>
+
+namespace {
+
+enum class TokenKind {
+    Word,
+    Space,
+    Other
+};
+
+TokenKind KindOf(wchar_t c) {
+    if (c == L' ' || c == L'\t' || c == L'\n' || c == L'\r' || c == L'\f' || c == L'\v' || c == 0xA0 || c == 0x3000) {
+        return TokenKind::Space;
+    }
+    if ((c >= L'0' && c <= L'9') || (c >= L'A' && c <= L'Z') || (c >= L'a' && c <= L'z') || c == L'_' || c == L'\'') {
+        return TokenKind::Word;
+    }
+    // Letters of alphabetic scripts and surrogate pairs; ideographs from U+2E80 on have no spaces between words
+    if (c >= 0x80 && (c < 0x2000 || (c >= 0xD800 && c <= 0xDFFF))) {
+        return TokenKind::Word;
+    }
+    return TokenKind::Other;
+}
+
+// Token start offsets, followed by the text length
+std::vector<size_t> Tokenize(std::wstring_view text) {
+    std::vector<size_t> starts;
+    size_t i = 0;
+    while (i < text.size()) {
+        starts.push_back(i);
+        TokenKind kind = KindOf(text[i]);
+        i++;
+        if (kind != TokenKind::Other) {
+            while (i < text.size() && KindOf(text[i]) == kind) {
+                i++;
+            }
+        }
+    }
+    starts.push_back(text.size());
+    return starts;
+}
+
+struct TokenRange {
+    size_t start; // first token of the old text
+    size_t end;
+    size_t replacementStart; // first token of the new text
+    size_t replacementEnd;
+};
+
+// Changed token ranges between a[aBegin, aEnd) and b[bBegin, bEnd), which share no prefix or suffix.
+// Returns false when the edit distance exceeds maxCost.
+bool MyersDiff(const std::vector<std::wstring_view>& a, const std::vector<std::wstring_view>& b, size_t aBegin, size_t aEnd,
+               size_t bBegin, size_t bEnd, size_t maxCost, std::vector<TokenRange>& ranges) {
+    long n = static_cast<long>(aEnd - aBegin);
+    long m = static_cast<long>(bEnd - bBegin);
+    long max = n + m;
+    long costLimit = static_cast<long>((std::min)(maxCost, static_cast<size_t>(max)));
+    std::vector<long> v(2 * max + 2, 0);
+    std::vector<std::vector<long>> trace; // v[-d..d] after each d
+    long offset = max + 1;
+    long found = -1;
+    for (long d = 0; d <= costLimit && found < 0; d++) {
+        for (long k = -d; k <= d; k += 2) {
+            long x = (k == -d || (k != d && v[offset + k - 1] < v[offset + k + 1])) ? v[offset + k + 1] : v[offset + k - 1] + 1;
+            long y = x - k;
+            while (x < n && y < m && a[aBegin + x] == b[bBegin + y]) {
+                x++;
+                y++;
+            }
+            v[offset + k] = x;
+            if (x >= n && y >= m) {
+                found = d;
+            }
+        }
+        trace.emplace_back(v.begin() + offset - d, v.begin() + offset + d + 1);
+    }
+    if (found < 0) {
+        return false;
+    }
+
+    // Walk back through the trace, one insertion or deletion per step
+    std::vector<TokenRange> reversed;
+    long x = n;
+    long y = m;
+    for (long d = found; d > 0; d--) {
+        const std::vector<long>& previous = trace[d - 1];
+        auto at = [&previous, d](long k) { return previous[k + d - 1]; };
+        long k = x - y;
+        long previousK = (k == -d || (k != d && at(k - 1) < at(k + 1))) ? k + 1 : k - 1;
+        long previousX = at(previousK);
+        long previousY = previousX - previousK;
+        while (x > previousX && y > previousY) {
+            x--;
+            y--;
+        }
+        size_t as = aBegin + static_cast<size_t>(previousX);
+        size_t bs = bBegin + static_cast<size_t>(previousY);
+        TokenRange step = { as, aBegin + static_cast<size_t>(x), bs, bBegin + static_cast<size_t>(y) };
+        if (!reversed.empty() && reversed.back().start == step.end && reversed.back().replacementStart == step.replacementEnd) {
+            reversed.back().start = step.start;
+            reversed.back().replacementStart = step.replacementStart;
+        } else {
+            reversed.push_back(step);
+        }
+        x = previousX;
+        y = previousY;
+    }
+    ranges.insert(ranges.end(), reversed.rbegin(), reversed.rend());
+    return true;
+}
+
+} // namespace
+
+std::vector<TextEdit> DiffWords(std::wstring_view before, std::wstring_view after, size_t maxCost) {
+    std::vector<size_t> beforeStarts = Tokenize(before);
+    std::vector<size_t> afterStarts = Tokenize(after);
+    auto tokens = [](std::wstring_view text, const std::vector<size_t>& starts) {
+        std::vector<std::wstring_view> result;
+        result.reserve(starts.size() - 1);
+        for (size_t i = 0; i + 1 < starts.size(); i++) {
+            result.push_back(text.substr(starts[i], starts[i + 1] - starts[i]));
+        }
+        return result;
+    };
+    std::vector<std::wstring_view> a = tokens(before, beforeStarts);
+    std::vector<std::wstring_view> b = tokens(after, afterStarts);
+
+    size_t prefix = 0;
+    while (prefix < a.size() && prefix < b.size() && a[prefix] == b[prefix]) {
+        prefix++;
+    }
+    size_t suffix = 0;
+    while (suffix < a.size() - prefix && suffix < b.size() - prefix && a[a.size() - 1 - suffix] == b[b.size() - 1 - suffix]) {
+        suffix++;
+    }
+    size_t aEnd = a.size() - suffix;
+    size_t bEnd = b.size() - suffix;
+
+    std::vector<TokenRange> ranges;
+    if (prefix < aEnd || prefix < bEnd) {
+        if (!MyersDiff(a, b, prefix, aEnd, prefix, bEnd, maxCost, ranges)) {
+            ranges = { { prefix, aEnd, prefix, bEnd } };
+        }
+    }
+
+    // Merge edits with a single unchanged token between them; the gap is the same tokens in both texts
+    std::vector<TokenRange> merged;
+    for (const auto& range : ranges) {
+        if (!merged.empty() && range.start - merged.back().end <= 1) {
+            merged.back().end = range.end;
+            merged.back().replacementEnd = range.replacementEnd;
+        } else {
+            merged.push_back(range);
+        }
+    }
+
+    std::vector<TextEdit> edits;
+    edits.reserve(merged.size());
+    for (const auto& range : merged) {
+        edits.push_back({ beforeStarts[range.start], beforeStarts[range.end], afterStarts[range.replacementStart], afterStarts[range.replacementEnd] });
+    }
+    return edits;
+}
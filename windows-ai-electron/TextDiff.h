@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+// Word-level diff of two UTF-16 strings, used to send rewrites back as small edits instead of the full
+// text.
+//
+// Tokens are runs of word characters, runs of whitespace and single other characters (punctuation, CJK
+// ideographs). The token sequences are compared with Myers' O(ND) algorithm after stripping the common
+// prefix and suffix.
+
+// Replaces [start, end) of the old text with [replacementStart, replacementEnd) of the new text
+struct TextEdit {
+    size_t start = 0;
+    size_t end = 0;
+    size_t replacementStart = 0;
+    size_t replacementEnd = 0;
+};
+
+// Edits that turn before into after, ascending and non-overlapping. Edits separated by a single unchanged
+// token are merged, so a rewritten phrase comes back as one edit. When the texts differ in more than
+// maxCost tokens the changed middle is returned as one edit.
+std::vector<TextEdit> DiffWords(std::wstring_view before, std::wstring_view after, size_t maxCost = 2000);
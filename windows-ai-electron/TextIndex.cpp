@@ -0,0 +1,977 @@
+#include "TextIndex.h"
+#include "ContentHash.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+// Segment layout: header, then fixed-width tables of little-endian uint32 fields, then the string pool
+//   documents  { idOffset, idLength, firstBox, wordCount }
+//   terms      { textOffset, textLength, firstPosting, postingCount }, sorted by text
+//   postings   { document, firstPosition, positionCount }, sorted by document within a term
+//   positions  word positions within the document
+//   boxes      8 floats per word (topLeft, topRight, bottomLeft, bottomRight)
+constexpr char kSegmentMagic[8] = { 'W', 'A', 'I', 'T', 'X', 'S', 'E', 'G' };
+constexpr uint32_t kSegmentVersion = 1;
+
+#pragma pack(push, 1)
+struct SegmentHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t documentCount;
+    uint32_t termCount;
+    uint32_t postingCount;
+    uint32_t positionCount;
+    uint32_t boxCount;
+    uint32_t stringBytes;
+    uint32_t reserved;
+    uint64_t checksum; // XXH64 of everything after the header
+};
+#pragma pack(pop)
+static_assert(sizeof(SegmentHeader) == 48, "SegmentHeader layout is part of the file format");
+
+constexpr size_t kDocumentSize = 16;
+constexpr size_t kTermSize = 16;
+constexpr size_t kPostingSize = 12;
+constexpr size_t kBoxSize = 32;
+
+const char kManifestName[] = "manifest";
+
+uint32_t LoadU32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+float LoadFloat(const uint8_t* data) {
+    float value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+void AppendU32(std::vector<uint8_t>& out, uint32_t value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(value));
+}
+
+// Non-ASCII bytes are kept so UTF-8 words are indexed unchanged
+bool IsAsciiPunctuation(unsigned char c) {
+    return c < 0x80 && !std::isalnum(c);
+}
+
+bool IsSegmentFileName(const std::string& name) {
+    return name.rfind("seg-", 0) == 0;
+}
+
+} // namespace
+
+std::string NormalizeIndexTerm(std::string_view word) {
+    size_t begin = 0;
+    size_t end = word.size();
+    while (begin < end && IsAsciiPunctuation(static_cast<unsigned char>(word[begin]))) {
+        begin++;
+    }
+    while (end > begin && IsAsciiPunctuation(static_cast<unsigned char>(word[end - 1]))) {
+        end--;
+    }
+    std::string term(word.substr(begin, end - begin));
+    for (char& c : term) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+    return term;
+}
+
+TextIndexQuery ParseTextIndexQuery(std::string_view query) {
+    TextIndexQuery parsed;
+    auto addTerm = [](std::vector<TextIndexQuery::Term>& clause, std::string_view token) {
+        bool prefix = !token.empty() && token.back() == '*';
+        if (prefix) {
+            token.remove_suffix(1);
+        }
+        std::string text = NormalizeIndexTerm(token);
+        if (!text.empty()) {
+            clause.push_back({ std::move(text), prefix });
+        }
+    };
+
+    size_t i = 0;
+    while (i < query.size()) {
+        if (std::isspace(static_cast<unsigned char>(query[i]))) {
+            i++;
+            continue;
+        }
+        std::vector<TextIndexQuery::Term> clause;
+        if (query[i] == '"') {
+            size_t close = query.find('"', i + 1);
+            std::string_view phrase = query.substr(i + 1, close == std::string_view::npos ? std::string_view::npos : close - i - 1);
+            size_t start = 0;
+            while (start < phrase.size()) {
+                size_t stop = start;
+                while (stop < phrase.size() && !std::isspace(static_cast<unsigned char>(phrase[stop]))) {
+                    stop++;
+                }
+                if (stop > start) {
+                    addTerm(clause, phrase.substr(start, stop - start));
+                }
+                start = stop + 1;
+            }
+            i = close == std::string_view::npos ? query.size() : close + 1;
+        } else {
+            size_t stop = i;
+            while (stop < query.size() && !std::isspace(static_cast<unsigned char>(query[stop]))) {
+                stop++;
+            }
+            addTerm(clause, query.substr(i, stop - i));
+            i = stop;
+        }
+        if (!clause.empty()) {
+            parsed.clauses.push_back(std::move(clause));
+        }
+    }
+    return parsed;
+}
+
+// TextIndexSegment
+
+std::shared_ptr<TextIndexSegment> TextIndexSegment::FromFile(const std::filesystem::path& path) {
+    std::shared_ptr<TextIndexSegment> segment(new TextIndexSegment());
+    segment->m_file = std::make_unique<MappedFile>(path);
+    segment->m_data = segment->m_file->Data();
+    segment->m_size = segment->m_file->Size();
+    segment->Parse();
+    return segment;
+}
+
+std::shared_ptr<TextIndexSegment> TextIndexSegment::FromBytes(std::vector<uint8_t> bytes) {
+    std::shared_ptr<TextIndexSegment> segment(new TextIndexSegment());
+    segment->m_bytes = std::move(bytes);
+    segment->m_data = segment->m_bytes.data();
+    segment->m_size = segment->m_bytes.size();
+    segment->Parse();
+    return segment;
+}
+
+void TextIndexSegment::Parse() {
+    if (m_size < sizeof(SegmentHeader)) {
+        throw std::runtime_error("Text index segment is truncated");
+    }
+    SegmentHeader header;
+    std::memcpy(&header, m_data, sizeof(header));
+    if (std::memcmp(header.magic, kSegmentMagic, sizeof(kSegmentMagic)) != 0 || header.version != kSegmentVersion) {
+        throw std::runtime_error("Not a text index segment");
+    }
+
+    uint64_t expected = sizeof(SegmentHeader) +
+        static_cast<uint64_t>(header.documentCount) * kDocumentSize +
+        static_cast<uint64_t>(header.termCount) * kTermSize +
+        static_cast<uint64_t>(header.postingCount) * kPostingSize +
+        static_cast<uint64_t>(header.positionCount) * 4 +
+        static_cast<uint64_t>(header.boxCount) * kBoxSize +
+        header.stringBytes;
+    if (expected != m_size) {
+        throw std::runtime_error("Text index segment is truncated");
+    }
+    if (ComputeContentHash(m_data + sizeof(SegmentHeader), m_size - sizeof(SegmentHeader)) != header.checksum) {
+        throw std::runtime_error("Text index segment checksum mismatch");
+    }
+
+    m_documentCount = header.documentCount;
+    m_termCount = header.termCount;
+    m_documents = m_data + sizeof(SegmentHeader);
+    m_terms = m_documents + static_cast<size_t>(header.documentCount) * kDocumentSize;
+    m_postings = m_terms + static_cast<size_t>(header.termCount) * kTermSize;
+    m_positions = m_postings + static_cast<size_t>(header.postingCount) * kPostingSize;
+    m_boxes = m_positions + static_cast<size_t>(header.positionCount) * 4;
+    m_strings = m_boxes + static_cast<size_t>(header.boxCount) * kBoxSize;
+
+    // Validate every reference once so queries can index without bounds checks
+    auto inRange = [](uint64_t offset, uint64_t length, uint64_t limit) { return offset + length <= limit; };
+    for (uint32_t i = 0; i < m_documentCount; i++) {
+        const uint8_t* document = m_documents + static_cast<size_t>(i) * kDocumentSize;
+        if (!inRange(LoadU32(document), LoadU32(document + 4), header.stringBytes) || !inRange(LoadU32(document + 8), LoadU32(document + 12), header.boxCount)) {
+            throw std::runtime_error("Text index segment is corrupt");
+        }
+    }
+    for (uint32_t i = 0; i < m_termCount; i++) {
+        const uint8_t* term = m_terms + static_cast<size_t>(i) * kTermSize;
+        if (!inRange(LoadU32(term), LoadU32(term + 4), header.stringBytes) || !inRange(LoadU32(term + 8), LoadU32(term + 12), header.postingCount)) {
+            throw std::runtime_error("Text index segment is corrupt");
+        }
+        if (i > 0 && !(TermText(i - 1) < TermText(i))) {
+            throw std::runtime_error("Text index segment terms are not sorted");
+        }
+    }
+    for (uint32_t i = 0; i < header.postingCount; i++) {
+        const uint8_t* posting = m_postings + static_cast<size_t>(i) * kPostingSize;
+        uint32_t document = LoadU32(posting);
+        if (document >= m_documentCount || !inRange(LoadU32(posting + 4), LoadU32(posting + 8), header.positionCount)) {
+            throw std::runtime_error("Text index segment is corrupt");
+        }
+        uint32_t wordCount = WordCount(document);
+        const uint8_t* positions = m_positions + static_cast<size_t>(LoadU32(posting + 4)) * 4;
+        for (uint32_t j = 0; j < LoadU32(posting + 8); j++) {
+            if (LoadU32(positions + static_cast<size_t>(j) * 4) >= wordCount) {
+                throw std::runtime_error("Text index segment is corrupt");
+            }
+        }
+    }
+}
+
+std::string_view TextIndexSegment::ImageId(uint32_t document) const {
+    const uint8_t* entry = m_documents + static_cast<size_t>(document) * kDocumentSize;
+    return { reinterpret_cast<const char*>(m_strings + LoadU32(entry)), LoadU32(entry + 4) };
+}
+
+uint32_t TextIndexSegment::WordCount(uint32_t document) const {
+    return LoadU32(m_documents + static_cast<size_t>(document) * kDocumentSize + 12);
+}
+
+OcrQuad TextIndexSegment::WordBox(uint32_t document, uint32_t word) const {
+    uint32_t firstBox = LoadU32(m_documents + static_cast<size_t>(document) * kDocumentSize + 8);
+    const uint8_t* box = m_boxes + (static_cast<size_t>(firstBox) + word) * kBoxSize;
+    OcrQuad quad;
+    size_t offset = 0;
+    for (OcrPoint* point : { &quad.topLeft, &quad.topRight, &quad.bottomLeft, &quad.bottomRight }) {
+        point->x = LoadFloat(box + offset);
+        point->y = LoadFloat(box + offset + 4);
+        offset += 8;
+    }
+    return quad;
+}
+
+std::string_view TextIndexSegment::TermText(uint32_t term) const {
+    const uint8_t* entry = m_terms + static_cast<size_t>(term) * kTermSize;
+    return { reinterpret_cast<const char*>(m_strings + LoadU32(entry)), LoadU32(entry + 4) };
+}
+
+void TextIndexSegment::VisitTerm(uint32_t term, const PostingVisitor& visit) const {
+    const uint8_t* entry = m_terms + static_cast<size_t>(term) * kTermSize;
+    std::string_view text = TermText(term);
+    uint32_t firstPosting = LoadU32(entry + 8);
+    uint32_t postingCount = LoadU32(entry + 12);
+    for (uint32_t i = firstPosting; i < firstPosting + postingCount; i++) {
+        const uint8_t* posting = m_postings + static_cast<size_t>(i) * kPostingSize;
+        visit(text, LoadU32(posting), m_positions + static_cast<size_t>(LoadU32(posting + 4)) * 4, LoadU32(posting + 8));
+    }
+}
+
+void TextIndexSegment::VisitPostings(const TextIndexQuery::Term& term, const PostingVisitor& visit) const {
+    // Binary search for the first term not less than the query text
+    uint32_t low = 0;
+    uint32_t high = m_termCount;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (TermText(middle) < term.text) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    for (uint32_t i = low; i < m_termCount; i++) {
+        std::string_view text = TermText(i);
+        bool matches = term.prefix ? text.substr(0, term.text.size()) == term.text : text == term.text;
+        if (!matches) {
+            break;
+        }
+        VisitTerm(i, visit);
+        if (!term.prefix) {
+            break;
+        }
+    }
+}
+
+void TextIndexSegment::VisitAllTerms(const PostingVisitor& visit) const {
+    for (uint32_t i = 0; i < m_termCount; i++) {
+        VisitTerm(i, visit);
+    }
+}
+
+// TextIndexSegmentBuilder
+
+void TextIndexSegmentBuilder::AddDocument(const std::string& imageId, const OcrPage& page) {
+    uint32_t document = static_cast<uint32_t>(m_documents.size());
+    uint32_t firstBox = static_cast<uint32_t>(m_boxes.size());
+    uint32_t position = 0;
+    for (const auto& line : page.lines) {
+        for (const auto& word : line.words) {
+            m_boxes.push_back(word.box);
+            std::string term = NormalizeIndexTerm(word.text);
+            if (!term.empty()) {
+                m_postings[std::move(term)].emplace_back(document, position);
+            }
+            position++;
+        }
+    }
+    m_documents.push_back({ imageId, firstBox, position });
+}
+
+void TextIndexSegmentBuilder::AddSegment(const TextIndexSegment& segment, const std::vector<bool>* deleted) {
+    constexpr uint32_t kSkipped = UINT32_MAX;
+    std::vector<uint32_t> renumbered(segment.DocumentCount(), kSkipped);
+    for (uint32_t document = 0; document < segment.DocumentCount(); document++) {
+        if (deleted && (*deleted)[document]) {
+            continue;
+        }
+        renumbered[document] = static_cast<uint32_t>(m_documents.size());
+        uint32_t firstBox = static_cast<uint32_t>(m_boxes.size());
+        uint32_t wordCount = segment.WordCount(document);
+        for (uint32_t word = 0; word < wordCount; word++) {
+            m_boxes.push_back(segment.WordBox(document, word));
+        }
+        m_documents.push_back({ std::string(segment.ImageId(document)), firstBox, wordCount });
+    }
+
+    // Postings of one term are visited consecutively, so each term is looked up once
+    std::vector<std::pair<uint32_t, uint32_t>>* postings = nullptr;
+    std::string_view currentTerm;
+    segment.VisitAllTerms([&](std::string_view term, uint32_t document, const uint8_t* positions, uint32_t positionCount) {
+        if (renumbered[document] == kSkipped) {
+            return;
+        }
+        if (!postings || term != currentTerm) {
+            postings = &m_postings[std::string(term)];
+            currentTerm = term;
+        }
+        for (uint32_t i = 0; i < positionCount; i++) {
+            postings->emplace_back(renumbered[document], LoadU32(positions + static_cast<size_t>(i) * 4));
+        }
+    });
+}
+
+std::vector<uint8_t> TextIndexSegmentBuilder::Serialize() const {
+    std::vector<uint8_t> documents;
+    std::vector<uint8_t> terms;
+    std::vector<uint8_t> postings;
+    std::vector<uint8_t> positions;
+    std::vector<uint8_t> strings;
+    uint32_t postingCount = 0;
+    uint32_t positionCount = 0;
+
+    documents.reserve(m_documents.size() * kDocumentSize);
+    for (const auto& document : m_documents) {
+        AppendU32(documents, static_cast<uint32_t>(strings.size()));
+        AppendU32(documents, static_cast<uint32_t>(document.imageId.size()));
+        AppendU32(documents, document.firstBox);
+        AppendU32(documents, document.wordCount);
+        strings.insert(strings.end(), document.imageId.begin(), document.imageId.end());
+    }
+
+    std::vector<const std::pair<const std::string, std::vector<std::pair<uint32_t, uint32_t>>>*> sortedTerms;
+    sortedTerms.reserve(m_postings.size());
+    for (const auto& entry : m_postings) {
+        sortedTerms.push_back(&entry);
+    }
+    std::sort(sortedTerms.begin(), sortedTerms.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+    terms.reserve(sortedTerms.size() * kTermSize);
+    for (const auto* entry : sortedTerms) {
+        const std::string& term = entry->first;
+        const auto& pairs = entry->second;
+        uint32_t firstPosting = postingCount;
+        strings.insert(strings.end(), term.begin(), term.end());
+
+        // Run-length group the (document, position) pairs into one posting per document
+        for (size_t i = 0; i < pairs.size();) {
+            size_t end = i;
+            while (end < pairs.size() && pairs[end].first == pairs[i].first) {
+                AppendU32(positions, pairs[end].second);
+                end++;
+            }
+            AppendU32(postings, pairs[i].first);
+            AppendU32(postings, positionCount);
+            AppendU32(postings, static_cast<uint32_t>(end - i));
+            positionCount += static_cast<uint32_t>(end - i);
+            postingCount++;
+            i = end;
+        }
+
+        AppendU32(terms, static_cast<uint32_t>(strings.size() - term.size()));
+        AppendU32(terms, static_cast<uint32_t>(term.size()));
+        AppendU32(terms, firstPosting);
+        AppendU32(terms, postingCount - firstPosting);
+    }
+
+    SegmentHeader header = {};
+    std::memcpy(header.magic, kSegmentMagic, sizeof(kSegmentMagic));
+    header.version = kSegmentVersion;
+    header.documentCount = static_cast<uint32_t>(m_documents.size());
+    header.termCount = static_cast<uint32_t>(m_postings.size());
+    header.postingCount = postingCount;
+    header.positionCount = positionCount;
+    header.boxCount = static_cast<uint32_t>(m_boxes.size());
+    header.stringBytes = static_cast<uint32_t>(strings.size());
+
+    std::vector<uint8_t> out(sizeof(SegmentHeader));
+    out.reserve(sizeof(SegmentHeader) + documents.size() + terms.size() + postings.size() + positions.size() + m_boxes.size() * kBoxSize + strings.size());
+    out.insert(out.end(), documents.begin(), documents.end());
+    out.insert(out.end(), terms.begin(), terms.end());
+    out.insert(out.end(), postings.begin(), postings.end());
+    out.insert(out.end(), positions.begin(), positions.end());
+    for (const auto& box : m_boxes) {
+        for (const OcrPoint* point : { &box.topLeft, &box.topRight, &box.bottomLeft, &box.bottomRight }) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(point);
+            out.insert(out.end(), bytes, bytes + 8);
+        }
+    }
+    out.insert(out.end(), strings.begin(), strings.end());
+
+    header.checksum = ComputeContentHash(out.data() + sizeof(SegmentHeader), out.size() - sizeof(SegmentHeader));
+    std::memcpy(out.data(), &header, sizeof(header));
+    return out;
+}
+
+// TextIndex
+
+TextIndex::TextIndex(std::filesystem::path directory, TextIndexOptions options) : m_directory(std::move(directory)), m_options(options) {
+    if (m_options.flushDocuments == 0) {
+        m_options.flushDocuments = 1;
+    }
+    if (m_options.maxSegments < 2) {
+        m_options.maxSegments = 2;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error) {
+        throw std::runtime_error("Failed to create text index directory " + m_directory.string() + ": " + error.message());
+    }
+
+    std::vector<uint64_t> live;
+    std::ifstream manifest(m_directory / kManifestName);
+    uint64_t generation = 0;
+    while (manifest >> generation) {
+        live.push_back(generation);
+    }
+    for (uint64_t liveGeneration : live) {
+        m_segments.push_back({ m_nextSegmentId++, liveGeneration, TextIndexSegment::FromFile(SegmentPath(liveGeneration)), nullptr, 0 });
+        m_nextGeneration = std::max(m_nextGeneration, liveGeneration + 1);
+    }
+
+    // Segments are listed oldest first, so the last document of an image id is its live one
+    for (const auto& segment : m_segments) {
+        for (uint32_t document = 0; document < segment.data->DocumentCount(); document++) {
+            auto [it, inserted] = m_locations.try_emplace(std::string(segment.data->ImageId(document)), Location{ segment.id, document });
+            if (!inserted) {
+                TombstoneLocked(it->second);
+                it->second = { segment.id, document };
+            }
+        }
+    }
+
+    // Segments not in the manifest are leftovers of an interrupted flush or merge
+    for (const auto& entry : std::filesystem::directory_iterator(m_directory, error)) {
+        std::string name = entry.path().filename().string();
+        if (!IsSegmentFileName(name)) {
+            continue;
+        }
+        uint64_t fileGeneration = std::strtoull(name.c_str() + 4, nullptr, 10);
+        m_nextGeneration = std::max(m_nextGeneration, fileGeneration + 1);
+        bool listed = std::find(live.begin(), live.end(), fileGeneration) != live.end() && entry.path() == SegmentPath(fileGeneration);
+        if (!listed) {
+            std::error_code removeError;
+            std::filesystem::remove(entry.path(), removeError);
+        }
+    }
+
+    m_background = std::thread([this]() { RunBackground(); });
+
+    // A merge that was due when the index was last closed
+    if (m_segments.size() > m_options.maxSegments) {
+        m_mergeScheduled = true;
+        Schedule([this]() { MergeIfNeeded(); });
+    }
+}
+
+TextIndex::~TextIndex() {
+    Close();
+}
+
+std::filesystem::path TextIndex::SegmentPath(uint64_t generation) const {
+    return m_directory / ("seg-" + std::to_string(generation) + ".tix");
+}
+
+void TextIndex::WriteManifestLocked() {
+    std::filesystem::path temporary = m_directory / (std::string(kManifestName) + ".tmp");
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        for (const auto& segment : m_segments) {
+            if (segment.generation != 0) {
+                out << segment.generation << '\n';
+            }
+        }
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Failed to write text index manifest");
+        }
+    }
+    std::filesystem::rename(temporary, m_directory / kManifestName);
+}
+
+std::shared_ptr<TextIndexSegment> TextIndex::WriteSegment(uint64_t generation, const TextIndexSegment& segment) {
+    std::filesystem::path path = SegmentPath(generation);
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(segment.Data()), static_cast<std::streamsize>(segment.ByteSize()));
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Failed to write text index segment " + path.string());
+        }
+    }
+    std::filesystem::rename(temporary, path);
+    return TextIndexSegment::FromFile(path);
+}
+
+void TextIndex::TombstoneLocked(const Location& location) {
+    if (location.segment == m_pendingId && m_pending) {
+        m_pendingDeleted[location.document] = true;
+        m_pendingDeletedCount++;
+        m_pendingView.reset();
+        return;
+    }
+    for (auto& segment : m_segments) {
+        if (segment.id == location.segment) {
+            // Searches keep the bitmap of their snapshot, so it is replaced rather than modified
+            auto deleted = segment.deleted ? std::make_shared<std::vector<bool>>(*segment.deleted) : std::make_shared<std::vector<bool>>(segment.data->DocumentCount());
+            (*deleted)[location.document] = true;
+            segment.deleted = std::move(deleted);
+            segment.deletedCount++;
+            return;
+        }
+    }
+}
+
+void TextIndex::ReleaseRetiredLocked() {
+    // A retired segment is not in m_segments, so no new search can take it; once only this list holds
+    // it, nothing has it mapped
+    for (auto it = m_retired.begin(); it != m_retired.end();) {
+        if (it->data.use_count() > 1) {
+            ++it;
+            continue;
+        }
+        it->data.reset();
+        std::error_code error;
+        std::filesystem::remove(SegmentPath(it->generation), error);
+        it = m_retired.erase(it);
+    }
+}
+
+void TextIndex::Add(const std::string& imageId, const OcrPage& page) {
+    if (m_closed) {
+        throw std::runtime_error("Text index is closed");
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_pending) {
+        m_pending = std::make_unique<TextIndexSegmentBuilder>();
+        m_pendingId = m_nextSegmentId++;
+        m_pendingDeleted.clear();
+        m_pendingDeletedCount = 0;
+    }
+    Location location{ m_pendingId, m_pending->DocumentCount() };
+    auto [it, inserted] = m_locations.try_emplace(imageId, location);
+    if (!inserted) {
+        TombstoneLocked(it->second);
+        it->second = location;
+    }
+    m_pending->AddDocument(imageId, page);
+    m_pendingDeleted.push_back(false);
+    m_pendingView.reset();
+    if (m_pending->DocumentCount() >= m_options.flushDocuments && !m_flushScheduled) {
+        m_flushScheduled = true;
+        Schedule([this]() { Flush(); });
+    }
+}
+
+void TextIndex::Flush() {
+    std::lock_guard<std::mutex> writeLock(m_writeMutex);
+
+    std::shared_ptr<TextIndexSegment> memory;
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_flushScheduled = false;
+        if (!m_pending || m_pending->DocumentCount() == 0) {
+            return;
+        }
+        // Keep the documents searchable from memory while the file is written. The segment keeps the
+        // buffer's id, so the locations of its documents stay valid.
+        memory = m_pendingView ? m_pendingView : TextIndexSegment::FromBytes(m_pending->Serialize());
+        generation = m_nextGeneration++;
+        std::shared_ptr<const std::vector<bool>> deleted;
+        if (m_pendingDeletedCount > 0) {
+            deleted = std::make_shared<std::vector<bool>>(std::move(m_pendingDeleted));
+        }
+        m_segments.push_back({ m_pendingId, 0, memory, std::move(deleted), m_pendingDeletedCount });
+        m_pending.reset();
+        m_pendingDeleted.clear();
+        m_pendingDeletedCount = 0;
+        m_pendingView.reset();
+    }
+
+    std::shared_ptr<TextIndexSegment> file;
+    try {
+        file = WriteSegment(generation, *memory);
+    } catch (...) {
+        // Put the documents back so a later flush can retry. The restored buffer takes over the id of the
+        // failed segment; documents buffered since then move behind its documents.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto failed = std::find_if(m_segments.begin(), m_segments.end(), [&memory](const Segment& segment) { return segment.data == memory; });
+        uint64_t restoredId = failed->id;
+        std::vector<bool> restoredDeleted = failed->deleted ? *failed->deleted : std::vector<bool>(memory->DocumentCount());
+        uint32_t restoredDeletedCount = failed->deletedCount;
+        m_segments.erase(failed);
+
+        auto restored = std::make_unique<TextIndexSegmentBuilder>();
+        restored->AddSegment(*memory);
+        if (m_pending) {
+            restored->AddSegment(*TextIndexSegment::FromBytes(m_pending->Serialize()));
+            for (auto& [imageId, location] : m_locations) {
+                if (location.segment == m_pendingId) {
+                    location = { restoredId, memory->DocumentCount() + location.document };
+                }
+            }
+            restoredDeleted.insert(restoredDeleted.end(), m_pendingDeleted.begin(), m_pendingDeleted.end());
+            restoredDeletedCount += m_pendingDeletedCount;
+        }
+        m_pending = std::move(restored);
+        m_pendingId = restoredId;
+        m_pendingDeleted = std::move(restoredDeleted);
+        m_pendingDeletedCount = restoredDeletedCount;
+        m_pendingView.reset();
+        throw;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& segment : m_segments) {
+        if (segment.data == memory) {
+            segment.generation = generation;
+            segment.data = file;
+        }
+    }
+    m_flushes++;
+    WriteManifestLocked();
+
+    size_t fileSegments = std::count_if(m_segments.begin(), m_segments.end(), [](const Segment& segment) { return segment.generation != 0; });
+    if (fileSegments > m_options.maxSegments && !m_mergeScheduled) {
+        m_mergeScheduled = true;
+        Schedule([this]() { MergeIfNeeded(); });
+    }
+}
+
+void TextIndex::MergeIfNeeded() {
+    std::lock_guard<std::mutex> writeLock(m_writeMutex);
+
+    std::vector<Segment> merging;
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_mergeScheduled = false;
+        std::vector<Segment> candidates;
+        for (const auto& segment : m_segments) {
+            if (segment.generation != 0) {
+                candidates.push_back(segment);
+            }
+        }
+        if (candidates.size() <= m_options.maxSegments) {
+            return;
+        }
+        // Merge the smallest segments down to half the limit, so large segments are rewritten rarely
+        std::sort(candidates.begin(), candidates.end(), [](const Segment& a, const Segment& b) { return a.data->ByteSize() < b.data->ByteSize(); });
+        size_t count = std::max<size_t>(2, candidates.size() - m_options.maxSegments / 2);
+        merging.assign(candidates.begin(), candidates.begin() + count);
+        generation = m_nextGeneration++;
+    }
+
+    // Tombstoned documents are dropped. Every document left is live, so the merged segment can go last
+    // in the manifest: anything added from now on is flushed after it.
+    TextIndexSegmentBuilder builder;
+    for (const auto& segment : merging) {
+        builder.AddSegment(*segment.data, segment.deleted.get());
+    }
+    auto merged = WriteSegment(generation, *TextIndexSegment::FromBytes(builder.Serialize()));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Segment replacement{ m_nextSegmentId++, generation, merged, nullptr, 0 };
+    auto deleted = std::make_shared<std::vector<bool>>(merged->DocumentCount());
+    uint32_t document = 0;
+    for (const auto& segment : merging) {
+        for (uint32_t old = 0; old < segment.data->DocumentCount(); old++) {
+            if (segment.deleted && (*segment.deleted)[old]) {
+                continue;
+            }
+            // An id added again while the merge ran is already superseded
+            auto it = m_locations.find(std::string(segment.data->ImageId(old)));
+            if (it != m_locations.end() && it->second.segment == segment.id && it->second.document == old) {
+                it->second = { replacement.id, document };
+            } else {
+                (*deleted)[document] = true;
+                replacement.deletedCount++;
+            }
+            document++;
+        }
+    }
+    if (replacement.deletedCount > 0) {
+        replacement.deleted = std::move(deleted);
+    }
+
+    m_segments.erase(std::remove_if(m_segments.begin(), m_segments.end(), [&merging](const Segment& segment) {
+        return std::any_of(merging.begin(), merging.end(), [&segment](const Segment& old) { return old.id == segment.id; });
+    }), m_segments.end());
+    m_segments.push_back(std::move(replacement));
+    m_merges++;
+    WriteManifestLocked();
+
+    m_retired.insert(m_retired.end(), merging.begin(), merging.end());
+    merging.clear();
+    ReleaseRetiredLocked();
+}
+
+namespace {
+
+using DocumentPosition = std::pair<uint32_t, uint32_t>;
+
+// Sorted (document, position) pairs of every word matching the clause, restricted to candidates when
+// given. Documents marked in deleted are skipped.
+std::vector<DocumentPosition> MatchClause(const TextIndexSegment& segment, const std::vector<bool>* deleted, const std::vector<TextIndexQuery::Term>& clause, const std::vector<uint32_t>* candidates) {
+    std::vector<std::vector<DocumentPosition>> termPositions(clause.size());
+    for (size_t t = 0; t < clause.size(); t++) {
+        auto& list = termPositions[t];
+        segment.VisitPostings(clause[t], [&](std::string_view, uint32_t document, const uint8_t* positions, uint32_t positionCount) {
+            if (candidates && !std::binary_search(candidates->begin(), candidates->end(), document)) {
+                return;
+            }
+            if (deleted && (*deleted)[document]) {
+                return;
+            }
+            for (uint32_t i = 0; i < positionCount; i++) {
+                list.emplace_back(document, LoadU32(positions + static_cast<size_t>(i) * 4));
+            }
+        });
+        // A prefix can expand to several terms, each sorted on its own
+        if (clause[t].prefix) {
+            std::sort(list.begin(), list.end());
+            list.erase(std::unique(list.begin(), list.end()), list.end());
+        }
+        if (list.empty()) {
+            return {};
+        }
+    }
+    if (clause.size() == 1) {
+        return std::move(termPositions[0]);
+    }
+
+    // A phrase matches where term t sits at position p + t for every t
+    std::vector<DocumentPosition> hits;
+    for (const auto& [document, start] : termPositions[0]) {
+        bool phrase = true;
+        for (size_t t = 1; t < clause.size() && phrase; t++) {
+            phrase = std::binary_search(termPositions[t].begin(), termPositions[t].end(), DocumentPosition(document, start + static_cast<uint32_t>(t)));
+        }
+        if (phrase) {
+            for (size_t t = 0; t < clause.size(); t++) {
+                hits.emplace_back(document, start + static_cast<uint32_t>(t));
+            }
+        }
+    }
+    std::sort(hits.begin(), hits.end());
+    hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+    return hits;
+}
+
+} // namespace
+
+std::vector<TextIndexHit> TextIndex::Search(const TextIndexQuery& query, size_t limit) {
+    std::vector<std::shared_ptr<TextIndexSegment>> snapshot;
+    std::vector<std::shared_ptr<const std::vector<bool>>> snapshotDeleted;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& segment : m_segments) {
+            snapshot.push_back(segment.data);
+            snapshotDeleted.push_back(segment.deleted);
+        }
+        if (m_pending && m_pending->DocumentCount() > 0) {
+            if (!m_pendingView) {
+                m_pendingView = TextIndexSegment::FromBytes(m_pending->Serialize());
+                m_pendingViewDeleted.reset();
+                if (m_pendingDeletedCount > 0) {
+                    m_pendingViewDeleted = std::make_shared<std::vector<bool>>(m_pendingDeleted);
+                }
+            }
+            snapshot.push_back(m_pendingView);
+            snapshotDeleted.push_back(m_pendingViewDeleted);
+        }
+    }
+    std::vector<TextIndexHit> results = SearchSnapshot(snapshot, snapshotDeleted, query, limit);
+
+    // This search may have held the last reference to a merged-away segment
+    snapshot.clear();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ReleaseRetiredLocked();
+    return results;
+}
+
+std::vector<TextIndexHit> TextIndex::SearchSnapshot(const std::vector<std::shared_ptr<TextIndexSegment>>& snapshot, const std::vector<std::shared_ptr<const std::vector<bool>>>& snapshotDeleted, const TextIndexQuery& query, size_t limit) {
+    if (query.clauses.empty() || limit == 0) {
+        return {};
+    }
+
+    // Matching words per image. Tombstones leave at most one live document per image id in a snapshot.
+    struct Match {
+        std::string_view imageId;
+        size_t hitCount = 0;
+        std::vector<std::pair<size_t, const DocumentPosition*>> ranges; // segment, first pair; pairs share the document
+        std::vector<size_t> rangeLengths;
+    };
+    std::vector<std::vector<DocumentPosition>> segmentHits(snapshot.size());
+    std::vector<Match> matches;
+    std::unordered_map<std::string_view, size_t> matchIndex;
+
+    for (size_t s = 0; s < snapshot.size(); s++) {
+        const TextIndexSegment& segment = *snapshot[s];
+        std::vector<DocumentPosition> hits;
+        std::vector<uint32_t> documents;
+        for (size_t c = 0; c < query.clauses.size(); c++) {
+            auto clauseHits = MatchClause(segment, snapshotDeleted[s].get(), query.clauses[c], c == 0 ? nullptr : &documents);
+            if (c == 0) {
+                hits = std::move(clauseHits);
+            } else {
+                // Keep documents matched by this clause too and add its words to the hits
+                std::vector<uint32_t> clauseDocuments;
+                for (const auto& hit : clauseHits) {
+                    if (clauseDocuments.empty() || clauseDocuments.back() != hit.first) {
+                        clauseDocuments.push_back(hit.first);
+                    }
+                }
+                hits.erase(std::remove_if(hits.begin(), hits.end(), [&clauseDocuments](const DocumentPosition& hit) {
+                    return !std::binary_search(clauseDocuments.begin(), clauseDocuments.end(), hit.first);
+                }), hits.end());
+                size_t previous = hits.size();
+                hits.insert(hits.end(), clauseHits.begin(), clauseHits.end());
+                std::inplace_merge(hits.begin(), hits.begin() + previous, hits.end());
+                hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+            }
+            documents.clear();
+            for (const auto& hit : hits) {
+                if (documents.empty() || documents.back() != hit.first) {
+                    documents.push_back(hit.first);
+                }
+            }
+            if (documents.empty()) {
+                break;
+            }
+        }
+        segmentHits[s] = std::move(hits);
+
+        const auto& finalHits = segmentHits[s];
+        for (size_t i = 0; i < finalHits.size();) {
+            size_t end = i;
+            while (end < finalHits.size() && finalHits[end].first == finalHits[i].first) {
+                end++;
+            }
+            std::string_view imageId = segment.ImageId(finalHits[i].first);
+            auto [it, inserted] = matchIndex.try_emplace(imageId, matches.size());
+            if (inserted) {
+                matches.emplace_back();
+                matches.back().imageId = imageId;
+            }
+            Match& match = matches[it->second];
+            match.hitCount += end - i;
+            match.ranges.emplace_back(s, &finalHits[i]);
+            match.rangeLengths.push_back(end - i);
+            i = end;
+        }
+    }
+
+    // Boxes are only read for the images that are returned
+    auto moreHitsFirst = [](const Match& a, const Match& b) {
+        return a.hitCount != b.hitCount ? a.hitCount > b.hitCount : a.imageId < b.imageId;
+    };
+    size_t count = std::min(limit, matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + count, matches.end(), moreHitsFirst);
+
+    std::vector<TextIndexHit> results(count);
+    for (size_t i = 0; i < count; i++) {
+        results[i].imageId = std::string(matches[i].imageId);
+        results[i].boxes.reserve(matches[i].hitCount);
+        for (size_t r = 0; r < matches[i].ranges.size(); r++) {
+            const auto& [segmentIndex, first] = matches[i].ranges[r];
+            for (size_t j = 0; j < matches[i].rangeLengths[r]; j++) {
+                results[i].boxes.push_back(snapshot[segmentIndex]->WordBox(first[j].first, first[j].second));
+            }
+        }
+    }
+    return results;
+}
+
+TextIndexStats TextIndex::GetStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    TextIndexStats stats;
+    stats.segments = m_segments.size();
+    for (const auto& segment : m_segments) {
+        stats.documents += segment.data->DocumentCount() - segment.deletedCount;
+        if (segment.generation != 0) {
+            stats.bytes += segment.data->ByteSize();
+        }
+    }
+    stats.pendingDocuments = m_pending ? m_pending->DocumentCount() - m_pendingDeletedCount : 0;
+    stats.documents += stats.pendingDocuments;
+    stats.flushes = m_flushes;
+    stats.merges = m_merges;
+    stats.lastError = m_lastError;
+    return stats;
+}
+
+void TextIndex::Schedule(std::function<void()> task) {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    if (m_stopping) {
+        return;
+    }
+    m_queue.push_back(std::move(task));
+    m_queueChanged.notify_one();
+}
+
+void TextIndex::RunBackground() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueChanged.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;
+            }
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        try {
+            task();
+        } catch (const std::exception& ex) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_lastError = ex.what();
+        }
+    }
+}
+
+void TextIndex::Close() {
+    if (m_closed.exchange(true)) {
+        return;
+    }
+    Schedule([this]() { Flush(); });
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_stopping = true;
+        m_queueChanged.notify_one();
+    }
+    if (m_background.joinable()) {
+        m_background.join();
+    }
+    // Files still mapped by a running search are removed as leftovers when the index is opened again
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ReleaseRetiredLocked();
+}
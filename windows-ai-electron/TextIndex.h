@@ -0,0 +1,209 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "OcrModel.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Full-text index over OCR results of many images.
+//
+// Documents (one per image) are buffered in memory and flushed into immutable segment files that
+// are memory-mapped for queries. A background thread flushes full buffers and merges the smallest
+// segments once there are more than maxSegments. The live segment list is kept in a manifest that
+// is replaced atomically, so a crash never leaves a half-written segment in use.
+//
+// Image ids are unique: adding an id again tombstones the postings of its earlier document, which
+// the next merge of that segment drops. Tombstones are not stored; on open they are rebuilt from the
+// manifest order, in which a later document always supersedes an earlier one. The file of a merged
+// segment is deleted once no search still has it mapped.
+
+// Lowercases ASCII and strips leading/trailing ASCII punctuation. Empty when nothing is left.
+std::string NormalizeIndexTerm(std::string_view word);
+
+// AND of clauses. A clause is one term or a quoted phrase; a term ending in '*' matches as a prefix.
+struct TextIndexQuery {
+    struct Term {
+        std::string text;
+        bool prefix = false;
+    };
+    std::vector<std::vector<Term>> clauses;
+};
+
+TextIndexQuery ParseTextIndexQuery(std::string_view query);
+
+struct TextIndexHit {
+    std::string imageId;
+    std::vector<OcrQuad> boxes; // boxes of the matching words, in word order
+};
+
+// Read-only view over one serialized segment, either mapped from a file or held in memory
+class TextIndexSegment {
+public:
+    // Throw std::runtime_error when the data is truncated or fails its checksum
+    static std::shared_ptr<TextIndexSegment> FromFile(const std::filesystem::path& path);
+    static std::shared_ptr<TextIndexSegment> FromBytes(std::vector<uint8_t> bytes);
+
+    const uint8_t* Data() const { return m_data; }
+    size_t ByteSize() const { return m_size; }
+    uint32_t DocumentCount() const { return m_documentCount; }
+    uint32_t TermCount() const { return m_termCount; }
+
+    std::string_view ImageId(uint32_t document) const;
+    uint32_t WordCount(uint32_t document) const;
+    OcrQuad WordBox(uint32_t document, uint32_t word) const;
+
+    // Calls visit(term, document, positions, positionCount) for every posting of every matching term
+    using PostingVisitor = std::function<void(std::string_view term, uint32_t document, const uint8_t* positions, uint32_t positionCount)>;
+    void VisitPostings(const TextIndexQuery::Term& term, const PostingVisitor& visit) const;
+    void VisitAllTerms(const PostingVisitor& visit) const;
+
+private:
+    TextIndexSegment() = default;
+    void Parse();
+    std::string_view TermText(uint32_t term) const;
+    void VisitTerm(uint32_t term, const PostingVisitor& visit) const;
+
+    std::unique_ptr<MappedFile> m_file;
+    std::vector<uint8_t> m_bytes;
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    uint32_t m_documentCount = 0;
+    uint32_t m_termCount = 0;
+    const uint8_t* m_documents = nullptr;
+    const uint8_t* m_terms = nullptr;
+    const uint8_t* m_postings = nullptr;
+    const uint8_t* m_positions = nullptr;
+    const uint8_t* m_boxes = nullptr;
+    const uint8_t* m_strings = nullptr;
+};
+
+// Accumulates documents (or whole segments, when merging) and serializes them into one segment
+class TextIndexSegmentBuilder {
+public:
+    void AddDocument(const std::string& imageId, const OcrPage& page);
+    // Appends the documents of segment in order, skipping those marked in deleted when given
+    void AddSegment(const TextIndexSegment& segment, const std::vector<bool>* deleted = nullptr);
+
+    uint32_t DocumentCount() const { return static_cast<uint32_t>(m_documents.size()); }
+    std::vector<uint8_t> Serialize() const;
+
+private:
+    struct Document {
+        std::string imageId;
+        uint32_t firstBox;
+        uint32_t wordCount;
+    };
+
+    std::vector<Document> m_documents;
+    std::vector<OcrQuad> m_boxes;
+    // (document, position) pairs per term, in ascending order because documents are only appended.
+    // Terms are sorted once when serializing.
+    std::unordered_map<std::string, std::vector<std::pair<uint32_t, uint32_t>>> m_postings;
+};
+
+struct TextIndexOptions {
+    uint32_t flushDocuments = 256; // buffered documents that trigger a background flush
+    uint32_t maxSegments = 8;      // segment count above which the smallest segments are merged
+};
+
+struct TextIndexStats {
+    uint64_t segments = 0;
+    uint64_t documents = 0;
+    uint64_t pendingDocuments = 0;
+    uint64_t bytes = 0;
+    uint64_t flushes = 0;
+    uint64_t merges = 0;
+    std::string lastError;
+};
+
+class TextIndex {
+public:
+    // Opens or creates the index in directory. Throws std::runtime_error when it cannot be read.
+    TextIndex(std::filesystem::path directory, TextIndexOptions options);
+    ~TextIndex();
+
+    TextIndex(const TextIndex&) = delete;
+    TextIndex& operator=(const TextIndex&) = delete;
+
+    // Buffers the document, replacing any earlier one with the same id. Searchable immediately,
+    // persisted by the next flush.
+    void Add(const std::string& imageId, const OcrPage& page);
+
+    // Writes buffered documents to a new segment on the calling thread. Throws on I/O errors.
+    void Flush();
+
+    // Images matching every clause, most hits first, at most limit of them
+    std::vector<TextIndexHit> Search(const TextIndexQuery& query, size_t limit);
+
+    TextIndexStats GetStats();
+
+    // Flushes, waits for background work and stops the background thread. Idempotent.
+    void Close();
+
+private:
+    struct Segment {
+        uint64_t id; // kept when the in-memory segment of a flush is replaced by its file
+        uint64_t generation; // 0 for a segment that only exists in memory while it is written
+        std::shared_ptr<TextIndexSegment> data;
+        std::shared_ptr<const std::vector<bool>> deleted; // tombstoned documents, copied on write; null when none
+        uint32_t deletedCount = 0;
+    };
+
+    // Where the live document of an image id is, m_pendingId for the buffer
+    struct Location {
+        uint64_t segment;
+        uint32_t document;
+    };
+
+    std::filesystem::path SegmentPath(uint64_t generation) const;
+    void WriteManifestLocked();
+    void TombstoneLocked(const Location& location);
+    void ReleaseRetiredLocked();
+    std::shared_ptr<TextIndexSegment> WriteSegment(uint64_t generation, const TextIndexSegment& segment);
+    void MergeIfNeeded();
+    static std::vector<TextIndexHit> SearchSnapshot(const std::vector<std::shared_ptr<TextIndexSegment>>& snapshot, const std::vector<std::shared_ptr<const std::vector<bool>>>& snapshotDeleted, const TextIndexQuery& query, size_t limit);
+    void Schedule(std::function<void()> task);
+    void RunBackground();
+
+    std::filesystem::path m_directory;
+    TextIndexOptions m_options;
+
+    std::mutex m_mutex;
+    std::vector<Segment> m_segments;
+    std::unique_ptr<TextIndexSegmentBuilder> m_pending;
+    uint64_t m_pendingId = 0;
+    std::vector<bool> m_pendingDeleted;
+    uint32_t m_pendingDeletedCount = 0;
+    std::shared_ptr<TextIndexSegment> m_pendingView; // searchable snapshot of m_pending, rebuilt lazily
+    std::shared_ptr<const std::vector<bool>> m_pendingViewDeleted;
+    std::unordered_map<std::string, Location> m_locations;
+    std::vector<Segment> m_retired; // merged away, their files are deleted once no search holds them
+    uint64_t m_nextSegmentId = 1;
+    uint64_t m_nextGeneration = 1;
+    uint64_t m_flushes = 0;
+    uint64_t m_merges = 0;
+    std::string m_lastError;
+    bool m_flushScheduled = false;
+    bool m_mergeScheduled = false;
+
+    // Serializes flushes and merges so at most one segment file is written at a time
+    std::mutex m_writeMutex;
+
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueChanged;
+    std::deque<std::function<void()>> m_queue;
+    bool m_stopping = false;
+    std::atomic<bool> m_closed{ false };
+    std::thread m_background;
+};
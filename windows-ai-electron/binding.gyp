@@ -2,7 +2,7 @@
   "targets": [
     {
       "target_name": "windows-ai-electron",
-      "sources": ["windows-ai-electron.cc", "LanguageModelProjections.cpp", "ImagingProjections.cpp", "ProjectionHelper.cpp", "ContentSeverity.cpp", "LimitedAccessFeature.cpp"],
+      "sources": ["windows-ai-electron.cc", "LanguageModelProjections.cpp", "ImagingProjections.cpp", "ProjectionHelper.cpp", "ImagingHelper.cpp", "PixelAnalysis.cpp", "OcrModel.cpp", "OcrLayout.cpp", "OcrTable.cpp", "TextChunking.cpp", "TextDiff.cpp", "PromptPacking.cpp", "TableMerge.cpp", "TableFormat.cpp", "ProgressText.cpp", "TableStream.cpp", "StopConditions.cpp", "OcrWordIndex.cpp", "TextIndex.cpp", "MappedFile.cpp", "ContentHash.cpp", "ResultStore.cpp", "ContentSeverity.cpp", "LimitedAccessFeature.cpp"],
       "include_dirs": [
         "<!@(node -p \"require('node-addon-api').include\")",
         "<!(node -e \"require('nan')\")",
@@ -3,6 +3,7 @@
 #include "ImagingProjections.h"
 #include "ContentSeverity.h"
 #include "LimitedAccessFeature.h"
+#include "ResultStore.h"
 
 using namespace winrt;
 using namespace Microsoft::Windows::AI;
@@ -101,6 +102,7 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
     exports = MyAIFeatureReadyResult::Init(env, exports);
     exports = MyConversationItem::Init(env, exports);
     exports = MyTextSummarizer::Init(env, exports);
+    exports = MyConversationSummarySession::Init(env, exports);
     exports = MyTextRewriter::Init(env, exports);
     exports = MyTextToTableConverter::Init(env, exports);
     exports = MyTextToTableResponseResult::Init(env, exports);
@@ -113,12 +115,15 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
     exports = MyRecognizedLine::Init(env, exports);
     exports = MyRecognizedWord::Init(env, exports);
     exports = MyRecognizedTextBoundingBox::Init(env, exports);
+    exports = MyIncrementalTextRecognizer::Init(env, exports);
+    exports = MyTextSearchIndex::Init(env, exports);
     exports = MyImageObjectExtractor::Init(env, exports);
     exports = MyImageObjectExtractorHint::Init(env, exports);
     exports = MyImageObjectRemover::Init(env, exports);
     
     exports = MyLimitedAccessFeatures::Init(env, exports);
     exports = MyLimitedAccessFeatureRequestResult::Init(env, exports);
+    exports = MyResultStore::Init(env, exports);
     
     return MyImageScaler::Init(env, exports);
 }